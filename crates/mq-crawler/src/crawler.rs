@@ -13,7 +13,7 @@ use std::sync::Arc;
 use std::sync::atomic::{AtomicUsize, Ordering};
 use std::time::{Duration, Instant};
 use std::{fs, io};
-use tokio::sync::{Notify, RwLock, Semaphore};
+use tokio::sync::{Notify, OwnedSemaphorePermit, RwLock, Semaphore};
 use tokio::time::sleep;
 use url::Url;
 
@@ -166,6 +166,10 @@ pub struct Crawler {
 }
 
 impl Crawler {
+    /// Pages at or above this size are converted with the streaming
+    /// HTML-to-Markdown pipeline instead of building a full DOM up front.
+    const STREAMING_CONVERSION_THRESHOLD: usize = 1024 * 1024;
+
     #[allow(clippy::too_many_arguments)]
     pub async fn new(
         http_client: HttpClient,
@@ -291,7 +295,31 @@ impl Crawler {
 
             // Drain the queue, spawning tasks up to the semaphore limit
             while let Some((url, depth)) = self.to_visit.pop() {
-                if self.should_skip_url_without_visited_check(&url) || !self.visited.insert(url.clone()) {
+                if self.should_skip_url_without_visited_check(&url) || self.visited.contains(&url) {
+                    continue;
+                }
+
+                // Per-domain politeness: if the domain is not ready yet, park
+                // the URL on a timer instead of sleeping inside a task that
+                // would pin one of the global fetch permits. Other domains keep
+                // the pipeline full in the meantime.
+                if let Some(domain) = url.domain()
+                    && let Err(wait) = self.try_reserve_domain_slot(domain)
+                {
+                    active_tasks.fetch_add(1, Ordering::SeqCst);
+                    let to_visit = self.to_visit.clone();
+                    let notify = self.notify.clone();
+                    let active_tasks_clone = active_tasks.clone();
+                    tokio::spawn(async move {
+                        sleep(wait).await;
+                        to_visit.push((url, depth));
+                        active_tasks_clone.fetch_sub(1, Ordering::SeqCst);
+                        notify.notify_one();
+                    });
+                    continue;
+                }
+
+                if !self.visited.insert(url.clone()) {
                     continue;
                 }
 
@@ -302,8 +330,7 @@ impl Crawler {
                 let active_tasks_clone = active_tasks.clone();
                 let notify_clone = self.notify.clone();
                 tokio::spawn(async move {
-                    let _permit = permit;
-                    crawler.process_url_with_rate_limit(url, depth).await;
+                    crawler.process_url(url, depth, permit).await;
                     active_tasks_clone.fetch_sub(1, Ordering::SeqCst);
                     // Wake the main loop so it can either spawn new tasks or
                     // detect the termination condition.
@@ -341,46 +368,41 @@ impl Crawler {
         false
     }
 
-    async fn wait_for_domain_rate_limit(&self, domain: &str) {
+    /// Attempts to reserve a request slot for `domain`.
+    ///
+    /// On success the domain's last-request timestamp is updated and the caller
+    /// may fetch immediately. Otherwise returns how long to wait before the
+    /// domain is ready again. The shard lock is held for the whole
+    /// check-and-update so concurrent callers cannot both observe the same
+    /// (or absent) timestamp and simultaneously bypass the per-domain delay.
+    fn try_reserve_domain_slot(&self, domain: &str) -> Result<(), Duration> {
         if self.crawl_delay.is_zero() {
-            return;
+            return Ok(());
         }
-        loop {
-            let now = Instant::now();
-            // Hold the shard lock for the entire check-and-update so concurrent
-            // tasks cannot both observe the same (or absent) timestamp and
-            // simultaneously bypass the intended per-domain delay.
-            let wait = match self.domain_last_request.entry(domain.to_string()) {
-                Entry::Occupied(mut e) => {
-                    let elapsed = now.duration_since(*e.get());
-                    if elapsed >= self.crawl_delay {
-                        e.insert(now);
-                        None
-                    } else {
-                        Some(self.crawl_delay - elapsed)
-                    }
-                }
-                Entry::Vacant(e) => {
+        let now = Instant::now();
+        match self.domain_last_request.entry(domain.to_string()) {
+            Entry::Occupied(mut e) => {
+                let elapsed = now.duration_since(*e.get());
+                if elapsed >= self.crawl_delay {
                     e.insert(now);
-                    None
+                    Ok(())
+                } else {
+                    Err(self.crawl_delay - elapsed)
                 }
-            };
-            // The entry (and its shard lock) is dropped before any await point.
-            match wait {
-                None => return,
-                Some(dur) => sleep(dur).await,
+            }
+            Entry::Vacant(e) => {
+                e.insert(now);
+                Ok(())
             }
         }
     }
 
-    async fn process_url_with_rate_limit(&self, url: Url, depth: usize) {
-        if let Some(domain) = url.domain() {
-            self.wait_for_domain_rate_limit(domain).await;
-        }
-        self.process_url(url, depth).await;
-    }
-
-    async fn process_url(&self, current_url: Url, current_depth: usize) {
+    /// Processes one URL as a two-stage pipeline: the network stage (robots
+    /// lookup and page fetch) runs while holding `fetch_permit`, which is
+    /// released as soon as the body has been downloaded so another fetch can
+    /// start; the CPU stage (HTML→Markdown conversion, disk write, and link
+    /// extraction) then runs on the blocking pool, overlapping with fetches.
+    async fn process_url(&self, current_url: Url, current_depth: usize, fetch_permit: OwnedSemaphorePermit) {
         tracing::info!("Processing URL: {} (depth: {})", current_url, current_depth);
 
         // URL is already marked as visited in run_parallel, no need to check again
@@ -403,6 +425,10 @@ impl Crawler {
 
         match self.http_client.fetch(current_url.clone()).await {
             Ok(html_content) => {
+                // The network stage is done; free the fetch slot before the
+                // CPU-bound conversion so the network stays saturated.
+                drop(fetch_permit);
+
                 tracing::info!("Applying mq query to content from {}", current_url);
 
                 let query = self.mq_query.clone();
@@ -465,7 +491,16 @@ impl Crawler {
     }
 
     fn execute_query(query: &str, input: &str, conversion_options: ConversionOptions) -> miette::Result<String> {
-        let input = mq_lang::parse_html_input_with_options(input, conversion_options)?;
+        // Large pages (API references routinely reach tens of megabytes) go
+        // through the streaming converter so peak memory is bounded by the
+        // largest element instead of the whole document. Streaming emits all
+        // body content rather than extracting `main`/`article` regions, so
+        // small pages keep the higher-fidelity whole-document conversion.
+        let input = if input.len() >= Self::STREAMING_CONVERSION_THRESHOLD {
+            mq_lang::parse_html_input_streaming(input, conversion_options)?
+        } else {
+            mq_lang::parse_html_input_with_options(input, conversion_options)?
+        };
         let mut mq_engine = mq_lang::DefaultEngine::default();
         mq_engine.load_builtin_module();
 
@@ -756,6 +791,42 @@ mod tests {
         assert!(crawler.should_skip_url_without_visited_check(&denied_url));
     }
 
+    #[tokio::test]
+    async fn test_try_reserve_domain_slot_enforces_delay_per_domain() {
+        let start_url = Url::parse("http://start.invalid/").unwrap();
+        let http_client = HttpClient::new_reqwest(30.0).unwrap();
+        let crawler = Crawler::new(
+            http_client,
+            start_url,
+            60.0,
+            None,
+            None,
+            None,
+            4,
+            OutputFormat::Text,
+            mq_markdown::ConversionOptions::default(),
+            None,
+            None,
+            Vec::new(),
+        )
+        .await
+        .unwrap();
+
+        // First reservation per domain succeeds; a second within the delay
+        // reports the remaining wait. Domains are independent.
+        assert!(crawler.try_reserve_domain_slot("a.invalid").is_ok());
+        let wait = crawler.try_reserve_domain_slot("a.invalid").expect_err("within delay");
+        assert!(wait <= Duration::from_secs(60));
+        assert!(crawler.try_reserve_domain_slot("b.invalid").is_ok());
+    }
+
+    #[tokio::test]
+    async fn test_try_reserve_domain_slot_zero_delay_always_ready() {
+        let crawler = make_test_crawler("start.invalid", None, None).await;
+        assert!(crawler.try_reserve_domain_slot("start.invalid").is_ok());
+        assert!(crawler.try_reserve_domain_slot("start.invalid").is_ok());
+    }
+
     #[tokio::test]
     async fn test_crawler_new_with_depth_limit() {
         let start_url = Url::parse("http://start.invalid/").unwrap();
@@ -0,0 +1,130 @@
+//! On-disk HTTP response cache with `ETag`/`Last-Modified` conditional revalidation.
+//!
+//! Entries are keyed by the MD5 of the URL and store the response body together with the
+//! validators the server sent. On a re-crawl, [`crate::http_client::HttpClient`] sends the
+//! recorded validators as `If-None-Match`/`If-Modified-Since`; an unchanged page is
+//! confirmed with an HTTP `304` instead of re-downloaded.
+//!
+//! Cache read/write failures are deliberately non-fatal: a broken cache entry just means
+//! the page is fetched unconditionally, as if the cache were cold.
+
+use std::path::PathBuf;
+
+use serde::{Deserialize, Serialize};
+
+/// A cached HTTP response body and the validators needed to revalidate it.
+#[derive(Debug, Clone, PartialEq, Serialize, Deserialize)]
+pub struct CachedResponse {
+    /// The response body as received.
+    pub body: String,
+    /// The `ETag` response header, sent back as `If-None-Match`.
+    #[serde(skip_serializing_if = "Option::is_none", default)]
+    pub etag: Option<String>,
+    /// The `Last-Modified` response header, sent back as `If-Modified-Since`.
+    #[serde(skip_serializing_if = "Option::is_none", default)]
+    pub last_modified: Option<String>,
+}
+
+impl CachedResponse {
+    /// Returns `true` if this entry carries at least one validator and can
+    /// therefore be revalidated with a conditional request.
+    pub fn has_validators(&self) -> bool {
+        self.etag.is_some() || self.last_modified.is_some()
+    }
+}
+
+/// Directory-backed cache of [`CachedResponse`] entries, one JSON file per URL.
+#[derive(Debug, Clone)]
+pub struct HttpCache {
+    dir: PathBuf,
+}
+
+impl HttpCache {
+    /// Creates a cache rooted at `dir`. The directory is created lazily on first store.
+    pub fn new(dir: PathBuf) -> Self {
+        Self { dir }
+    }
+
+    fn entry_path(&self, url: &str) -> PathBuf {
+        self.dir.join(format!("{:x}.json", md5::compute(url)))
+    }
+
+    /// Loads the cached response for `url`, if present and well-formed.
+    pub fn load(&self, url: &str) -> Option<CachedResponse> {
+        let content = std::fs::read_to_string(self.entry_path(url)).ok()?;
+        serde_json::from_str(&content).ok()
+    }
+
+    /// Stores `response` for `url`. Entries without validators are skipped (they could
+    /// never be revalidated), and I/O errors are logged rather than propagated so a
+    /// read-only or full cache directory never fails a crawl.
+    pub fn store(&self, url: &str, response: &CachedResponse) {
+        if !response.has_validators() {
+            return;
+        }
+        let result = std::fs::create_dir_all(&self.dir).and_then(|_| {
+            let content = serde_json::to_string(response)?;
+            std::fs::write(self.entry_path(url), content)
+        });
+        if let Err(e) = result {
+            tracing::warn!("Failed to write HTTP cache entry for {}: {}", url, e);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_store_and_load_roundtrip() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = HttpCache::new(dir.path().to_path_buf());
+        let response = CachedResponse {
+            body: "<html>hello</html>".to_string(),
+            etag: Some("\"v1\"".to_string()),
+            last_modified: Some("Wed, 01 Jan 2025 00:00:00 GMT".to_string()),
+        };
+
+        cache.store("https://example.com/page", &response);
+        assert_eq!(cache.load("https://example.com/page"), Some(response));
+    }
+
+    #[test]
+    fn test_store_skips_entry_without_validators() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = HttpCache::new(dir.path().to_path_buf());
+        let response = CachedResponse {
+            body: "<html>hello</html>".to_string(),
+            etag: None,
+            last_modified: None,
+        };
+
+        cache.store("https://example.com/page", &response);
+        assert_eq!(cache.load("https://example.com/page"), None);
+    }
+
+    #[test]
+    fn test_load_missing_or_corrupt_entry_returns_none() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = HttpCache::new(dir.path().to_path_buf());
+        assert_eq!(cache.load("https://example.com/missing"), None);
+
+        std::fs::write(cache.entry_path("https://example.com/bad"), "not json").unwrap();
+        assert_eq!(cache.load("https://example.com/bad"), None);
+    }
+
+    #[test]
+    fn test_entries_are_keyed_per_url() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = HttpCache::new(dir.path().to_path_buf());
+        let response = CachedResponse {
+            body: "a".to_string(),
+            etag: Some("\"a\"".to_string()),
+            last_modified: None,
+        };
+
+        cache.store("https://example.com/a", &response);
+        assert_eq!(cache.load("https://example.com/b"), None);
+    }
+}
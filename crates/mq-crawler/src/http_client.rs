@@ -7,10 +7,12 @@ use base64::engine::general_purpose::STANDARD as BASE64;
 use chromiumoxide::cdp::browser_protocol::page::EventLifecycleEvent;
 use futures::StreamExt;
 use reqwest::Client as ReqwestClient;
-use reqwest::header::{AUTHORIZATION, HeaderMap, HeaderValue};
+use reqwest::header::{AUTHORIZATION, ETAG, HeaderMap, HeaderValue, IF_MODIFIED_SINCE, IF_NONE_MATCH, LAST_MODIFIED};
 use tokio::time::sleep;
 use url::Url;
 
+use crate::http_cache::{CachedResponse, HttpCache};
+
 /// Exponential backoff config for retrying failed requests.
 ///
 /// Retries on network errors, `429`, and `5xx`; other client errors (e.g. `404`) are not retried.
@@ -98,7 +100,11 @@ pub struct ChromiumWaitConfig {
 /// Enum for different HTTP client implementations
 #[derive(Debug, Clone)]
 pub enum HttpClient {
-    Reqwest(ReqwestClient, RetryConfig),
+    /// Plain HTTP client with an optional on-disk response cache: when set, fetched
+    /// pages are revalidated with conditional requests (`If-None-Match`/
+    /// `If-Modified-Since`) so unchanged pages cost an HTTP `304` instead of a
+    /// re-download. See [`crate::http_cache::HttpCache`].
+    Reqwest(ReqwestClient, RetryConfig, Option<HttpCache>),
     Fantoccini(fantoccini::Client, RetryConfig),
     /// Headless Chrome via CDP.
     /// `new_page()` waits for the `load` event, which covers synchronous JS
@@ -120,6 +126,7 @@ impl Default for HttpClient {
                 .build()
                 .expect("Failed to build default reqwest client"),
             RetryConfig::default(),
+            None,
         )
     }
 }
@@ -180,7 +187,25 @@ impl HttpClient {
         let client = builder
             .build()
             .map_err(|e| format!("Failed to build reqwest client: {}", e))?;
-        Ok(Self::Reqwest(client, retry_config))
+        Ok(Self::Reqwest(client, retry_config, None))
+    }
+
+    /// Attaches an on-disk response cache rooted at `dir`, enabling conditional
+    /// revalidation (`ETag`/`Last-Modified`) on re-crawls.
+    ///
+    /// Only applies to the plain reqwest client; browser-based clients render pages
+    /// through a browser and have no access to raw response headers, so the setting is
+    /// ignored (with a warning) for them.
+    pub fn with_cache_dir(self, dir: PathBuf) -> Self {
+        match self {
+            HttpClient::Reqwest(client, retry_config, _) => {
+                HttpClient::Reqwest(client, retry_config, Some(HttpCache::new(dir)))
+            }
+            other => {
+                tracing::warn!("--cache-dir only applies to non-browser crawling and will be ignored.");
+                other
+            }
+        }
     }
 
     /// Create a headless Chrome client that launches Chrome/Chromium automatically.
@@ -235,7 +260,7 @@ impl HttpClient {
 
     fn retry_config(&self) -> &RetryConfig {
         match self {
-            HttpClient::Reqwest(_, retry_config) => retry_config,
+            HttpClient::Reqwest(_, retry_config, _) => retry_config,
             HttpClient::Fantoccini(_, retry_config) => retry_config,
             HttpClient::Chromium(_, _, retry_config, _) => retry_config,
         }
@@ -271,19 +296,63 @@ impl HttpClient {
 
     async fn fetch_once(&self, url: Url) -> Result<String, FetchError> {
         match self {
-            HttpClient::Reqwest(client, _) => {
-                let response = client
-                    .get(url.clone())
+            HttpClient::Reqwest(client, _, cache) => {
+                let cached = cache.as_ref().and_then(|cache| cache.load(url.as_str()));
+
+                let mut request = client.get(url.clone());
+                if let Some(cached) = &cached {
+                    if let Some(etag) = &cached.etag {
+                        request = request.header(IF_NONE_MATCH, etag);
+                    }
+                    if let Some(last_modified) = &cached.last_modified {
+                        request = request.header(IF_MODIFIED_SINCE, last_modified);
+                    }
+                }
+
+                let response = request
                     .send()
                     .await
                     .map_err(|e| FetchError::Retryable(format!("Failed to fetch URL {}: {}", url, e)))?;
 
                 let status = response.status();
+                if status == reqwest::StatusCode::NOT_MODIFIED
+                    && let Some(cached) = cached
+                {
+                    tracing::debug!("Content not modified, serving {} from cache", url);
+                    return Ok(cached.body);
+                }
+
                 if status.is_success() {
-                    response
+                    let header_value = |name| {
+                        response
+                            .headers()
+                            .get(name)
+                            .and_then(|v: &HeaderValue| v.to_str().ok())
+                            .map(|s| s.to_string())
+                    };
+                    let etag = header_value(ETAG);
+                    let last_modified = header_value(LAST_MODIFIED);
+
+                    let body = response
                         .text()
                         .await
-                        .map_err(|e| FetchError::Retryable(format!("Failed to read response text: {}", e)))
+                        .map_err(|e| FetchError::Retryable(format!("Failed to read response text: {}", e)))?;
+
+                    // Avoid cloning the body for responses that could never be revalidated.
+                    if let Some(cache) = cache
+                        && (etag.is_some() || last_modified.is_some())
+                    {
+                        cache.store(
+                            url.as_str(),
+                            &CachedResponse {
+                                body: body.clone(),
+                                etag,
+                                last_modified,
+                            },
+                        );
+                    }
+
+                    Ok(body)
                 } else if status.as_u16() == 429 || status.is_server_error() {
                     Err(FetchError::Retryable(format!(
                         "Request to {} failed with status: {}",
@@ -409,13 +478,13 @@ mod tests {
     #[test]
     fn test_default_client_creation() {
         let client = HttpClient::default();
-        assert!(matches!(client, HttpClient::Reqwest(_, _)));
+        assert!(matches!(client, HttpClient::Reqwest(_, _, _)));
     }
 
     #[test]
     fn test_new_reqwest_client() {
         let client = HttpClient::new_reqwest(30.0).unwrap();
-        assert!(matches!(client, HttpClient::Reqwest(_, _)));
+        assert!(matches!(client, HttpClient::Reqwest(_, _, _)));
         assert_eq!(client.retry_config(), &RetryConfig::default());
     }
 
@@ -432,7 +501,7 @@ mod tests {
             }),
         )
         .unwrap();
-        assert!(matches!(client, HttpClient::Reqwest(_, _)));
+        assert!(matches!(client, HttpClient::Reqwest(_, _, _)));
     }
 
     #[test]
@@ -447,7 +516,7 @@ mod tests {
             }),
         )
         .unwrap();
-        assert!(matches!(client, HttpClient::Reqwest(_, _)));
+        assert!(matches!(client, HttpClient::Reqwest(_, _, _)));
     }
 
     #[test]
@@ -501,6 +570,106 @@ mod tests {
         assert_eq!(mock.calls_async().await, 3);
     }
 
+    #[tokio::test]
+    async fn test_fetch_serves_cached_body_on_304() {
+        use httpmock::MockServer;
+
+        let server = MockServer::start_async().await;
+        let cache_dir = tempfile::tempdir().unwrap();
+        let client = HttpClient::new_reqwest(5.0)
+            .unwrap()
+            .with_cache_dir(cache_dir.path().to_path_buf());
+        let url = Url::parse(&format!("http://{}/page", server.address())).unwrap();
+
+        // First crawl: full download, validators recorded.
+        let mock_200 = server
+            .mock_async(|when, then| {
+                when.method(httpmock::Method::GET).path("/page");
+                then.status(200).header("etag", "\"v1\"").body("original content");
+            })
+            .await;
+        assert_eq!(client.fetch(url.clone()).await.unwrap(), "original content");
+        mock_200.delete_async().await;
+
+        // Re-crawl: the recorded ETag is sent back and the 304 answer is served
+        // from the cache without a body transfer.
+        let mock_304 = server
+            .mock_async(|when, then| {
+                when.method(httpmock::Method::GET)
+                    .path("/page")
+                    .header("if-none-match", "\"v1\"");
+                then.status(304);
+            })
+            .await;
+        assert_eq!(client.fetch(url).await.unwrap(), "original content");
+        assert_eq!(mock_304.calls_async().await, 1);
+    }
+
+    #[tokio::test]
+    async fn test_fetch_updates_cache_when_content_changes() {
+        use httpmock::MockServer;
+
+        let server = MockServer::start_async().await;
+        let cache_dir = tempfile::tempdir().unwrap();
+        let client = HttpClient::new_reqwest(5.0)
+            .unwrap()
+            .with_cache_dir(cache_dir.path().to_path_buf());
+        let url = Url::parse(&format!("http://{}/page", server.address())).unwrap();
+
+        let mock_v1 = server
+            .mock_async(|when, then| {
+                when.method(httpmock::Method::GET).path("/page");
+                then.status(200).header("etag", "\"v1\"").body("old content");
+            })
+            .await;
+        assert_eq!(client.fetch(url.clone()).await.unwrap(), "old content");
+        mock_v1.delete_async().await;
+
+        // The page changed: the conditional request gets a 200 with a new validator,
+        // which must replace the cached entry.
+        let mock_v2 = server
+            .mock_async(|when, then| {
+                when.method(httpmock::Method::GET)
+                    .path("/page")
+                    .header("if-none-match", "\"v1\"");
+                then.status(200).header("etag", "\"v2\"").body("new content");
+            })
+            .await;
+        assert_eq!(client.fetch(url.clone()).await.unwrap(), "new content");
+        mock_v2.delete_async().await;
+
+        let mock_304 = server
+            .mock_async(|when, then| {
+                when.method(httpmock::Method::GET)
+                    .path("/page")
+                    .header("if-none-match", "\"v2\"");
+                then.status(304);
+            })
+            .await;
+        assert_eq!(client.fetch(url).await.unwrap(), "new content");
+        assert_eq!(mock_304.calls_async().await, 1);
+    }
+
+    #[tokio::test]
+    async fn test_fetch_without_cache_sends_no_conditional_headers() {
+        use httpmock::MockServer;
+
+        let server = MockServer::start_async().await;
+        let client = HttpClient::new_reqwest(5.0).unwrap();
+        let url = Url::parse(&format!("http://{}/page", server.address())).unwrap();
+
+        let mock = server
+            .mock_async(|when, then| {
+                when.method(httpmock::Method::GET).path("/page");
+                then.status(200).header("etag", "\"v1\"").body("content");
+            })
+            .await;
+
+        assert_eq!(client.fetch(url.clone()).await.unwrap(), "content");
+        assert_eq!(client.fetch(url).await.unwrap(), "content");
+        assert_eq!(mock.calls_async().await, 2);
+    }
+
     #[tokio::test]
     async fn test_fetch_does_not_retry_on_client_error() {
         use httpmock::MockServer;
@@ -16,6 +16,7 @@
 //! - Basic and bearer authentication for protected sites
 //! - Automatic retry with exponential backoff for failed requests
 //! - Rate limiting and politeness delays
+//! - Optional on-disk response cache with `ETag`/`Last-Modified` conditional revalidation
 //!
 //! # Usage
 //!
@@ -44,6 +45,7 @@
 //! - Tracks statistics about the crawl
 //!
 pub mod crawler;
+pub mod http_cache;
 pub mod http_client;
 pub mod robots;
 pub mod sitemap;
@@ -127,6 +127,11 @@ struct CliArgs {
     /// Bearer token for "Authorization: Bearer <token>". Non-browser crawling only.
     #[clap(long, value_name = "TOKEN", conflicts_with = "basic_auth")]
     bearer_token: Option<String>,
+    /// Directory for an on-disk HTTP response cache. On re-crawls, pages are revalidated
+    /// with conditional requests (ETag/Last-Modified) and unchanged pages are served from
+    /// the cache (HTTP 304) instead of re-downloaded. Non-browser crawling only.
+    #[clap(long, value_name = "DIR")]
+    cache_dir: Option<std::path::PathBuf>,
     #[clap(flatten)]
     pub conversion: ConversionArgs,
 }
@@ -321,6 +326,12 @@ async fn main() {
         .unwrap()
     };
 
+    let client = if let Some(dir) = args.cache_dir {
+        client.with_cache_dir(dir)
+    } else {
+        client
+    };
+
     let format = match args.format {
         OutputFormat::Text => mq_crawler::crawler::OutputFormat::Text,
         OutputFormat::Json => mq_crawler::crawler::OutputFormat::Json,
@@ -10,6 +10,8 @@ fn main() {
         .with_include_guard("MQ_H")
         .rename_item("MqContext", "mq_context_t")
         .rename_item("MqResult", "mq_result_t")
+        .rename_item("MqCompiledQuery", "mq_compiled_query_t")
+        .rename_item("MqBatchResult", "mq_batch_result_t")
         .generate()
         .unwrap();
     bindings.write_to_file(Path::new(&crate_dir).join("mq.h"));
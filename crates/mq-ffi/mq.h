@@ -23,6 +23,10 @@ typedef struct mq_result_t {
   char *error_msg;
 } mq_result_t;
 
+typedef void mq_compiled_query_t;
+
+typedef void mq_batch_result_t;
+
 /**
  * C-compatible conversion options for HTML to Markdown conversion.
  */
@@ -89,6 +93,92 @@ void mq_free_string(char *s);
  */
 void mq_free_result(struct mq_result_t result);
 
+/**
+ * Compiles mq code into a reusable query handle, so the parse/compile cost is
+ * paid once when the same query is evaluated against many documents.
+ * Returns NULL on error and, if `error_msg` is non-null, stores a message that
+ * must be freed with `mq_free_string`. The returned handle must be destroyed
+ * with `mq_compiled_destroy`.
+ *
+ * # Safety
+ *
+ * This function is unsafe because it dereferences raw pointers. The caller must ensure:
+ * - `engine_ptr` must be a valid pointer to an `Engine` created by `mq_create`
+ * - `code_c` must be a valid pointer to a null-terminated C string
+ * - `error_msg` must be null or a valid pointer to a location where an error message pointer can be stored
+ */
+mq_compiled_query_t *mq_compile(mq_context_t *engine_ptr,
+                                const char *code_c,
+                                char **error_msg);
+
+/**
+ * Destroys a compiled query created by `mq_compile`.
+ */
+void mq_compiled_destroy(mq_compiled_query_t *compiled_ptr);
+
+/**
+ * Evaluates a compiled query against input borrowed from caller memory.
+ *
+ * Unlike `mq_eval`, the input is passed as a pointer plus byte length: it does
+ * not need to be null-terminated and is never copied before parsing, so a
+ * caller can point directly into a memory-mapped file or a larger buffer.
+ * The returned handle is never NULL (except on allocation failure inside the
+ * allocator itself); evaluation and parse failures are reported through
+ * `mq_batch_error`. The handle must be freed with `mq_free_batch_result`.
+ *
+ * # Safety
+ *
+ * This function is unsafe because it dereferences raw pointers. The caller must ensure:
+ * - `engine_ptr` must be a valid pointer to an `Engine` created by `mq_create`
+ * - `compiled_ptr` must be a valid pointer to a compiled query created by `mq_compile`
+ * - `input` must point to `input_len` bytes of valid UTF-8, or be null only if `input_len` is 0
+ * - `input_format_c` must be a valid pointer to a null-terminated C string
+ * - The input bytes must remain valid for the duration of this function call; they
+ *   are not referenced after it returns
+ */
+mq_batch_result_t *mq_eval_batch(mq_context_t *engine_ptr,
+                                 const mq_compiled_query_t *compiled_ptr,
+                                 const char *input,
+                                 uintptr_t input_len,
+                                 const char *input_format_c);
+
+/**
+ * Returns the number of values in a batch result, or 0 if `result_ptr` is null
+ * or the evaluation failed.
+ */
+uintptr_t mq_batch_len(const mq_batch_result_t *result_ptr);
+
+/**
+ * Returns the error message of a batch result, or NULL if the evaluation
+ * succeeded. The returned string is borrowed from the result handle and is
+ * valid until `mq_free_batch_result` is called; it must not be freed by the caller.
+ */
+const char *mq_batch_error(const mq_batch_result_t *result_ptr);
+
+/**
+ * Advances the batch result iterator and exposes the next value as a borrowed
+ * string slice. Returns `true` and stores the slice pointer and byte length in
+ * `value_out` / `value_len_out` while values remain, `false` once the batch is
+ * exhausted (or on a null/failed result).
+ *
+ * The slice is NOT null-terminated and is only valid until the next
+ * `mq_batch_next` call on the same result or `mq_free_batch_result`,
+ * whichever comes first; copy it if it must outlive the iteration step.
+ *
+ * # Safety
+ *
+ * This function is unsafe because it dereferences raw pointers. The caller must ensure:
+ * - `result_ptr` must be a valid pointer to a batch result created by `mq_eval_batch`, or null
+ * - `value_out` and `value_len_out` must be valid pointers, or null to skip the value
+ */
+bool mq_batch_next(mq_batch_result_t *result_ptr, const char **value_out, uintptr_t *value_len_out);
+
+/**
+ * Frees a batch result created by `mq_eval_batch`, invalidating any slices
+ * previously returned by `mq_batch_next` and the string returned by `mq_batch_error`.
+ */
+void mq_free_batch_result(mq_batch_result_t *result_ptr);
+
 /**
  * Converts HTML to Markdown with the given conversion options.
  * Returns a C string containing the markdown output, or NULL on error.
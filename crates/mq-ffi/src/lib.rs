@@ -8,6 +8,8 @@
 //! - Create and manage mq engine instances
 //! - Evaluate mq code with markdown, MDX, HTML, or plain text input
 //! - Memory-safe API with proper ownership handling
+//! - Batch evaluation: compile a query once and run it against many documents
+//!   with zero-copy (pointer + length) input
 //! - Support for multiple input formats: markdown, MDX, HTML, and plain text
 //!
 //! # Basic Usage
@@ -67,6 +69,18 @@ use std::path::PathBuf;
 use std::ptr;
 
 pub type MqContext = c_void;
+pub type MqCompiledQuery = c_void;
+pub type MqBatchResult = c_void;
+
+/// Owned state behind a `MqBatchResult` handle: the evaluated values plus a
+/// rendering slot reused by `mq_batch_next`, so iterating a batch performs one
+/// string render per value and no per-value C allocations.
+struct BatchResult {
+    values: Vec<RuntimeValue>,
+    index: usize,
+    current: String,
+    error: Option<CString>,
+}
 
 #[repr(C)]
 pub struct MqResult {
@@ -128,6 +142,18 @@ unsafe fn c_str_array_to_strings(items: *const *const c_char, items_len: usize)
         .collect()
 }
 
+// Parses input text into runtime values according to the input format
+// ("text", "markdown", "mdx" or "html"). Shared by `mq_eval` and `mq_eval_batch`.
+fn parse_input_values(input_str: &str, input_format: &str) -> Result<Vec<RuntimeValue>, String> {
+    match input_format {
+        "text" => Ok(mq_lang::parse_text_input(input_str).unwrap()),
+        "markdown" => mq_lang::parse_markdown_input(input_str).map_err(|e| format!("Markdown parsing error: {}", e)),
+        "mdx" => mq_lang::parse_mdx_input(input_str).map_err(|e| format!("Markdown parsing error: {}", e)),
+        "html" => mq_lang::parse_html_input(input_str).map_err(|e| format!("Html parsing error: {}", e)),
+        _ => Err(format!("Unsupported input format: {}", input_format)),
+    }
+}
+
 /// Creates a new mq_lang engine.
 /// The caller is responsible for destroying the engine using `mq_destroy`.
 #[unsafe(no_mangle)]
@@ -226,43 +252,13 @@ pub unsafe extern "C" fn mq_eval(
         }
     };
 
-    let mq_input_values: Vec<RuntimeValue> = match input_format_str.as_str() {
-        "text" => mq_lang::parse_text_input(input_str).unwrap(),
-        "markdown" => match mq_lang::parse_markdown_input(input_str) {
-            Ok(v) => v,
-            Err(e) => {
-                return MqResult {
-                    values: ptr::null_mut(),
-                    values_len: 0,
-                    error_msg: to_c_string(format!("Markdown parsing error: {}", e)),
-                };
-            }
-        },
-        "mdx" => match mq_lang::parse_mdx_input(input_str) {
-            Ok(v) => v,
-            Err(e) => {
-                return MqResult {
-                    values: ptr::null_mut(),
-                    values_len: 0,
-                    error_msg: to_c_string(format!("Markdown parsing error: {}", e)),
-                };
-            }
-        },
-        "html" => match mq_lang::parse_html_input(input_str) {
-            Ok(v) => v,
-            Err(e) => {
-                return MqResult {
-                    values: ptr::null_mut(),
-                    values_len: 0,
-                    error_msg: to_c_string(format!("Html parsing error: {}", e)),
-                };
-            }
-        },
-        _ => {
+    let mq_input_values: Vec<RuntimeValue> = match parse_input_values(input_str, input_format_str.as_str()) {
+        Ok(values) => values,
+        Err(msg) => {
             return MqResult {
                 values: ptr::null_mut(),
                 values_len: 0,
-                error_msg: to_c_string(format!("Unsupported input format: {}", input_format_str)),
+                error_msg: to_c_string(msg),
             };
         }
     };
@@ -345,6 +341,239 @@ pub extern "C" fn mq_free_result(result: MqResult) {
     }
 }
 
+/// Compiles mq code into a reusable query handle, so the parse/compile cost is
+/// paid once when the same query is evaluated against many documents.
+/// Returns NULL on error and, if `error_msg` is non-null, stores a message that
+/// must be freed with `mq_free_string`. The returned handle must be destroyed
+/// with `mq_compiled_destroy`.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers. The caller must ensure:
+/// - `engine_ptr` must be a valid pointer to an `Engine` created by `mq_create`
+/// - `code_c` must be a valid pointer to a null-terminated C string
+/// - `error_msg` must be null or a valid pointer to a location where an error message pointer can be stored
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mq_compile(
+    engine_ptr: *mut MqContext,
+    code_c: *const c_char,
+    error_msg: *mut *mut c_char,
+) -> *mut MqCompiledQuery {
+    if !error_msg.is_null() {
+        unsafe {
+            *error_msg = ptr::null_mut();
+        }
+    }
+
+    if engine_ptr.is_null() {
+        if !error_msg.is_null() {
+            unsafe {
+                *error_msg = to_c_string("Engine pointer is null".to_string());
+            }
+        }
+        return ptr::null_mut();
+    }
+    let engine = unsafe { &mut *(engine_ptr as *mut Engine) };
+
+    let code = match unsafe { c_str_to_rust_str_slice(code_c) } {
+        Ok(s) => s,
+        Err(_) => {
+            if !error_msg.is_null() {
+                unsafe {
+                    *error_msg = to_c_string("Invalid UTF-8 sequence in code".to_string());
+                }
+            }
+            return ptr::null_mut();
+        }
+    };
+
+    match engine.compile(code) {
+        Ok(compiled) => Box::into_raw(Box::new(compiled)) as *mut MqCompiledQuery,
+        Err(e) => {
+            if !error_msg.is_null() {
+                unsafe {
+                    *error_msg = to_c_string(format!("Error compiling query: {}", e));
+                }
+            }
+            ptr::null_mut()
+        }
+    }
+}
+
+/// Destroys a compiled query created by `mq_compile`.
+#[unsafe(no_mangle)]
+pub extern "C" fn mq_compiled_destroy(compiled_ptr: *mut MqCompiledQuery) {
+    if compiled_ptr.is_null() {
+        return;
+    }
+    unsafe {
+        let _ = Box::from_raw(compiled_ptr as *mut mq_lang::CompiledProgram);
+    }
+}
+
+/// Evaluates a compiled query against input borrowed from caller memory.
+///
+/// Unlike `mq_eval`, the input is passed as a pointer plus byte length: it does
+/// not need to be null-terminated and is never copied before parsing, so a
+/// caller can point directly into a memory-mapped file or a larger buffer.
+/// The returned handle is never NULL (except on allocation failure inside the
+/// allocator itself); evaluation and parse failures are reported through
+/// `mq_batch_error`. The handle must be freed with `mq_free_batch_result`.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers. The caller must ensure:
+/// - `engine_ptr` must be a valid pointer to an `Engine` created by `mq_create`
+/// - `compiled_ptr` must be a valid pointer to a compiled query created by `mq_compile`
+/// - `input` must point to `input_len` bytes of valid UTF-8, or be null only if `input_len` is 0
+/// - `input_format_c` must be a valid pointer to a null-terminated C string
+/// - The input bytes must remain valid for the duration of this function call; they
+///   are not referenced after it returns
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mq_eval_batch(
+    engine_ptr: *mut MqContext,
+    compiled_ptr: *const MqCompiledQuery,
+    input: *const c_char,
+    input_len: usize,
+    input_format_c: *const c_char, // "markdown", "mdx", "html" or "text"
+) -> *mut MqBatchResult {
+    fn error_result(msg: String) -> *mut MqBatchResult {
+        Box::into_raw(Box::new(BatchResult {
+            values: Vec::new(),
+            index: 0,
+            current: String::new(),
+            error: CString::new(msg).ok(),
+        })) as *mut MqBatchResult
+    }
+
+    if engine_ptr.is_null() {
+        return error_result("Engine pointer is null".to_string());
+    }
+    if compiled_ptr.is_null() {
+        return error_result("Compiled query pointer is null".to_string());
+    }
+    if input.is_null() && input_len > 0 {
+        return error_result("Input pointer is null".to_string());
+    }
+
+    let engine = unsafe { &mut *(engine_ptr as *mut Engine) };
+    let compiled = unsafe { &*(compiled_ptr as *const mq_lang::CompiledProgram) };
+
+    let input_str = if input_len == 0 {
+        ""
+    } else {
+        let input_bytes = unsafe { std::slice::from_raw_parts(input as *const u8, input_len) };
+        match std::str::from_utf8(input_bytes) {
+            Ok(s) => s,
+            Err(_) => return error_result("Invalid UTF-8 sequence in input".to_string()),
+        }
+    };
+
+    let input_format_str = match unsafe { c_str_to_rust_str_slice(input_format_c) } {
+        Ok(s) => s.to_lowercase(),
+        Err(_) => return error_result("Invalid UTF-8 sequence in input_format".to_string()),
+    };
+
+    let mq_input_values = match parse_input_values(input_str, input_format_str.as_str()) {
+        Ok(values) => values,
+        Err(msg) => return error_result(msg),
+    };
+
+    match engine.eval_compiled(compiled, mq_input_values.into_iter()) {
+        Ok(result_values) => Box::into_raw(Box::new(BatchResult {
+            values: result_values.into_iter().collect(),
+            index: 0,
+            current: String::new(),
+            error: None,
+        })) as *mut MqBatchResult,
+        Err(e) => error_result(format!("Error evaluating query: {}", e)),
+    }
+}
+
+/// Returns the number of values in a batch result, or 0 if `result_ptr` is null
+/// or the evaluation failed.
+#[unsafe(no_mangle)]
+pub extern "C" fn mq_batch_len(result_ptr: *const MqBatchResult) -> usize {
+    if result_ptr.is_null() {
+        return 0;
+    }
+    let result = unsafe { &*(result_ptr as *const BatchResult) };
+    result.values.len()
+}
+
+/// Returns the error message of a batch result, or NULL if the evaluation
+/// succeeded. The returned string is borrowed from the result handle and is
+/// valid until `mq_free_batch_result` is called; it must not be freed by the caller.
+#[unsafe(no_mangle)]
+pub extern "C" fn mq_batch_error(result_ptr: *const MqBatchResult) -> *const c_char {
+    if result_ptr.is_null() {
+        return ptr::null();
+    }
+    let result = unsafe { &*(result_ptr as *const BatchResult) };
+    result.error.as_ref().map_or(ptr::null(), |e| e.as_ptr())
+}
+
+/// Advances the batch result iterator and exposes the next value as a borrowed
+/// string slice. Returns `true` and stores the slice pointer and byte length in
+/// `value_out` / `value_len_out` while values remain, `false` once the batch is
+/// exhausted (or on a null/failed result).
+///
+/// The slice is NOT null-terminated and is only valid until the next
+/// `mq_batch_next` call on the same result or `mq_free_batch_result`,
+/// whichever comes first; copy it if it must outlive the iteration step.
+///
+/// # Safety
+///
+/// This function is unsafe because it dereferences raw pointers. The caller must ensure:
+/// - `result_ptr` must be a valid pointer to a batch result created by `mq_eval_batch`, or null
+/// - `value_out` and `value_len_out` must be valid pointers, or null to skip the value
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn mq_batch_next(
+    result_ptr: *mut MqBatchResult,
+    value_out: *mut *const c_char,
+    value_len_out: *mut usize,
+) -> bool {
+    if result_ptr.is_null() {
+        return false;
+    }
+    let result = unsafe { &mut *(result_ptr as *mut BatchResult) };
+
+    let Some(value) = result.values.get(result.index) else {
+        return false;
+    };
+    result.index += 1;
+
+    // Render into the reusable slot so iteration allocates at most one growing
+    // buffer for the whole batch instead of one C string per value.
+    result.current.clear();
+    use std::fmt::Write;
+    let _ = write!(result.current, "{}", value);
+
+    if !value_out.is_null() {
+        unsafe {
+            *value_out = result.current.as_ptr() as *const c_char;
+        }
+    }
+    if !value_len_out.is_null() {
+        unsafe {
+            *value_len_out = result.current.len();
+        }
+    }
+    true
+}
+
+/// Frees a batch result created by `mq_eval_batch`, invalidating any slices
+/// previously returned by `mq_batch_next` and the string returned by `mq_batch_error`.
+#[unsafe(no_mangle)]
+pub extern "C" fn mq_free_batch_result(result_ptr: *mut MqBatchResult) {
+    if result_ptr.is_null() {
+        return;
+    }
+    unsafe {
+        let _ = Box::from_raw(result_ptr as *mut BatchResult);
+    }
+}
+
 /// Converts HTML to Markdown with the given conversion options.
 /// Returns a C string containing the markdown output, or NULL on error.
 /// The caller is responsible for freeing the result using `mq_free_string`.
@@ -1557,4 +1786,235 @@ mod tests {
 
         mq_destroy(engine);
     }
+
+    // Helper that reads the borrowed slice exposed by `mq_batch_next` into an
+    // owned Rust string for assertions.
+    unsafe fn batch_next_to_string(result: *mut MqBatchResult) -> Option<String> {
+        let mut value_ptr: *const c_char = ptr::null();
+        let mut value_len: usize = 0;
+        if unsafe { mq_batch_next(result, &mut value_ptr, &mut value_len) } {
+            let bytes = unsafe { std::slice::from_raw_parts(value_ptr as *const u8, value_len) };
+            Some(String::from_utf8_lossy(bytes).into_owned())
+        } else {
+            None
+        }
+    }
+
+    #[test]
+    fn test_compile_and_destroy() {
+        let engine = mq_create();
+        let code = make_c_string(".h");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        assert!(!compiled.is_null());
+        assert!(error_msg.is_null());
+
+        mq_compiled_destroy(compiled);
+        // Destroying a null compiled query should not crash.
+        mq_compiled_destroy(ptr::null_mut());
+
+        unsafe { mq_free_string(code as *mut c_char) };
+        mq_destroy(engine);
+    }
+
+    #[test]
+    fn test_compile_with_syntax_error() {
+        let engine = mq_create();
+        let code = make_c_string("def foo(:");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        assert!(compiled.is_null());
+        assert!(!error_msg.is_null());
+
+        let msg = unsafe { c_string_to_rust_string(error_msg) };
+        assert!(msg.contains("Error compiling query"));
+
+        unsafe {
+            mq_free_string(error_msg);
+            mq_free_string(code as *mut c_char);
+        }
+        mq_destroy(engine);
+    }
+
+    #[test]
+    fn test_compile_with_null_engine() {
+        let code = make_c_string(".h");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+
+        let compiled = unsafe { mq_compile(ptr::null_mut(), code, &mut error_msg) };
+        assert!(compiled.is_null());
+
+        let msg = unsafe { c_string_to_rust_string(error_msg) };
+        assert_eq!(msg, "Engine pointer is null");
+
+        unsafe {
+            mq_free_string(error_msg);
+            mq_free_string(code as *mut c_char);
+        }
+    }
+
+    #[test]
+    fn test_eval_batch_with_markdown_input() {
+        let engine = mq_create();
+        let code = make_c_string(".h");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        assert!(!compiled.is_null());
+
+        // The input is passed as pointer + length and is deliberately not
+        // null-terminated: a slice of a larger buffer must work unchanged.
+        let buffer = "# Heading\n\ntext!!trailing bytes that are not part of the input";
+        let input_len = buffer.find("!!").unwrap();
+        let format = make_c_string("markdown");
+
+        let result = unsafe { mq_eval_batch(engine, compiled, buffer.as_ptr() as *const c_char, input_len, format) };
+        assert!(!result.is_null());
+        assert!(mq_batch_error(result).is_null());
+        assert_eq!(mq_batch_len(result), 2);
+
+        let first = unsafe { batch_next_to_string(result) }.unwrap();
+        assert!(first.contains("Heading"));
+        // The text paragraph does not match `.h`, so it renders as an empty value.
+        assert_eq!(unsafe { batch_next_to_string(result) }.as_deref(), Some(""));
+        // Exhausted: further calls keep returning false.
+        assert_eq!(unsafe { batch_next_to_string(result) }, None);
+        assert_eq!(unsafe { batch_next_to_string(result) }, None);
+
+        mq_free_batch_result(result);
+        mq_compiled_destroy(compiled);
+        unsafe {
+            mq_free_string(code as *mut c_char);
+            mq_free_string(format as *mut c_char);
+        }
+        mq_destroy(engine);
+    }
+
+    #[test]
+    fn test_eval_batch_reuses_compiled_query_across_inputs() {
+        let engine = mq_create();
+        let code = make_c_string("upcase()");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        assert!(!compiled.is_null());
+        let format = make_c_string("text");
+
+        for (input, expected) in [("hello", "HELLO"), ("world", "WORLD")] {
+            let result =
+                unsafe { mq_eval_batch(engine, compiled, input.as_ptr() as *const c_char, input.len(), format) };
+            assert!(mq_batch_error(result).is_null());
+            assert_eq!(mq_batch_len(result), 1);
+            assert_eq!(unsafe { batch_next_to_string(result) }.as_deref(), Some(expected));
+            mq_free_batch_result(result);
+        }
+
+        mq_compiled_destroy(compiled);
+        unsafe {
+            mq_free_string(code as *mut c_char);
+            mq_free_string(format as *mut c_char);
+        }
+        mq_destroy(engine);
+    }
+
+    #[test]
+    fn test_eval_batch_with_empty_input() {
+        let engine = mq_create();
+        let code = make_c_string("identity()");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        assert!(!compiled.is_null());
+        let format = make_c_string("text");
+
+        // A null input pointer is allowed when the length is zero.
+        let result = unsafe { mq_eval_batch(engine, compiled, ptr::null(), 0, format) };
+        assert!(!result.is_null());
+        assert!(mq_batch_error(result).is_null());
+
+        mq_free_batch_result(result);
+        mq_compiled_destroy(compiled);
+        unsafe {
+            mq_free_string(code as *mut c_char);
+            mq_free_string(format as *mut c_char);
+        }
+        mq_destroy(engine);
+    }
+
+    #[test]
+    fn test_eval_batch_error_reporting() {
+        let engine = mq_create();
+        let code = make_c_string(".h");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        assert!(!compiled.is_null());
+
+        let input = "test";
+        let format = make_c_string("unsupported_format");
+        let result = unsafe { mq_eval_batch(engine, compiled, input.as_ptr() as *const c_char, input.len(), format) };
+        assert!(!result.is_null());
+        assert_eq!(mq_batch_len(result), 0);
+
+        let error_ptr = mq_batch_error(result);
+        assert!(!error_ptr.is_null());
+        let msg = unsafe { CStr::from_ptr(error_ptr) }.to_string_lossy().into_owned();
+        assert_eq!(msg, "Unsupported input format: unsupported_format");
+
+        // Iterating a failed batch yields nothing.
+        assert_eq!(unsafe { batch_next_to_string(result) }, None);
+
+        mq_free_batch_result(result);
+        mq_compiled_destroy(compiled);
+        unsafe {
+            mq_free_string(code as *mut c_char);
+            mq_free_string(format as *mut c_char);
+        }
+        mq_destroy(engine);
+    }
+
+    #[test]
+    fn test_eval_batch_with_null_pointers() {
+        let engine = mq_create();
+        let code = make_c_string(".h");
+        let mut error_msg: *mut c_char = ptr::null_mut();
+        let compiled = unsafe { mq_compile(engine, code, &mut error_msg) };
+        let input = "test";
+        let format = make_c_string("text");
+
+        let null_engine = unsafe {
+            mq_eval_batch(
+                ptr::null_mut(),
+                compiled,
+                input.as_ptr() as *const c_char,
+                input.len(),
+                format,
+            )
+        };
+        assert!(!mq_batch_error(null_engine).is_null());
+        mq_free_batch_result(null_engine);
+
+        let null_compiled = unsafe {
+            mq_eval_batch(
+                engine,
+                ptr::null(),
+                input.as_ptr() as *const c_char,
+                input.len(),
+                format,
+            )
+        };
+        assert!(!mq_batch_error(null_compiled).is_null());
+        mq_free_batch_result(null_compiled);
+
+        // Accessors tolerate a null result handle.
+        assert_eq!(mq_batch_len(ptr::null()), 0);
+        assert!(mq_batch_error(ptr::null()).is_null());
+        assert!(!unsafe { mq_batch_next(ptr::null_mut(), ptr::null_mut(), ptr::null_mut()) });
+        mq_free_batch_result(ptr::null_mut());
+
+        mq_compiled_destroy(compiled);
+        unsafe {
+            mq_free_string(code as *mut c_char);
+            mq_free_string(format as *mut c_char);
+        }
+        mq_destroy(engine);
+    }
 }
@@ -481,6 +481,87 @@ void test_clear_http_cache_does_not_crash() {
     printf("PASS\n");
 }
 
+void test_compile_and_eval_batch() {
+    printf("Test 24: mq_compile + mq_eval_batch... ");
+
+    mq_context_t *engine = mq_create();
+
+    char *compile_error = NULL;
+    mq_compiled_query_t *compiled = mq_compile(engine, "upcase()", &compile_error);
+    assert_null(compile_error, "Should not have compile error");
+    assert_not_null(compiled, "Compiled query should not be null");
+
+    // The input is pointer + length: a slice of a larger buffer works without
+    // a null terminator or a copy.
+    const char *buffer = "hello!!trailing garbage";
+    size_t input_len = 5;
+
+    // The same compiled query is reused across documents.
+    for (int i = 0; i < 2; i++) {
+        mq_batch_result_t *result = mq_eval_batch(engine, compiled, buffer, input_len, "text");
+        assert_not_null(result, "Batch result should not be null");
+        assert_null((void *)mq_batch_error(result), "Should not have eval error");
+        assert_equals(mq_batch_len(result), 1, "Should have 1 value");
+
+        const char *value = NULL;
+        size_t value_len = 0;
+        assert(mq_batch_next(result, &value, &value_len));
+        assert_equals(value_len, 5, "Value length mismatch");
+        assert(strncmp(value, "HELLO", value_len) == 0);
+
+        // Exhausted: further calls return false.
+        assert(!mq_batch_next(result, &value, &value_len));
+
+        mq_free_batch_result(result);
+    }
+
+    mq_compiled_destroy(compiled);
+    mq_destroy(engine);
+
+    printf("PASS\n");
+}
+
+void test_compile_error_and_batch_error() {
+    printf("Test 25: mq_compile / mq_eval_batch error reporting... ");
+
+    mq_context_t *engine = mq_create();
+
+    // Compile errors are reported through the out-parameter.
+    char *compile_error = NULL;
+    mq_compiled_query_t *bad = mq_compile(engine, "def broken(:", &compile_error);
+    assert_null(bad, "Compiled query should be null on error");
+    assert_not_null(compile_error, "Should have compile error");
+    mq_free_string(compile_error);
+
+    // Evaluation errors are reported through mq_batch_error.
+    char *error_msg = NULL;
+    mq_compiled_query_t *compiled = mq_compile(engine, ".h", &error_msg);
+    assert_not_null(compiled, "Compiled query should not be null");
+
+    mq_batch_result_t *result = mq_eval_batch(engine, compiled, "test", 4, "json");
+    assert_not_null(result, "Batch result should not be null");
+    assert_not_null((void *)mq_batch_error(result), "Should have error for unsupported format");
+    assert_equals(mq_batch_len(result), 0, "Failed batch should have no values");
+
+    const char *value = NULL;
+    size_t value_len = 0;
+    assert(!mq_batch_next(result, &value, &value_len));
+
+    mq_free_batch_result(result);
+    mq_compiled_destroy(compiled);
+
+    // Null handles should not crash.
+    mq_compiled_destroy(NULL);
+    mq_free_batch_result(NULL);
+    assert_equals(mq_batch_len(NULL), 0, "Null result should have length 0");
+    assert_null((void *)mq_batch_error(NULL), "Null result should have no error");
+    assert(!mq_batch_next(NULL, &value, &value_len));
+
+    mq_destroy(engine);
+
+    printf("PASS\n");
+}
+
 int main() {
     printf("Running mq-ffi C tests...\n\n");
 
@@ -507,6 +588,8 @@ int main() {
     test_set_search_paths_edge_cases();
     test_http_allowed_domains_does_not_crash();
     test_clear_http_cache_does_not_crash();
+    test_compile_and_eval_batch();
+    test_compile_error_and_batch_error();
 
     printf("\nAll tests passed!\n");
     return 0;
@@ -2,7 +2,11 @@ use clap::Parser;
 use glob::glob;
 use miette::IntoDiagnostic;
 use miette::miette;
-use std::{fs, path::PathBuf};
+use std::collections::HashMap;
+use std::{
+    fs,
+    path::{Path, PathBuf},
+};
 
 #[derive(Parser, Debug)]
 #[command(name = "mq-fmt")]
@@ -43,6 +47,10 @@ struct Cli {
     #[arg(long, default_value_t = false)]
     sort_fields: bool,
 
+    /// Format every file even if the cache says it is unchanged since the last run
+    #[arg(long, default_value_t = false)]
+    no_cache: bool,
+
     /// Path to the mq file(s) to format
     files: Option<Vec<PathBuf>>,
 }
@@ -50,13 +58,13 @@ struct Cli {
 fn main() -> miette::Result<()> {
     let cli = Cli::parse();
 
-    let mut formatter = mq_formatter::Formatter::new(Some(mq_formatter::FormatterConfig {
+    let config = mq_formatter::FormatterConfig {
         indent_width: cli.indent_width,
         sort_imports: cli.sort_imports,
         sort_fields: cli.sort_fields,
         sort_functions: cli.sort_functions,
         max_width: cli.max_width,
-    }));
+    };
 
     let files = match cli.files {
         Some(f) => f,
@@ -70,18 +78,202 @@ fn main() -> miette::Result<()> {
         if !file.exists() {
             return Err(miette!("File not found: {}", file.display()));
         }
+    }
+
+    let mut cache = if cli.no_cache {
+        FmtCache::disabled()
+    } else {
+        FmtCache::load(&config)
+    };
+
+    // Files whose (mtime, size) still match the cache were left formatted by a
+    // previous run with the same config, so they are skipped entirely.
+    let pending: Vec<&PathBuf> = files.iter().filter(|file| !cache.is_fresh(file)).collect();
+
+    let results = format_files_parallel(&pending, &config, cli.check);
+
+    let mut first_error = None;
+    for (file, result) in pending.iter().zip(results) {
+        match result {
+            Ok(()) => cache.record(file),
+            Err(e) if first_error.is_none() => first_error = Some(e),
+            Err(_) => {}
+        }
+    }
+
+    // Formatted files stay cached even when another file failed, so the next
+    // run only revisits the failures.
+    cache.save();
 
+    match first_error {
+        Some(e) => Err(e),
+        None => Ok(()),
+    }
+}
+
+/// Formats `files` across the available cores with one `Formatter` per worker,
+/// returning one result per file in input order.
+///
+/// In `check` mode nothing is written and an unformatted file is an error;
+/// otherwise changed files are rewritten in place from the worker thread.
+fn format_files_parallel(
+    files: &[&PathBuf],
+    config: &mq_formatter::FormatterConfig,
+    check: bool,
+) -> Vec<miette::Result<()>> {
+    let format_file = |formatter: &mut mq_formatter::Formatter, file: &Path| -> miette::Result<()> {
         let content = fs::read_to_string(file).into_diagnostic()?;
         let formatted = formatter
             .format(&content)
             .map_err(|e| miette!("{}: {e}", file.display()))?;
 
-        if cli.check && formatted != content {
+        if check && formatted != content {
             return Err(miette!("The input is not formatted: {}", file.display()));
         } else if formatted != content {
             fs::write(file, formatted).into_diagnostic()?;
         }
+
+        Ok(())
+    };
+
+    let threads = std::thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1)
+        .min(files.len());
+    if threads <= 1 {
+        let mut formatter = mq_formatter::Formatter::new(Some(config.clone()));
+        return files.iter().map(|file| format_file(&mut formatter, file)).collect();
     }
 
-    Ok(())
+    let chunk_size = files.len().div_ceil(threads);
+    std::thread::scope(|scope| {
+        let handles: Vec<_> = files
+            .chunks(chunk_size)
+            .map(|chunk| {
+                scope.spawn(move || {
+                    let mut formatter = mq_formatter::Formatter::new(Some(config.clone()));
+                    chunk
+                        .iter()
+                        .map(|file| format_file(&mut formatter, file))
+                        .collect::<Vec<_>>()
+                })
+            })
+            .collect();
+
+        // Joining in spawn order keeps results in input file order.
+        handles
+            .into_iter()
+            .flat_map(|handle| handle.join().expect("format thread panicked"))
+            .collect()
+    })
+}
+
+/// Best-effort cache of files known to be formatted, keyed by path and
+/// formatting config and validated by (mtime, size), so a no-op repo-wide
+/// format skips unchanged files entirely.
+///
+/// Stored as one tab-separated line per entry under `{system_cache_dir}/mq/`,
+/// alongside the compile and HTTP module caches. Unreadable or corrupt cache
+/// files are treated as empty and a failed save never fails the format run.
+struct FmtCache {
+    path: Option<PathBuf>,
+    /// Config-fingerprint-and-path key -> (mtime in nanos since epoch, file size).
+    entries: HashMap<String, (u128, u64)>,
+    /// Fingerprint of the formatting config, mixed into every key so changing
+    /// options invalidates prior entries.
+    config_fingerprint: String,
+}
+
+impl FmtCache {
+    /// A cache that never hits and never saves (`--no-cache`).
+    fn disabled() -> Self {
+        Self {
+            path: None,
+            entries: HashMap::new(),
+            config_fingerprint: String::new(),
+        }
+    }
+
+    /// Loads the cache for `config`, or an empty one if missing or unreadable.
+    fn load(config: &mq_formatter::FormatterConfig) -> Self {
+        let path = dirs::cache_dir().unwrap_or_default().join("mq").join("fmt-cache");
+        let config_fingerprint = format!("{}|{:?}", env!("CARGO_PKG_VERSION"), config);
+
+        // The key comes last on each line since paths may contain any character
+        // except the newline.
+        let entries = fs::read_to_string(&path)
+            .map(|content| {
+                content
+                    .lines()
+                    .filter_map(|line| {
+                        let (mtime, rest) = line.split_once('\t')?;
+                        let (size, key) = rest.split_once('\t')?;
+                        Some((key.to_string(), (mtime.parse().ok()?, size.parse().ok()?)))
+                    })
+                    .collect()
+            })
+            .unwrap_or_default();
+
+        Self {
+            path: Some(path),
+            entries,
+            config_fingerprint,
+        }
+    }
+
+    /// Returns `true` when `file`'s (mtime, size) still match its cache entry.
+    fn is_fresh(&self, file: &Path) -> bool {
+        self.path.is_some()
+            && match (self.entries.get(&self.key(file)), stat(file)) {
+                (Some(cached), Some(current)) => *cached == current,
+                _ => false,
+            }
+    }
+
+    /// Records `file` as formatted at its current (mtime, size).
+    fn record(&mut self, file: &Path) {
+        if self.path.is_none() {
+            return;
+        }
+        if let Some(current) = stat(file) {
+            self.entries.insert(self.key(file), current);
+        }
+    }
+
+    /// Writes the cache atomically (temp file, then rename). Errors are ignored.
+    fn save(&self) {
+        let Some(path) = &self.path else { return };
+        let Some(dir) = path.parent() else { return };
+        if fs::create_dir_all(dir).is_err() {
+            return;
+        }
+
+        let content: String = self
+            .entries
+            .iter()
+            .map(|(key, (mtime, size))| format!("{mtime}\t{size}\t{key}\n"))
+            .collect();
+
+        let tmp_path = path.with_extension("tmp");
+        if fs::write(&tmp_path, content).is_ok() {
+            let _ = fs::rename(&tmp_path, path);
+        }
+    }
+
+    fn key(&self, file: &Path) -> String {
+        let canonical = file.canonicalize().unwrap_or_else(|_| file.to_path_buf());
+        format!("{}|{}", self.config_fingerprint, canonical.display())
+    }
+}
+
+/// Returns `file`'s (mtime in nanos since epoch, size), or `None` on any error.
+fn stat(file: &Path) -> Option<(u128, u64)> {
+    let meta = fs::metadata(file).ok()?;
+    let mtime = meta
+        .modified()
+        .ok()?
+        .duration_since(std::time::UNIX_EPOCH)
+        .ok()?
+        .as_nanos();
+    Some((mtime, meta.len()))
 }
@@ -1,4 +1,4 @@
-use rustc_hash::FxHashMap;
+use rustc_hash::{FxHashMap, FxHashSet};
 use slotmap::SlotMap;
 use smol_str::SmolStr;
 use url::Url;
@@ -34,6 +34,13 @@ pub struct Hir {
     /// Populated by `insert_symbol` and pruned by `add_nodes` cleanup.
     /// Allows name-based lookups in `resolve.rs` to skip an O(n) full-symbol scan.
     pub(crate) name_index: FxHashMap<SmolStr, Vec<SymbolId>>,
+    /// File-granularity dependency tracking for incremental re-resolution:
+    /// definition source → sources whose cached reference resolutions point
+    /// into it. Re-lowering a source only re-resolves it and its dependents.
+    pub(crate) resolution_deps: FxHashMap<SourceId, FxHashSet<SourceId>>,
+    /// Sources that still contain unresolved references. They are re-resolved
+    /// whenever any source changes, since new definitions may resolve them.
+    pub(crate) unresolved_sources: FxHashSet<SourceId>,
 }
 
 impl Default for Hir {
@@ -72,6 +79,8 @@ impl Hir {
             source_symbols: FxHashMap::default(),
             symbol_insertion_counter: 0,
             name_index: FxHashMap::default(),
+            resolution_deps: FxHashMap::default(),
+            unresolved_sources: FxHashSet::default(),
         }
     }
 
@@ -187,6 +196,7 @@ impl Hir {
     }
 
     pub fn add_nodes(&mut self, url: Url, nodes: &[mq_lang::Shared<mq_lang::CstNode>]) -> (SourceId, ScopeId) {
+        let builtin_already_loaded = self.builtin.loaded || self.builtin.disabled;
         self.add_builtin();
 
         let source_id = self
@@ -227,7 +237,28 @@ impl Hir {
         nodes.iter().for_each(|node| {
             self.add_expr(node, source_id, scope_id, None);
         });
-        self.resolve();
+
+        if !builtin_already_loaded {
+            // First lowering also pulled in the builtin module; resolve
+            // everything once so builtin-internal references are cached too.
+            self.resolve();
+        } else {
+            // Incremental re-resolution at file granularity: re-resolve this
+            // source, the sources whose cached resolutions point into it, and
+            // sources with unresolved references (the new definitions may make
+            // them resolvable). All other cached resolutions stay valid.
+            let mut to_resolve: Vec<SourceId> = vec![source_id];
+            if let Some(dependents) = self.resolution_deps.remove(&source_id) {
+                to_resolve.extend(dependents);
+            }
+            to_resolve.extend(self.unresolved_sources.iter().copied());
+            to_resolve.sort_unstable();
+            to_resolve.dedup();
+
+            for dependent_source_id in to_resolve {
+                self.resolve_source(dependent_source_id);
+            }
+        }
 
         (source_id, scope_id)
     }
@@ -507,6 +538,41 @@ end"#;
         assert!(hir.errors().is_empty());
     }
 
+    #[test]
+    fn test_incremental_reresolve_on_source_update() {
+        let mut hir = Hir::default();
+        hir.builtin.disabled = true;
+        let url = Url::parse("file:///incremental.mq").unwrap();
+
+        let find_call = |hir: &Hir, name: &str| {
+            hir.symbols()
+                .find(|(_, symbol)| symbol.value.as_deref() == Some(name) && matches!(symbol.kind, SymbolKind::Call))
+                .map(|(symbol_id, _)| symbol_id)
+                .expect("call symbol should be present")
+        };
+
+        hir.add_code(Some(url.clone()), "def foo(): 1; | foo()");
+        let call_id = find_call(&hir, "foo");
+        assert!(hir.resolve_reference_symbol(call_id).is_some());
+
+        // Re-lowering the same source with the definition renamed must drop
+        // the stale cached resolution.
+        hir.add_code(Some(url.clone()), "def bar(): 1; | foo()");
+        let call_id = find_call(&hir, "foo");
+        assert!(hir.resolve_reference_symbol(call_id).is_none());
+
+        // Restoring the definition re-resolves the previously unresolved call.
+        hir.add_code(Some(url.clone()), "def foo(): 1; | foo()");
+        let call_id = find_call(&hir, "foo");
+        let resolved = hir
+            .resolve_reference_symbol(call_id)
+            .expect("call should resolve again");
+        assert!(matches!(
+            hir.symbol(resolved).expect("resolved symbol should exist").kind,
+            SymbolKind::Function(_)
+        ));
+    }
+
     #[test]
     fn test_unused_functions() {
         let mut hir = Hir::default();
@@ -2,31 +2,102 @@ use smol_str::SmolStr;
 
 use crate::{Hir, ScopeId, SourceId, Symbol, SymbolId, SymbolKind};
 
+/// The fields of a reference-like symbol needed to resolve it:
+/// `(ref symbol, its scope, referenced name, source it belongs to)`.
+type RefSymbolFields = (SymbolId, ScopeId, Option<SmolStr>, Option<SourceId>);
+
 impl Hir {
+    /// Resolves every reference-like symbol in the HIR from scratch.
+    ///
+    /// Used for the initial build; subsequent per-source updates go through
+    /// [`Hir::resolve_source`], which only re-resolves the affected files.
     pub fn resolve(&mut self) {
+        self.unresolved_sources.clear();
+
         // Extract only the fields we need instead of cloning the entire Symbol
         let symbols_to_resolve: Vec<_> = self
             .symbols
             .iter()
-            .filter_map(|(ref_symbol_id, ref_symbol)| match &ref_symbol.kind {
-                SymbolKind::Ref
-                | SymbolKind::Call
-                | SymbolKind::CallDynamic
-                | SymbolKind::Argument
-                | SymbolKind::Macro(_)
-                | SymbolKind::QualifiedAccess => Some((ref_symbol_id, ref_symbol.scope, ref_symbol.value.clone())),
-                _ => None,
-            })
+            .filter_map(|(ref_symbol_id, ref_symbol)| Self::ref_symbol_fields(ref_symbol_id, ref_symbol))
+            .collect();
+
+        self.resolve_symbols(symbols_to_resolve);
+    }
+
+    /// Re-resolves only the reference-like symbols belonging to `source_id`,
+    /// keeping cached resolutions for every other source.
+    ///
+    /// Scans the full symbol table rather than `source_symbols`: several
+    /// lowering sites insert reference symbols without source tracking, so
+    /// `symbols_for_source` would miss them. The scan is cheap; the savings
+    /// come from skipping the name resolution of every other source's refs.
+    pub(crate) fn resolve_source(&mut self, source_id: SourceId) {
+        self.unresolved_sources.remove(&source_id);
+
+        let symbols_to_resolve: Vec<_> = self
+            .symbols
+            .iter()
+            .filter(|(_, ref_symbol)| ref_symbol.source.source_id == Some(source_id))
+            .filter_map(|(ref_symbol_id, ref_symbol)| Self::ref_symbol_fields(ref_symbol_id, ref_symbol))
             .collect();
 
-        for (ref_symbol_id, scope, ref_name) in symbols_to_resolve {
-            if let Some(ref_name) = ref_name {
-                let resolved = self
-                    .resolve_ref_symbol_of_scope(scope, &ref_name, ref_symbol_id)
-                    .or_else(|| self.resolve_ref_symbol_of_source(self.include_source_ids(), &ref_name));
+        self.resolve_symbols(symbols_to_resolve);
+    }
 
-                if let Some((symbol_id, _)) = resolved {
+    #[inline(always)]
+    fn ref_symbol_fields(ref_symbol_id: SymbolId, ref_symbol: &Symbol) -> Option<RefSymbolFields> {
+        match &ref_symbol.kind {
+            SymbolKind::Ref
+            | SymbolKind::Call
+            | SymbolKind::CallDynamic
+            | SymbolKind::Argument
+            | SymbolKind::Macro(_)
+            | SymbolKind::QualifiedAccess => Some((
+                ref_symbol_id,
+                ref_symbol.scope,
+                ref_symbol.value.clone(),
+                ref_symbol.source.source_id,
+            )),
+            _ => None,
+        }
+    }
+
+    /// Resolves the given reference symbols and records file-granularity
+    /// dependencies: when a reference in source `R` resolves to a definition
+    /// in source `D`, `R` is remembered as a dependent of `D` so that
+    /// re-lowering `D` re-resolves `R`. Sources left with unresolved
+    /// references are tracked so later edits anywhere can resolve them.
+    fn resolve_symbols(&mut self, symbols_to_resolve: Vec<RefSymbolFields>) {
+        for (ref_symbol_id, scope, ref_name, ref_source_id) in symbols_to_resolve {
+            let Some(ref_name) = ref_name else {
+                continue;
+            };
+
+            let resolved = self
+                .resolve_ref_symbol_of_scope(scope, &ref_name, ref_symbol_id)
+                .or_else(|| self.resolve_ref_symbol_of_source(self.include_source_ids(), &ref_name));
+
+            match resolved {
+                Some((symbol_id, symbol)) => {
                     self.references.insert(ref_symbol_id, symbol_id);
+
+                    if let (Some(ref_source_id), Some(def_source_id)) = (ref_source_id, symbol.source.source_id)
+                        && ref_source_id != def_source_id
+                    {
+                        self.resolution_deps
+                            .entry(def_source_id)
+                            .or_default()
+                            .insert(ref_source_id);
+                    }
+                }
+                None => {
+                    // Drop any resolution cached from a previous lowering of
+                    // this source; the target may no longer exist.
+                    self.references.remove(&ref_symbol_id);
+
+                    if let Some(ref_source_id) = ref_source_id {
+                        self.unresolved_sources.insert(ref_source_id);
+                    }
                 }
             }
         }
@@ -20,6 +20,23 @@ fn eval_fibonacci() -> mq_lang::RuntimeValues {
         .unwrap()
 }
 
+#[divan::bench()]
+fn eval_fibonacci_bytecode() -> mq_lang::RuntimeValues {
+    let mut engine = mq_lang::DefaultEngine::default();
+    engine.set_eval_backend(mq_lang::EvalBackend::Bytecode);
+    engine
+        .eval(
+            "
+     def fibonacci(x):
+      if (x < 2):
+        x
+      else:
+        fibonacci(x - 1) + fibonacci(x - 2); | fibonacci(20)",
+            vec![mq_lang::RuntimeValue::Number(20.into())].into_iter(),
+        )
+        .unwrap()
+}
+
 #[divan::bench()]
 fn eval_while_speed_test() -> mq_lang::RuntimeValues {
     let mut engine = mq_lang::DefaultEngine::default();
@@ -31,6 +48,18 @@ fn eval_while_speed_test() -> mq_lang::RuntimeValues {
         .unwrap()
 }
 
+#[divan::bench()]
+fn eval_while_speed_test_bytecode() -> mq_lang::RuntimeValues {
+    let mut engine = mq_lang::DefaultEngine::default();
+    engine.set_eval_backend(mq_lang::EvalBackend::Bytecode);
+    engine
+        .eval(
+            "var i = 10000 | while(i > 0): i -= 1; | i",
+            vec![mq_lang::RuntimeValue::Number(1.into())].into_iter(),
+        )
+        .unwrap()
+}
+
 #[divan::bench(name = "eval_select_h")]
 fn eval_select_h() -> mq_lang::RuntimeValues {
     let markdown: mq_markdown::Markdown =
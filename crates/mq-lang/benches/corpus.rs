@@ -0,0 +1,80 @@
+//! Corpus-scale benchmarks for evaluation over realistic workloads.
+//!
+//! `benchmark.rs` measures micro-patterns (fibonacci, tiny documents); this
+//! suite runs selector scans over documents with ~100k nodes and compiled
+//! queries over many small files, the shapes `mq` actually sees in batch CLI
+//! runs. Throughput counters report nodes/s and files/s alongside wall time,
+//! and the divan `AllocProfiler` adds allocation counts and peak heap bytes
+//! (a proxy for peak RSS). Corpora are generated deterministically so runs
+//! are comparable across machines.
+
+use divan::counter::ItemsCount;
+
+#[global_allocator]
+static ALLOC: divan::AllocProfiler = divan::AllocProfiler::system();
+
+fn main() {
+    divan::main();
+}
+
+/// Builds an input of roughly `sections * 8` nodes mixing headings,
+/// paragraphs, lists and code blocks.
+fn corpus_nodes(sections: usize) -> Vec<mq_lang::RuntimeValue> {
+    let doc: String = (0..sections)
+        .map(|i| {
+            format!(
+                "## Section {i}\n\nParagraph {i} with [link](https://example.com/{i}).\n\n\
+                 - item a{i}\n- item b{i}\n\n```rust\nlet v = {i};\n```\n\n> quote {i}\n\n"
+            )
+        })
+        .collect();
+    mq_lang::parse_markdown_input(&doc).unwrap()
+}
+
+/// Selector scan over a ~100k-node document, in nodes/s.
+#[divan::bench(name = "corpus/selector_scan_100k")]
+fn corpus_selector_scan(bencher: divan::Bencher) {
+    let nodes = corpus_nodes(12_500);
+    let mut engine = mq_lang::DefaultEngine::default();
+    let program = engine.compile(".h2").unwrap();
+    bencher.counter(ItemsCount::new(nodes.len())).bench_local(|| {
+        engine
+            .eval_compiled(divan::black_box(&program), nodes.clone().into_iter())
+            .unwrap()
+    });
+}
+
+/// Text filter over a ~100k-node document, in nodes/s.
+#[divan::bench(name = "corpus/select_contains_100k")]
+fn corpus_select_contains(bencher: divan::Bencher) {
+    let nodes = corpus_nodes(12_500);
+    let mut engine = mq_lang::DefaultEngine::default();
+    engine.load_builtin_module();
+    let program = engine.compile(r#"select(contains("item a"))"#).unwrap();
+    bencher.counter(ItemsCount::new(nodes.len())).bench_local(|| {
+        engine
+            .eval_compiled(divan::black_box(&program), nodes.clone().into_iter())
+            .unwrap()
+    });
+}
+
+/// One compiled query evaluated over many small files, in files/s — the
+/// shape of a many-file `mq` CLI run (the CLI compiles once and reuses the
+/// program per file, so this is the engine-level equivalent).
+#[divan::bench(name = "corpus/many_files_batch")]
+fn corpus_many_files(bencher: divan::Bencher) {
+    let files: Vec<Vec<mq_lang::RuntimeValue>> = (0..500).map(|_| corpus_nodes(4)).collect();
+    let mut engine = mq_lang::DefaultEngine::default();
+    engine.load_builtin_module();
+    let program = engine.compile(r#"select(contains("item"))"#).unwrap();
+    bencher.counter(ItemsCount::new(files.len())).bench_local(|| {
+        files
+            .iter()
+            .map(|nodes| {
+                engine
+                    .eval_compiled(divan::black_box(&program), nodes.clone().into_iter())
+                    .unwrap()
+            })
+            .count()
+    });
+}
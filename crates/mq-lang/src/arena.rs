@@ -15,6 +15,14 @@ pub struct ArenaId<T> {
 
 impl<T> Copy for ArenaId<T> {}
 
+// Manual impl so `ArenaId<T>: Hash` does not require `T: Hash`; only the raw
+// index participates, matching the manual `Copy`/`Clone` impls above.
+impl<T> std::hash::Hash for ArenaId<T> {
+    fn hash<H: std::hash::Hasher>(&self, state: &mut H) {
+        self.id.hash(state);
+    }
+}
+
 impl<T> Clone for ArenaId<T> {
     #[inline(always)]
     fn clone(&self) -> ArenaId<T> {
@@ -58,6 +58,10 @@ pub mod builtins {
 
     pub const BREAKPOINT: &str = "breakpoint";
     pub const COALESCE: &str = "coalesce";
+
+    pub const PMAP: &str = "pmap";
+    pub const PFILTER: &str = "pfilter";
+    pub const PGROUP_BY: &str = "pgroup_by";
 }
 
 pub mod identifiers {
@@ -20,15 +20,15 @@ type IfExpr = (Option<Shared<Node>>, Shared<Node>);
 static GET_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::from(constants::builtins::GET));
 
 pub struct Parser<'a, 'alloc> {
-    tokens: Peekable<core::slice::Iter<'a, Shared<Token>>>,
-    token_arena: &'alloc mut Arena<Shared<Token>>,
+    tokens: Peekable<core::slice::Iter<'a, Token>>,
+    token_arena: &'alloc mut Arena<Token>,
     module_id: ModuleId,
 }
 
 impl<'a, 'alloc> Parser<'a, 'alloc> {
     pub fn new(
-        tokens: core::slice::Iter<'a, Shared<Token>>,
-        token_arena: &'alloc mut Arena<Shared<Token>>,
+        tokens: core::slice::Iter<'a, Token>,
+        token_arena: &'alloc mut Arena<Token>,
         module_id: ModuleId,
     ) -> Self {
         Self {
@@ -49,10 +49,10 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         match self.tokens.peek() {
             Some(token) => match &token.kind {
                 TokenKind::Pipe | TokenKind::SemiColon => {
-                    return Err(SyntaxError::UnexpectedToken((***token).clone()));
+                    return Err(SyntaxError::UnexpectedToken((**token).clone()));
                 }
                 TokenKind::End => {
-                    return Err(SyntaxError::UnmatchedEnd((***token).clone()));
+                    return Err(SyntaxError::UnmatchedEnd((**token).clone()));
                 }
                 _ => {}
             },
@@ -71,9 +71,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         match self.tokens.peek() {
                             Some(next_token) if !matches!(next_token.kind, TokenKind::Eof) => {
                                 if matches!(token.kind, TokenKind::End) {
-                                    return Err(SyntaxError::UnmatchedEnd((**token).clone()));
+                                    return Err(SyntaxError::UnmatchedEnd((*token).clone()));
                                 } else {
-                                    return Err(SyntaxError::UnexpectedToken((***next_token).clone()));
+                                    return Err(SyntaxError::UnexpectedToken((**next_token).clone()));
                                 }
                             }
                             _ => break,
@@ -87,7 +87,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     asts.push(ast);
                 }
                 TokenKind::Nodes => {
-                    return Err(SyntaxError::UnexpectedToken((**token).clone()));
+                    return Err(SyntaxError::UnexpectedToken((*token).clone()));
                 }
                 TokenKind::NewLine | TokenKind::Tab(_) | TokenKind::Whitespace(_) => {
                     unreachable!("parse_program should have filtered out whitespace tokens")
@@ -107,7 +107,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     }
 
     #[inline(always)]
-    fn parse_expr(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_expr(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         self.parse_equality_expr(token)
     }
 
@@ -167,13 +167,13 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         lhs: &Shared<Node>,
         rhs: Shared<Node>,
         operator_token_id: TokenId,
-        operator_token: &Shared<Token>,
+        operator_token: &Token,
         function_name: &'static str,
     ) -> Result<Shared<Node>, SyntaxError> {
         let compound_rhs = Shared::new(Node {
             token_id: operator_token_id,
             expr: Shared::new(Expr::Call(
-                IdentWithToken::new_with_token(function_name, Some(Shared::clone(operator_token))),
+                IdentWithToken::new_with_token(function_name, Some(operator_token.clone())),
                 smallvec![Shared::clone(lhs), rhs],
             )),
         });
@@ -189,7 +189,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         lhs: &Shared<Node>,
         rhs: Shared<Node>,
         operator_token_id: TokenId,
-        operator_token: &Shared<Token>,
+        operator_token: &Token,
     ) -> Result<Shared<Node>, SyntaxError> {
         match &*lhs.expr {
             Expr::Ident(ident) => Ok(Shared::new(Node {
@@ -204,21 +204,18 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         Shared::new(Node {
                             token_id: operator_token_id,
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(
-                                    constants::builtins::SET,
-                                    Some(Shared::clone(operator_token)),
-                                ),
+                                IdentWithToken::new_with_token(constants::builtins::SET, Some(operator_token.clone())),
                                 smallvec![Shared::clone(&args[0]), Shared::clone(&args[1]), rhs,],
                             )),
                         }),
                     )),
                 })),
                 _ => Err(SyntaxError::InvalidAssignmentTarget(
-                    (*self.token_arena[args[0].token_id]).clone(),
+                    self.token_arena[args[0].token_id].clone(),
                 )),
             },
             _ => Err(SyntaxError::InvalidAssignmentTarget(
-                (*self.token_arena[lhs.token_id]).clone(),
+                self.token_arena[lhs.token_id].clone(),
             )),
         }
     }
@@ -237,14 +234,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             }
 
             let operator_token = parser.tokens.next().unwrap();
-            let operator_token_id = parser.token_arena.alloc(Shared::clone(operator_token));
+            let operator_token_id = parser.token_arena.alloc(operator_token.clone());
 
             let rhs_token = match parser.tokens.next() {
                 Some(t) if t.kind == TokenKind::Eof => {
-                    return Err(SyntaxError::UnexpectedEOFAfterToken((**operator_token).clone()));
+                    return Err(SyntaxError::UnexpectedEOFAfterToken((*operator_token).clone()));
                 }
                 Some(t) => t,
-                None => return Err(SyntaxError::UnexpectedEOFAfterToken((**operator_token).clone())),
+                None => return Err(SyntaxError::UnexpectedEOFAfterToken((*operator_token).clone())),
             };
             let mut rhs = parser.parse_primary_expr(rhs_token)?;
 
@@ -334,16 +331,13 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     let floor_div_rhs = Shared::new(Node {
                         token_id: operator_token_id,
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(
-                                constants::builtins::FLOOR,
-                                Some(Shared::clone(operator_token)),
-                            ),
+                            IdentWithToken::new_with_token(constants::builtins::FLOOR, Some(operator_token.clone())),
                             smallvec![Shared::new(Node {
                                 token_id: operator_token_id,
                                 expr: Shared::new(Expr::Call(
                                     IdentWithToken::new_with_token(
                                         constants::builtins::DIV,
-                                        Some(Shared::clone(operator_token)),
+                                        Some(operator_token.clone()),
                                     ),
                                     smallvec![Shared::clone(&lhs), rhs],
                                 )),
@@ -357,7 +351,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     expr: Shared::new(Expr::Call(
                         IdentWithToken::new_with_token(
                             Self::binary_op_function_name(kind),
-                            Some(Shared::clone(operator_token)),
+                            Some(operator_token.clone()),
                         ),
                         smallvec![lhs, rhs],
                     )),
@@ -368,7 +362,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         Ok(lhs)
     }
 
-    fn parse_equality_expr(&mut self, initial_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_equality_expr(&mut self, initial_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         let lhs = self.parse_primary_expr(initial_token)?;
         let lhs = Self::parse_binary_op(self, 0, lhs)?;
 
@@ -383,7 +377,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
     fn parse_as_binding(&mut self, expr: Shared<Node>) -> Result<Shared<Node>, SyntaxError> {
         let as_token = self.tokens.next().unwrap();
-        let as_token_id = self.token_arena.alloc(Shared::clone(as_token));
+        let as_token_id = self.token_arena.alloc(as_token.clone());
 
         let name_token = match self.tokens.next() {
             Some(token) => token,
@@ -392,17 +386,17 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
         match &name_token.kind {
             TokenKind::Ident(name) => {
-                let ident = IdentWithToken::new_with_token(name, Some(Shared::clone(name_token)));
+                let ident = IdentWithToken::new_with_token(name, Some(name_token.clone()));
                 Ok(Shared::new(Node {
                     token_id: as_token_id,
                     expr: Shared::new(Expr::As(ident, expr)),
                 }))
             }
-            _ => Err(SyntaxError::UnexpectedToken((**name_token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*name_token).clone())),
         }
     }
 
-    fn parse_primary_expr(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_primary_expr(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match &token.kind {
             TokenKind::Selector(_) | TokenKind::DoubleDot => self.parse_selector(token),
             TokenKind::Let => self.parse_let(token),
@@ -440,11 +434,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             TokenKind::None => self.parse_literal(token),
             TokenKind::Colon => self.parse_symbol(token),
             TokenKind::Eof => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
-            _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*token).clone())),
         }
     }
 
-    fn parse_module(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_module(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match &token.kind {
             TokenKind::Module => match self.tokens.peek() {
                 Some(_) => {
@@ -462,34 +456,34 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         match &*node.expr {
                             Expr::Let(_, _) | Expr::Def(_, _, _) | Expr::Module(_, _) | Expr::Import(_, _) => {}
                             _ => {
-                                return Err(SyntaxError::UnexpectedToken((*self.token_arena[node.token_id]).clone()));
+                                return Err(SyntaxError::UnexpectedToken(self.token_arena[node.token_id].clone()));
                             }
                         }
                     }
 
                     Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(token)),
+                        token_id: self.token_arena.alloc(token.clone()),
                         expr: Shared::new(Expr::Module(
                             IdentWithToken::new_with_token(
                                 match &ident_token.kind {
                                     TokenKind::Ident(name) => name,
                                     _ => {
-                                        return Err(SyntaxError::UnexpectedToken((**ident_token).clone()));
+                                        return Err(SyntaxError::UnexpectedToken((*ident_token).clone()));
                                     }
                                 },
-                                Some(Shared::clone(ident_token)),
+                                Some(ident_token.clone()),
                             ),
                             program.iter().map(Shared::clone).collect(),
                         )),
                     }))
                 }
-                None => Err(SyntaxError::UnexpectedToken((**token).clone())),
+                None => Err(SyntaxError::UnexpectedToken((*token).clone())),
             },
-            _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*token).clone())),
         }
     }
 
-    fn parse_symbol(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_symbol(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match &token.kind {
             TokenKind::Colon => {
                 let next_token = match self.tokens.next() {
@@ -498,23 +492,23 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 };
                 match &next_token.kind {
                     TokenKind::Ident(name) => Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(token)),
+                        token_id: self.token_arena.alloc(token.clone()),
                         expr: Shared::new(Expr::Literal(Literal::Symbol(Ident::new(name)))),
                     })),
                     TokenKind::StringLiteral(s) => Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(token)),
+                        token_id: self.token_arena.alloc(token.clone()),
                         expr: Shared::new(Expr::Literal(Literal::Symbol(Ident::new(s)))),
                     })),
-                    _ => Err(SyntaxError::UnexpectedToken((**next_token).clone())),
+                    _ => Err(SyntaxError::UnexpectedToken((*next_token).clone())),
                 }
             }
-            _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*token).clone())),
         }
     }
 
-    fn parse_paren(&mut self, lparen_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let opening = (**lparen_token).clone();
-        let token_id = self.token_arena.alloc(Shared::clone(lparen_token));
+    fn parse_paren(&mut self, lparen_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let opening = (*lparen_token).clone();
+        let token_id = self.token_arena.alloc(lparen_token.clone());
         let expr_token = match self.tokens.next() {
             Some(t) => t,
             None => {
@@ -534,12 +528,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         match self.tokens.next() {
             Some(t) if t.kind == TokenKind::RParen => {}
             Some(t) if t.kind == TokenKind::Eof => {
-                return Err(SyntaxError::ExpectedClosingParen(
-                    (**t).clone(),
-                    Some(Box::new(opening)),
-                ));
+                return Err(SyntaxError::ExpectedClosingParen((*t).clone(), Some(Box::new(opening))));
             }
-            Some(t) => return Err(SyntaxError::UnexpectedToken((**t).clone())),
+            Some(t) => return Err(SyntaxError::UnexpectedToken((*t).clone())),
             None => {
                 return Err(SyntaxError::ExpectedClosingParen(
                     Token {
@@ -561,15 +552,15 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         self.parse_postfix_ops(paren_node, lparen_token)
     }
 
-    fn parse_not(&mut self, not_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(not_token));
+    fn parse_not(&mut self, not_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(not_token.clone());
 
         let expr_token = match self.tokens.next() {
             Some(t) if t.kind == TokenKind::Eof => {
-                return Err(SyntaxError::UnexpectedEOFAfterToken((**not_token).clone()));
+                return Err(SyntaxError::UnexpectedEOFAfterToken((*not_token).clone()));
             }
             Some(t) => t,
-            None => return Err(SyntaxError::UnexpectedEOFAfterToken((**not_token).clone())),
+            None => return Err(SyntaxError::UnexpectedEOFAfterToken((*not_token).clone())),
         };
 
         if !matches!(
@@ -592,13 +583,13 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 | TokenKind::Not
                 | TokenKind::Ident(_)
         ) {
-            return Err(SyntaxError::UnexpectedToken((**expr_token).clone()));
+            return Err(SyntaxError::UnexpectedToken((*expr_token).clone()));
         }
 
         let expr_node = self.parse_primary_expr(expr_token)?;
 
         // Convert ! to not() function call
-        let not_ident = IdentWithToken::new_with_token(constants::builtins::NOT, Some(Shared::clone(not_token)));
+        let not_ident = IdentWithToken::new_with_token(constants::builtins::NOT, Some(not_token.clone()));
         let args = smallvec![expr_node];
 
         Ok(Shared::new(Node {
@@ -607,15 +598,15 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_negate(&mut self, minus_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(minus_token));
+    fn parse_negate(&mut self, minus_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(minus_token.clone());
 
         let expr_token = match self.tokens.next() {
             Some(t) if t.kind == TokenKind::Eof => {
-                return Err(SyntaxError::UnexpectedEOFAfterToken((**minus_token).clone()));
+                return Err(SyntaxError::UnexpectedEOFAfterToken((*minus_token).clone()));
             }
             Some(t) => t,
-            None => return Err(SyntaxError::UnexpectedEOFAfterToken((**minus_token).clone())),
+            None => return Err(SyntaxError::UnexpectedEOFAfterToken((*minus_token).clone())),
         };
 
         if !matches!(
@@ -632,12 +623,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 | TokenKind::Env(_)
                 | TokenKind::Ident(_)
         ) {
-            return Err(SyntaxError::UnexpectedToken((**expr_token).clone()));
+            return Err(SyntaxError::UnexpectedToken((*expr_token).clone()));
         }
 
         let expr_node = self.parse_primary_expr(expr_token)?;
-        let negate_ident =
-            IdentWithToken::new_with_token(constants::builtins::NEGATE, Some(Shared::clone(minus_token)));
+        let negate_ident = IdentWithToken::new_with_token(constants::builtins::NEGATE, Some(minus_token.clone()));
         let args = smallvec![expr_node];
 
         Ok(Shared::new(Node {
@@ -664,7 +654,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 Ok(true)
             }
             Some(token) => Err(SyntaxError::ExpectedClosingBrace(
-                (***token).clone(),
+                (**token).clone(),
                 Some(Box::new(opening.clone())),
             )),
             None => Err(SyntaxError::ExpectedClosingBrace(
@@ -678,9 +668,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }
     }
 
-    fn parse_dict(&mut self, lbrace_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let opening = (**lbrace_token).clone();
-        let token_id = self.token_arena.alloc(Shared::clone(lbrace_token));
+    fn parse_dict(&mut self, lbrace_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let opening = (*lbrace_token).clone();
+        let token_id = self.token_arena.alloc(lbrace_token.clone());
         let mut pairs = SmallVec::new();
 
         let eof_closing_err = |opening: &Token, module_id: ModuleId| {
@@ -702,7 +692,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 }
                 Some(token) if token.kind == TokenKind::Eof => {
                     return Err(SyntaxError::ExpectedClosingBrace(
-                        (***token).clone(),
+                        (**token).clone(),
                         Some(Box::new(opening.clone())),
                     ));
                 }
@@ -728,22 +718,22 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
             let key_node = match &key_token.kind {
                 TokenKind::Ident(name) => Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(key_token)),
+                    token_id: self.token_arena.alloc(key_token.clone()),
                     expr: Shared::new(Expr::Literal(Literal::Symbol(Ident::new(name)))),
                 }),
                 TokenKind::StringLiteral(s) => Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(key_token)),
+                    token_id: self.token_arena.alloc(key_token.clone()),
                     expr: Shared::new(Expr::Literal(Literal::String(s.clone()))),
                 }),
                 _ => {
-                    return Err(SyntaxError::UnexpectedToken((**key_token).clone()));
+                    return Err(SyntaxError::UnexpectedToken((*key_token).clone()));
                 }
             };
 
             // Expect Colon
             match self.tokens.next() {
                 Some(token) if token.kind == TokenKind::Colon => {}
-                Some(token) => return Err(SyntaxError::UnexpectedToken((**token).clone())),
+                Some(token) => return Err(SyntaxError::UnexpectedToken((*token).clone())),
                 None => return Err(eof_closing_err(&opening, self.module_id)),
             }
 
@@ -757,7 +747,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             pairs.push(Shared::new(Node {
                 token_id,
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::clone(key_token))),
+                    IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(key_token.clone())),
                     smallvec![key_node, value_node],
                 )),
             }));
@@ -770,22 +760,22 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         Ok(Shared::new(Node {
             token_id,
             expr: Shared::new(Expr::Call(
-                IdentWithToken::new_with_token(constants::builtins::DICT, Some(Shared::clone(lbrace_token))),
+                IdentWithToken::new_with_token(constants::builtins::DICT, Some(lbrace_token.clone())),
                 pairs,
             )),
         }))
     }
 
-    fn parse_env(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_env(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match &token.kind {
             TokenKind::Env(s) => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(token)),
+                token_id: self.token_arena.alloc(token.clone()),
                 expr: std::env::var(s)
-                    .map_err(|_| SyntaxError::EnvNotFound((**token).clone(), SmolStr::new(s)))
+                    .map_err(|_| SyntaxError::EnvNotFound((*token).clone(), SmolStr::new(s)))
                     .map(|s| Shared::new(Expr::Literal(Literal::String(s.to_owned()))))?,
             })),
             TokenKind::Eof => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
-            _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*token).clone())),
         }
     }
 
@@ -795,22 +785,22 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         token_id: TokenId,
     ) -> Result<Shared<Node>, SyntaxError> {
         let selector_token = match self.tokens.peek() {
-            Some(t) => Shared::clone(t),
+            Some(t) => (*t).clone(),
             None => return Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         };
 
         if let TokenKind::Selector(selector) = &selector_token.kind
             && selector.len() > 1
         {
-            if !Selector::try_from(&*selector_token)
+            if !Selector::try_from(&selector_token)
                 .map_err(SyntaxError::UnknownSelector)?
                 .is_attribute_selector()
             {
-                return Err(SyntaxError::UnexpectedToken((*selector_token).clone()));
+                return Err(SyntaxError::UnexpectedToken(selector_token.clone()));
             }
 
             let attribute_name = &selector[1..]; // Skip the leading '.'
-            let attr_literal_token_id = self.token_arena.alloc(Shared::clone(&selector_token));
+            let attr_literal_token_id = self.token_arena.alloc(selector_token.clone());
             let attr_literal = Shared::new(Node {
                 token_id: attr_literal_token_id,
                 expr: Shared::new(Expr::Literal(Literal::String(attribute_name.to_string()))),
@@ -826,10 +816,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             Ok(Shared::new(Node {
                 token_id: attr_literal_token_id,
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(
-                        constants::builtins::ATTR,
-                        Some(Shared::clone(&self.token_arena[token_id])),
-                    ),
+                    IdentWithToken::new_with_token(constants::builtins::ATTR, Some(self.token_arena[token_id].clone())),
                     smallvec![base_node, attr_literal],
                 )),
             }))
@@ -838,8 +825,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }
     }
 
-    fn parse_self(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(token));
+    fn parse_self(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(token.clone());
         let self_node = Shared::new(Node {
             token_id,
             expr: Shared::new(Expr::Self_),
@@ -852,8 +839,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }
     }
 
-    fn parse_break(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(token));
+    fn parse_break(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(token.clone());
 
         // Check for colon and expression (break: expr)
         let value = if self.tokens.peek().map(|t| &t.kind) == Some(&TokenKind::Colon) {
@@ -873,17 +860,17 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_continue(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_continue(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         Ok(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(token)),
+            token_id: self.token_arena.alloc(token.clone()),
             expr: Shared::new(Expr::Continue),
         }))
     }
 
     /// Parses a `...expr` spread element, wrapping it in a `SPREAD` marker call that
     /// `eval_builtin` expands in place when building the enclosing array/dict.
-    fn parse_spread_element(&mut self, dots_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(dots_token));
+    fn parse_spread_element(&mut self, dots_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(dots_token.clone());
         let next_token = self
             .tokens
             .next()
@@ -893,15 +880,15 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         Ok(Shared::new(Node {
             token_id,
             expr: Shared::new(Expr::Call(
-                IdentWithToken::new_with_token(constants::builtins::SPREAD, Some(Shared::clone(dots_token))),
+                IdentWithToken::new_with_token(constants::builtins::SPREAD, Some(dots_token.clone())),
                 smallvec![inner],
             )),
         }))
     }
 
-    fn parse_array(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let opening = (**token).clone();
-        let token_id = self.token_arena.alloc(Shared::clone(token));
+    fn parse_array(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let opening = (*token).clone();
+        let token_id = self.token_arena.alloc(token.clone());
         let mut elements: SmallVec<[Shared<Node>; 4]> = SmallVec::new();
         let mut closed = false;
 
@@ -913,7 +900,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 }
                 TokenKind::Eof => {
                     return Err(SyntaxError::ExpectedClosingBracket(
-                        (**elem_token).clone(),
+                        (*elem_token).clone(),
                         Some(Box::new(opening)),
                     ));
                 }
@@ -942,7 +929,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         let array_node = Shared::new(Node {
             token_id,
             expr: Shared::new(Expr::Call(
-                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::clone(token))),
+                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token.clone())),
                 elements,
             )),
         });
@@ -951,9 +938,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         self.parse_postfix_ops(array_node, token)
     }
 
-    fn parse_all_nodes(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_all_nodes(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         Ok(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(token)),
+            token_id: self.token_arena.alloc(token.clone()),
             expr: Shared::new(Expr::Nodes),
         }))
     }
@@ -1042,30 +1029,30 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         )
     }
 
-    fn parse_literal(&mut self, literal_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_literal(&mut self, literal_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         let literal_node = match &literal_token.kind {
             TokenKind::BoolLiteral(b) => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(literal_token)),
+                token_id: self.token_arena.alloc(literal_token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::Bool(*b))),
             })),
             TokenKind::StringLiteral(s) => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(literal_token)),
+                token_id: self.token_arena.alloc(literal_token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::String(s.to_owned()))),
             })),
             TokenKind::BytesLiteral(b) => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(literal_token)),
+                token_id: self.token_arena.alloc(literal_token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::Bytes(b.clone()))),
             })),
             TokenKind::NumberLiteral(n) => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(literal_token)),
+                token_id: self.token_arena.alloc(literal_token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::Number(*n))),
             })),
             TokenKind::None => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(literal_token)),
+                token_id: self.token_arena.alloc(literal_token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::None)),
             })),
             TokenKind::Eof => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
-            _ => Err(SyntaxError::UnexpectedToken((**literal_token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*literal_token).clone())),
         }?;
 
         let token = self.tokens.peek();
@@ -1073,19 +1060,19 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         if Self::is_next_token_allowed(token.as_ref().map(|t| &t.kind)) {
             Ok(literal_node)
         } else {
-            Err(SyntaxError::UnexpectedToken((***token.unwrap()).clone()))
+            Err(SyntaxError::UnexpectedToken((**token.unwrap()).clone()))
         }
     }
 
-    fn parse_ident(&mut self, ident: &str, ident_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_ident(&mut self, ident: &str, ident_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match self.tokens.peek().map(|t| &t.kind) {
             Some(TokenKind::Selector(selector)) if selector.len() > 1 => {
-                let token_id = self.token_arena.alloc(Shared::clone(ident_token));
+                let token_id = self.token_arena.alloc(ident_token.clone());
                 let base_node = Shared::new(Node {
                     token_id,
                     expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                         ident,
-                        Some(Shared::clone(ident_token)),
+                        Some(ident_token.clone()),
                     ))),
                 });
 
@@ -1094,7 +1081,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             Some(TokenKind::DoubleColon) => {
                 // Parse qualified access: module::function(), module::ident, or module::module2::method
                 // Build the module path by collecting all identifiers separated by '::'
-                let mut module_path = vec![IdentWithToken::new_with_token(ident, Some(Shared::clone(ident_token)))];
+                let mut module_path = vec![IdentWithToken::new_with_token(ident, Some(ident_token.clone()))];
 
                 // Collect all module path segments
                 while matches!(self.tokens.peek().map(|t| &t.kind), Some(TokenKind::DoubleColon)) {
@@ -1107,27 +1094,24 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
                     let next_ident = match &next_token.kind {
                         TokenKind::Ident(name) => name.clone(),
-                        _ => return Err(SyntaxError::UnexpectedToken((**next_token).clone())),
+                        _ => return Err(SyntaxError::UnexpectedToken((*next_token).clone())),
                     };
 
                     // Check if this is the last segment (followed by '(' or not '::')
                     match self.tokens.peek().map(|t| &t.kind) {
                         Some(TokenKind::DoubleColon) => {
                             // More segments to come, add to module path
-                            module_path.push(IdentWithToken::new_with_token(
-                                &next_ident,
-                                Some(Shared::clone(next_token)),
-                            ));
+                            module_path.push(IdentWithToken::new_with_token(&next_ident, Some(next_token.clone())));
                         }
                         Some(TokenKind::LParen) => {
                             // This is a function call: module::...::function(args)
                             let args = self.parse_args()?;
                             let access_target = AccessTarget::Call(
-                                IdentWithToken::new_with_token(&next_ident, Some(Shared::clone(next_token))),
+                                IdentWithToken::new_with_token(&next_ident, Some(next_token.clone())),
                                 args,
                             );
 
-                            let token_id = self.token_arena.alloc(Shared::clone(ident_token));
+                            let token_id = self.token_arena.alloc(ident_token.clone());
                             let qualified_node = Shared::new(Node {
                                 token_id,
                                 expr: Shared::new(Expr::QualifiedAccess(module_path, access_target)),
@@ -1142,10 +1126,10 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                             // This is an identifier: module::...::ident
                             let access_target = AccessTarget::Ident(IdentWithToken::new_with_token(
                                 &next_ident,
-                                Some(Shared::clone(next_token)),
+                                Some(next_token.clone()),
                             ));
 
-                            let token_id = self.token_arena.alloc(Shared::clone(ident_token));
+                            let token_id = self.token_arena.alloc(ident_token.clone());
                             return Ok(Shared::new(Node {
                                 token_id,
                                 expr: Shared::new(Expr::QualifiedAccess(module_path, access_target)),
@@ -1155,11 +1139,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 }
 
                 // This should not be reached, but handle it gracefully
-                Err(SyntaxError::UnexpectedToken((**ident_token).clone()))
+                Err(SyntaxError::UnexpectedToken((*ident_token).clone()))
             }
             Some(TokenKind::LParen) => {
                 let mut args = self.parse_args()?;
-                let token_id = self.token_arena.alloc(Shared::clone(ident_token));
+                let token_id = self.token_arena.alloc(ident_token.clone());
 
                 // Check for macro call (e.g., foo(args) do ...)
                 if matches!(self.tokens.peek().map(|t| &t.kind), Some(TokenKind::Do)) {
@@ -1168,9 +1152,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     args.push(block);
 
                     return Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(ident_token)),
+                        token_id: self.token_arena.alloc(ident_token.clone()),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(ident, Some(Shared::clone(ident_token))),
+                            IdentWithToken::new_with_token(ident, Some(ident_token.clone())),
                             args,
                         )),
                     }));
@@ -1179,14 +1163,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 let call_node = Shared::new(Node {
                     token_id,
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(ident, Some(Shared::clone(ident_token))),
+                        IdentWithToken::new_with_token(ident, Some(ident_token.clone())),
                         args,
                     )),
                 });
 
                 if self.is_next_token(|token_kind| matches!(token_kind, TokenKind::Question)) {
                     let question_token = self.tokens.next().unwrap();
-                    let question_token_id = self.token_arena.alloc(Shared::clone(question_token));
+                    let question_token_id = self.token_arena.alloc(question_token.clone());
 
                     return Ok(Shared::new(Node {
                         token_id: question_token_id,
@@ -1210,15 +1194,15 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 } else if Self::is_next_token_allowed(self.tokens.peek().map(|t| &t.kind)) {
                     Ok(call_node)
                 } else {
-                    Err(SyntaxError::UnexpectedToken((***self.tokens.peek().unwrap()).clone()))
+                    Err(SyntaxError::UnexpectedToken((**self.tokens.peek().unwrap()).clone()))
                 }
             }
             Some(TokenKind::LBracket) => {
                 let ident_node = Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(ident_token)),
+                    token_id: self.token_arena.alloc(ident_token.clone()),
                     expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                         ident,
-                        Some(Shared::clone(ident_token)),
+                        Some(ident_token.clone()),
                     ))),
                 });
 
@@ -1226,13 +1210,13 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 self.parse_postfix_ops(result, ident_token)
             }
             token if Self::is_next_token_allowed(token) => Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(ident_token)),
+                token_id: self.token_arena.alloc(ident_token.clone()),
                 expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                     ident,
-                    Some(Shared::clone(ident_token)),
+                    Some(ident_token.clone()),
                 ))),
             })),
-            _ => Err(SyntaxError::UnexpectedToken((**ident_token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*ident_token).clone())),
         }
     }
 
@@ -1240,9 +1224,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     fn parse_bracket_access(
         &mut self,
         target_node: Shared<Node>,
-        original_token: &Shared<Token>,
+        original_token: &Token,
     ) -> Result<Shared<Node>, SyntaxError> {
-        let lbracket = self.tokens.next().map(|t| (**t).clone()); // consume '['
+        let lbracket = self.tokens.next().map(|t| (*t).clone()); // consume '['
 
         // Check for [:N] or [:]  style slice (empty start index).
         // [:ident] and [:string] are dict key accesses using a symbol, not slices.
@@ -1255,7 +1239,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         if is_slice_from_start {
             let _ = self.tokens.next(); // consume ':'
             let start_node = Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                token_id: self.token_arena.alloc(original_token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::Number(0.into()))),
             });
 
@@ -1263,17 +1247,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 Some(t) if t.kind == TokenKind::RBracket => {
                     // [:] = slice(arr, 0, len(arr))
                     Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                        token_id: self.token_arena.alloc(original_token.clone()),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(
-                                constants::builtins::SLICE,
-                                Some(Shared::clone(original_token)),
-                            ),
+                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(original_token.clone())),
                             smallvec![
                                 Shared::clone(&target_node),
                                 start_node,
                                 Shared::new(Node {
-                                    token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                                    token_id: self.token_arena.alloc(original_token.clone()),
                                     expr: Shared::new(Expr::Call(
                                         IdentWithToken::new_with_token(constants::builtins::LEN, None,),
                                         smallvec![target_node],
@@ -1291,7 +1272,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         }
                         Some(token) => {
                             return Err(SyntaxError::ExpectedClosingBracket(
-                                (***token).clone(),
+                                (**token).clone(),
                                 lbracket.clone().map(Box::new),
                             ));
                         }
@@ -1307,12 +1288,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         }
                     }
                     Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                        token_id: self.token_arena.alloc(original_token.clone()),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(
-                                constants::builtins::SLICE,
-                                Some(Shared::clone(original_token)),
-                            ),
+                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(original_token.clone())),
                             smallvec![target_node, start_node, end_node],
                         )),
                     })
@@ -1345,14 +1323,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
             match self.tokens.next() {
                 Some(t) if t.kind == TokenKind::RBracket => Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                    token_id: self.token_arena.alloc(original_token.clone()),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::clone(original_token))),
+                        IdentWithToken::new_with_token(constants::builtins::SLICE, Some(original_token.clone())),
                         smallvec![
                             Shared::clone(&target_node),
                             first_node,
                             Shared::new(Node {
-                                token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                                token_id: self.token_arena.alloc(original_token.clone()),
                                 expr: Shared::new(Expr::Call(
                                     IdentWithToken::new_with_token(constants::builtins::LEN, None),
                                     smallvec![target_node],
@@ -1371,7 +1349,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         }
                         Some(token) => {
                             return Err(SyntaxError::ExpectedClosingBracket(
-                                (***token).clone(),
+                                (**token).clone(),
                                 lbracket.clone().map(Box::new),
                             ));
                         }
@@ -1388,12 +1366,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     }
 
                     Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                        token_id: self.token_arena.alloc(original_token.clone()),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(
-                                constants::builtins::SLICE,
-                                Some(Shared::clone(original_token)),
-                            ),
+                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(original_token.clone())),
                             smallvec![target_node, first_node, second_node],
                         )),
                     })
@@ -1408,7 +1383,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 }
                 Some(token) => {
                     return Err(SyntaxError::ExpectedClosingBracket(
-                        (***token).clone(),
+                        (**token).clone(),
                         lbracket.clone().map(Box::new),
                     ));
                 }
@@ -1425,9 +1400,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             }
 
             Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                token_id: self.token_arena.alloc(original_token.clone()),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::clone(original_token))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(original_token.clone())),
                     smallvec![target_node, first_node],
                 )),
             })
@@ -1445,7 +1420,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         if matches!(self.tokens.peek().map(|t| &t.kind), Some(TokenKind::LParen)) {
             let args = self.parse_args()?;
             let call_dynamic = Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                token_id: self.token_arena.alloc(original_token.clone()),
                 expr: Shared::new(Expr::CallDynamic(final_result, args)),
             });
             self.parse_postfix_ops(call_dynamic, original_token)
@@ -1459,13 +1434,13 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     fn parse_postfix_ops(
         &mut self,
         mut current: Shared<Node>,
-        original_token: &Shared<Token>,
+        original_token: &Token,
     ) -> Result<Shared<Node>, SyntaxError> {
         loop {
             if matches!(self.tokens.peek().map(|t| &t.kind), Some(TokenKind::LParen)) {
                 let args = self.parse_args()?;
                 current = Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(original_token)),
+                    token_id: self.token_arena.alloc(original_token.clone()),
                     expr: Shared::new(Expr::CallDynamic(current, args)),
                 });
             } else if matches!(self.tokens.peek().map(|t| &t.kind), Some(TokenKind::LBracket)) {
@@ -1477,16 +1452,16 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         Ok(current)
     }
 
-    fn parse_def(&mut self, def_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_def(&mut self, def_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         let ident_token = self.tokens.next();
         let ident = match &ident_token {
             Some(token) => match &token.kind {
                 TokenKind::Ident(ident) => Ok(ident),
-                _ => Err(SyntaxError::UnexpectedToken((***token).clone())),
+                _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
             },
             None => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         }?;
-        let def_token_id = self.token_arena.alloc(Shared::clone(def_token));
+        let def_token_id = self.token_arena.alloc(def_token.clone());
         let params = if self.is_next_token(|token| matches!(token, TokenKind::Colon | TokenKind::Do)) {
             SmallVec::new()
         } else {
@@ -1500,36 +1475,36 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         Ok(Shared::new(Node {
             token_id: def_token_id,
             expr: Shared::new(Expr::Def(
-                IdentWithToken::new_with_token(ident, ident_token.map(Shared::clone)),
+                IdentWithToken::new_with_token(ident, ident_token.cloned()),
                 params,
                 program,
             )),
         }))
     }
 
-    fn parse_macro(&mut self, macro_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_macro(&mut self, macro_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         let ident_token = self.tokens.next();
         let ident = match &ident_token {
             Some(token) => match &token.kind {
                 TokenKind::Ident(ident) => Ok(ident),
-                _ => Err(SyntaxError::UnexpectedToken((***token).clone())),
+                _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
             },
             None => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         }?;
-        let macro_token_id = self.token_arena.alloc(Shared::clone(macro_token));
+        let macro_token_id = self.token_arena.alloc(macro_token.clone());
         let params = self.parse_params()?;
 
         // Macros should not support default parameters
         if params.iter().any(|p| p.default.is_some()) {
             return Err(SyntaxError::MacroParametersCannotHaveDefaults(
-                (*self.token_arena[macro_token_id]).clone(),
+                self.token_arena[macro_token_id].clone(),
             ));
         }
 
         // Macros should not support variadic parameters
         if params.iter().any(|p| p.is_variadic) {
             return Err(SyntaxError::MacroParametersCannotBeVariadic(
-                (*self.token_arena[macro_token_id]).clone(),
+                self.token_arena[macro_token_id].clone(),
             ));
         }
 
@@ -1543,15 +1518,15 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         Ok(Shared::new(Node {
             token_id: macro_token_id,
             expr: Shared::new(Expr::Macro(
-                IdentWithToken::new_with_token(ident, ident_token.map(Shared::clone)),
+                IdentWithToken::new_with_token(ident, ident_token.cloned()),
                 params,
                 expr,
             )),
         }))
     }
 
-    fn parse_block(&mut self, do_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let do_token_id = self.token_arena.alloc(Shared::clone(do_token));
+    fn parse_block(&mut self, do_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let do_token_id = self.token_arena.alloc(do_token.clone());
         let program = self.parse_program(false)?;
 
         // The End token is already consumed by parse_program when it encounters it
@@ -1563,8 +1538,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_fn(&mut self, fn_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let fn_token_id = self.token_arena.alloc(Shared::clone(fn_token));
+    fn parse_fn(&mut self, fn_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let fn_token_id = self.token_arena.alloc(fn_token.clone());
         let params = self.parse_params()?;
 
         self.consume_colon_or_do();
@@ -1580,12 +1555,12 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         self.parse_postfix_ops(fn_node, fn_token)
     }
 
-    fn parse_while(&mut self, while_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(while_token));
+    fn parse_while(&mut self, while_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(while_token.clone());
         let args = self.parse_args()?;
 
         if args.len() != 1 {
-            return Err(SyntaxError::UnexpectedToken((**while_token).clone()));
+            return Err(SyntaxError::UnexpectedToken((*while_token).clone()));
         }
 
         self.consume_colon_or_do();
@@ -1603,12 +1578,12 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     )),
                 }))
             }
-            None => Err(SyntaxError::UnexpectedToken((**while_token).clone())),
+            None => Err(SyntaxError::UnexpectedToken((*while_token).clone())),
         }
     }
 
-    fn parse_loop(&mut self, loop_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(loop_token));
+    fn parse_loop(&mut self, loop_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(loop_token.clone());
 
         self.consume_colon_or_do();
 
@@ -1621,12 +1596,12 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     expr: Shared::new(Expr::Loop(body_program.iter().map(Shared::clone).collect())),
                 }))
             }
-            None => Err(SyntaxError::UnexpectedToken((**loop_token).clone())),
+            None => Err(SyntaxError::UnexpectedToken((*loop_token).clone())),
         }
     }
 
-    fn parse_try(&mut self, try_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(try_token));
+    fn parse_try(&mut self, try_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(try_token.clone());
 
         self.consume_colon_or_do();
 
@@ -1659,12 +1634,10 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             match args.as_slice() {
                 [arg] => match &*arg.expr {
                     Expr::Ident(ident) => Some(ident.clone()),
-                    _ => return Err(SyntaxError::UnexpectedToken((*self.token_arena[arg.token_id]).clone())),
+                    _ => return Err(SyntaxError::UnexpectedToken(self.token_arena[arg.token_id].clone())),
                 },
                 _ => {
-                    return Err(SyntaxError::UnexpectedToken(
-                        (*self.token_arena[catch_token_id]).clone(),
-                    ));
+                    return Err(SyntaxError::UnexpectedToken(self.token_arena[catch_token_id].clone()));
                 }
             }
         } else {
@@ -1685,8 +1658,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_quote(&mut self, quote_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(quote_token));
+    fn parse_quote(&mut self, quote_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(quote_token.clone());
 
         self.consume_colon();
 
@@ -1701,13 +1674,13 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_unquote(&mut self, unquote_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(unquote_token));
+    fn parse_unquote(&mut self, unquote_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(unquote_token.clone());
 
         let args = self.parse_args()?;
 
         if args.len() != 1 {
-            return Err(SyntaxError::UnexpectedToken((*self.token_arena[token_id]).clone()));
+            return Err(SyntaxError::UnexpectedToken(self.token_arena[token_id].clone()));
         }
 
         let expr = Shared::clone(args.first().unwrap());
@@ -1718,11 +1691,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_foreach(&mut self, foreach_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_foreach(&mut self, foreach_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         let args = self.parse_args()?;
 
         if args.len() != 2 {
-            return Err(SyntaxError::UnexpectedToken((**foreach_token).clone()));
+            return Err(SyntaxError::UnexpectedToken((*foreach_token).clone()));
         }
 
         let first_arg = &*args.first().unwrap().expr;
@@ -1738,7 +1711,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 let body_program = self.parse_program(false)?;
 
                 Ok(Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(foreach_token)),
+                    token_id: self.token_arena.alloc(foreach_token.clone()),
                     expr: Shared::new(Expr::Foreach(
                         IdentWithToken {
                             name: *ident,
@@ -1749,16 +1722,16 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     )),
                 }))
             }
-            _ => Err(SyntaxError::UnexpectedToken((**foreach_token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*foreach_token).clone())),
         }
     }
 
-    fn parse_if(&mut self, if_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(if_token));
+    fn parse_if(&mut self, if_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(if_token.clone());
         let args = self.parse_args()?;
 
         if args.len() != 1 {
-            return Err(SyntaxError::UnexpectedToken((*self.token_arena[token_id]).clone()));
+            return Err(SyntaxError::UnexpectedToken(self.token_arena[token_id].clone()));
         }
         let cond = args.first().unwrap();
 
@@ -1784,18 +1757,18 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }
 
         Ok(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(if_token)),
+            token_id: self.token_arena.alloc(if_token.clone()),
             expr: Shared::new(Expr::If(branches)),
         }))
     }
 
-    fn parse_match(&mut self, match_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(match_token));
+    fn parse_match(&mut self, match_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(match_token.clone());
 
         // Parse the value expression: match (value):
         let args = self.parse_args()?;
         if args.len() != 1 {
-            return Err(SyntaxError::UnexpectedToken((*self.token_arena[token_id]).clone()));
+            return Err(SyntaxError::UnexpectedToken(self.token_arena[token_id].clone()));
         }
         let value = Shared::clone(args.first().unwrap());
 
@@ -1817,11 +1790,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             // Check for guard (if condition)
             let guard = if let Some(token) = self.tokens.peek() {
                 if matches!(token.kind, TokenKind::If) {
-                    let if_token = Shared::clone(token);
+                    let if_token = (*token).clone();
                     self.tokens.next(); // consume 'if'
                     let guard_args = self.parse_args()?;
                     if guard_args.len() != 1 {
-                        return Err(SyntaxError::UnexpectedToken((*if_token).clone()));
+                        return Err(SyntaxError::UnexpectedToken(if_token));
                     }
                     Some(Shared::clone(guard_args.first().unwrap()))
                 } else {
@@ -1882,7 +1855,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 };
                 match &type_token.kind {
                     TokenKind::Ident(type_name) => Ok(Pattern::Type(Ident::new(type_name))),
-                    _ => Err(SyntaxError::UnexpectedToken((**type_token).clone())),
+                    _ => Err(SyntaxError::UnexpectedToken((*type_token).clone())),
                 }
             }
             // Literal patterns
@@ -1897,7 +1870,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             TokenKind::LBrace => self.parse_dict_pattern(),
             // Identifier pattern (binding)
             TokenKind::Ident(name) => Ok(Pattern::Ident(IdentWithToken::new(name))),
-            _ => Err(SyntaxError::UnexpectedToken((**token).clone())),
+            _ => Err(SyntaxError::UnexpectedToken((*token).clone())),
         }
     }
 
@@ -1922,14 +1895,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                             rest_binding = Some(IdentWithToken::new(name));
                             has_rest = true;
                         } else {
-                            return Err(SyntaxError::UnexpectedToken((**ident_token).clone()));
+                            return Err(SyntaxError::UnexpectedToken((*ident_token).clone()));
                         }
                     }
                     // Expect closing bracket after rest
                     if let Some(token) = self.tokens.next()
                         && !matches!(token.kind, TokenKind::RBracket)
                     {
-                        return Err(SyntaxError::UnexpectedToken((**token).clone()));
+                        return Err(SyntaxError::UnexpectedToken((*token).clone()));
                     }
                     break;
                 }
@@ -1946,7 +1919,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     // Will be consumed in next iteration
                     continue;
                 } else {
-                    return Err(SyntaxError::UnexpectedToken((***token).clone()));
+                    return Err(SyntaxError::UnexpectedToken((**token).clone()));
                 }
             }
         }
@@ -1978,7 +1951,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
             let key = match &key_token.kind {
                 TokenKind::Ident(name) => IdentWithToken::new(name),
-                _ => return Err(SyntaxError::UnexpectedToken((**key_token).clone())),
+                _ => return Err(SyntaxError::UnexpectedToken((*key_token).clone())),
             };
 
             // Check if there's a colon (key: pattern) or just key shorthand
@@ -2004,7 +1977,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     // Will be consumed in next iteration
                     continue;
                 } else {
-                    return Err(SyntaxError::UnexpectedToken((***token).clone()));
+                    return Err(SyntaxError::UnexpectedToken((**token).clone()));
                 }
             }
         }
@@ -2016,7 +1989,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     fn parse_next_expr(&mut self, token_id: TokenId) -> Result<Shared<Node>, SyntaxError> {
         let expr_token = match self.tokens.next() {
             Some(token) => Ok(token),
-            None => Err(SyntaxError::UnexpectedToken((*self.token_arena[token_id]).clone())),
+            None => Err(SyntaxError::UnexpectedToken(self.token_arena[token_id].clone())),
         }?;
 
         self.parse_expr(expr_token)
@@ -2034,14 +2007,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             let args = self.parse_args()?;
 
             if args.len() != 1 {
-                return Err(SyntaxError::UnexpectedToken((*self.token_arena[token_id]).clone()));
+                return Err(SyntaxError::UnexpectedToken(self.token_arena[token_id].clone()));
             }
 
             self.consume_colon();
 
             let expr_token = match self.tokens.next() {
                 Some(token) => Ok(token),
-                None => Err(SyntaxError::UnexpectedToken((*self.token_arena[token_id]).clone())),
+                None => Err(SyntaxError::UnexpectedToken(self.token_arena[token_id].clone())),
             }?;
 
             let cond = args.first().unwrap();
@@ -2072,18 +2045,18 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 let ident_token = self.tokens.next().unwrap();
                 Ok(Pattern::Ident(IdentWithToken::new_with_token(
                     name,
-                    Some(Shared::clone(ident_token)),
+                    Some(ident_token.clone()),
                 )))
             }
             _ => {
                 let bad_token = self.tokens.next().unwrap();
-                Err(SyntaxError::UnexpectedToken((**bad_token).clone()))
+                Err(SyntaxError::UnexpectedToken((*bad_token).clone()))
             }
         }
     }
 
-    fn parse_let(&mut self, let_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let let_token_id = self.token_arena.alloc(Shared::clone(let_token));
+    fn parse_let(&mut self, let_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let let_token_id = self.token_arena.alloc(let_token.clone());
         let pattern = self.parse_let_or_var_pattern()?;
 
         self.next_token(|token_kind| matches!(token_kind, TokenKind::Equal))?;
@@ -2093,7 +2066,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }?;
 
         if matches!(expr_token.kind, TokenKind::Let | TokenKind::Var) {
-            return Err(SyntaxError::UnexpectedToken((**expr_token).clone()));
+            return Err(SyntaxError::UnexpectedToken((*expr_token).clone()));
         }
 
         let ast = self.parse_expr(expr_token)?;
@@ -2104,7 +2077,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 TokenKind::Pipe | TokenKind::Eof | TokenKind::SemiColon | TokenKind::End
             )
         {
-            return Err(SyntaxError::UnexpectedToken((***token).clone()));
+            return Err(SyntaxError::UnexpectedToken((**token).clone()));
         }
 
         Ok(Shared::new(Node {
@@ -2113,8 +2086,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }))
     }
 
-    fn parse_var(&mut self, var_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let var_token_id = self.token_arena.alloc(Shared::clone(var_token));
+    fn parse_var(&mut self, var_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let var_token_id = self.token_arena.alloc(var_token.clone());
         let pattern = self.parse_let_or_var_pattern()?;
 
         self.next_token(|token_kind| matches!(token_kind, TokenKind::Equal))?;
@@ -2124,7 +2097,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }?;
 
         if matches!(expr_token.kind, TokenKind::Let | TokenKind::Var) {
-            return Err(SyntaxError::UnexpectedToken((**expr_token).clone()));
+            return Err(SyntaxError::UnexpectedToken((*expr_token).clone()));
         }
 
         let ast = self.parse_expr(expr_token)?;
@@ -2135,7 +2108,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 TokenKind::Pipe | TokenKind::Eof | TokenKind::SemiColon | TokenKind::End
             )
         {
-            return Err(SyntaxError::UnexpectedToken((***token).clone()));
+            return Err(SyntaxError::UnexpectedToken((**token).clone()));
         }
 
         Ok(Shared::new(Node {
@@ -2145,27 +2118,27 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     }
 
     #[inline(always)]
-    fn parse_include(&mut self, include_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_include(&mut self, include_token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match self.tokens.peek() {
             Some(token) => match &token.kind {
                 TokenKind::StringLiteral(module) => {
                     self.tokens.next();
                     Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(include_token)),
+                        token_id: self.token_arena.alloc(include_token.clone()),
                         expr: Shared::new(Expr::Include(Literal::String(module.to_owned()))),
                     }))
                 }
-                _ => Err(SyntaxError::InsufficientTokens((***token).clone())),
+                _ => Err(SyntaxError::InsufficientTokens((**token).clone())),
             },
             None => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         }
     }
 
     #[inline(always)]
-    fn parse_import(&mut self, import_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let token_id = self.token_arena.alloc(Shared::clone(import_token));
+    fn parse_import(&mut self, import_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let token_id = self.token_arena.alloc(import_token.clone());
         let token = match self.tokens.next() {
-            Some(token) => Ok(Shared::clone(token)),
+            Some(token) => Ok(token.clone()),
             None => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         }?;
 
@@ -2182,10 +2155,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     };
 
                     match &name_token.kind {
-                        TokenKind::Ident(name) => {
-                            Some(IdentWithToken::new_with_token(name, Some(Shared::clone(name_token))))
-                        }
-                        _ => return Err(SyntaxError::UnexpectedToken((**name_token).clone())),
+                        TokenKind::Ident(name) => Some(IdentWithToken::new_with_token(name, Some(name_token.clone()))),
+                        _ => return Err(SyntaxError::UnexpectedToken((*name_token).clone())),
                     }
                 } else {
                     None
@@ -2196,11 +2167,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     expr: Shared::new(Expr::Import(Literal::String(module_name), alias)),
                 }))
             }
-            _ => Err(SyntaxError::InsufficientTokens((*token).clone())),
+            _ => Err(SyntaxError::InsufficientTokens(token.clone())),
         }
     }
 
-    fn parse_interpolated_string(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_interpolated_string(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         if let TokenKind::InterpolatedString(segments) = &token.kind {
             let mut parsed_segments = Vec::new();
 
@@ -2230,8 +2201,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                                 })
                             })?;
 
-                            let shared_tokens: Vec<Shared<Token>> = tokens.into_iter().map(Shared::new).collect();
-                            let mut parser = Parser::new(shared_tokens.iter(), self.token_arena, token.module_id);
+                            let mut parser = Parser::new(tokens.iter(), self.token_arena, token.module_id);
                             let expr_node = parser.parse_expr_from_tokens().map_err(|_| {
                                 SyntaxError::UnexpectedToken(Token {
                                     range: *range,
@@ -2247,11 +2217,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             }
 
             Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(token)),
+                token_id: self.token_arena.alloc(token.clone()),
                 expr: Shared::new(Expr::InterpolatedString(parsed_segments)),
             }))
         } else {
-            Err(SyntaxError::UnexpectedToken((**token).clone()))
+            Err(SyntaxError::UnexpectedToken((*token).clone()))
         }
     }
 
@@ -2269,11 +2239,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         let opening_paren = match self.tokens.peek() {
             Some(token) => match &token.kind {
                 TokenKind::LParen => {
-                    let t = (***token).clone();
+                    let t = (**token).clone();
                     self.tokens.next();
                     Some(t)
                 }
-                _ => return Err(SyntaxError::UnexpectedToken((***token).clone())),
+                _ => return Err(SyntaxError::UnexpectedToken((**token).clone())),
             },
             None => return Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         };
@@ -2287,7 +2257,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             match &token.kind {
                 TokenKind::RParen => match prev_token {
                     Some(TokenKind::Comma) => {
-                        return Err(SyntaxError::UnexpectedToken((**token).clone()));
+                        return Err(SyntaxError::UnexpectedToken((*token).clone()));
                     }
                     _ => break,
                 },
@@ -2295,7 +2265,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     Some(TokenKind::RParen) => break,
                     Some(_) | None => {
                         return Err(SyntaxError::ExpectedClosingParen(
-                            (**token).clone(),
+                            (*token).clone(),
                             opening_paren.clone().map(Box::new),
                         ));
                     }
@@ -2303,23 +2273,23 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 TokenKind::Comma => match prev_token {
                     Some(_) => {
                         let token = match self.tokens.peek() {
-                            Some(token) => Ok(Shared::clone(token)),
+                            Some(token) => Ok((*token).clone()),
                             None => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
                         }?;
                         match &token.kind {
                             TokenKind::Comma => {
-                                return Err(SyntaxError::UnexpectedToken((*token).clone()));
+                                return Err(SyntaxError::UnexpectedToken(token.clone()));
                             }
                             _ => continue,
                         }
                     }
-                    None => return Err(SyntaxError::UnexpectedToken((**token).clone())),
+                    None => return Err(SyntaxError::UnexpectedToken((*token).clone())),
                 },
                 TokenKind::SemiColon => return Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
                 TokenKind::Asterisk => {
                     // Variadic parameter: *name
                     if seen_variadic {
-                        return Err(SyntaxError::MultipleVariadicParameters((**token).clone()));
+                        return Err(SyntaxError::MultipleVariadicParameters((*token).clone()));
                     }
                     let ident_token = match self.tokens.next() {
                         Some(t) => t,
@@ -2327,23 +2297,23 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     };
                     match &ident_token.kind {
                         TokenKind::Ident(name) => {
-                            let ident = IdentWithToken::new_with_token(name, Some(Shared::clone(ident_token)));
+                            let ident = IdentWithToken::new_with_token(name, Some(ident_token.clone()));
                             params.push(Param::variadic(ident));
                             seen_variadic = true;
                         }
                         _ => {
-                            return Err(SyntaxError::UnexpectedToken((**ident_token).clone()));
+                            return Err(SyntaxError::UnexpectedToken((*ident_token).clone()));
                         }
                     }
                 }
                 TokenKind::Ident(name) => {
                     // Non-variadic param after variadic is an error
                     if seen_variadic {
-                        return Err(SyntaxError::VariadicParameterMustBeLast((**token).clone()));
+                        return Err(SyntaxError::VariadicParameterMustBeLast((*token).clone()));
                     }
 
                     // Parse parameter name
-                    let ident = IdentWithToken::new_with_token(name, Some(Shared::clone(token)));
+                    let ident = IdentWithToken::new_with_token(name, Some(token.clone()));
 
                     // Check for '=' indicating a default value
                     let default = if let Some(next_token) = self.tokens.peek()
@@ -2361,7 +2331,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         Some(self.parse_expr(default_token)?)
                     } else {
                         if seen_default {
-                            return Err(SyntaxError::ParameterWithoutDefaultAfterDefault((**token).clone()));
+                            return Err(SyntaxError::ParameterWithoutDefaultAfterDefault((*token).clone()));
                         }
                         None
                     };
@@ -2369,7 +2339,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     params.push(Param::with_default(ident, default));
                 }
                 _ => {
-                    return Err(SyntaxError::UnexpectedToken((**token).clone()));
+                    return Err(SyntaxError::UnexpectedToken((*token).clone()));
                 }
             }
 
@@ -2379,7 +2349,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 && !matches!(token.kind, TokenKind::RParen | TokenKind::Comma)
             {
                 return Err(SyntaxError::ExpectedClosingParen(
-                    (***token).clone(),
+                    (**token).clone(),
                     opening_paren.clone().map(Box::new),
                 ));
             }
@@ -2392,11 +2362,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         let opening_paren = match self.tokens.peek() {
             Some(token) => match &token.kind {
                 TokenKind::LParen => {
-                    let t = (***token).clone();
+                    let t = (**token).clone();
                     self.tokens.next();
                     Some(t)
                 }
-                _ => return Err(SyntaxError::UnexpectedToken((***token).clone())),
+                _ => return Err(SyntaxError::UnexpectedToken((**token).clone())),
             },
             None => return Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         };
@@ -2408,7 +2378,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             match &token.kind {
                 TokenKind::RParen => match prev_token {
                     Some(TokenKind::Comma) => {
-                        return Err(SyntaxError::UnexpectedToken((**token).clone()));
+                        return Err(SyntaxError::UnexpectedToken((*token).clone()));
                     }
                     _ => break,
                 },
@@ -2416,7 +2386,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     Some(TokenKind::RParen) => break,
                     Some(_) | None => {
                         return Err(SyntaxError::ExpectedClosingParen(
-                            (**token).clone(),
+                            (*token).clone(),
                             opening_paren.clone().map(Box::new),
                         ));
                     }
@@ -2424,17 +2394,17 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 TokenKind::Comma => match prev_token {
                     Some(_) => {
                         let token = match self.tokens.peek() {
-                            Some(token) => Ok(Shared::clone(token)),
+                            Some(token) => Ok((*token).clone()),
                             None => Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
                         }?;
                         match &token.kind {
                             TokenKind::Comma => {
-                                return Err(SyntaxError::UnexpectedToken((*token).clone()));
+                                return Err(SyntaxError::UnexpectedToken(token.clone()));
                             }
                             _ => continue,
                         }
                     }
-                    None => return Err(SyntaxError::UnexpectedToken((**token).clone())),
+                    None => return Err(SyntaxError::UnexpectedToken((*token).clone())),
                 },
                 TokenKind::SemiColon => return Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
                 _ => {
@@ -2449,7 +2419,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 && !matches!(token.kind, TokenKind::RParen | TokenKind::Comma)
             {
                 return Err(SyntaxError::ExpectedClosingParen(
-                    (***token).clone(),
+                    (**token).clone(),
                     opening_paren.clone().map(Box::new),
                 ));
             }
@@ -2461,7 +2431,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     // Helper to parse an argument that is expected to be a general expression.
     // This typically involves a recursive call to `parse_expr`.
     #[inline(always)]
-    fn parse_arg_expr(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_arg_expr(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         let first = self.parse_expr(token)?;
         if !self.is_next_token(|kind| matches!(kind, TokenKind::Pipe)) {
             return Ok(first);
@@ -2473,10 +2443,10 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             let pipe_token = self.tokens.next().unwrap();
             let next_token = match self.tokens.next() {
                 Some(token) if token.kind == TokenKind::Eof => {
-                    return Err(SyntaxError::UnexpectedEOFAfterToken((**pipe_token).clone()));
+                    return Err(SyntaxError::UnexpectedEOFAfterToken((*pipe_token).clone()));
                 }
                 Some(token) => token,
-                None => return Err(SyntaxError::UnexpectedEOFAfterToken((**pipe_token).clone())),
+                None => return Err(SyntaxError::UnexpectedEOFAfterToken((*pipe_token).clone())),
             };
             program.push(self.parse_expr(next_token)?);
         }
@@ -2500,9 +2470,9 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
         // Create the set_attr() function call
         Ok(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(token)),
+            token_id: self.token_arena.alloc(token.clone()),
             expr: Shared::new(Expr::Call(
-                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(Shared::clone(token))),
+                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(token.clone())),
                 smallvec![selector_node, attr_literal, value],
             )),
         }))
@@ -2512,20 +2482,20 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
     fn build_attr_call_for_node(
         &mut self,
         base_node: Shared<Node>,
-        attr_token: Shared<Token>,
-        token: &Shared<Token>,
+        attr_token: Token,
+        token: &Token,
     ) -> Result<Shared<Node>, SyntaxError> {
         if let TokenKind::Selector(attr_selector) = &attr_token.kind {
-            if !Selector::try_from(&*attr_token)
+            if !Selector::try_from(&attr_token)
                 .map_err(SyntaxError::UnknownSelector)?
                 .is_attribute_selector()
             {
-                return Err(SyntaxError::UnexpectedToken((*attr_token).clone()));
+                return Err(SyntaxError::UnexpectedToken(attr_token.clone()));
             }
 
             let attribute = &attr_selector[1..]; // Skip the dot
             let attr_literal = Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(token)),
+                token_id: self.token_arena.alloc(token.clone()),
                 expr: Shared::new(Expr::Literal(Literal::String(attribute.to_string()))),
             });
 
@@ -2535,45 +2505,41 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             }
 
             Ok(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(token)),
+                token_id: self.token_arena.alloc(token.clone()),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::clone(token))),
+                    IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token.clone())),
                     smallvec![base_node, attr_literal],
                 )),
             }))
         } else {
-            Err(SyntaxError::UnexpectedToken((**token).clone()))
+            Err(SyntaxError::UnexpectedToken((*token).clone()))
         }
     }
 
     /// Parse a selector with an attribute suffix and convert it to an attr() function call
-    fn parse_selector_with_attribute(
-        &mut self,
-        token: &Shared<Token>,
-        attr_token: Shared<Token>,
-    ) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_selector_with_attribute(&mut self, token: &Token, attr_token: Token) -> Result<Shared<Node>, SyntaxError> {
         let base_node = self.parse_selector_direct(token)?;
         self.build_attr_call_for_node(base_node, attr_token, token)
     }
 
     /// Parse a selector without checking for attributes (to avoid infinite recursion)
-    fn parse_selector_direct(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_selector_direct(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         match &token.kind {
             TokenKind::Selector(selector) => {
                 if selector == "." {
                     if self.is_next_token(|token_kind| matches!(token_kind, TokenKind::LBracket)) {
-                        self.parse_selector_table_args(Shared::clone(token))
+                        self.parse_selector_table_args(token.clone())
                     } else {
                         Ok(Shared::new(Node {
-                            token_id: self.token_arena.alloc(Shared::clone(token)),
+                            token_id: self.token_arena.alloc(token.clone()),
                             expr: Shared::new(Expr::Self_),
                         }))
                     }
                 } else {
-                    let selector = Selector::try_from(&**token).map_err(SyntaxError::UnknownSelector)?;
+                    let selector = Selector::try_from(token).map_err(SyntaxError::UnknownSelector)?;
 
                     if selector.is_attribute_selector() {
-                        let token_id = self.token_arena.alloc(Shared::clone(token));
+                        let token_id = self.token_arena.alloc(token.clone());
                         let self_node = Shared::new(Node {
                             token_id,
                             expr: Shared::new(Expr::Self_),
@@ -2589,7 +2555,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         return Ok(Shared::new(Node {
                             token_id,
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::clone(token))),
+                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token.clone())),
                                 smallvec![self_node, attr_literal],
                             )),
                         }));
@@ -2600,21 +2566,21 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         && self.is_next_token(|kind| matches!(kind, TokenKind::LBracket))
                     {
                         let prop_node = Shared::new(Node {
-                            token_id: self.token_arena.alloc(Shared::clone(token)),
+                            token_id: self.token_arena.alloc(token.clone()),
                             expr: Shared::new(Expr::Selector(selector)),
                         });
                         return self.parse_property_iterator(token, vec![prop_node]);
                     }
 
                     Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(token)),
+                        token_id: self.token_arena.alloc(token.clone()),
                         expr: Shared::new(Expr::Selector(selector)),
                     }))
                 }
             }
             TokenKind::DoubleDot => {
                 let recursive_node = Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(token)),
+                    token_id: self.token_arena.alloc(token.clone()),
                     expr: Shared::new(Expr::Selector(Selector::Recursive)),
                 });
                 if let Some(next) = self.tokens.peek() {
@@ -2624,11 +2590,11 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                             let key = key.clone();
                             let next = self.tokens.next().unwrap();
                             let prop_node = Shared::new(Node {
-                                token_id: self.token_arena.alloc(Shared::clone(next)),
+                                token_id: self.token_arena.alloc(next.clone()),
                                 expr: Shared::new(Expr::Selector(Selector::Property(Ident::new(key.as_str())))),
                             });
                             return Ok(Shared::new(Node {
-                                token_id: self.token_arena.alloc(Shared::clone(token)),
+                                token_id: self.token_arena.alloc(token.clone()),
                                 expr: Shared::new(Expr::Block(vec![recursive_node, prop_node])),
                             }));
                         }
@@ -2642,12 +2608,12 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                             {
                                 let next = self.tokens.next().unwrap();
                                 let sel_node = Shared::new(Node {
-                                    token_id: self.token_arena.alloc(Shared::clone(next)),
+                                    token_id: self.token_arena.alloc(next.clone()),
                                     expr: Shared::new(Expr::Selector(selector)),
                                 });
 
                                 return Ok(Shared::new(Node {
-                                    token_id: self.token_arena.alloc(Shared::clone(token)),
+                                    token_id: self.token_arena.alloc(token.clone()),
                                     expr: Shared::new(Expr::Block(vec![recursive_node, sel_node])),
                                 }));
                             }
@@ -2657,19 +2623,19 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 }
                 Ok(recursive_node)
             }
-            _ => Err(SyntaxError::InsufficientTokens((**token).clone())),
+            _ => Err(SyntaxError::InsufficientTokens(token.clone())),
         }
     }
 
-    fn parse_selector(&mut self, token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_selector(&mut self, token: &Token) -> Result<Shared<Node>, SyntaxError> {
         // Handle chained property access: .a.b.c → Block([Selector(Property("a")), ...])
         if let TokenKind::Selector(_) = &token.kind
-            && matches!(Selector::try_from(&**token), Ok(Selector::Property(_)))
+            && matches!(Selector::try_from(token), Ok(Selector::Property(_)))
         {
             let next_is_property = self
                 .tokens
                 .peek()
-                .is_some_and(|t| matches!(Selector::try_from(&***t), Ok(Selector::Property(_))));
+                .is_some_and(|t| matches!(Selector::try_from(&**t), Ok(Selector::Property(_))));
             if next_is_property {
                 return self.parse_chained_property_selectors(token);
             }
@@ -2678,7 +2644,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         if self.is_next_token(|kind| matches!(kind, TokenKind::Selector(_)))
             && let Some(attr_token) = self.tokens.next()
         {
-            return self.parse_selector_with_attribute(token, Shared::clone(attr_token));
+            return self.parse_selector_with_attribute(token, attr_token.clone());
         }
 
         // Check for selector call: `.h(...)`, `.code(...)`
@@ -2686,18 +2652,18 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             && let TokenKind::Selector(s) = &token.kind
             && s != "."
         {
-            let selector = Selector::try_from(&**token).map_err(SyntaxError::UnknownSelector)?;
+            let selector = Selector::try_from(token).map_err(SyntaxError::UnknownSelector)?;
             if !selector.is_attribute_selector() {
                 let args = self.parse_args()?;
                 let base_node = Shared::new(Node {
-                    token_id: self.token_arena.alloc(Shared::clone(token)),
+                    token_id: self.token_arena.alloc(token.clone()),
                     expr: Shared::new(Expr::SelectorCall(selector, args)),
                 });
                 // Check for attribute access on SelectorCall: `.h(1).level`
                 if self.is_next_token(|kind| matches!(kind, TokenKind::Selector(_)))
                     && let Some(attr_token) = self.tokens.next()
                 {
-                    return self.build_attr_call_for_node(base_node, Shared::clone(attr_token), token);
+                    return self.build_attr_call_for_node(base_node, attr_token.clone(), token);
                 }
                 return Ok(base_node);
             }
@@ -2706,10 +2672,10 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         self.parse_selector_direct(token)
     }
 
-    fn parse_chained_property_selectors(&mut self, first_token: &Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
-        let first_sel = Selector::try_from(&**first_token).map_err(SyntaxError::UnknownSelector)?;
+    fn parse_chained_property_selectors(&mut self, first_token: &Token) -> Result<Shared<Node>, SyntaxError> {
+        let first_sel = Selector::try_from(first_token).map_err(SyntaxError::UnknownSelector)?;
         let mut nodes: Program = vec![Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(first_token)),
+            token_id: self.token_arena.alloc(first_token.clone()),
             expr: Shared::new(Expr::Selector(first_sel)),
         })];
 
@@ -2717,14 +2683,14 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             let next_is_property = self
                 .tokens
                 .peek()
-                .is_some_and(|t| matches!(Selector::try_from(&***t), Ok(Selector::Property(_))));
+                .is_some_and(|t| matches!(Selector::try_from(&**t), Ok(Selector::Property(_))));
             if !next_is_property {
                 break;
             }
             let next_token = self.tokens.next().unwrap();
-            let sel = Selector::try_from(&**next_token).map_err(SyntaxError::UnknownSelector)?;
+            let sel = Selector::try_from(next_token).map_err(SyntaxError::UnknownSelector)?;
             nodes.push(Shared::new(Node {
-                token_id: self.token_arena.alloc(Shared::clone(next_token)),
+                token_id: self.token_arena.alloc(next_token.clone()),
                 expr: Shared::new(Expr::Selector(sel)),
             }));
         }
@@ -2735,16 +2701,12 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }
 
         Ok(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(first_token)),
+            token_id: self.token_arena.alloc(first_token.clone()),
             expr: Shared::new(Expr::Block(nodes)),
         }))
     }
 
-    fn parse_property_iterator(
-        &mut self,
-        token: &Shared<Token>,
-        mut nodes: Program,
-    ) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_property_iterator(&mut self, token: &Token, mut nodes: Program) -> Result<Shared<Node>, SyntaxError> {
         let index = self.parse_bracket_expr()?;
 
         let list_selector = match &index {
@@ -2754,7 +2716,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                     Selector::List(Some(num.value() as usize), None)
                 } else {
                     // Dynamic index expression: emit a SelectorCall so the index is evaluated at runtime
-                    let token_id = self.token_arena.alloc(Shared::clone(token));
+                    let token_id = self.token_arena.alloc(token.clone());
                     nodes.push(Shared::new(Node {
                         token_id,
                         expr: Shared::new(Expr::SelectorCall(
@@ -2763,7 +2725,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                         )),
                     }));
                     return Ok(Shared::new(Node {
-                        token_id: self.token_arena.alloc(Shared::clone(token)),
+                        token_id: self.token_arena.alloc(token.clone()),
                         expr: Shared::new(Expr::Block(nodes)),
                     }));
                 }
@@ -2771,18 +2733,18 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         };
 
         nodes.push(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(token)),
+            token_id: self.token_arena.alloc(token.clone()),
             expr: Shared::new(Expr::Selector(list_selector)),
         }));
 
         Ok(Shared::new(Node {
-            token_id: self.token_arena.alloc(Shared::clone(token)),
+            token_id: self.token_arena.alloc(token.clone()),
             expr: Shared::new(Expr::Block(nodes)),
         }))
     }
 
     // Parses arguments for table or list item selectors like `.[index1][index2]` (for tables) or `.[index1]` (for lists).
-    fn parse_selector_table_args(&mut self, token: Shared<Token>) -> Result<Shared<Node>, SyntaxError> {
+    fn parse_selector_table_args(&mut self, token: Token) -> Result<Shared<Node>, SyntaxError> {
         let first = self.parse_bracket_expr()?;
         let has_second = self.is_next_token(|kind| matches!(kind, TokenKind::LBracket));
         let second = if has_second {
@@ -2810,7 +2772,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
             // .[][v]: insert None as row placeholder so args[0]=row, args[1]=col positional encoding holds.
             if is_table && first.is_none() && second.as_ref().is_some_and(|s| s.is_some()) {
-                let placeholder_token_id = self.token_arena.alloc(Shared::clone(&token));
+                let placeholder_token_id = self.token_arena.alloc(token.clone());
                 args.push(Shared::new(Node {
                     token_id: placeholder_token_id,
                     expr: Shared::new(Expr::Literal(Literal::None)),
@@ -2826,7 +2788,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
                 args.extend(self.parse_args()?);
             }
 
-            let token_id = self.token_arena.alloc(Shared::clone(&token));
+            let token_id = self.token_arena.alloc(token.clone());
             return Ok(Shared::new(Node {
                 token_id,
                 expr: Shared::new(Expr::SelectorCall(selector, args)),
@@ -2848,7 +2810,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             Some(opt) => Selector::Table(i1, static_index(opt)),
         };
 
-        let token_id = self.token_arena.alloc(Shared::clone(&token));
+        let token_id = self.token_arena.alloc(token.clone());
         Ok(Shared::new(Node {
             token_id,
             expr: Shared::new(Expr::Selector(selector)),
@@ -2857,7 +2819,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
 
     fn parse_bracket_expr(&mut self) -> Result<Option<Shared<Node>>, SyntaxError> {
         let bracket_token = match self.tokens.peek() {
-            Some(t) => Shared::clone(t),
+            Some(t) => (*t).clone(),
             None => return Err(SyntaxError::UnexpectedEOFDetected(self.module_id)),
         };
         self.next_token(|kind| matches!(kind, TokenKind::LBracket))?;
@@ -2868,8 +2830,8 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
         }
 
         let expr_token = match self.tokens.next() {
-            Some(t) => Shared::clone(t),
-            None => return Err(SyntaxError::InsufficientTokens((*bracket_token).clone())),
+            Some(t) => (*t).clone(),
+            None => return Err(SyntaxError::InsufficientTokens(bracket_token.clone())),
         };
         let node = self.parse_expr(&expr_token)?;
         self.next_token(|kind| matches!(kind, TokenKind::RBracket))?;
@@ -2881,7 +2843,7 @@ impl<'a, 'alloc> Parser<'a, 'alloc> {
             // Token found and matches one of the expected kinds.
             Some(token) if expected_kinds(&token.kind) => {
                 let token = self.tokens.next().unwrap();
-                Ok(self.token_arena.alloc(Shared::clone(token)))
+                Ok(self.token_arena.alloc(token.clone()))
             } // Consume and return.
             // Token found but does not match expected kinds.
             Some(token) => Err(SyntaxError::UnexpectedToken(Token {
@@ -2954,12 +2916,12 @@ mod tests {
             Shared::new(Node {
                 token_id: 4.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token("and", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("and")))))),
+                    IdentWithToken::new_with_token("and", Some(token(TokenKind::Ident(SmolStr::new("and"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token("contains", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("contains")))))),
+                                IdentWithToken::new_with_token("contains", Some(token(TokenKind::Ident(SmolStr::new("contains"))))),
                                 smallvec![Shared::new(Node {
                                     token_id: 0.into(),
                                     expr: Shared::new(Expr::Literal(Literal::String("test".to_owned())))
@@ -2969,7 +2931,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token("startswith", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("startswith")))))),
+                                IdentWithToken::new_with_token("startswith", Some(token(TokenKind::Ident(SmolStr::new("startswith"))))),
                                 smallvec![Shared::new(Node {
                                     token_id: 2.into(),
                                     expr: Shared::new(Expr::Literal(Literal::String("test2".to_owned())))
@@ -2999,7 +2961,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 8.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token("and", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("and")))))),
+                    IdentWithToken::new_with_token("and", Some(token(TokenKind::Ident(SmolStr::new("and"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
@@ -3034,15 +2996,15 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                    IdentWithToken::new_with_token("filter", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("filter")))))),
+                    IdentWithToken::new_with_token("filter", Some(token(TokenKind::Ident(SmolStr::new("filter"))))),
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("arg1", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arg1"))))))),
-                        Param::new(IdentWithToken::new_with_token("arg2", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arg2"))))))),
+                        Param::new(IdentWithToken::new_with_token("arg1", Some(token(TokenKind::Ident(SmolStr::new("arg1")))))),
+                        Param::new(IdentWithToken::new_with_token("arg2", Some(token(TokenKind::Ident(SmolStr::new("arg2")))))),
                     ],
                     vec![Shared::new(Node {
                         token_id: 4.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token("contains", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("contains")))))),
+                            IdentWithToken::new_with_token("contains", Some(token(TokenKind::Ident(SmolStr::new("contains"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 2.into(),
@@ -3072,7 +3034,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 2.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token("and", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("and")))))),
+                    IdentWithToken::new_with_token("and", Some(token(TokenKind::Ident(SmolStr::new("and"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
@@ -3124,11 +3086,11 @@ mod tests {
             Shared::new(Node {
                 token_id: 2.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))),
+                    IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Ident(SmolStr::new("c"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 1.into(),
@@ -3160,7 +3122,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("name", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("name")))))),
+                        IdentWithToken::new_with_token("name", Some(token(TokenKind::Ident(SmolStr::new("name"))))),
                         SmallVec::new(),
                         vec![Shared::new(Node {
                             token_id: 2.into(),
@@ -3183,7 +3145,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("name", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("name")))))),
+                        IdentWithToken::new_with_token("name", Some(token(TokenKind::Ident(SmolStr::new("name"))))),
                         SmallVec::new(),
                         vec![Shared::new(Node {
                             token_id: 2.into(),
@@ -3275,7 +3237,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("name", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("name")))))),
+                        IdentWithToken::new_with_token("name", Some(token(TokenKind::Ident(SmolStr::new("name"))))),
                         SmallVec::new(),
                         vec![Shared::new(Node {
                             token_id: 1.into(),
@@ -3297,7 +3259,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("name", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("name")))))),
+                        IdentWithToken::new_with_token("name", Some(token(TokenKind::Ident(SmolStr::new("name"))))),
                         SmallVec::new(),
                         vec![Shared::new(Node {
                             token_id: 1.into(),
@@ -3320,14 +3282,14 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("name", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("name")))))),
+                        IdentWithToken::new_with_token("name", Some(token(TokenKind::Ident(SmolStr::new("name"))))),
                         smallvec![
-                          Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
+                          Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
                         ],
                         vec![Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Ident(
-                                IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))),
+                                IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))),
                             )),
                         })],
                 )),
@@ -3385,7 +3347,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Let(
-                        Pattern::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::Number(42.into()))),
@@ -3405,7 +3367,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Let(
-                        Pattern::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y"))))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y")))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::String("hello".to_owned()))),
@@ -3425,7 +3387,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Let(
-                        Pattern::Ident(IdentWithToken::new_with_token("flag", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("flag"))))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("flag", Some(token(TokenKind::Ident(SmolStr::new("flag")))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::Bool(true))),
@@ -3445,12 +3407,12 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Let(
-                        Pattern::Ident(IdentWithToken::new_with_token("z", Some(Shared::new(token(TokenKind::Ident("z".into())))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("z", Some(token(TokenKind::Ident("z".into()))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(
                                 Expr::Ident(IdentWithToken::new_with_token("some_var",
-                                                 Some(Shared::new(token(TokenKind::Ident(SmolStr::new("some_var"))))))))
+                                                 Some(token(TokenKind::Ident(SmolStr::new("some_var")))))))
                         }),
                     )),
                 })
@@ -3467,11 +3429,11 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Let(
-                        Pattern::Ident(IdentWithToken::new_with_token("z", Some(Shared::new(token(TokenKind::Ident("z".into())))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("z", Some(token(TokenKind::Ident("z".into()))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(
-                                Expr::Ident(IdentWithToken::new_with_token("some_var", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("some_var")))))))),
+                                Expr::Ident(IdentWithToken::new_with_token("some_var", Some(token(TokenKind::Ident(SmolStr::new("some_var"))))))),
                         }),
                     )),
                 })
@@ -3487,11 +3449,11 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Let(
-                        Pattern::Ident(IdentWithToken::new_with_token("z", Some(Shared::new(token(TokenKind::Ident("z".into())))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("z", Some(token(TokenKind::Ident("z".into()))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(
-                                Expr::Ident(IdentWithToken::new_with_token("some_var", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("some_var")))))))),
+                                Expr::Ident(IdentWithToken::new_with_token("some_var", Some(token(TokenKind::Ident(SmolStr::new("some_var"))))))),
                         }),
                     )),
                 })
@@ -3508,7 +3470,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Var(
-                        Pattern::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::Number(42.into()))),
@@ -3528,7 +3490,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 0.into(),
                     expr: Shared::new(Expr::Var(
-                        Pattern::Ident(IdentWithToken::new_with_token("count", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("count"))))))),
+                        Pattern::Ident(IdentWithToken::new_with_token("count", Some(token(TokenKind::Ident(SmolStr::new("count")))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::Number(0.into()))),
@@ -3547,7 +3509,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Assign(
-                        IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))),
+                        IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::Number(100.into()))),
@@ -3566,7 +3528,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Assign(
-                        IdentWithToken::new_with_token("name", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("name")))))),
+                        IdentWithToken::new_with_token("name", Some(token(TokenKind::Ident(SmolStr::new("name"))))),
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Literal(Literal::String("Alice".to_owned()))),
@@ -3588,15 +3550,15 @@ mod tests {
                 Shared::new(Node {
                     token_id: 3.into(),
                     expr: Shared::new(Expr::Assign(
-                        IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                        IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::SET, Some(Shared::new(token(TokenKind::Equal)))),
+                                IdentWithToken::new_with_token(constants::builtins::SET, Some(token(TokenKind::Equal))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 1.into(),
@@ -3626,15 +3588,15 @@ mod tests {
                 Shared::new(Node {
                     token_id: 3.into(),
                     expr: Shared::new(Expr::Assign(
-                        IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                        IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::SET, Some(Shared::new(token(TokenKind::PlusEqual)))),
+                                IdentWithToken::new_with_token(constants::builtins::SET, Some(token(TokenKind::PlusEqual))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 1.into(),
@@ -3643,16 +3605,16 @@ mod tests {
                                     Shared::new(Node {
                                         token_id: 3.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::PlusEqual)))),
+                                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::PlusEqual))),
                                             smallvec![
                                                 Shared::new(Node {
                                                     token_id: 2.into(),
                                                     expr: Shared::new(Expr::Call(
-                                                        IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                                                        IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                                                         smallvec![
                                                             Shared::new(Node {
                                                                 token_id: 0.into(),
-                                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                                             }),
                                                             Shared::new(Node {
                                                                 token_id: 1.into(),
@@ -3689,15 +3651,15 @@ mod tests {
                 Shared::new(Node {
                     token_id: 3.into(),
                     expr: Shared::new(Expr::Assign(
-                        IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                        IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::SET, Some(Shared::new(token(TokenKind::DoubleSlashEqual)))),
+                                IdentWithToken::new_with_token(constants::builtins::SET, Some(token(TokenKind::DoubleSlashEqual))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 1.into(),
@@ -3706,20 +3668,20 @@ mod tests {
                                     Shared::new(Node {
                                         token_id: 3.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token(constants::builtins::FLOOR, Some(Shared::new(token(TokenKind::DoubleSlashEqual)))),
+                                            IdentWithToken::new_with_token(constants::builtins::FLOOR, Some(token(TokenKind::DoubleSlashEqual))),
                                             smallvec![Shared::new(Node {
                                                 token_id: 3.into(),
                                                 expr: Shared::new(Expr::Call(
-                                                    IdentWithToken::new_with_token(constants::builtins::DIV, Some(Shared::new(token(TokenKind::DoubleSlashEqual)))),
+                                                    IdentWithToken::new_with_token(constants::builtins::DIV, Some(token(TokenKind::DoubleSlashEqual))),
                                                     smallvec![
                                                         Shared::new(Node {
                                                             token_id: 2.into(),
                                                             expr: Shared::new(Expr::Call(
-                                                                IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                                                                IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                                                                 smallvec![
                                                                     Shared::new(Node {
                                                                         token_id: 0.into(),
-                                                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                                                     }),
                                                                     Shared::new(Node {
                                                                         token_id: 1.into(),
@@ -4090,7 +4052,7 @@ mod tests {
             expr: Shared::new(Expr::Try(
                 Shared::new(Node {
                     token_id: 2.into(),
-                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("error_expr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("error_expr")))))))),
+                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("error_expr", Some(token(TokenKind::Ident(SmolStr::new("error_expr"))))))),
                 }),
                 None,
                 Shared::new(Node {
@@ -4117,12 +4079,12 @@ mod tests {
             expr: Shared::new(Expr::Try(
                 Shared::new(Node {
                     token_id: 2.into(),
-                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("error_expr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("error_expr")))))))),
+                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("error_expr", Some(token(TokenKind::Ident(SmolStr::new("error_expr"))))))),
                 }),
-                Some(IdentWithToken::new_with_token("e", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("e"))))))),
+                Some(IdentWithToken::new_with_token("e", Some(token(TokenKind::Ident(SmolStr::new("e")))))),
                 Shared::new(Node {
                     token_id: 6.into(),
-                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("e", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("e")))))))),
+                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("e", Some(token(TokenKind::Ident(SmolStr::new("e"))))))),
                 }),
             )),
         })]))]
@@ -4146,7 +4108,7 @@ mod tests {
             expr: Shared::new(Expr::Foreach(
                 IdentWithToken::new_with_token(
                     "item",
-                    Some(Shared::new(token(TokenKind::Ident(SmolStr::new("item"))))),
+                    Some(token(TokenKind::Ident(SmolStr::new("item")))),
                 ),
                 Shared::new(Node {
                     token_id: 1.into(),
@@ -4157,15 +4119,15 @@ mod tests {
                     expr: Shared::new(Expr::Call(
                         IdentWithToken::new_with_token(
                             "print",
-                            Some(Shared::new(token(TokenKind::Ident(SmolStr::new(
+                            Some(token(TokenKind::Ident(SmolStr::new(
                                 "print",
-                            ))))),
+                            )))),
                         ),
                         smallvec![Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                                 "item",
-                                Some(Shared::new(token(TokenKind::Ident(SmolStr::new("item"))))),
+                                Some(token(TokenKind::Ident(SmolStr::new("item")))),
                             ))),
                         })],
                     )),
@@ -4205,7 +4167,7 @@ mod tests {
             expr: Shared::new(Expr::Foreach(
                 IdentWithToken::new_with_token(
                     "item",
-                    Some(Shared::new(token(TokenKind::Ident(SmolStr::new("item"))))),
+                    Some(token(TokenKind::Ident(SmolStr::new("item")))),
                 ),
                 Shared::new(Node {
                     token_id: 1.into(),
@@ -4216,15 +4178,15 @@ mod tests {
                     expr: Shared::new(Expr::Call(
                         IdentWithToken::new_with_token(
                             "print",
-                            Some(Shared::new(token(TokenKind::Ident(SmolStr::new(
+                            Some(token(TokenKind::Ident(SmolStr::new(
                                 "print",
-                            ))))),
+                            )))),
                         ),
                         smallvec![Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                                 "item",
-                                Some(Shared::new(token(TokenKind::Ident(SmolStr::new("item"))))),
+                                Some(token(TokenKind::Ident(SmolStr::new("item")))),
                             ))),
                         })],
                     )),
@@ -4336,7 +4298,7 @@ mod tests {
             expr: Shared::new(Expr::Call(
                 IdentWithToken::new_with_token(
                     constants::builtins::ATTR,
-                    Some(Shared::new(token(TokenKind::Selector(SmolStr::new(".h"))))),
+                    Some(token(TokenKind::Selector(SmolStr::new(".h")))),
                 ),
                 smallvec![
                     Shared::new(Node {
@@ -4371,7 +4333,7 @@ mod tests {
             expr: Shared::new(Expr::Call(
                 IdentWithToken::new_with_token(
                     constants::builtins::ATTR,
-                    Some(Shared::new(token(TokenKind::Selector(SmolStr::new(".code"))))),
+                    Some(token(TokenKind::Selector(SmolStr::new(".code")))),
                 ),
                 smallvec![
                     Shared::new(Node {
@@ -4464,7 +4426,7 @@ mod tests {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                         "v",
-                        Some(Shared::new(token(TokenKind::Ident(SmolStr::new("v"))))),
+                        Some(token(TokenKind::Ident(SmolStr::new("v")))),
                     ))),
                 })],
             )),
@@ -4492,7 +4454,7 @@ mod tests {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                             "v",
-                            Some(Shared::new(token(TokenKind::Ident(SmolStr::new("v"))))),
+                            Some(token(TokenKind::Ident(SmolStr::new("v")))),
                         ))),
                     }),
                 ],
@@ -4516,7 +4478,7 @@ mod tests {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(
                         "v",
-                        Some(Shared::new(token(TokenKind::Ident(SmolStr::new("v"))))),
+                        Some(token(TokenKind::Ident(SmolStr::new("v")))),
                     ))),
                 })],
             )),
@@ -4722,22 +4684,22 @@ mod tests {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Fn(
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
-                        Param::new(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y"))))))),
+                        Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
+                        Param::new(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y")))))),
                     ],
                     vec![
                         Shared::new(Node {
                             token_id: 4.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token("contains", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("contains")))))),
+                                IdentWithToken::new_with_token("contains", Some(token(TokenKind::Ident(SmolStr::new("contains"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 3.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                                     }),
                                 ],
                             )),
@@ -4763,7 +4725,7 @@ mod tests {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Fn(
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
+                        Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
                     ],
                     vec![
                         Shared::new(Node {
@@ -4816,13 +4778,13 @@ mod tests {
             Shared::new(Node {
                 token_id: 4.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token("apply", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("apply")))))),
+                    IdentWithToken::new_with_token("apply", Some(token(TokenKind::Ident(SmolStr::new("apply"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::Fn(
                                 smallvec![
-                                  Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
+                                  Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
                                 ],
                                 vec![
                                     Shared::new(Node {
@@ -4846,7 +4808,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                             SmallVec::new(),
                         )),
                     })
@@ -4864,7 +4826,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -4893,7 +4855,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -4928,12 +4890,12 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
                                     expr: Shared::new(Expr::Call(
-                                        IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                                        IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                                         smallvec![
                                             Shared::new(Node {
                                                 token_id: 2.into(),
@@ -4945,7 +4907,7 @@ mod tests {
                                 Shared::new(Node {
                                     token_id: 3.into(),
                                     expr: Shared::new(Expr::Call(
-                                        IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                                        IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                                         smallvec![
                                             Shared::new(Node {
                                                 token_id: 4.into(),
@@ -4970,7 +4932,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                            IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -5017,15 +4979,15 @@ mod tests {
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 1.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("bar", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("bar")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("bar", Some(token(TokenKind::Ident(SmolStr::new("bar"))))))),
                                     }),
                                 ],
                             )),
@@ -5042,7 +5004,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5067,7 +5029,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5092,7 +5054,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5117,15 +5079,15 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                                     }),
                                 ],
                             )),
@@ -5145,12 +5107,12 @@ mod tests {
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 1.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                                            IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                                             smallvec![
                                                 Shared::new(Node {
                                                     token_id: 0.into(),
@@ -5178,7 +5140,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5203,7 +5165,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5244,11 +5206,11 @@ mod tests {
                                     Some(Shared::new(Node {
                                         token_id: 2.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                                            IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                                             smallvec![
                                                 Shared::new(Node {
                                                     token_id: 1.into(),
-                                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                                 }),
                                                 Shared::new(Node {
                                                     token_id: 3.into(),
@@ -5276,7 +5238,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5301,7 +5263,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5326,7 +5288,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5351,15 +5313,15 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                                     }),
                                 ],
                             )),
@@ -5379,12 +5341,12 @@ mod tests {
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 1.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                                            IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                                             smallvec![
                                                 Shared::new(Node {
                                                     token_id: 0.into(),
@@ -5412,7 +5374,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5437,7 +5399,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5478,11 +5440,11 @@ mod tests {
                                     Some(Shared::new(Node {
                                         token_id: 2.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token(constants::builtins::NE, Some(Shared::new(token(TokenKind::NeEq)))),
+                                            IdentWithToken::new_with_token(constants::builtins::NE, Some(token(TokenKind::NeEq))),
                                             smallvec![
                                                 Shared::new(Node {
                                                     token_id: 1.into(),
-                                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                                 }),
                                                 Shared::new(Node {
                                                     token_id: 3.into(),
@@ -5510,7 +5472,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                                IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5535,15 +5497,15 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                                IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                                     }),
                                 ],
                             )),
@@ -5567,7 +5529,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::LT, Some(Shared::new(token(TokenKind::Lt)))),
+                                IdentWithToken::new_with_token(constants::builtins::LT, Some(token(TokenKind::Lt))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5592,7 +5554,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::LTE, Some(Shared::new(token(TokenKind::Lte)))),
+                                IdentWithToken::new_with_token(constants::builtins::LTE, Some(token(TokenKind::Lte))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5617,7 +5579,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::GT, Some(Shared::new(token(TokenKind::Gt)))),
+                                IdentWithToken::new_with_token(constants::builtins::GT, Some(token(TokenKind::Gt))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5642,7 +5604,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::GTE, Some(Shared::new(token(TokenKind::Gte)))),
+                                IdentWithToken::new_with_token(constants::builtins::GTE, Some(token(TokenKind::Gte))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -5666,7 +5628,7 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 0.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(Shared::new(token(TokenKind::LBrace)))),
+                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(token(TokenKind::LBrace))),
                                     SmallVec::new(),
                                 )),
                             })
@@ -5684,12 +5646,12 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 0.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(Shared::new(token(TokenKind::LBrace)))),
+                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(token(TokenKind::LBrace))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
                                             expr: Shared::new(Expr::Call(
-                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("key")))))),
+                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::Ident(SmolStr::new("key"))))),
                                                 smallvec![
                                                     Shared::new(Node {
                                                         token_id: 1.into(),
@@ -5723,12 +5685,12 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 0.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(Shared::new(token(TokenKind::LBrace)))),
+                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(token(TokenKind::LBrace))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
                                             expr: Shared::new(Expr::Call(
-                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))),
+                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::Ident(SmolStr::new("a"))))),
                                                 smallvec![
                                                     Shared::new(Node {
                                                         token_id: 1.into(),
@@ -5744,7 +5706,7 @@ mod tests {
                                         Shared::new(Node {
                                             token_id: 0.into(),
                                             expr: Shared::new(Expr::Call(
-                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::StringLiteral("b".to_owned()))))),
+                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::StringLiteral("b".to_owned())))),
                                                 smallvec![
                                                     Shared::new(Node {
                                                         token_id: 3.into(),
@@ -5775,12 +5737,12 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 0.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(Shared::new(token(TokenKind::LBrace)))),
+                                    IdentWithToken::new_with_token(constants::builtins::DICT, Some(token(TokenKind::LBrace))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
                                             expr: Shared::new(Expr::Call(
-                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))),
+                                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::Ident(SmolStr::new("x"))))),
                                                 smallvec![
                                                     Shared::new(Node {
                                                         token_id: 1.into(),
@@ -5833,7 +5795,7 @@ mod tests {
         Ok(vec![
             Shared::new(Node {
                 token_id: 2.into(),
-                expr: Shared::new(Expr::Call(IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Selector(".h".into()))))),
+                expr: Shared::new(Expr::Call(IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Selector(".h".into())))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
@@ -5854,7 +5816,7 @@ mod tests {
         Ok(vec![
             Shared::new(Node {
                 token_id: 2.into(),
-                expr: Shared::new(Expr::Call(IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Selector(".list".into()))))),
+                expr: Shared::new(Expr::Call(IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Selector(".list".into())))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
@@ -5882,7 +5844,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -5909,7 +5871,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 1.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::SUB, Some(Shared::new(token(TokenKind::Minus)))),
+                    IdentWithToken::new_with_token(constants::builtins::SUB, Some(token(TokenKind::Minus))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
@@ -5934,15 +5896,15 @@ mod tests {
             Shared::new(Node {
                 token_id: 1.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::SUB, Some(Shared::new(token(TokenKind::Minus)))),
+                    IdentWithToken::new_with_token(constants::builtins::SUB, Some(token(TokenKind::Minus))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                         }),
                     ],
                 )),
@@ -5959,7 +5921,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 1.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::DIV, Some(Shared::new(token(TokenKind::Slash)))),
+                    IdentWithToken::new_with_token(constants::builtins::DIV, Some(token(TokenKind::Slash))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
@@ -5984,7 +5946,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::MOD, Some(Shared::new(token(TokenKind::Percent)))),
+                        IdentWithToken::new_with_token(constants::builtins::MOD, Some(token(TokenKind::Percent))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
@@ -6009,15 +5971,15 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::MOD, Some(Shared::new(token(TokenKind::Percent)))),
+                        IdentWithToken::new_with_token(constants::builtins::MOD, Some(token(TokenKind::Percent))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                             }),
                             Shared::new(Node {
                                 token_id: 2.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                             }),
                         ],
                     )),
@@ -6041,7 +6003,7 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::MUL, Some(Shared::new(token(TokenKind::Asterisk)))),
+                        IdentWithToken::new_with_token(constants::builtins::MUL, Some(token(TokenKind::Asterisk))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
@@ -6066,15 +6028,15 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::MUL, Some(Shared::new(token(TokenKind::Asterisk)))),
+                        IdentWithToken::new_with_token(constants::builtins::MUL, Some(token(TokenKind::Asterisk))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                             }),
                             Shared::new(Node {
                                 token_id: 2.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                             }),
                         ],
                     )),
@@ -6098,15 +6060,15 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::CONVERT, Some(Shared::new(token(TokenKind::Convert)))),
+                        IdentWithToken::new_with_token(constants::builtins::CONVERT, Some(token(TokenKind::Convert))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                             }),
                             Shared::new(Node {
                                 token_id: 2.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                             }),
                         ],
                     )),
@@ -6132,12 +6094,12 @@ mod tests {
                 Shared::new(Node {
                     token_id: 3.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::MUL, Some(Shared::new(token(TokenKind::Asterisk)))),
+                        IdentWithToken::new_with_token(constants::builtins::MUL, Some(token(TokenKind::Asterisk))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 1.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::MUL, Some(Shared::new(token(TokenKind::Asterisk)))),
+                                    IdentWithToken::new_with_token(constants::builtins::MUL, Some(token(TokenKind::Asterisk))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
@@ -6171,12 +6133,12 @@ mod tests {
                 Shared::new(Node {
                     token_id: 3.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::EQ, Some(Shared::new(token(TokenKind::EqEq)))),
+                        IdentWithToken::new_with_token(constants::builtins::EQ, Some(token(TokenKind::EqEq))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 1.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                                    IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
@@ -6212,15 +6174,15 @@ mod tests {
                     expr: Shared::new(Expr::And(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 4.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                         }),
                     ])),
                 })
@@ -6240,15 +6202,15 @@ mod tests {
                     expr: Shared::new(Expr::Or(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 4.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("z", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("z")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("z", Some(token(TokenKind::Ident(SmolStr::new("z"))))))),
                         }),
                     ])),
                 })
@@ -6271,17 +6233,17 @@ mod tests {
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                                 }),
                             ])),
                         }),
                         Shared::new(Node {
                             token_id: 4.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                         }),
                     ])),
                 })
@@ -6303,19 +6265,19 @@ mod tests {
                     expr: Shared::new(Expr::And(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 4.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 6.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("d")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(token(TokenKind::Ident(SmolStr::new("d"))))))),
                         }),
                     ])),
                 })
@@ -6337,19 +6299,19 @@ mod tests {
                     expr: Shared::new(Expr::Or(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 4.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 6.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("d")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(token(TokenKind::Ident(SmolStr::new("d"))))))),
                         }),
                     ])),
                 })
@@ -6371,24 +6333,24 @@ mod tests {
                     expr: Shared::new(Expr::Or(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 4.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                                 }),
                             ])),
                         }),
                         Shared::new(Node {
                             token_id: 6.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("d")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(token(TokenKind::Ident(SmolStr::new("d"))))))),
                         }),
                     ])),
                 })
@@ -6414,11 +6376,11 @@ mod tests {
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                                 }),
                             ])),
                         }),
@@ -6427,11 +6389,11 @@ mod tests {
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 4.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 6.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("d")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(token(TokenKind::Ident(SmolStr::new("d"))))))),
                                 }),
                             ])),
                         }),
@@ -6456,24 +6418,24 @@ mod tests {
                     expr: Shared::new(Expr::Or(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 4.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                                 }),
                             ])),
                         }),
                         Shared::new(Node {
                             token_id: 6.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("d")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(token(TokenKind::Ident(SmolStr::new("d"))))))),
                         }),
                     ])),
                 })
@@ -6503,15 +6465,15 @@ mod tests {
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 4.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("c")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("c", Some(token(TokenKind::Ident(SmolStr::new("c"))))))),
                                 }),
                             ])),
                         }),
@@ -6520,15 +6482,15 @@ mod tests {
                             expr: Shared::new(Expr::And(vec![
                                 Shared::new(Node {
                                     token_id: 6.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("d")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("d", Some(token(TokenKind::Ident(SmolStr::new("d"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 8.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("e", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("e")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("e", Some(token(TokenKind::Ident(SmolStr::new("e"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 10.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("f", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("f")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("f", Some(token(TokenKind::Ident(SmolStr::new("f"))))))),
                                 }),
                             ])),
                         }),
@@ -6546,7 +6508,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 1.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::RANGE, Some(Shared::new(token(TokenKind::DoubleDot)))),
+                            IdentWithToken::new_with_token(constants::builtins::RANGE, Some(token(TokenKind::DoubleDot))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
@@ -6571,15 +6533,15 @@ mod tests {
                     Shared::new(Node {
                         token_id: 1.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::RANGE, Some(Shared::new(token(TokenKind::DoubleDot)))),
+                            IdentWithToken::new_with_token(constants::builtins::RANGE, Some(token(TokenKind::DoubleDot))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("start", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("start")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("start", Some(token(TokenKind::Ident(SmolStr::new("start"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("end", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("end")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("end", Some(token(TokenKind::Ident(SmolStr::new("end"))))))),
                                 }),
                             ],
                         )),
@@ -6661,7 +6623,7 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 1.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::GT, Some(Shared::new(token(TokenKind::Gt)))),
+                                    IdentWithToken::new_with_token(constants::builtins::GT, Some(token(TokenKind::Gt))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
@@ -6677,7 +6639,7 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 5.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::GT, Some(Shared::new(token(TokenKind::Gt)))),
+                                    IdentWithToken::new_with_token(constants::builtins::GT, Some(token(TokenKind::Gt))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 4.into(),
@@ -6703,7 +6665,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::NOT, Some(Shared::new(token(TokenKind::Not)))),
+                            IdentWithToken::new_with_token(constants::builtins::NOT, Some(token(TokenKind::Not))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -6723,11 +6685,11 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::NOT, Some(Shared::new(token(TokenKind::Not)))),
+                            IdentWithToken::new_with_token(constants::builtins::NOT, Some(token(TokenKind::Not))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                 }),
                             ],
                         )),
@@ -6745,11 +6707,11 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -6771,11 +6733,11 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("dict")))))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("dict"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(constants::builtins::DICT, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("dict")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token(constants::builtins::DICT, Some(token(TokenKind::Ident(SmolStr::new("dict"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -6810,11 +6772,11 @@ mod tests {
                     Shared::new(Node {
                         token_id: 5.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -6842,19 +6804,19 @@ mod tests {
                     Shared::new(Node {
                         token_id: 5.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("items")))))),
+                            IdentWithToken::new_with_token(constants::builtins::SLICE, Some(token(TokenKind::Ident(SmolStr::new("items"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("items", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("items")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("items", Some(token(TokenKind::Ident(SmolStr::new("items"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 1.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("start", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("start")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("start", Some(token(TokenKind::Ident(SmolStr::new("start"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("end", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("end")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("end", Some(token(TokenKind::Ident(SmolStr::new("end"))))))),
                                 }),
                             ],
                         )),
@@ -6872,7 +6834,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 0.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::NOT, Some(Shared::new(token(TokenKind::Not)))),
+                            IdentWithToken::new_with_token(constants::builtins::NOT, Some(token(TokenKind::Not))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -6927,7 +6889,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Self_)))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Self_))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
@@ -6953,7 +6915,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Self_)))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Self_))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
@@ -6982,12 +6944,12 @@ mod tests {
             Shared::new(Node {
                 token_id: 2.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                                IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                                 SmallVec::new(),
                             )),
                         }),
@@ -7015,12 +6977,12 @@ mod tests {
             Shared::new(Node {
                 token_id: 1.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("bar")))))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("bar"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token("bar", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("bar")))))),
+                                IdentWithToken::new_with_token("bar", Some(token(TokenKind::Ident(SmolStr::new("bar"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -7055,17 +7017,17 @@ mod tests {
             Shared::new(Node {
                 token_id: 2.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("baz")))))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("baz"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("baz")))))),
+                                IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("baz"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token("baz", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("baz")))))),
+                                            IdentWithToken::new_with_token("baz", Some(token(TokenKind::Ident(SmolStr::new("baz"))))),
                                             SmallVec::new(),
                                         )),
                                     }),
@@ -7096,7 +7058,7 @@ mod tests {
                 expr: Shared::new(Expr::Try(
                     Shared::new(Node {
                         token_id: 2.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("error_expr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("error_expr")))))))),
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("error_expr", Some(token(TokenKind::Ident(SmolStr::new("error_expr"))))))),
                     }),
                     None,
                     Shared::new(Node {
@@ -7124,11 +7086,11 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -7160,11 +7122,11 @@ mod tests {
                     Shared::new(Node {
                         token_id: 2.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 1.into(),
@@ -7197,14 +7159,14 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::LParen)))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::LParen))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::Paren(
                                 Shared::new(Node {
                                     token_id: 1.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                 }),
                             )),
                         }),
@@ -7236,7 +7198,7 @@ mod tests {
                         expr: Shared::new(Expr::Paren(
                             Shared::new(Node {
                                 token_id: 1.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                             }),
                         )),
                     }),
@@ -7267,7 +7229,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::LParen)))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::LParen))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 3.into(),
@@ -7277,7 +7239,7 @@ mod tests {
                                     expr: Shared::new(Expr::Paren(
                                         Shared::new(Node {
                                             token_id: 1.into(),
-                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("f", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("f")))))))),
+                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("f", Some(token(TokenKind::Ident(SmolStr::new("f"))))))),
                                         }),
                                     )),
                                 }),
@@ -7314,12 +7276,12 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::LBracket)))),
+                    IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::LBracket))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(Shared::new(token(TokenKind::LBracket)))),
+                                IdentWithToken::new_with_token(constants::builtins::ARRAY, Some(token(TokenKind::LBracket))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 1.into(),
@@ -7361,16 +7323,16 @@ mod tests {
                     Shared::new(Node {
                         token_id: 4.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                            IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 2.into(),
                                     expr: Shared::new(Expr::Call(
-                                        IdentWithToken::new_with_token(constants::builtins::GET, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                                        IdentWithToken::new_with_token(constants::builtins::GET, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                                         smallvec![
                                             Shared::new(Node {
                                                 token_id: 0.into(),
-                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                             }),
                                             Shared::new(Node {
                                                 token_id: 1.into(),
@@ -7405,7 +7367,7 @@ mod tests {
                     Shared::new(Node {
                         token_id: 1.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                            IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 0.into(),
@@ -7437,7 +7399,7 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 0.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                                    IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                                     SmallVec::new(),
                                 )),
                             }),
@@ -7465,7 +7427,7 @@ mod tests {
                             Shared::new(Node {
                                 token_id: 1.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token("bar", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("bar")))))),
+                                    IdentWithToken::new_with_token("bar", Some(token(TokenKind::Ident(SmolStr::new("bar"))))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
@@ -7500,7 +7462,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::COALESCE, Some(Shared::new(token(TokenKind::Coalesce)))),
+                                IdentWithToken::new_with_token(constants::builtins::COALESCE, Some(token(TokenKind::Coalesce))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -7525,7 +7487,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::COALESCE, Some(Shared::new(token(TokenKind::Coalesce)))),
+                                IdentWithToken::new_with_token(constants::builtins::COALESCE, Some(token(TokenKind::Coalesce))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -7550,15 +7512,15 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::COALESCE, Some(Shared::new(token(TokenKind::Coalesce)))),
+                                IdentWithToken::new_with_token(constants::builtins::COALESCE, Some(token(TokenKind::Coalesce))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                                     }),
                                 ],
                             )),
@@ -7581,7 +7543,7 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::NEGATE, Some(Shared::new(token(TokenKind::Minus)))),
+                    IdentWithToken::new_with_token(constants::builtins::NEGATE, Some(token(TokenKind::Minus))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 1.into(),
@@ -7601,11 +7563,11 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::NEGATE, Some(Shared::new(token(TokenKind::Minus)))),
+                    IdentWithToken::new_with_token(constants::builtins::NEGATE, Some(token(TokenKind::Minus))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 1.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                         }),
                     ],
                 )),
@@ -7647,7 +7609,7 @@ mod tests {
                     Literal::String("name".to_owned()),
                     Some(IdentWithToken::new_with_token(
                         "alias",
-                        Some(Shared::new(token(TokenKind::Ident(SmolStr::new("alias"))))),
+                        Some(token(TokenKind::Ident(SmolStr::new("alias")))),
                     )),
                 )),
             })
@@ -7671,8 +7633,8 @@ mod tests {
                 Shared::new(Node {
                     token_id: 1.into(),
                     expr: Shared::new(Expr::QualifiedAccess(
-                        vec![IdentWithToken::new_with_token("test", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("test"))))))],
-                        AccessTarget::Ident(IdentWithToken::new_with_token("foo", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("foo")))))),
+                        vec![IdentWithToken::new_with_token("test", Some(token(TokenKind::Ident(SmolStr::new("test")))))],
+                        AccessTarget::Ident(IdentWithToken::new_with_token("foo", Some(token(TokenKind::Ident(SmolStr::new("foo"))))),
                     ))),
                 })
             ]))]
@@ -7690,9 +7652,9 @@ mod tests {
             Shared::new(Node {
                 token_id: 4.into(),
                 expr: Shared::new(Expr::QualifiedAccess(
-                    vec![IdentWithToken::new_with_token("mod", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod"))))))],
+                    vec![IdentWithToken::new_with_token("mod", Some(token(TokenKind::Ident(SmolStr::new("mod")))))],
                     AccessTarget::Call(
-                        IdentWithToken::new_with_token("func", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("func")))))),
+                        IdentWithToken::new_with_token("func", Some(token(TokenKind::Ident(SmolStr::new("func"))))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
@@ -7719,11 +7681,11 @@ mod tests {
                 token_id: 4.into(),
                 expr: Shared::new(Expr::QualifiedAccess(
                     vec![
-                        IdentWithToken::new_with_token("mod1", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod1")))))),
-                        IdentWithToken::new_with_token("mod2", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod2")))))),
+                        IdentWithToken::new_with_token("mod1", Some(token(TokenKind::Ident(SmolStr::new("mod1"))))),
+                        IdentWithToken::new_with_token("mod2", Some(token(TokenKind::Ident(SmolStr::new("mod2"))))),
                     ],
                     AccessTarget::Call(
-                        IdentWithToken::new_with_token("func", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("func")))))),
+                        IdentWithToken::new_with_token("func", Some(token(TokenKind::Ident(SmolStr::new("func"))))),
                         smallvec![],
                     ),
                 )),
@@ -7742,11 +7704,11 @@ mod tests {
                 Shared::new(Node {
                     token_id: 4.into(),
                     expr: Shared::new(Expr::Call(
-                        IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                        IdentWithToken::new_with_token(constants::builtins::SLICE, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                         smallvec![
                             Shared::new(Node {
                                 token_id: 0.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                             }),
                             Shared::new(Node {
                                 token_id: 1.into(),
@@ -7759,7 +7721,7 @@ mod tests {
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 0.into(),
-                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                                         }),
                                     ],
                                 )),
@@ -7781,11 +7743,11 @@ mod tests {
             Shared::new(Node {
                 token_id: 3.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))),
+                    IdentWithToken::new_with_token(constants::builtins::SLICE, Some(token(TokenKind::Ident(SmolStr::new("arr"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("arr")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(token(TokenKind::Ident(SmolStr::new("arr"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 1.into(),
@@ -7817,14 +7779,14 @@ mod tests {
             Shared::new(Node {
                 token_id: 3.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod")))))),
+                    IdentWithToken::new_with_token(constants::builtins::SLICE, Some(token(TokenKind::Ident(SmolStr::new("mod"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::QualifiedAccess(
-                                vec![IdentWithToken::new_with_token("mod", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod"))))))],
+                                vec![IdentWithToken::new_with_token("mod", Some(token(TokenKind::Ident(SmolStr::new("mod")))))],
                                 AccessTarget::Call(
-                                    IdentWithToken::new_with_token("func", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("func")))))),
+                                    IdentWithToken::new_with_token("func", Some(token(TokenKind::Ident(SmolStr::new("func"))))),
                                     smallvec![],
                                 ),
                             )),
@@ -7858,14 +7820,14 @@ mod tests {
             Shared::new(Node {
                 token_id: 3.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token(constants::builtins::SLICE, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod")))))),
+                    IdentWithToken::new_with_token(constants::builtins::SLICE, Some(token(TokenKind::Ident(SmolStr::new("mod"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::QualifiedAccess(
-                                vec![IdentWithToken::new_with_token("mod", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("mod"))))))],
+                                vec![IdentWithToken::new_with_token("mod", Some(token(TokenKind::Ident(SmolStr::new("mod")))))],
                                 AccessTarget::Call(
-                                    IdentWithToken::new_with_token("func", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("func")))))),
+                                    IdentWithToken::new_with_token("func", Some(token(TokenKind::Ident(SmolStr::new("func"))))),
                                     smallvec![],
                                 ),
                             )),
@@ -7903,11 +7865,11 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("obj")))))),
+                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Ident(SmolStr::new("obj"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("obj")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(token(TokenKind::Ident(SmolStr::new("obj"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 1.into(),
@@ -7929,12 +7891,12 @@ mod tests {
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("get_user")))))),
+                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Ident(SmolStr::new("get_user"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
                                         expr: Shared::new(Expr::Call(
-                                            IdentWithToken::new_with_token("get_user", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("get_user")))))),
+                                            IdentWithToken::new_with_token("get_user", Some(token(TokenKind::Ident(SmolStr::new("get_user"))))),
                                             SmallVec::new(),
                                         )),
                                     }),
@@ -7957,16 +7919,16 @@ mod tests {
                     Ok(vec![
                         Shared::new(Node {
                             token_id: 0.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("data", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("data")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("data", Some(token(TokenKind::Ident(SmolStr::new("data"))))))),
                         }),
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Ident(SmolStr::new("obj")))))),
+                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Ident(SmolStr::new("obj"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 1.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("obj")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(token(TokenKind::Ident(SmolStr::new("obj"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 2.into(),
@@ -7986,7 +7948,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 1.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(Shared::new(token(TokenKind::Self_)))),
+                                IdentWithToken::new_with_token(constants::builtins::ATTR, Some(token(TokenKind::Self_))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -8012,7 +7974,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(Shared::new(token(TokenKind::StringLiteral("new_id".to_owned()))))),
+                                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(token(TokenKind::StringLiteral("new_id".to_owned())))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -8042,11 +8004,11 @@ mod tests {
                         Shared::new(Node {
                             token_id: 3.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(Shared::new(token(TokenKind::StringLiteral("John".to_owned()))))),
+                                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(token(TokenKind::StringLiteral("John".to_owned())))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("obj")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(token(TokenKind::Ident(SmolStr::new("obj"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 1.into(),
@@ -8072,7 +8034,7 @@ mod tests {
                         Shared::new(Node {
                             token_id: 2.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(Shared::new(token(TokenKind::NumberLiteral(42.into()))))),
+                                IdentWithToken::new_with_token(constants::builtins::SET_ATTR, Some(token(TokenKind::NumberLiteral(42.into())))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 0.into(),
@@ -8148,22 +8110,22 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Macro(
-                    IdentWithToken::new_with_token("double", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("double")))))),
+                    IdentWithToken::new_with_token("double", Some(token(TokenKind::Ident(SmolStr::new("double"))))),
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))
+                        Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))
                     ],
                     Shared::new(Node {
                         token_id: 3.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 4.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                 })
                             ]
                         ))
@@ -8189,34 +8151,34 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Macro(
-                    IdentWithToken::new_with_token("triple", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("triple")))))),
+                    IdentWithToken::new_with_token("triple", Some(token(TokenKind::Ident(SmolStr::new("triple"))))),
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))
+                        Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))
                     ],
                     Shared::new(Node {
                         token_id: 5.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 3.into(),
                                     expr: Shared::new(Expr::Call(
-                                        IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                                        IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                                         smallvec![
                                             Shared::new(Node {
                                                 token_id: 2.into(),
-                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                             }),
                                             Shared::new(Node {
                                                 token_id: 4.into(),
-                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                             })
                                         ]
                                     ))
                                 }),
                                 Shared::new(Node {
                                     token_id: 6.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                 })
                             ]
                         ))
@@ -8242,23 +8204,23 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Macro(
-                    IdentWithToken::new_with_token("add_two", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("add_two")))))),
+                    IdentWithToken::new_with_token("add_two", Some(token(TokenKind::Ident(SmolStr::new("add_two"))))),
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a"))))))),
-                        Param::new(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b"))))))),
+                        Param::new(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a")))))),
+                        Param::new(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b")))))),
                     ],
                     Shared::new(Node {
                         token_id: 3.into(),
                         expr: Shared::new(Expr::Call(
-                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(Shared::new(token(TokenKind::Plus)))),
+                            IdentWithToken::new_with_token(constants::builtins::ADD, Some(token(TokenKind::Plus))),
                             smallvec![
                                 Shared::new(Node {
                                     token_id: 2.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a"))))))),
                                 }),
                                 Shared::new(Node {
                                     token_id: 4.into(),
-                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("b")))))))),
+                                    expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("b", Some(token(TokenKind::Ident(SmolStr::new("b"))))))),
                                 })
                             ]
                         ))
@@ -8282,13 +8244,13 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("f", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("f")))))),
+                        IdentWithToken::new_with_token("f", Some(token(TokenKind::Ident(SmolStr::new("f"))))),
                         smallvec![
-                            Param::variadic(IdentWithToken::new_with_token("args", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("args"))))))),
+                            Param::variadic(IdentWithToken::new_with_token("args", Some(token(TokenKind::Ident(SmolStr::new("args")))))),
                         ],
                         vec![Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("args", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("args")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("args", Some(token(TokenKind::Ident(SmolStr::new("args"))))))),
                         })],
                 )),
             }),
@@ -8311,14 +8273,14 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("f", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("f")))))),
+                        IdentWithToken::new_with_token("f", Some(token(TokenKind::Ident(SmolStr::new("f"))))),
                         smallvec![
-                            Param::new(IdentWithToken::new_with_token("a", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("a"))))))),
-                            Param::variadic(IdentWithToken::new_with_token("rest", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("rest"))))))),
+                            Param::new(IdentWithToken::new_with_token("a", Some(token(TokenKind::Ident(SmolStr::new("a")))))),
+                            Param::variadic(IdentWithToken::new_with_token("rest", Some(token(TokenKind::Ident(SmolStr::new("rest")))))),
                         ],
                         vec![Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("rest", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("rest")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("rest", Some(token(TokenKind::Ident(SmolStr::new("rest"))))))),
                         })],
                 )),
             }),
@@ -8360,11 +8322,11 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("f", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("f")))))),
+                        IdentWithToken::new_with_token("f", Some(token(TokenKind::Ident(SmolStr::new("f"))))),
                         smallvec![],
                         vec![Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("args", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("args")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("args", Some(token(TokenKind::Ident(SmolStr::new("args"))))))),
                         })],
                 )),
             }),
@@ -8381,11 +8343,11 @@ mod tests {
             Shared::new(Node {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Def(
-                        IdentWithToken::new_with_token("f", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("f")))))),
+                        IdentWithToken::new_with_token("f", Some(token(TokenKind::Ident(SmolStr::new("f"))))),
                         smallvec![],
                         vec![Shared::new(Node {
                             token_id: 2.into(),
-                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("args", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("args")))))))),
+                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("args", Some(token(TokenKind::Ident(SmolStr::new("args"))))))),
                         })],
                 )),
             }),
@@ -8447,22 +8409,22 @@ mod tests {
                 token_id: 0.into(),
                 expr: Shared::new(Expr::Fn(
                     smallvec![
-                        Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
-                        Param::new(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y"))))))),
+                        Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
+                        Param::new(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y")))))),
                     ],
                     vec![
                         Shared::new(Node {
                             token_id: 4.into(),
                             expr: Shared::new(Expr::Call(
-                                IdentWithToken::new_with_token("contains", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("contains")))))),
+                                IdentWithToken::new_with_token("contains", Some(token(TokenKind::Ident(SmolStr::new("contains"))))),
                                 smallvec![
                                     Shared::new(Node {
                                         token_id: 2.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x"))))))),
                                     }),
                                     Shared::new(Node {
                                         token_id: 3.into(),
-                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("y")))))))),
+                                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("y", Some(token(TokenKind::Ident(SmolStr::new("y"))))))),
                                     }),
                                 ],
                             )),
@@ -8489,13 +8451,13 @@ mod tests {
             Shared::new(Node {
                 token_id: 4.into(),
                 expr: Shared::new(Expr::Call(
-                    IdentWithToken::new_with_token("apply", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("apply")))))),
+                    IdentWithToken::new_with_token("apply", Some(token(TokenKind::Ident(SmolStr::new("apply"))))),
                     smallvec![
                         Shared::new(Node {
                             token_id: 0.into(),
                             expr: Shared::new(Expr::Fn(
                                 smallvec![
-                                  Param::new(IdentWithToken::new_with_token("x", Some(Shared::new(token(TokenKind::Ident(SmolStr::new("x"))))))),
+                                  Param::new(IdentWithToken::new_with_token("x", Some(token(TokenKind::Ident(SmolStr::new("x")))))),
                                 ],
                                 vec![
                                     Shared::new(Node {
@@ -8511,8 +8473,7 @@ mod tests {
         ]))]
     fn test_parse(#[case] input: Vec<Token>, #[case] expected: Result<Program, SyntaxError>) {
         let mut arena = Arena::new(10);
-        let tokens: Vec<Shared<Token>> = input.into_iter().map(Shared::new).collect();
-        let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
+        let result = Parser::new(input.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
 
         match (&result, &expected) {
             (Ok(actual), Ok(expected)) => {
@@ -8572,19 +8533,19 @@ mod tests {
     #[case::mdx_flow_expression(".mdx_flow_expression", Selector::MdxFlowExpression)]
     fn test_parse_selector(#[case] selector_str: &str, #[case] expected_selector: Selector) {
         let mut arena = Arena::new(10);
-        let token = Shared::new(Token {
+        let token = Token {
             range: Range::default(),
             kind: TokenKind::Selector(SmolStr::new(selector_str)),
             module_id: 1.into(),
-        });
+        };
 
         let tokens = [
-            Shared::clone(&token),
-            Shared::new(Token {
+            token.clone(),
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
@@ -8613,59 +8574,59 @@ mod tests {
     ) {
         let mut arena = Arena::new(10);
         let mut tokens = vec![
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Selector(SmolStr::new(selector_str)),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::LBracket,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         if let Some(idx) = first_idx {
-            tokens.push(Shared::new(Token {
+            tokens.push(Token {
                 range: Range::default(),
                 kind: TokenKind::NumberLiteral(idx.into()),
                 module_id: 1.into(),
-            }));
+            });
         }
 
-        tokens.push(Shared::new(Token {
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::RBracket,
             module_id: 1.into(),
-        }));
+        });
 
         if second_idx.is_some() {
-            tokens.push(Shared::new(Token {
+            tokens.push(Token {
                 range: Range::default(),
                 kind: TokenKind::LBracket,
                 module_id: 1.into(),
-            }));
+            });
 
             if let Some(idx) = second_idx {
-                tokens.push(Shared::new(Token {
+                tokens.push(Token {
                     range: Range::default(),
                     kind: TokenKind::NumberLiteral(idx.into()),
                     module_id: 1.into(),
-                }));
+                });
             }
 
-            tokens.push(Shared::new(Token {
+            tokens.push(Token {
                 range: Range::default(),
                 kind: TokenKind::RBracket,
                 module_id: 1.into(),
-            }));
+            });
         }
 
-        tokens.push(Shared::new(Token {
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::Eof,
             module_id: 1.into(),
-        }));
+        });
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
 
@@ -8694,34 +8655,34 @@ mod tests {
     ) {
         let mut arena = Arena::new(10);
         let mut tokens = vec![
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Selector(SmolStr::new(selector_str)),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::LBracket,
                 module_id: 1.into(),
-            }),
+            },
         ];
         if let Some(idx) = index {
-            tokens.push(Shared::new(Token {
+            tokens.push(Token {
                 range: Range::default(),
                 kind: TokenKind::NumberLiteral(idx.into()),
                 module_id: 1.into(),
-            }));
+            });
         }
-        tokens.push(Shared::new(Token {
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::RBracket,
             module_id: 1.into(),
-        }));
-        tokens.push(Shared::new(Token {
+        });
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::Eof,
             module_id: 1.into(),
-        }));
+        });
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID)
             .parse()
@@ -8753,39 +8714,39 @@ mod tests {
     ) {
         let mut arena = Arena::new(10);
         let mut tokens = vec![
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Selector(SmolStr::new(first)),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Selector(SmolStr::new(second)),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::LBracket,
                 module_id: 1.into(),
-            }),
+            },
         ];
         if let Some(idx) = index {
-            tokens.push(Shared::new(Token {
+            tokens.push(Token {
                 range: Range::default(),
                 kind: TokenKind::NumberLiteral(idx.into()),
                 module_id: 1.into(),
-            }));
+            });
         }
-        tokens.push(Shared::new(Token {
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::RBracket,
             module_id: 1.into(),
-        }));
-        tokens.push(Shared::new(Token {
+        });
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::Eof,
             module_id: 1.into(),
-        }));
+        });
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID)
             .parse()
@@ -8808,26 +8769,26 @@ mod tests {
     fn test_parse_as_binding() {
         let mut arena = Arena::new(10);
         let tokens = [
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::NumberLiteral(42.into()),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::As,
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Ident("x".into()),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
         assert!(result.is_ok());
@@ -8846,16 +8807,16 @@ mod tests {
 
         let mut arena = Arena::new(10);
         let tokens = [
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Env("MQ_TEST_VAR".into()),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
@@ -8876,19 +8837,19 @@ mod tests {
     #[test]
     fn test_parse_env_not_found() {
         let mut arena = Arena::new(10);
-        let token = Shared::new(Token {
+        let token = Token {
             range: Range::default(),
             kind: TokenKind::Env("MQ_NONEXISTENT_VAR".into()),
             module_id: 1.into(),
-        });
+        };
 
         let tokens = [
-            Shared::clone(&token),
-            Shared::new(Token {
+            token.clone(),
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
@@ -8905,31 +8866,31 @@ mod tests {
 
         let mut arena = Arena::new(10);
         let tokens = [
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Ident(SmolStr::new("function")),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::LParen,
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Env("MQ_ARG_TEST".into()),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::RParen,
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
@@ -8960,16 +8921,16 @@ mod tests {
     fn test_parse_standalone_attr_selector(#[case] selector: &str, #[case] attribute: &str) {
         let mut arena = Arena::new(10);
         let tokens = [
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Selector(SmolStr::new(selector)),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
@@ -9007,20 +8968,18 @@ mod tests {
         let mut arena = Arena::new(10);
         let mut tokens = selectors
             .iter()
-            .map(|selector| {
-                Shared::new(Token {
-                    range: Range::default(),
-                    kind: TokenKind::Selector(SmolStr::new(selector)),
-                    module_id: 1.into(),
-                })
+            .map(|selector| Token {
+                range: Range::default(),
+                kind: TokenKind::Selector(SmolStr::new(selector)),
+                module_id: 1.into(),
             })
             .collect::<Vec<_>>();
 
-        tokens.push(Shared::new(Token {
+        tokens.push(Token {
             range: Range::default(),
             kind: TokenKind::Eof,
             module_id: 1.into(),
-        }));
+        });
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
 
@@ -9088,11 +9047,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("x")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9149,11 +9108,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("value", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("value", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("value")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9200,11 +9159,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("arr")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9247,11 +9206,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("arr", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("arr")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9262,11 +9221,11 @@ mod tests {
                             guard: None,
                             body: Shared::new(Node {
                                 token_id: 5.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("first", Some(Shared::new(Token {
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("first", Some(Token {
                                     range: Range::default(),
                                     kind: TokenKind::Ident(SmolStr::new("first")),
                                     module_id: 1.into()
-                                })))))
+                                }))))
                             })
                         }
                     ]
@@ -9297,11 +9256,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("obj", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("obj")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9312,11 +9271,11 @@ mod tests {
                             guard: None,
                             body: Shared::new(Node {
                                 token_id: 5.into(),
-                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("name", Some(Shared::new(Token {
+                                expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("name", Some(Token {
                                     range: Range::default(),
                                     kind: TokenKind::Ident(SmolStr::new("name")),
                                     module_id: 1.into()
-                                })))))
+                                }))))
                             })
                         }
                     ]
@@ -9363,11 +9322,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("n", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("n", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("n")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9375,15 +9334,15 @@ mod tests {
                             guard: Some(Shared::new(Node {
                                 token_id: 5.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::GT, Some(Shared::new(token(TokenKind::Gt)))),
+                                    IdentWithToken::new_with_token(constants::builtins::GT, Some(token(TokenKind::Gt))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 4.into(),
-                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                                                 range: Range::default(),
                                                 kind: TokenKind::Ident(SmolStr::new("x")),
                                                 module_id: 1.into()
-                                            })))))
+                                            }))))
                                         }),
                                         Shared::new(Node {
                                             token_id: 6.into(),
@@ -9402,15 +9361,15 @@ mod tests {
                             guard: Some(Shared::new(Node {
                                 token_id: 11.into(),
                                 expr: Shared::new(Expr::Call(
-                                    IdentWithToken::new_with_token(constants::builtins::LT, Some(Shared::new(token(TokenKind::Lt)))),
+                                    IdentWithToken::new_with_token(constants::builtins::LT, Some(token(TokenKind::Lt))),
                                     smallvec![
                                         Shared::new(Node {
                                             token_id: 10.into(),
-                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                                            expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                                                 range: Range::default(),
                                                 kind: TokenKind::Ident(SmolStr::new("x")),
                                                 module_id: 1.into()
-                                            })))))
+                                            }))))
                                         }),
                                         Shared::new(Node {
                                             token_id: 12.into(),
@@ -9525,11 +9484,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("x")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9581,11 +9540,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("x")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9635,11 +9594,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("x")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9685,11 +9644,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("x")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9738,11 +9697,11 @@ mod tests {
                 expr: Shared::new(Expr::Match(
                     Shared::new(Node {
                         token_id: 1.into(),
-                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Shared::new(Token {
+                        expr: Shared::new(Expr::Ident(IdentWithToken::new_with_token("x", Some(Token {
                             range: Range::default(),
                             kind: TokenKind::Ident(SmolStr::new("x")),
                             module_id: 1.into()
-                        })))))
+                        }))))
                     }),
                     smallvec![
                         MatchArm {
@@ -9762,8 +9721,7 @@ mod tests {
         ]))]
     fn test_parse_match(#[case] input: Vec<Token>, #[case] expected: Result<Program, SyntaxError>) {
         let mut arena = Arena::new(10);
-        let tokens: Vec<Shared<Token>> = input.into_iter().map(Shared::new).collect();
-        let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
+        let result = Parser::new(input.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
         assert_eq!(result, expected);
     }
 
@@ -9885,16 +9843,16 @@ mod tests {
     ) {
         let mut arena = Arena::new(10);
         let tokens = [
-            Shared::new(Token {
+            Token {
                 range: Range::default(),
                 kind: TokenKind::InterpolatedString(input_segments),
                 module_id: 1.into(),
-            }),
-            Shared::new(Token {
+            },
+            Token {
                 range: Range::default(),
                 kind: TokenKind::Eof,
                 module_id: 1.into(),
-            }),
+            },
         ];
 
         let result = Parser::new(tokens.iter(), &mut arena, Module::TOP_LEVEL_MODULE_ID).parse();
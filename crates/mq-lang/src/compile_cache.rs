@@ -0,0 +1,190 @@
+//! Persistent on-disk cache for compiled mq programs.
+//!
+//! Entries are keyed by query source, optimization level, token-arena base
+//! length, and the mq version, and store the optimized AST in a compact binary
+//! encoding (CBOR) together with the tokens the compilation appended to the
+//! token arena. A later process can therefore skip lexing and parsing entirely
+//! while restoring the exact arena layout the program's node ids point into,
+//! keeping error spans valid.
+//!
+//! The cache is best-effort: unreadable, corrupt, or version-mismatched entries
+//! are treated as misses and a failed store never fails a compilation.
+//! Available with the `ast-json` feature; see [`Engine::set_compile_cache`](crate::Engine::set_compile_cache).
+
+use std::fs;
+use std::path::PathBuf;
+
+use serde::{Deserialize, Serialize};
+use sha2::{Digest, Sha256};
+
+use crate::Token;
+use crate::ast::Program;
+use crate::optimizer::OptimizationLevel;
+
+/// One serialized cache entry.
+#[derive(Serialize, Deserialize)]
+struct CacheEntry {
+    /// mq version that wrote the entry; mismatches are treated as a miss.
+    version: String,
+    /// Token arena length when compilation started (i.e. after the builtin
+    /// module was loaded). The entry only applies to an engine whose arena
+    /// has the same length.
+    base_token_len: usize,
+    /// Tokens the compilation appended to the arena, in allocation order.
+    tokens: Vec<Token>,
+    /// The optimized program.
+    program: Program,
+}
+
+/// A persistent cache of compiled programs stored as one CBOR file per entry.
+///
+/// # Examples
+///
+/// ```no_run
+/// let mut engine = mq_lang::DefaultEngine::default();
+/// engine.load_builtin_module();
+/// engine.set_compile_cache(Some(mq_lang::CompileCache::default()));
+///
+/// // The first run compiles and stores; later runs deserialize instead of parsing.
+/// let input = mq_lang::parse_text_input("hello").unwrap();
+/// let result = engine.eval("add(\" world\")", input.into_iter());
+/// assert_eq!(result.unwrap(), vec!["hello world".to_string().into()].into());
+/// ```
+#[derive(Clone, Debug)]
+pub struct CompileCache {
+    dir: PathBuf,
+}
+
+impl Default for CompileCache {
+    /// Uses `{system_cache_dir}/mq/compiled`, alongside the HTTP module cache.
+    fn default() -> Self {
+        Self {
+            dir: dirs::cache_dir().unwrap_or_default().join("mq").join("compiled"),
+        }
+    }
+}
+
+impl CompileCache {
+    /// Creates a cache rooted at `dir`. The directory is created on first store.
+    pub fn new(dir: PathBuf) -> Self {
+        Self { dir }
+    }
+
+    /// Returns the cached program and its appended tokens, or `None` on a miss.
+    pub(crate) fn load(
+        &self,
+        code: &str,
+        level: OptimizationLevel,
+        base_token_len: usize,
+    ) -> Option<(Program, Vec<Token>)> {
+        let file = fs::File::open(self.entry_path(code, level, base_token_len)).ok()?;
+        let entry: CacheEntry = ciborium::from_reader(std::io::BufReader::new(file)).ok()?;
+        (entry.version == env!("CARGO_PKG_VERSION") && entry.base_token_len == base_token_len)
+            .then_some((entry.program, entry.tokens))
+    }
+
+    /// Stores a compiled program, writing atomically (temp file, then rename) so
+    /// concurrent mq processes never observe a partial entry.
+    pub(crate) fn store(
+        &self,
+        code: &str,
+        level: OptimizationLevel,
+        base_token_len: usize,
+        tokens: Vec<Token>,
+        program: &Program,
+    ) -> std::io::Result<()> {
+        fs::create_dir_all(&self.dir)?;
+
+        let entry = CacheEntry {
+            version: env!("CARGO_PKG_VERSION").to_string(),
+            base_token_len,
+            tokens,
+            program: program.clone(),
+        };
+        let path = self.entry_path(code, level, base_token_len);
+        let tmp_path = path.with_extension("mqc.tmp");
+
+        let mut writer = std::io::BufWriter::new(fs::File::create(&tmp_path)?);
+        ciborium::into_writer(&entry, &mut writer).map_err(std::io::Error::other)?;
+        writer.into_inner().map_err(|e| e.into_error())?;
+
+        fs::rename(&tmp_path, path)
+    }
+
+    fn entry_path(&self, code: &str, level: OptimizationLevel, base_token_len: usize) -> PathBuf {
+        let mut hasher = Sha256::new();
+        hasher.update(env!("CARGO_PKG_VERSION").as_bytes());
+        hasher.update([level as u8]);
+        hasher.update(base_token_len.to_le_bytes());
+        hasher.update(code.as_bytes());
+        use std::fmt::Write;
+        let digest = hasher.finalize();
+        let mut file_name = String::with_capacity(digest.len() * 2 + 4);
+        for byte in digest {
+            let _ = write!(file_name, "{:02x}", byte);
+        }
+        file_name.push_str(".mqc");
+        self.dir.join(file_name)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{DefaultEngine, parse_text_input};
+
+    fn eval_with_cache(cache: &CompileCache, query: &str) -> crate::MqResult {
+        let mut engine = DefaultEngine::default();
+        engine.load_builtin_module();
+        engine.set_compile_cache(Some(cache.clone()));
+        engine.eval(query, parse_text_input("hello").unwrap().into_iter())
+    }
+
+    #[test]
+    fn test_cache_hit_matches_fresh_compile() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = CompileCache::new(dir.path().to_path_buf());
+        let query = "add(\" world\") | upcase()";
+
+        let first = eval_with_cache(&cache, query).unwrap();
+        assert!(
+            fs::read_dir(dir.path()).unwrap().next().is_some(),
+            "an entry must be written on the first compile"
+        );
+
+        let second = eval_with_cache(&cache, query).unwrap();
+        assert_eq!(first, second);
+    }
+
+    #[test]
+    fn test_cached_program_preserves_runtime_error_spans() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = CompileCache::new(dir.path().to_path_buf());
+        let query = "error(\"boom\")";
+
+        let fresh_err = eval_with_cache(&cache, query).unwrap_err().to_string();
+        let cached_err = eval_with_cache(&cache, query).unwrap_err().to_string();
+        assert_eq!(fresh_err, cached_err);
+    }
+
+    #[test]
+    fn test_corrupt_entry_is_a_miss() {
+        let dir = tempfile::tempdir().unwrap();
+        let cache = CompileCache::new(dir.path().to_path_buf());
+        let query = "add(\" world\")";
+
+        eval_with_cache(&cache, query).unwrap();
+        for entry in fs::read_dir(dir.path()).unwrap() {
+            fs::write(entry.unwrap().path(), b"not cbor").unwrap();
+        }
+
+        let result = eval_with_cache(&cache, query).unwrap();
+        assert_eq!(result, vec!["hello world".to_string().into()].into());
+    }
+
+    #[test]
+    fn test_mismatched_base_token_len_is_a_miss() {
+        let cache = CompileCache::new(tempfile::tempdir().unwrap().path().to_path_buf());
+        assert!(cache.load("add(1)", OptimizationLevel::None, 42).is_none());
+    }
+}
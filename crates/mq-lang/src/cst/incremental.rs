@@ -1,12 +1,14 @@
 use ropey::Rope;
+use rustc_hash::FxHashSet;
 
 use crate::{
-    Lexer, Module, Shared, Token,
+    Lexer, Module, Range, Shared, Token,
     cst::{
+        error::ParseError,
         node::Node,
         parser::{ErrorReporter, Parser},
     },
-    lexer,
+    lexer, selector,
 };
 
 /// Fraction of top-level nodes that must be affected to trigger a full re-parse.
@@ -70,6 +72,7 @@ impl TextEdit {
 /// parser2.apply_edit(&edit2).unwrap();
 /// assert_eq!(parser2.source(), "\"世界\" | upcase()");
 /// ```
+#[derive(Debug)]
 pub struct IncrementalParser {
     source: Rope,
     tokens: Vec<Shared<Token>>,
@@ -220,7 +223,36 @@ impl IncrementalParser {
         let reparse_new_end = ((reparse_old_end as isize) + delta).max(reparse_new_start as isize) as usize;
 
         // Re-parse only the affected token slice.
-        let (new_nodes, new_ranges, _) = Self::parse_tokens_range(&new_tokens, reparse_new_start, reparse_new_end);
+        let (new_nodes, new_ranges, slice_errors) =
+            Self::parse_tokens_range(&new_tokens, reparse_new_start, reparse_new_end);
+
+        // Merge errors incrementally instead of re-parsing the whole program:
+        // old errors attached to tokens inside the reparsed range are replaced
+        // by the slice parse's errors, and errors outside it are kept as-is.
+        // `UnexpectedEOFDetected` carries no token and is only meaningful at
+        // the end of input, so it is dropped from a mid-document slice parse
+        // (where running out of tokens is a boundary artifact, not an error).
+        let reparse_reaches_end = reparse_old_end >= self.tokens.len();
+        let reparsed_tokens: FxHashSet<Range> = self.tokens[reparse_old_start..reparse_old_end.min(self.tokens.len())]
+            .iter()
+            .map(|token| token.range)
+            .collect();
+        let mut merged_errors: Vec<ParseError> = self
+            .errors
+            .to_vec()
+            .into_iter()
+            .filter(|error| match error_token(error) {
+                Some(token) => !reparsed_tokens.contains(&token.range),
+                None => !reparse_reaches_end,
+            })
+            .collect();
+        merged_errors.extend(
+            slice_errors
+                .to_vec()
+                .into_iter()
+                .filter(|error| !matches!(error, ParseError::UnexpectedEOFDetected) || reparse_reaches_end),
+        );
+        self.errors = ErrorReporter::with_error(merged_errors, 100);
 
         // Adjust suffix node-group token ranges by the net token delta.
         for range in &mut self.node_token_ranges[last_affected..] {
@@ -235,10 +267,6 @@ impl IncrementalParser {
         self.source = Rope::from_str(new_source);
         self.tokens = new_tokens;
 
-        // Re-collect errors for the whole program after a structural change.
-        let (_, _, errors) = Self::parse_tokens(&self.tokens);
-        self.errors = errors;
-
         (&self.nodes, &self.errors)
     }
 
@@ -343,6 +371,18 @@ fn tokens_same_kind(a: &Shared<Token>, b: &Shared<Token>) -> bool {
     a.kind == b.kind
 }
 
+/// Returns the token a parse error is attached to, if any.
+fn error_token(error: &ParseError) -> Option<&Token> {
+    match error {
+        ParseError::UnexpectedToken(token)
+        | ParseError::InsufficientTokens(token)
+        | ParseError::ExpectedClosingBracket(token)
+        | ParseError::UnmatchedEnd(token) => Some(token.as_ref()),
+        ParseError::UnknownSelector(selector::UnknownSelector(token)) => Some(token),
+        ParseError::UnexpectedEOFDetected => None,
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -430,6 +470,36 @@ mod tests {
         assert!(parser.apply_edit(&edit).is_err());
     }
 
+    #[test]
+    fn test_incremental_error_reported_and_cleared() {
+        let source = "upcase() | downcase() | ltrim() | rtrim() | length()";
+        let mut parser = IncrementalParser::new(source);
+        assert!(!parser.result().1.has_errors());
+
+        // Introduce a syntax error in a single statement; only the affected
+        // statement groups are re-parsed and their errors merged in.
+        let (_, errors) = parser.update("upcase() | downcase() | xq() | rtrim() | length()");
+        assert!(!errors.has_errors());
+
+        let (_, errors) = parser.update("upcase() | downcase() | .unknown_sel | rtrim() | length()");
+        assert!(errors.has_errors());
+
+        // Fixing the statement must drop the stale error again.
+        let (_, errors) = parser.update(source);
+        assert!(!errors.has_errors());
+    }
+
+    #[test]
+    fn test_incremental_keeps_errors_outside_edit() {
+        // An error in the last statement must survive an edit to an earlier one.
+        let source = "upcase() | downcase() | ltrim() | rtrim() | .unknown_sel";
+        let mut parser = IncrementalParser::new(source);
+        assert!(parser.result().1.has_errors());
+
+        let (_, errors) = parser.update("upcase() | downcase() | trim() | rtrim() | .unknown_sel");
+        assert!(errors.has_errors());
+    }
+
     #[test]
     fn test_full_parse_fallback_triggered() {
         // Source with several distinct statements so we have multiple nodes.
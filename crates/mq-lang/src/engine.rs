@@ -40,6 +40,58 @@ impl CompiledProgram {
     pub fn program(&self) -> &crate::ast::Program {
         &self.program
     }
+
+    /// Returns `true` if evaluating this program can define or modify bindings in
+    /// the root environment of the engine that runs it — a top-level `let`, `def`,
+    /// `import`, etc., including ones reachable through forms that evaluate in the
+    /// enclosing scope (`if` branches, `try`/`catch`, parentheses, call arguments).
+    ///
+    /// Embedders that reuse one engine across independent callers can use this to
+    /// decide whether the engine is still pristine after an evaluation, or whether
+    /// bindings from one caller could leak into the next.
+    pub fn mutates_env(&self) -> bool {
+        self.program.iter().any(|node| expr_mutates_env(&node.expr))
+    }
+}
+
+/// Whether evaluating `expr` can bind into the environment it is evaluated in.
+///
+/// Recurses only through sub-expressions the evaluator runs in the *same*
+/// environment; blocks, loop bodies, function bodies, match arms, and module
+/// bodies all get a child scope, so bindings inside them cannot escape.
+fn expr_mutates_env(expr: &crate::ast::node::Expr) -> bool {
+    use crate::ast::node::{Expr, StringSegment};
+
+    match expr {
+        Expr::Let(..)
+        | Expr::Var(..)
+        | Expr::As(..)
+        | Expr::Assign(..)
+        | Expr::Def(..)
+        | Expr::Macro(..)
+        | Expr::Include(..)
+        | Expr::Import(..)
+        | Expr::Module(..) => true,
+        Expr::Paren(node) | Expr::Quote(node) | Expr::Unquote(node) => expr_mutates_env(&node.expr),
+        Expr::Break(Some(node)) => expr_mutates_env(&node.expr),
+        Expr::And(nodes) | Expr::Or(nodes) => nodes.iter().any(|n| expr_mutates_env(&n.expr)),
+        Expr::Call(_, args) | Expr::SelectorCall(_, args) => args.iter().any(|n| expr_mutates_env(&n.expr)),
+        Expr::CallDynamic(target, args) => {
+            expr_mutates_env(&target.expr) || args.iter().any(|n| expr_mutates_env(&n.expr))
+        }
+        Expr::If(branches) => branches.iter().any(|(cond, body)| {
+            cond.as_ref().is_some_and(|c| expr_mutates_env(&c.expr)) || expr_mutates_env(&body.expr)
+        }),
+        // The catch expression runs in the caller's env when no error binder is given.
+        Expr::Try(body, _, catch) => expr_mutates_env(&body.expr) || expr_mutates_env(&catch.expr),
+        Expr::Match(value, _) => expr_mutates_env(&value.expr),
+        Expr::Foreach(_, values, _) => expr_mutates_env(&values.expr),
+        Expr::InterpolatedString(segments) => segments.iter().any(|segment| match segment {
+            StringSegment::Expr(node) => expr_mutates_env(&node.expr),
+            _ => false,
+        }),
+        _ => false,
+    }
 }
 
 impl From<crate::ast::Program> for CompiledProgram {
@@ -72,20 +124,22 @@ impl From<crate::ast::Program> for CompiledProgram {
 #[derive(Debug, Clone)]
 pub struct Engine<T: ModuleResolver = DefaultModuleResolver> {
     pub(crate) evaluator: Evaluator<T>,
-    token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
+    token_arena: Shared<SharedCell<Arena<Token>>>,
     optimization_level: OptimizationLevel,
+    #[cfg(feature = "ast-json")]
+    compile_cache: Option<crate::CompileCache>,
 }
 
-fn create_default_token_arena() -> Shared<SharedCell<Arena<Shared<Token>>>> {
+fn create_default_token_arena() -> Shared<SharedCell<Arena<Token>>> {
     let token_arena = Shared::new(SharedCell::new(Arena::new(2048)));
     token_alloc(
         &token_arena,
-        &Shared::new(Token {
+        &Token {
             // Ensure at least one token for ArenaId::new(0)
             kind: TokenKind::Eof, // Dummy token
             range: Range::default(),
             module_id: ArenaId::new(0), // Dummy module_id
-        }),
+        },
     );
     token_arena
 }
@@ -103,6 +157,8 @@ impl<T: ModuleResolver> Engine<T> {
             evaluator: Evaluator::new(ModuleLoader::new(module_resolver), Shared::clone(&token_arena)),
             token_arena,
             optimization_level: OptimizationLevel::default(),
+            #[cfg(feature = "ast-json")]
+            compile_cache: None,
         }
     }
 
@@ -111,6 +167,49 @@ impl<T: ModuleResolver> Engine<T> {
         self.optimization_level = level;
     }
 
+    /// Sets the persistent compile cache consulted by [`Engine::eval`] and
+    /// [`Engine::compile`]. Cache hits skip lexing and parsing entirely; misses
+    /// compile as usual and store the result for later processes. Pass `None`
+    /// to disable (the default).
+    #[cfg(feature = "ast-json")]
+    pub fn set_compile_cache(&mut self, cache: Option<crate::CompileCache>) {
+        self.compile_cache = cache;
+    }
+
+    /// Enables or disables per-expression profiling.
+    ///
+    /// While enabled, every evaluated AST node records an invocation count and
+    /// cumulative (inclusive) wall time; collect the results with
+    /// [`Engine::take_profile_records`]. Profiling forces the AST walker so
+    /// timings attach to source expressions, and adds one clock sample pair per
+    /// expression of overhead.
+    #[cfg(feature = "profiler")]
+    pub fn set_profiling(&mut self, enabled: bool) {
+        self.evaluator.profiler = enabled.then(crate::eval::profiler::Profiler::default);
+    }
+
+    /// Returns the profile collected since profiling was enabled (or since the
+    /// last call), sorted by cumulative time with the hottest expression first,
+    /// and clears the collector. Returns an empty list when profiling is off.
+    #[cfg(feature = "profiler")]
+    pub fn take_profile_records(&mut self) -> Vec<crate::ProfileRecord> {
+        self.evaluator
+            .profiler
+            .as_mut()
+            .map(|profiler| profiler.take_records(Shared::clone(&self.token_arena)))
+            .unwrap_or_default()
+    }
+
+    /// Selects the execution backend for evaluated programs.
+    ///
+    /// [`EvalBackend::Bytecode`](crate::EvalBackend) lowers programs to a flat
+    /// instruction stream before execution, which avoids per-node AST dispatch in
+    /// hot loops; programs using constructs the compiler does not lower yet fall
+    /// back to the AST walker transparently, so results are identical either way.
+    pub fn set_eval_backend(&mut self, backend: crate::EvalBackend) {
+        self.evaluator.backend = backend;
+    }
+
     /// Set the maximum call stack depth for function calls.
     ///
     /// This prevents infinite recursion by limiting how deep function
@@ -248,8 +347,7 @@ impl<T: ModuleResolver> Engine<T> {
             return Ok(vec![].into());
         }
 
-        let program = parse(code, Shared::clone(&self.token_arena))?;
-        let program = Optimizer::with_level(self.optimization_level).optimize(program);
+        let program = self.compile_program(code)?;
 
         #[cfg(feature = "debugger")]
         self.evaluator.module_loader.set_source_code(code.to_string());
@@ -270,14 +368,56 @@ impl<T: ModuleResolver> Engine<T> {
                 program: vec![],
             });
         }
-        let program = parse(code, Shared::clone(&self.token_arena))?;
-        let program = Optimizer::with_level(self.optimization_level).optimize(program);
+        let program = self.compile_program(code)?;
         Ok(CompiledProgram {
             source: code.to_string(),
             program,
         })
     }
 
+    /// Parses and optimizes `code`, consulting the persistent compile cache when
+    /// one is configured (`ast-json` feature).
+    fn compile_program(&mut self, code: &str) -> Result<crate::ast::Program, Box<error::Error>> {
+        #[cfg(feature = "ast-json")]
+        if let Some(cache) = &self.compile_cache {
+            let base_token_len = {
+                #[cfg(not(feature = "sync"))]
+                {
+                    self.token_arena.borrow().len()
+                }
+                #[cfg(feature = "sync")]
+                {
+                    self.token_arena.read().unwrap().len()
+                }
+            };
+
+            if let Some((program, tokens)) = cache.load(code, self.optimization_level, base_token_len) {
+                // Re-create the token layout the cached program's node ids point into.
+                #[cfg(not(feature = "sync"))]
+                self.token_arena.borrow_mut().extend_from_slice(&tokens);
+                #[cfg(feature = "sync")]
+                self.token_arena.write().unwrap().extend_from_slice(&tokens);
+                return Ok(program);
+            }
+
+            let program = parse(code, Shared::clone(&self.token_arena))?;
+            let program = Optimizer::with_level(self.optimization_level).optimize(program);
+            let appended: Vec<Token> = {
+                #[cfg(not(feature = "sync"))]
+                let arena = self.token_arena.borrow();
+                #[cfg(feature = "sync")]
+                let arena = self.token_arena.read().unwrap();
+                arena.as_slice()[base_token_len..].to_vec()
+            };
+            // Best-effort: a failed store never fails the compilation.
+            let _ = cache.store(code, self.optimization_level, base_token_len, appended, &program);
+            return Ok(program);
+        }
+
+        let program = parse(code, Shared::clone(&self.token_arena))?;
+        Ok(Optimizer::with_level(self.optimization_level).optimize(program))
+    }
+
     /// Evaluates a pre-compiled program against the given input.
     ///
     /// Use with `compile` to avoid re-parsing the same query for each input file,
@@ -330,7 +470,7 @@ impl<T: ModuleResolver> Engine<T> {
     }
 
     #[cfg(feature = "debugger")]
-    pub fn token_arena(&self) -> Shared<SharedCell<Arena<Shared<Token>>>> {
+    pub fn token_arena(&self) -> Shared<SharedCell<Arena<Token>>> {
         Shared::clone(&self.token_arena)
     }
 
@@ -349,6 +489,8 @@ impl<T: ModuleResolver> Engine<T> {
             evaluator: Evaluator::with_env(Shared::clone(&token_arena), Shared::clone(&env)),
             token_arena: Shared::clone(&token_arena),
             optimization_level: self.optimization_level,
+            #[cfg(feature = "ast-json")]
+            compile_cache: self.compile_cache.clone(),
         }
     }
 
@@ -396,10 +538,11 @@ impl Engine<DefaultModuleResolver> {
         self.evaluator.module_loader.set_http_allowed_domains(domains);
     }
 
-    /// Clears all locally-cached HTTP module files.
+    /// Marks all locally-cached mutable-ref HTTP module files stale.
     ///
-    /// Call this once before processing to force a re-fetch of all cached modules
-    /// on the next resolve (e.g. when `--refresh-modules` is passed on the CLI).
+    /// Call this once before processing (e.g. when `--refresh-modules` is passed on the
+    /// CLI); the next resolve revalidates each stale module against the server with a
+    /// conditional request and re-downloads only those whose content actually changed.
     pub fn clear_http_cache(&self) -> Result<(), crate::module::error::ModuleError> {
         self.evaluator.module_loader.clear_http_cache()
     }
@@ -489,6 +632,20 @@ mod tests {
         assert!(started.elapsed() < std::time::Duration::from_secs(5));
     }
 
+    #[rstest]
+    #[case::selector(".h1", false)]
+    #[case::pipeline(r#"select(contains("a")) | upcase()"#, false)]
+    #[case::fn_body_is_scoped("map(fn(x): let y = x | y;)", false)]
+    #[case::top_level_let("let x = 1 | x", true)]
+    #[case::top_level_def("def f(): 1; | f()", true)]
+    #[case::import(r#"import "csv""#, true)]
+    #[case::if_body_let("if (true): let x = 1", true)]
+    fn test_compiled_program_mutates_env(#[case] query: &str, #[case] expected: bool) {
+        let mut engine = DefaultEngine::default();
+        let compiled = engine.compile(query).unwrap();
+        assert_eq!(compiled.mutates_env(), expected, "query: {query}");
+    }
+
     #[test]
     fn test_no_timeout_by_default() {
         let mut engine = DefaultEngine::default();
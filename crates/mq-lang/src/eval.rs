@@ -1,5 +1,4 @@
 use std::borrow::Cow;
-use std::collections::BTreeMap;
 use std::sync::LazyLock;
 use std::time::Duration;
 #[cfg(not(target_arch = "wasm32"))]
@@ -44,21 +43,64 @@ pub mod builtin;
 #[cfg(feature = "debugger")]
 pub mod debugger;
 pub mod env;
+#[cfg(feature = "profiler")]
+pub mod profiler;
 pub mod runtime_value;
+pub mod vm;
 
 use env::Env;
 use runtime_value::RuntimeValue;
+use vm::EvalBackend;
 
 /// Number of loop iterations / function calls between wall-clock deadline checks.
 /// Must be a power of two so the check is a cheap bitmask instead of a modulo.
 const TIMEOUT_CHECK_INTERVAL: u32 = 1024;
 
+/// Upper bound on call frames kept in [`Evaluator::env_pool`]; frames beyond
+/// this are simply dropped.
+const ENV_POOL_CAPACITY: usize = 64;
+
 static TYPE_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new("type"));
 static DYNAMIC_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new("<dynamic>"));
 static SPREAD_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new(constants::builtins::SPREAD));
 static ARRAY_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new(constants::builtins::ARRAY));
 static DICT_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new(constants::builtins::DICT));
 static ERROR_MESSAGE_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new("message"));
+static PMAP_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new(constants::builtins::PMAP));
+static PFILTER_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new(constants::builtins::PFILTER));
+static PGROUP_BY_IDENT: LazyLock<Ident> = LazyLock::new(|| Ident::new(constants::builtins::PGROUP_BY));
+
+/// Minimum array length before `pmap`/`pfilter`/`pgroup_by` fan out across
+/// threads; below this the thread handoff costs more than it saves.
+#[cfg(feature = "sync")]
+const PARALLEL_MIN_LEN: usize = 32;
+
+/// Parallel counterparts of the `map`/`filter`/`group_by` builtins.
+///
+/// These are dispatched by the evaluator rather than defined in `builtin.mq`
+/// because applying the supplied function to each element requires evaluator
+/// access, and (with the `sync` feature) a private evaluator clone per worker
+/// thread.
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub(crate) enum ParallelCollection {
+    Map,
+    Filter,
+    GroupBy,
+}
+
+impl ParallelCollection {
+    pub(crate) fn from_ident(ident: &Ident) -> Option<Self> {
+        if *ident == *PMAP_IDENT {
+            Some(ParallelCollection::Map)
+        } else if *ident == *PFILTER_IDENT {
+            Some(ParallelCollection::Filter)
+        } else if *ident == *PGROUP_BY_IDENT {
+            Some(ParallelCollection::GroupBy)
+        } else {
+            None
+        }
+    }
+}
 
 /// Control flow signals for internal evaluation.
 ///
@@ -158,7 +200,7 @@ impl Default for Options {
 #[derive(Debug)]
 pub struct Evaluator<T: ModuleResolver = DefaultModuleResolver> {
     env: Shared<SharedCell<Env>>,
-    token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
+    token_arena: Shared<SharedCell<Arena<Token>>>,
 
     call_stack_depth: u32,
     /// Deadline for the current `eval` call; `None` if no timeout is set.
@@ -168,6 +210,15 @@ pub struct Evaluator<T: ModuleResolver = DefaultModuleResolver> {
     pub(crate) options: Options,
     pub(crate) module_loader: module::ModuleLoader<T>,
     pub(crate) macro_expander: Macro,
+    /// Execution backend for compiled programs; `Ast` walks the tree directly,
+    /// `Bytecode` lowers to a flat instruction stream when the program supports it.
+    pub(crate) backend: EvalBackend,
+    /// Finished call frames kept for reuse, so tight call loops stop allocating a
+    /// fresh shared `Env` per call. Only frames nothing else refers to are pooled.
+    env_pool: Vec<Shared<SharedCell<Env>>>,
+    /// Per-expression timing collector; `None` unless profiling is enabled.
+    #[cfg(feature = "profiler")]
+    pub(crate) profiler: Option<profiler::Profiler>,
 
     #[cfg(feature = "debugger")]
     debugger: Shared<SharedCell<Debugger>>,
@@ -186,6 +237,10 @@ impl<T: ModuleResolver> Default for Evaluator<T> {
             options: Options::default(),
             module_loader: module::ModuleLoader::new(T::default()),
             macro_expander: Macro::new(),
+            backend: EvalBackend::default(),
+            env_pool: Vec::new(),
+            #[cfg(feature = "profiler")]
+            profiler: None,
             #[cfg_attr(feature = "sync", allow(clippy::arc_with_non_send_sync))]
             #[cfg(feature = "debugger")]
             debugger: Shared::new(SharedCell::new(Debugger::new())),
@@ -206,6 +261,12 @@ impl<T: ModuleResolver> Clone for Evaluator<T> {
             options: self.options.clone(),
             module_loader: self.module_loader.clone(),
             macro_expander: self.macro_expander.clone(),
+            backend: self.backend,
+            // Pooled frames are recycled based on their reference counts, so they
+            // must not be shared between evaluator instances.
+            env_pool: Vec::new(),
+            #[cfg(feature = "profiler")]
+            profiler: self.profiler.clone(),
             #[cfg(feature = "debugger")]
             debugger: Shared::clone(&self.debugger),
             #[cfg(feature = "debugger")]
@@ -215,10 +276,7 @@ impl<T: ModuleResolver> Clone for Evaluator<T> {
 }
 
 impl<T: ModuleResolver> Evaluator<T> {
-    pub(crate) fn new(
-        module_loader: module::ModuleLoader<T>,
-        token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
-    ) -> Self {
+    pub(crate) fn new(module_loader: module::ModuleLoader<T>, token_arena: Shared<SharedCell<Arena<Token>>>) -> Self {
         Self {
             module_loader,
             token_arena,
@@ -227,10 +285,7 @@ impl<T: ModuleResolver> Evaluator<T> {
     }
 
     #[allow(unused)]
-    pub(crate) fn with_env(
-        token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
-        env: Shared<SharedCell<Env>>,
-    ) -> Self {
+    pub(crate) fn with_env(token_arena: Shared<SharedCell<Arena<Token>>>, env: Shared<SharedCell<Env>>) -> Self {
         Self {
             token_arena,
             env: Shared::clone(&env),
@@ -325,12 +380,13 @@ impl<T: ModuleResolver> Evaluator<T> {
             let (program, nodes_program) = program.split_at_mut(*index);
             let program = program.to_vec();
             let nodes_program = nodes_program.to_vec();
+            let chunk = self.compile_chunk(&program);
 
             let values: Result<Vec<RuntimeValue>, InnerError> = input
                 .map(|runtime_value| match &runtime_value {
-                    RuntimeValue::Markdown(node, _) => self.eval_markdown_node(&program, node),
+                    RuntimeValue::Markdown(node, _) => self.eval_markdown_node(&program, chunk.as_ref(), node),
                     _ => self
-                        .eval_program(&program, runtime_value, &Shared::clone(&self.env))
+                        .eval_program_with_backend(&program, chunk.as_ref(), runtime_value, &Shared::clone(&self.env))
                         .map_err(|e| e.into_inner_error()),
                 })
                 .collect();
@@ -338,34 +394,83 @@ impl<T: ModuleResolver> Evaluator<T> {
             if nodes_program.is_empty() {
                 values
             } else {
-                self.eval_program(&nodes_program, values?.into(), &Shared::clone(&self.env))
-                    .map(|value| {
-                        if let RuntimeValue::Array(values) = value {
-                            Shared::unwrap_or_clone(values)
-                        } else {
-                            vec![value]
-                        }
-                    })
-                    .map_err(|e| e.into_inner_error())
+                let nodes_chunk = self.compile_chunk(&nodes_program);
+                self.eval_program_with_backend(
+                    &nodes_program,
+                    nodes_chunk.as_ref(),
+                    values?.into(),
+                    &Shared::clone(&self.env),
+                )
+                .map(|value| {
+                    if let RuntimeValue::Array(values) = value {
+                        Shared::unwrap_or_clone(values)
+                    } else {
+                        vec![value]
+                    }
+                })
+                .map_err(|e| e.into_inner_error())
             }
         } else {
+            let chunk = self.compile_chunk(&program);
             input
                 .map(|runtime_value| match &runtime_value {
-                    RuntimeValue::Markdown(node, _) => self.eval_markdown_node(&program, node),
+                    RuntimeValue::Markdown(node, _) => self.eval_markdown_node(&program, chunk.as_ref(), node),
                     _ => self
-                        .eval_program(&program, runtime_value, &Shared::clone(&self.env))
+                        .eval_program_with_backend(&program, chunk.as_ref(), runtime_value, &Shared::clone(&self.env))
                         .map_err(|e| e.into_inner_error()),
                 })
                 .collect()
         }
     }
 
+    /// Lowers `program` to bytecode when the bytecode backend is selected and the
+    /// program is supported; `None` keeps the AST walker.
+    fn compile_chunk(&self, program: &Program) -> Option<vm::Chunk> {
+        match self.backend {
+            EvalBackend::Bytecode => {
+                #[cfg(feature = "debugger")]
+                if self.debugger.read().unwrap().is_active() {
+                    // Breakpoints and stepping rely on per-node interception in the
+                    // AST walker, so an active debugger disables lowering.
+                    return None;
+                }
+                #[cfg(feature = "profiler")]
+                if self.profiler.is_some() {
+                    // Profiling records per-node timings in the AST walker.
+                    return None;
+                }
+                vm::Compiler::compile(program)
+            }
+            EvalBackend::Ast => None,
+        }
+    }
+
+    #[inline(always)]
+    fn eval_program_with_backend(
+        &mut self,
+        program: &Program,
+        chunk: Option<&vm::Chunk>,
+        runtime_value: RuntimeValue,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        match chunk {
+            Some(chunk) => vm::Vm::run(self, chunk, runtime_value, env),
+            None => self.eval_program(program, runtime_value, env),
+        }
+    }
+
     #[inline(always)]
-    fn eval_markdown_node(&mut self, program: &Program, node: &mq_markdown::Node) -> Result<RuntimeValue, InnerError> {
+    fn eval_markdown_node(
+        &mut self,
+        program: &Program,
+        chunk: Option<&vm::Chunk>,
+        node: &mq_markdown::Node,
+    ) -> Result<RuntimeValue, InnerError> {
         node.map_values(&mut |child_node| {
             let value = self
-                .eval_program(
+                .eval_program_with_backend(
                     program,
+                    chunk,
                     RuntimeValue::new_markdown(child_node.clone()),
                     &Shared::clone(&self.env),
                 )
@@ -446,9 +551,10 @@ impl<T: ModuleResolver> Evaluator<T> {
                     .eval_import(module_path.to_owned(), alias.as_ref().map(|ident| ident.name), env)
                     .map_err(|e| e.into_runtime_error())?,
                 _ => {
-                    return Err(RuntimeError::InternalError(
-                        (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone(),
-                    ));
+                    return Err(RuntimeError::InternalError(get_token(
+                        Shared::clone(&self.token_arena),
+                        node.token_id,
+                    )));
                 }
             };
         }
@@ -478,15 +584,16 @@ impl<T: ModuleResolver> Evaluator<T> {
                             }
                         }
                         None => {
-                            let token = (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone();
+                            let token = get_token(Shared::clone(&self.token_arena), node.token_id);
                             return Err(RuntimeError::DestructuringFailed(token));
                         }
                     }
                 }
             } else {
-                return Err(RuntimeError::InternalError(
-                    (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone(),
-                ));
+                return Err(RuntimeError::InternalError(get_token(
+                    Shared::clone(&self.token_arena),
+                    node.token_id,
+                )));
             }
         }
 
@@ -592,7 +699,7 @@ impl<T: ModuleResolver> Evaluator<T> {
         let debug_context = DebugContext {
             current_value: runtime_value.clone(),
             current_node: Shared::clone(&node),
-            token: Shared::clone(&token),
+            token: token.clone(),
             call_stack: current_call_stack,
             env: Shared::clone(&env),
             source: Source {
@@ -682,7 +789,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                                 }
                             }
                             None => {
-                                let token = (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone();
+                                let token = get_token(Shared::clone(&self.token_arena), node.token_id);
                                 return Err(RuntimeError::DestructuringFailed(token).into());
                             }
                         }
@@ -799,7 +906,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             self.eval_ident(first_module.name, token_id, env)?
         } else {
             let token = get_token(Shared::clone(&self.token_arena), token_id);
-            return Err(RuntimeError::InternalError((*token).clone()).into());
+            return Err(RuntimeError::InternalError(token.clone()).into());
         };
 
         // Traverse nested modules
@@ -818,12 +925,9 @@ impl<T: ModuleResolver> Evaluator<T> {
                 }
                 _ => {
                     let token = get_token(Shared::clone(&self.token_arena), token_id);
-                    return Err(RuntimeError::NotDefined(
-                        (*token).clone(),
-                        module_ident.name.to_string(),
-                        Box::new([]),
-                    )
-                    .into());
+                    return Err(
+                        RuntimeError::NotDefined(token.clone(), module_ident.name.to_string(), Box::new([])).into(),
+                    );
                 }
             }
         }
@@ -862,7 +966,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                                 let candidates = module_exports.read().unwrap().defined_names();
 
                                 Err(RuntimeError::NotDefined(
-                                    (*token).clone(),
+                                    token.clone(),
                                     func_name.name.to_string(),
                                     candidates.into_boxed_slice(),
                                 )
@@ -889,7 +993,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                     .map(|m| (m.token.clone(), m.name.to_string()))
                     .unwrap_or_default();
                 let token = token.unwrap_or(get_token(Shared::clone(&self.token_arena), token_id));
-                Err(RuntimeError::NotDefined((*token).clone(), last_module, Box::new([])).into())
+                Err(RuntimeError::NotDefined(token.clone(), last_module, Box::new([])).into())
             }
         }
     }
@@ -927,7 +1031,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                 RuntimeValue::Array(Shared::new(values))
             }
             RuntimeValue::Dict(map) => {
-                let new_map: BTreeMap<_, _> = map
+                let new_map: runtime_value::Dict = map
                     .iter()
                     .map(|(k, v)| {
                         let new_v = if *k == *TYPE_IDENT {
@@ -984,6 +1088,68 @@ impl<T: ModuleResolver> Evaluator<T> {
         result
     }
 
+    /// Evaluates an optimizer-fused selector chain (`.h | .text | ...`).
+    ///
+    /// For arrays of nodes the whole chain is applied element by element in a
+    /// single pass, short-circuiting to `None` at the first non-matching stage,
+    /// so a document-sized array is scanned once per chain instead of once per
+    /// stage with a full-length intermediate array allocated each time. Stages
+    /// with array- or dict-level semantics (list indexing, `..`, properties,
+    /// attribute access) fall back to the staged evaluation they require.
+    fn eval_selector_chain(runtime_value: &RuntimeValue, selectors: &[Selector]) -> RuntimeValue {
+        let fusable = matches!(runtime_value, RuntimeValue::Array(_))
+            && selectors.iter().all(|selector| {
+                !matches!(
+                    selector,
+                    Selector::List(Some(_), None) | Selector::Recursive | Selector::Property(_) | Selector::Attr(_)
+                )
+            });
+
+        match runtime_value {
+            RuntimeValue::Array(values) if fusable => {
+                let mut results = Vec::with_capacity(values.len());
+                for value in values.iter() {
+                    Self::apply_chain_to_element(value, selectors, &mut results);
+                }
+                RuntimeValue::Array(Shared::new(results))
+            }
+            _ => selectors.iter().fold(runtime_value.clone(), |value, selector| {
+                Self::eval_selector_expr(&value, selector)
+            }),
+        }
+    }
+
+    /// Applies the remaining chain stages to one array element, mirroring the
+    /// per-element dispatch of [`Self::eval_selector_expr`]'s array arm.
+    fn apply_chain_to_element(value: &RuntimeValue, selectors: &[Selector], results: &mut Vec<RuntimeValue>) {
+        let Some((selector, rest)) = selectors.split_first() else {
+            results.push(value.clone());
+            return;
+        };
+
+        match value {
+            RuntimeValue::Markdown(node_value, _) => match builtin::eval_selector(node_value, selector) {
+                // A non-match contributes exactly one `None`, regardless of how
+                // many stages remain; later stages cannot revive it.
+                RuntimeValue::None => results.push(RuntimeValue::NONE),
+                RuntimeValue::Array(arr) => {
+                    for item in arr.iter() {
+                        Self::apply_chain_to_element(item, rest, results);
+                    }
+                }
+                other => Self::apply_chain_to_element(&other, rest, results),
+            },
+            _ if matches!(selector, Selector::List(None, None)) => {
+                Self::apply_chain_to_element(value, rest, results);
+            }
+            RuntimeValue::Dict(_) => {
+                let selected = Self::eval_selector_expr(value, selector);
+                Self::apply_chain_to_element(&selected, rest, results);
+            }
+            _ => results.push(RuntimeValue::NONE),
+        }
+    }
+
     fn eval_selector_expr(runtime_value: &RuntimeValue, selector: &Selector) -> RuntimeValue {
         if let Selector::Property(property_name) = selector {
             return Self::eval_property_selector_expr(runtime_value, property_name);
@@ -1024,7 +1190,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                 if matches!(selector, Selector::Recursive) {
                     return RuntimeValue::Array(Shared::new(Self::collect_recursive(runtime_value)));
                 }
-                let new_map: BTreeMap<_, _> = map
+                let new_map: runtime_value::Dict = map
                     .iter()
                     .map(|(k, v)| {
                         let new_v = if *k == *TYPE_IDENT {
@@ -1076,7 +1242,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                     ast::StringSegment::Env(env_var) => {
                         acc.push_str(&std::env::var(env_var).map_err(|_| {
                             RuntimeError::EnvNotFound(
-                                (*get_token(Shared::clone(&self.token_arena), token_id)).clone(),
+                                get_token(Shared::clone(&self.token_arena), token_id),
                                 env_var.clone(),
                             )
                         })?);
@@ -1098,7 +1264,7 @@ impl<T: ModuleResolver> Evaluator<T> {
         &mut self,
         breakpoint: &Breakpoint,
         runtime_value: &RuntimeValue,
-        token: &Shared<Token>,
+        token: &Token,
         env: &Shared<SharedCell<Env>>,
     ) -> Result<BreakpointDecision, EvalError> {
         if let Some(condition) = &breakpoint.condition {
@@ -1136,14 +1302,11 @@ impl<T: ModuleResolver> Evaluator<T> {
     fn eval_debug_expr(
         &mut self,
         code: &str,
-        token: &Shared<Token>,
+        token: &Token,
         env: &Shared<SharedCell<Env>>,
     ) -> Result<RuntimeValue, EvalError> {
         let program = parse(code, Shared::clone(&self.token_arena)).map_err(|e| {
-            RuntimeError::Runtime(
-                (**token).clone(),
-                format!("Invalid breakpoint expression \"{code}\": {e}"),
-            )
+            RuntimeError::Runtime(token.clone(), format!("Invalid breakpoint expression \"{code}\": {e}"))
         })?;
 
         let saved_env = std::mem::replace(&mut self.env, Shared::clone(env));
@@ -1154,7 +1317,7 @@ impl<T: ModuleResolver> Evaluator<T> {
 
         let values = result.map_err(|e| {
             RuntimeError::Runtime(
-                (**token).clone(),
+                token.clone(),
                 format!("Failed to evaluate breakpoint expression \"{code}\": {e}"),
             )
         })?;
@@ -1173,7 +1336,7 @@ impl<T: ModuleResolver> Evaluator<T> {
         &mut self,
         expr: &str,
         count: usize,
-        token: &Shared<Token>,
+        token: &Token,
         env: &Shared<SharedCell<Env>>,
     ) -> Result<bool, EvalError> {
         let trimmed = expr.trim();
@@ -1201,11 +1364,11 @@ impl<T: ModuleResolver> Evaluator<T> {
         &mut self,
         message: &str,
         runtime_value: &RuntimeValue,
-        token: &Shared<Token>,
+        token: &Token,
         env: &Shared<SharedCell<Env>>,
     ) -> Result<String, EvalError> {
         let segments = crate::lexer::parse_interpolation_segments(message, token.module_id)
-            .map_err(|_| RuntimeError::Runtime((**token).clone(), format!("Invalid log message \"{message}\"")))?;
+            .map_err(|_| RuntimeError::Runtime(token.clone(), format!("Invalid log message \"{message}\"")))?;
 
         segments
             .iter()
@@ -1220,7 +1383,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                         } else if let Some(var) = expr_str.strip_prefix('$') {
                             acc.push_str(
                                 &std::env::var(var)
-                                    .map_err(|_| RuntimeError::EnvNotFound((**token).clone(), var.into()))?,
+                                    .map_err(|_| RuntimeError::EnvNotFound(token.clone(), var.into()))?,
                             );
                         } else {
                             let value = self.eval_debug_expr(expr_str, token, env)?;
@@ -1233,11 +1396,32 @@ impl<T: ModuleResolver> Evaluator<T> {
             })
     }
 
+    #[inline(always)]
     fn eval_expr(
         &mut self,
         runtime_value: &RuntimeValue,
         node: &Shared<ast::Node>,
         env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        #[cfg(feature = "profiler")]
+        if self.profiler.is_some() {
+            let start = Instant::now();
+            let result = self.eval_expr_inner(runtime_value, node, env);
+            let elapsed = start.elapsed();
+            if let Some(profiler) = self.profiler.as_mut() {
+                profiler.record(node.token_id, elapsed);
+            }
+            return result;
+        }
+
+        self.eval_expr_inner(runtime_value, node, env)
+    }
+
+    fn eval_expr_inner(
+        &mut self,
+        runtime_value: &RuntimeValue,
+        node: &Shared<ast::Node>,
+        env: &Shared<SharedCell<Env>>,
     ) -> EvalResult {
         #[cfg(feature = "debugger")]
         if self.debugger.read().unwrap().is_active() {
@@ -1246,7 +1430,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             let debug_context = DebugContext {
                 current_value: runtime_value.clone(),
                 current_node: Shared::clone(node),
-                token: Shared::clone(token),
+                token: token.clone(),
                 call_stack,
                 env: Shared::clone(env),
                 source: Source {
@@ -1266,7 +1450,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                 .debugger
                 .read()
                 .unwrap()
-                .get_hit_breakpoint(&debug_context, Shared::clone(token));
+                .get_hit_breakpoint(&debug_context, token.clone());
 
             if let Some(breakpoint) = breakpoint {
                 match self.eval_breakpoint(&breakpoint, runtime_value, token, env)? {
@@ -1294,9 +1478,7 @@ impl<T: ModuleResolver> Evaluator<T> {
 
         match &*node.expr {
             ast::Expr::Selector(ident) => Ok(Self::eval_selector_expr(runtime_value, ident)),
-            ast::Expr::SelectorChain(selectors) => Ok(selectors
-                .iter()
-                .fold(runtime_value.clone(), |v, sel| Self::eval_selector_expr(&v, sel))),
+            ast::Expr::SelectorChain(selectors) => Ok(Self::eval_selector_chain(runtime_value, selectors)),
             ast::Expr::SelectorCall(selector, args) => {
                 let evaluated_args = args
                     .iter()
@@ -1357,7 +1539,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                             }
                         }
                         None => {
-                            let token = (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone();
+                            let token = get_token(Shared::clone(&self.token_arena), node.token_id);
                             return Err(RuntimeError::DestructuringFailed(token).into());
                         }
                     }
@@ -1376,7 +1558,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                             }
                         }
                         None => {
-                            let token = (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone();
+                            let token = get_token(Shared::clone(&self.token_arena), node.token_id);
                             return Err(RuntimeError::DestructuringFailed(token).into());
                         }
                     }
@@ -1392,8 +1574,8 @@ impl<T: ModuleResolver> Evaluator<T> {
                             ident
                                 .token
                                 .as_ref()
-                                .map(|t| (**t).clone())
-                                .unwrap_or((*get_token(Shared::clone(&self.token_arena), node.token_id)).clone()),
+                                .map(|t| (*t).clone())
+                                .unwrap_or(get_token(Shared::clone(&self.token_arena), node.token_id)),
                         )
                     })?;
                 }
@@ -1405,8 +1587,8 @@ impl<T: ModuleResolver> Evaluator<T> {
                             ident
                                 .token
                                 .as_ref()
-                                .map(|t| (**t).clone())
-                                .unwrap_or((*get_token(Shared::clone(&self.token_arena), node.token_id)).clone()),
+                                .map(|t| (*t).clone())
+                                .unwrap_or(get_token(Shared::clone(&self.token_arena), node.token_id)),
                         )
                     })?;
                 }
@@ -1441,17 +1623,17 @@ impl<T: ModuleResolver> Evaluator<T> {
                     Some(node) => Some(Box::new(self.eval_expr(runtime_value, node, env)?)),
                     None => None,
                 };
-                Err(EvalError::Flow(ControlFlow::Break((*token).clone(), value)))
+                Err(EvalError::Flow(ControlFlow::Break(token.clone(), value)))
             }
             ast::Expr::Continue => {
                 let token = get_token(Shared::clone(&self.token_arena), node.token_id);
-                Err(EvalError::Flow(ControlFlow::Continue((*token).clone())))
+                Err(EvalError::Flow(ControlFlow::Continue(token.clone())))
             }
             ast::Expr::Paren(expr) => self.eval_expr(runtime_value, expr, env),
             ast::Expr::Quote(inner) => self.eval_quote(inner, env),
             ast::Expr::Unquote(_) => {
                 let token = get_token(Shared::clone(&self.token_arena), node.token_id);
-                Err(RuntimeError::UnquoteNotAllowedOutsideQuote((*token).clone()).into())
+                Err(RuntimeError::UnquoteNotAllowedOutsideQuote(token.clone()).into())
             }
         }
     }
@@ -1550,7 +1732,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             }
             _ => {
                 return Err(RuntimeError::InvalidTypes {
-                    token: (*get_token(Shared::clone(&self.token_arena), token_id)).clone(),
+                    token: get_token(Shared::clone(&self.token_arena), token_id),
                     name: TokenKind::Foreach.to_string(),
                     args: vec![values.to_string().into()],
                 }
@@ -1645,7 +1827,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             Err(EvalError::Flow(flow)) => Err(EvalError::Flow(flow)),
             Err(EvalError::Runtime(err)) => match error_binder {
                 Some(binder) => {
-                    let mut error_dict = BTreeMap::new();
+                    let mut error_dict = runtime_value::Dict::default();
                     error_dict.insert(*ERROR_MESSAGE_IDENT, RuntimeValue::String(err.to_string()));
                     let catch_env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(env))));
                     define(&catch_env, binder.name, RuntimeValue::Dict(Shared::new(error_dict)));
@@ -1805,7 +1987,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             Ok(value)
         } else {
             let token = get_token(Shared::clone(&self.token_arena), node.token_id);
-            Err(RuntimeError::InvalidMacroResultAst((*token).clone()).into())
+            Err(RuntimeError::InvalidMacroResultAst(token.clone()).into())
         }
     }
 
@@ -1955,7 +2137,13 @@ impl<T: ModuleResolver> Evaluator<T> {
 
         match resolved {
             Ok(fn_value) => self.call_fn(&fn_value, node, ident, args, runtime_value, env),
-            Err(_) => self.eval_builtin(runtime_value, node, &ident, args, env),
+            Err(_) => {
+                if let Some(kind) = ParallelCollection::from_ident(&ident) {
+                    let args = self.eval_call_args(runtime_value, &node, &ident, args, env)?;
+                    return self.eval_parallel_collection(kind, node, ident, args, env);
+                }
+                self.eval_builtin(runtime_value, node, &ident, args, env)
+            }
         }
     }
 
@@ -2052,6 +2240,35 @@ impl<T: ModuleResolver> Evaluator<T> {
         )
     }
 
+    /// Returns a call frame parented at `parent`, reusing a pooled frame when one
+    /// is available instead of allocating a fresh shared `Env`.
+    #[inline(always)]
+    fn alloc_call_env(&mut self, parent: &Shared<SharedCell<Env>>) -> Shared<SharedCell<Env>> {
+        match self.env_pool.pop() {
+            Some(env) => {
+                #[cfg(not(feature = "sync"))]
+                env.borrow_mut().reset_for_call(Shared::downgrade(parent));
+                #[cfg(feature = "sync")]
+                env.write().unwrap().reset_for_call(Shared::downgrade(parent));
+                env
+            }
+            None => Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(parent)))),
+        }
+    }
+
+    /// Returns a finished call frame to the pool.
+    ///
+    /// A frame is only reusable when nothing else still refers to it: a closure
+    /// that escaped the call holds a strong handle, and an escaped child scope
+    /// holds a weak one. Such frames must stay alive as they are, so they are
+    /// dropped from the pool's point of view and live on with their owners.
+    #[inline(always)]
+    fn recycle_call_env(&mut self, env: Shared<SharedCell<Env>>) {
+        if self.env_pool.len() < ENV_POOL_CAPACITY && Shared::strong_count(&env) == 1 && Shared::weak_count(&env) == 0 {
+            self.env_pool.push(env);
+        }
+    }
+
     #[inline(always)]
     fn enter_scope(&mut self) -> Result<(), EvalError> {
         if self.call_stack_depth >= self.options.max_call_stack_depth {
@@ -2104,7 +2321,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             #[cfg(feature = "debugger")]
             self.debugger.write().unwrap().push_call_stack(Shared::clone(&node));
 
-            let new_env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(fn_env))));
+            let new_env = self.alloc_call_env(fn_env);
 
             // If the function name matches a built-in, expose the native builtin in the
             // body's scope so calls to the same name invoke the builtin rather than
@@ -2125,7 +2342,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                     true
                 } else {
                     return Err(RuntimeError::InvalidNumberOfArguments {
-                        token: (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone(),
+                        token: get_token(Shared::clone(&self.token_arena), node.token_id),
                         name: ident.to_string(),
                         expected: required_params as u8,
                         actual: args.len() as u8,
@@ -2139,7 +2356,7 @@ impl<T: ModuleResolver> Evaluator<T> {
             } else {
                 // arg_count > param_count: too many arguments
                 return Err(RuntimeError::InvalidNumberOfArguments {
-                    token: (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone(),
+                    token: get_token(Shared::clone(&self.token_arena), node.token_id),
                     name: ident.to_string(),
                     expected: params.len() as u8,
                     actual: args.len() as u8,
@@ -2174,7 +2391,7 @@ impl<T: ModuleResolver> Evaluator<T> {
                     define(&new_env, param.ident.name, val);
                 } else {
                     return Err(RuntimeError::InvalidNumberOfArguments {
-                        token: (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone(),
+                        token: get_token(Shared::clone(&self.token_arena), node.token_id),
                         name: ident.to_string(),
                         expected: params.len() as u8,
                         actual: args.len() as u8,
@@ -2188,17 +2405,313 @@ impl<T: ModuleResolver> Evaluator<T> {
             #[cfg(feature = "debugger")]
             self.debugger.write().unwrap().pop_call_stack();
 
+            self.recycle_call_env(new_env);
             result
         } else if let RuntimeValue::NativeFunction(ident) = fn_value {
             self.eval_builtin(runtime_value, node, ident, args, env)
         } else {
             Err(RuntimeError::InvalidDefinition(
-                (*get_token(Shared::clone(&self.token_arena), node.token_id)).clone(),
+                get_token(Shared::clone(&self.token_arena), node.token_id),
                 ident.to_string(),
             )
             .into())
         }
     }
+
+    /// Calls a function value with already-evaluated arguments.
+    ///
+    /// Mirrors [`Self::call_fn`], but takes `RuntimeValue`s instead of argument ASTs
+    /// so callers that evaluate arguments themselves (the bytecode VM, host-driven
+    /// invocation) can share the parameter-binding and arity rules. Default parameter
+    /// expressions are still evaluated lazily in the callee's scope.
+    pub(crate) fn call_fn_with_values(
+        &mut self,
+        fn_value: &RuntimeValue,
+        node: Shared<ast::Node>,
+        ident: Ident,
+        arg_values: Vec<RuntimeValue>,
+        runtime_value: &RuntimeValue,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        if let RuntimeValue::Function(params, program, fn_env) = fn_value {
+            self.enter_scope()?;
+            #[cfg(feature = "debugger")]
+            self.debugger.write().unwrap().push_call_stack(Shared::clone(&node));
+
+            let new_env = self.alloc_call_env(fn_env);
+
+            if builtin::get_builtin_functions(&ident).is_some() {
+                define(&new_env, ident, RuntimeValue::NativeFunction(ident));
+            }
+
+            let has_variadic = params.iter().any(|p| p.is_variadic);
+            let required_params = params.iter().filter(|p| p.default.is_none() && !p.is_variadic).count();
+            let arg_count = arg_values.len();
+            let param_count = params.len();
+
+            let use_self_param = if has_variadic {
+                if arg_count >= required_params {
+                    false
+                } else if arg_count + 1 >= required_params {
+                    true
+                } else {
+                    return Err(RuntimeError::InvalidNumberOfArguments {
+                        token: get_token(Shared::clone(&self.token_arena), node.token_id),
+                        name: ident.to_string(),
+                        expected: required_params as u8,
+                        actual: arg_count as u8,
+                    }
+                    .into());
+                }
+            } else if arg_count >= required_params && arg_count <= param_count {
+                false
+            } else if arg_count + 1 >= required_params && arg_count < param_count {
+                true
+            } else {
+                return Err(RuntimeError::InvalidNumberOfArguments {
+                    token: get_token(Shared::clone(&self.token_arena), node.token_id),
+                    name: ident.to_string(),
+                    expected: params.len() as u8,
+                    actual: arg_count as u8,
+                }
+                .into());
+            };
+
+            let mut param_iter = params.iter();
+            let mut arg_iter = arg_values.into_iter();
+
+            if use_self_param && let Some(param) = param_iter.next() {
+                define(&new_env, param.ident.name, runtime_value.clone());
+            }
+
+            for param in param_iter {
+                if param.is_variadic {
+                    let variadic_args: Vec<RuntimeValue> = arg_iter.by_ref().collect();
+                    define(
+                        &new_env,
+                        param.ident.name,
+                        RuntimeValue::Array(Shared::new(variadic_args)),
+                    );
+                } else if let Some(val) = arg_iter.next() {
+                    define(&new_env, param.ident.name, val);
+                } else if let Some(default_expr) = &param.default {
+                    let val = self.eval_expr(runtime_value, default_expr, &new_env)?;
+                    define(&new_env, param.ident.name, val);
+                } else {
+                    return Err(RuntimeError::InvalidNumberOfArguments {
+                        token: get_token(Shared::clone(&self.token_arena), node.token_id),
+                        name: ident.to_string(),
+                        expected: params.len() as u8,
+                        actual: arg_count as u8,
+                    }
+                    .into());
+                }
+            }
+
+            let result = self.eval_program(program, runtime_value.clone(), &new_env);
+            self.exit_scope();
+            #[cfg(feature = "debugger")]
+            self.debugger.write().unwrap().pop_call_stack();
+
+            self.recycle_call_env(new_env);
+            result
+        } else if let RuntimeValue::NativeFunction(native_ident) = fn_value {
+            builtin::eval_builtin(runtime_value, native_ident, arg_values, env)
+                .map_err(|e| EvalError::from(e.to_runtime_error((*node).clone(), Shared::clone(&self.token_arena))))
+        } else {
+            Err(RuntimeError::InvalidDefinition(
+                get_token(Shared::clone(&self.token_arena), node.token_id),
+                ident.to_string(),
+            )
+            .into())
+        }
+    }
+
+    /// Evaluates one of the parallel collection functions (`pmap`, `pfilter`,
+    /// `pgroup_by`) over an already-evaluated argument list.
+    ///
+    /// The first argument must be an array (`None` propagates as `None`) and the
+    /// second a function value. With the `sync` feature the array is split into
+    /// contiguous chunks, each processed by a worker thread holding its own
+    /// evaluator clone, and results are reassembled in input order; without it
+    /// the elements are processed sequentially with identical semantics. The
+    /// supplied function should not mutate shared state, since workers may apply
+    /// it concurrently.
+    pub(crate) fn eval_parallel_collection(
+        &mut self,
+        kind: ParallelCollection,
+        node: Shared<ast::Node>,
+        ident: Ident,
+        args: Vec<RuntimeValue>,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        if args.len() != 2 {
+            return Err(RuntimeError::InvalidNumberOfArguments {
+                token: get_token(Shared::clone(&self.token_arena), node.token_id),
+                name: ident.to_string(),
+                expected: 2,
+                actual: args.len() as u8,
+            }
+            .into());
+        }
+
+        let mut args = args.into_iter();
+        let (Some(target), Some(fn_value)) = (args.next(), args.next()) else {
+            // Unreachable: the argument count was validated above.
+            return Ok(RuntimeValue::None);
+        };
+
+        let values = match target {
+            RuntimeValue::None => return Ok(RuntimeValue::None),
+            RuntimeValue::Array(values) => values,
+            other => {
+                return Err(RuntimeError::InvalidTypes {
+                    token: get_token(Shared::clone(&self.token_arena), node.token_id),
+                    name: ident.to_string(),
+                    args: vec![other.to_string().into()],
+                }
+                .into());
+            }
+        };
+
+        if !matches!(
+            fn_value,
+            RuntimeValue::Function(_, _, _) | RuntimeValue::NativeFunction(_)
+        ) {
+            return Err(RuntimeError::InvalidTypes {
+                token: get_token(Shared::clone(&self.token_arena), node.token_id),
+                name: ident.to_string(),
+                args: vec![fn_value.to_string().into()],
+            }
+            .into());
+        }
+
+        let mapped = self.apply_to_elements(&fn_value, &node, ident, &values, env)?;
+
+        match kind {
+            ParallelCollection::Map => Ok(RuntimeValue::Array(Shared::new(mapped))),
+            ParallelCollection::Filter => {
+                let filtered = values
+                    .iter()
+                    .zip(mapped.iter())
+                    .filter(|(_, keep)| keep.is_truthy())
+                    .map(|(value, _)| value.clone())
+                    .collect();
+                Ok(RuntimeValue::Array(Shared::new(filtered)))
+            }
+            ParallelCollection::GroupBy => {
+                let mut groups: indexmap::IndexMap<Ident, Vec<RuntimeValue>, rustc_hash::FxBuildHasher> =
+                    indexmap::IndexMap::default();
+                for (value, key) in values.iter().zip(mapped.iter()) {
+                    groups
+                        .entry(Ident::new(&key.to_string()))
+                        .or_default()
+                        .push(value.clone());
+                }
+                let dict: runtime_value::Dict = groups
+                    .into_iter()
+                    .map(|(key, group)| (key, RuntimeValue::Array(Shared::new(group))))
+                    .collect();
+                Ok(RuntimeValue::Dict(Shared::new(dict)))
+            }
+        }
+    }
+
+    /// Applies `fn_value` to each element of `values`, returning the results in
+    /// input order. Fans out across worker threads when the `sync` feature is
+    /// enabled and the array is large enough to amortize the thread handoff.
+    fn apply_to_elements(
+        &mut self,
+        fn_value: &RuntimeValue,
+        node: &Shared<ast::Node>,
+        ident: Ident,
+        values: &[RuntimeValue],
+        env: &Shared<SharedCell<Env>>,
+    ) -> Result<Vec<RuntimeValue>, EvalError> {
+        #[cfg(feature = "sync")]
+        {
+            let threads = std::thread::available_parallelism().map(|n| n.get()).unwrap_or(1);
+            if values.len() >= PARALLEL_MIN_LEN && threads > 1 {
+                return self.apply_to_elements_parallel(fn_value, node, ident, values, env, threads);
+            }
+        }
+        self.apply_to_elements_seq(fn_value, node, ident, values, env)
+    }
+
+    fn apply_to_elements_seq(
+        &mut self,
+        fn_value: &RuntimeValue,
+        node: &Shared<ast::Node>,
+        ident: Ident,
+        values: &[RuntimeValue],
+        env: &Shared<SharedCell<Env>>,
+    ) -> Result<Vec<RuntimeValue>, EvalError> {
+        values
+            .iter()
+            .map(|value| {
+                self.check_timeout()?;
+                self.call_fn_with_values(fn_value, Shared::clone(node), ident, vec![value.clone()], value, env)
+            })
+            .collect()
+    }
+
+    /// Splits `values` into one contiguous chunk per worker and evaluates each
+    /// chunk on its own thread, so call frames and scope tracking stay
+    /// isolated. Each worker gets a fresh evaluator sharing the caller's token
+    /// arena, options, and deadline but a default module loader, so the
+    /// supplied function must not `include` modules. Results come back in
+    /// input order; the first error (by chunk order) wins.
+    #[cfg(feature = "sync")]
+    fn apply_to_elements_parallel(
+        &self,
+        fn_value: &RuntimeValue,
+        node: &Shared<ast::Node>,
+        ident: Ident,
+        values: &[RuntimeValue],
+        env: &Shared<SharedCell<Env>>,
+        threads: usize,
+    ) -> Result<Vec<RuntimeValue>, EvalError> {
+        let chunk_size = values.len().div_ceil(threads).max(1);
+        let chunk_results: Vec<Result<Vec<RuntimeValue>, EvalError>> = std::thread::scope(|scope| {
+            let handles: Vec<_> = values
+                .chunks(chunk_size)
+                .map(|chunk| {
+                    let token_arena = Shared::clone(&self.token_arena);
+                    let options = self.options.clone();
+                    let deadline = self.deadline;
+                    let backend = self.backend;
+                    let node = Shared::clone(node);
+                    let env = Shared::clone(env);
+                    scope.spawn(move || {
+                        let mut worker =
+                            Evaluator::new(module::ModuleLoader::new(DefaultModuleResolver::default()), token_arena);
+                        worker.options = options;
+                        worker.deadline = deadline;
+                        worker.backend = backend;
+                        worker.apply_to_elements_seq(fn_value, &node, ident, chunk, &env)
+                    })
+                })
+                .collect();
+            handles
+                .into_iter()
+                .map(|handle| {
+                    handle.join().unwrap_or_else(|_| {
+                        Err(RuntimeError::Runtime(
+                            get_token(Shared::clone(&self.token_arena), node.token_id),
+                            "parallel worker panicked".to_string(),
+                        )
+                        .into())
+                    })
+                })
+                .collect()
+        });
+
+        let mut results = Vec::with_capacity(values.len());
+        for chunk in chunk_results {
+            results.extend(chunk?);
+        }
+        Ok(results)
+    }
 }
 
 #[inline(always)]
@@ -2295,16 +2808,16 @@ mod tests {
     }
 
     #[fixture]
-    fn token_arena() -> Shared<SharedCell<Arena<Shared<Token>>>> {
+    fn token_arena() -> Shared<SharedCell<Arena<Token>>> {
         let token_arena = Shared::new(SharedCell::new(Arena::new(10)));
 
         token_alloc(
             &token_arena,
-            &Shared::new(Token {
+            &Token {
                 kind: TokenKind::Eof,
                 range: Range::default(),
                 module_id: 1.into(),
-            }),
+            },
         );
 
         token_arena
@@ -3096,7 +3609,7 @@ mod tests {
                     ast_node(ast::Expr::Literal(ast::Literal::Number(1.into()))),
                 ]),
        ],
-       Err(InnerError::Runtime(RuntimeError::Runtime(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
+       Err(InnerError::Runtime(RuntimeError::Runtime(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
     #[case::sub(vec![RuntimeValue::String("testString".to_string())],
        vec![
             ast_call("sub", smallvec![
@@ -3120,7 +3633,7 @@ mod tests {
                     ast_node(ast::Expr::Literal(ast::Literal::Number(1.into()))),
                 ])
        ],
-       Err(InnerError::Runtime(RuntimeError::Runtime(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
+       Err(InnerError::Runtime(RuntimeError::Runtime(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
     #[case::div(vec![RuntimeValue::String("testString".to_string())],
        vec![
             ast_call("div", smallvec![
@@ -3128,7 +3641,7 @@ mod tests {
                     ast_node(ast::Expr::Literal(ast::Literal::Number(0.into()))),
                 ])
        ],
-       Err(InnerError::Runtime(RuntimeError::ZeroDivision(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}))))]
+       Err(InnerError::Runtime(RuntimeError::ZeroDivision(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}))))]
     #[case::div(vec![RuntimeValue::String("testString".to_string())],
        vec![
             ast_call("div", smallvec![
@@ -3184,7 +3697,7 @@ mod tests {
                     ast_node(ast::Expr::Literal(ast::Literal::Number(1.into()))),
                 ]),
        ],
-       Err(InnerError::Runtime(RuntimeError::Runtime(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
+       Err(InnerError::Runtime(RuntimeError::Runtime(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
     #[case::pow(vec![RuntimeValue::String("testString".to_string())],
        vec![
             ast_call("pow", smallvec![
@@ -3882,7 +4395,7 @@ mod tests {
        vec![
             ast_call("to_number", SmallVec::new())
        ],
-       Err(InnerError::Runtime(RuntimeError::Runtime(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
+       Err(InnerError::Runtime(RuntimeError::Runtime(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
     #[case::to_number_array(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("42".to_string()), RuntimeValue::String("43".to_string()), RuntimeValue::String("44".to_string())]))],
         vec![
               ast_call("to_number", SmallVec::new())
@@ -3897,7 +4410,7 @@ mod tests {
         vec![
               ast_call("to_number", SmallVec::new())
         ],
-        Err(InnerError::Runtime(RuntimeError::Runtime(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
+        Err(InnerError::Runtime(RuntimeError::Runtime(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "invalid float literal".to_string()))))]
     #[case::to_number_array_empty(vec![RuntimeValue::Array(Shared::new(Vec::new()))],
         vec![
               ast_call("to_number", SmallVec::new())
@@ -4799,7 +5312,7 @@ mod tests {
         vec![
             ast_call("from_date", SmallVec::new())
         ],
-        Err(InnerError::Runtime(RuntimeError::Runtime(Token { range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "premature end of input".to_string()))))]
+        Err(InnerError::Runtime(RuntimeError::Runtime(Token{ range: Range::default(), kind: TokenKind::Eof, module_id: 1.into()}, "premature end of input".to_string()))))]
     #[case::from_date(vec![RuntimeValue::Number(1.into())],
         vec![
             ast_call("from_date", SmallVec::new())
@@ -7264,7 +7777,7 @@ mod tests {
         Ok(vec![RuntimeValue::String("other".to_string())])
     )]
     fn test_eval(
-        token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
+        token_arena: Shared<SharedCell<Arena<Token>>>,
         #[case] runtime_values: Vec<RuntimeValue>,
         #[case] program: Program,
         #[case] expected: Result<Vec<RuntimeValue>, InnerError>,
@@ -7513,7 +8026,7 @@ mod tests {
         Ok(vec![RuntimeValue::Number(42.into())])
     )]
     fn test_import_qualified_access_paren_free(
-        token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
+        token_arena: Shared<SharedCell<Arena<Token>>>,
         #[case] module_name: &str,
         #[case] module_content: &str,
         #[case] member_name: &str,
@@ -7540,7 +8053,7 @@ mod tests {
     /// A 2-arg function accessed via QualifiedAccess must NOT be auto-called;
     /// the function value itself should be the pipeline output.
     #[rstest]
-    fn test_import_qualified_access_paren_free_skips_multi_arg(token_arena: Shared<SharedCell<Arena<Shared<Token>>>>) {
+    fn test_import_qualified_access_paren_free_skips_multi_arg(token_arena: Shared<SharedCell<Arena<Token>>>) {
         let (temp_dir, temp_file_path) = create_file("qa_pf_multi_skip.mq", r#"def add(a, b): a + b;"#);
 
         defer! {
@@ -7828,7 +8341,7 @@ mod tests {
         Ok(vec![RuntimeValue::String("Is true: true".to_string())])
     )]
     fn test_interpolated_string_eval(
-        token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
+        token_arena: Shared<SharedCell<Arena<Token>>>,
         #[case] runtime_values: Vec<RuntimeValue>,
         #[case] program: Program,
         #[case] expected: Result<Vec<RuntimeValue>, InnerError>,
@@ -8204,16 +8717,16 @@ mod debugger_tests {
     use crate::{AstNode, DebuggerAction, IdentWithToken, ModuleLoader, Range, token_alloc};
 
     #[fixture]
-    fn token_arena() -> Shared<SharedCell<Arena<Shared<Token>>>> {
+    fn token_arena() -> Shared<SharedCell<Arena<Token>>> {
         let token_arena = Shared::new(SharedCell::new(Arena::new(10)));
 
         token_alloc(
             &token_arena,
-            &Shared::new(Token {
+            &Token {
                 kind: TokenKind::Eof,
                 range: Range::default(),
                 module_id: 1.into(),
-            }),
+            },
         );
 
         token_arena
@@ -8266,7 +8779,7 @@ mod debugger_tests {
     }
 
     #[rstest]
-    fn test_eval_debugger_breakpoint_call(token_arena: Shared<SharedCell<Arena<Shared<Token>>>>) {
+    fn test_eval_debugger_breakpoint_call(token_arena: Shared<SharedCell<Arena<Token>>>) {
         let handler = Shared::new(SharedCell::new(
             Box::new(TestDebuggerHandler::new(DebuggerAction::Continue)) as Box<dyn DebuggerHandler>,
         ));
@@ -8489,4 +9002,79 @@ mod debugger_tests {
         let query = "foreach (x, array(1)):\n  x\nend";
         assert!(engine.eval(query, crate::null_input().into_iter()).is_err());
     }
+
+    #[test]
+    fn test_env_pool_recycles_only_unreferenced_frames() {
+        let mut evaluator: Evaluator = Evaluator::default();
+        let parent = Shared::new(SharedCell::new(Env::default()));
+
+        let frame = evaluator.alloc_call_env(&parent);
+        evaluator.recycle_call_env(frame);
+        assert_eq!(evaluator.env_pool.len(), 1);
+
+        let frame = evaluator.alloc_call_env(&parent);
+        assert!(evaluator.env_pool.is_empty(), "pool hit must pop the stored frame");
+
+        // A frame someone still holds strongly (an escaped closure) must not be pooled.
+        let keep = Shared::clone(&frame);
+        evaluator.recycle_call_env(frame);
+        assert!(evaluator.env_pool.is_empty());
+        drop(keep);
+
+        // A frame with an outstanding weak handle (an escaped child scope) must not be pooled.
+        let frame = evaluator.alloc_call_env(&parent);
+        let escaped_child = Shared::downgrade(&frame);
+        evaluator.recycle_call_env(frame);
+        assert!(evaluator.env_pool.is_empty());
+        drop(escaped_child);
+    }
+
+    #[test]
+    fn test_env_pool_reused_frame_starts_empty() {
+        let mut evaluator: Evaluator = Evaluator::default();
+        let parent = Shared::new(SharedCell::new(Env::default()));
+
+        let frame = evaluator.alloc_call_env(&parent);
+        define(&frame, Ident::new("leftover"), RuntimeValue::Number(1.0.into()));
+        evaluator.recycle_call_env(frame);
+
+        let other_parent = Shared::new(SharedCell::new(Env::default()));
+        let frame = evaluator.alloc_call_env(&other_parent);
+        #[cfg(not(feature = "sync"))]
+        let env = frame.borrow();
+        #[cfg(feature = "sync")]
+        let env = frame.read().unwrap();
+        assert_eq!(env.len(), 0, "recycled frame must not leak previous bindings");
+        assert!(env.resolve(Ident::new("leftover")).is_err());
+    }
+
+    #[rstest]
+    #[case::kind_chain(vec![Selector::Heading(None), Selector::Text])]
+    #[case::heading_level(vec![Selector::List(None, None), Selector::Heading(Some(2))])]
+    #[case::all_non_matching(vec![Selector::Code, Selector::Blockquote])]
+    #[case::staged_fallback(vec![Selector::Heading(None), Selector::Recursive])]
+    fn test_selector_chain_matches_staged_evaluation(#[case] selectors: Vec<Selector>) {
+        let input = RuntimeValue::Array(Shared::new(vec![
+            RuntimeValue::new_markdown(mq_markdown::Node::Heading(mq_markdown::Heading {
+                values: vec![mq_markdown::Node::Text(mq_markdown::Text {
+                    position: None,
+                    value: "title".to_string(),
+                })],
+                position: None,
+                depth: 2,
+            })),
+            RuntimeValue::String("not markdown".to_string()),
+            RuntimeValue::new_markdown(mq_markdown::Node::Text(mq_markdown::Text {
+                position: None,
+                value: "plain".to_string(),
+            })),
+            RuntimeValue::NONE,
+        ]));
+
+        let staged = selectors.iter().fold(input.clone(), |value, selector| {
+            Evaluator::<DefaultModuleResolver>::eval_selector_expr(&value, selector)
+        });
+        let fused = Evaluator::<DefaultModuleResolver>::eval_selector_chain(&input, &selectors);
+        assert_eq!(fused, staged);
+    }
 }
@@ -30,7 +30,6 @@ use rustc_hash::{FxBuildHasher, FxHashMap, FxHashSet};
 use similar::{ChangeTag, TextDiff};
 use smol_str::SmolStr;
 use std::borrow::Cow;
-use std::collections::BTreeMap;
 use std::io;
 use std::process::exit;
 use std::sync::LazyLock;
@@ -39,7 +38,7 @@ use unicode_width::{UnicodeWidthChar, UnicodeWidthStr};
 
 use self::range::{generate_char_range, generate_multi_char_range, generate_numeric_range};
 use self::regex::{capture_re, is_match_re, match_re, replace_re, scan_re, split_re};
-use super::runtime_value::{self, RuntimeValue};
+use super::runtime_value::{self, Dict, RuntimeValue};
 use mq_markdown;
 
 /// Maximum number of elements allowed in a generated range
@@ -1178,7 +1177,15 @@ fn replace_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv)
             RuntimeValue::String(s1),
             RuntimeValue::String(s2),
             RuntimeValue::String(s3),
-        ] => Ok(s1.replace(&*s2, &*s3).into()),
+        ] => {
+            // `str::replace` always allocates a fresh copy; hand the original
+            // buffer back untouched when the pattern cannot match.
+            if s1.contains(&*s2) {
+                Ok(s1.replace(&*s2, &*s3).into())
+            } else {
+                Ok(std::mem::take(s1).into())
+            }
+        }
         [
             node @ RuntimeValue::Markdown(_, _),
             RuntimeValue::String(s1),
@@ -1283,9 +1290,9 @@ fn implode_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv)
         [RuntimeValue::Array(array)] => {
             let result: String = array
                 .iter()
-                .map(|o| match o {
-                    RuntimeValue::Number(n) => std::char::from_u32(n.value() as u32).unwrap_or_default().to_string(),
-                    _ => "".to_string(),
+                .filter_map(|o| match o {
+                    RuntimeValue::Number(n) => Some(std::char::from_u32(n.value() as u32).unwrap_or_default()),
+                    _ => None,
                 })
                 .collect();
             Ok(result.into())
@@ -1298,7 +1305,13 @@ fn implode_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv)
 #[mq_macros::mq_fn(name = "trim", params = Fixed(1))]
 fn trim_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Result<RuntimeValue, Error> {
     match args.as_mut_slice() {
-        [RuntimeValue::String(s)] => Ok(s.trim().to_string().into()),
+        [RuntimeValue::String(s)] => {
+            let mut s = std::mem::take(s);
+            s.truncate(s.trim_end().len());
+            let start = s.len() - s.trim_start().len();
+            s.drain(..start);
+            Ok(s.into())
+        }
         [node @ RuntimeValue::Markdown(_, _)] => node
             .markdown_node()
             .map(|md| Ok(node.update_markdown_value(md.to_string().trim())))
@@ -1312,7 +1325,12 @@ fn trim_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) ->
 #[mq_macros::mq_fn(name = "ltrim", params = Fixed(1))]
 fn ltrim_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Result<RuntimeValue, Error> {
     match args.as_mut_slice() {
-        [RuntimeValue::String(s)] => Ok(s.trim_start().to_string().into()),
+        [RuntimeValue::String(s)] => {
+            let mut s = std::mem::take(s);
+            let start = s.len() - s.trim_start().len();
+            s.drain(..start);
+            Ok(s.into())
+        }
         [node @ RuntimeValue::Markdown(_, _)] => node
             .markdown_node()
             .map(|md| Ok(node.update_markdown_value(md.to_string().trim_start())))
@@ -1326,7 +1344,11 @@ fn ltrim_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) ->
 #[mq_macros::mq_fn(name = "rtrim", params = Fixed(1))]
 fn rtrim_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Result<RuntimeValue, Error> {
     match args.as_mut_slice() {
-        [RuntimeValue::String(s)] => Ok(s.trim_end().to_string().into()),
+        [RuntimeValue::String(s)] => {
+            let mut s = std::mem::take(s);
+            s.truncate(s.trim_end().len());
+            Ok(s.into())
+        }
         [node @ RuntimeValue::Markdown(_, _)] => node
             .markdown_node()
             .map(|md| Ok(node.update_markdown_value(md.to_string().trim_end())))
@@ -1390,8 +1412,7 @@ fn slice_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) ->
             RuntimeValue::Number(start),
             RuntimeValue::Number(end),
         ] => {
-            let chars: Vec<char> = s.chars().collect();
-            let len = chars.len();
+            let len = s.chars().count();
             let start = start.value() as isize;
             let end = end.value() as isize;
 
@@ -1411,8 +1432,15 @@ fn slice_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) ->
                 return Ok("".into());
             }
 
-            let sub: String = chars[real_start..real_end].iter().collect();
-            Ok(sub.into())
+            // Map character positions to byte offsets so the substring is a
+            // single copy, without buffering the input as a `Vec<char>`.
+            let byte_start = s.char_indices().nth(real_start).map(|(i, _)| i).unwrap_or(s.len());
+            let byte_end = s[byte_start..]
+                .char_indices()
+                .nth(real_end - real_start)
+                .map(|(i, _)| byte_start + i)
+                .unwrap_or(s.len());
+            Ok(s[byte_start..byte_end].to_string().into())
         }
         [
             RuntimeValue::Array(arrays),
@@ -1764,12 +1792,12 @@ fn del_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> R
         [RuntimeValue::None, RuntimeValue::Number(_)] => Ok(RuntimeValue::NONE),
         [RuntimeValue::Dict(dict), RuntimeValue::String(key)] => {
             let mut dict = std::mem::take(dict);
-            runtime_value::dict_mut(&mut dict).remove(&Ident::new(key));
+            runtime_value::dict_mut(&mut dict).shift_remove(&Ident::new(key));
             Ok(RuntimeValue::Dict(dict))
         }
         [RuntimeValue::Dict(dict), RuntimeValue::Symbol(key)] => {
             let mut dict = std::mem::take(dict);
-            runtime_value::dict_mut(&mut dict).remove(key);
+            runtime_value::dict_mut(&mut dict).shift_remove(key);
             Ok(RuntimeValue::Dict(dict))
         }
         [a, b] => Err(Error::InvalidTypes(
@@ -2925,7 +2953,7 @@ fn dict_impl(_: &Ident, _: &RuntimeValue, args: Args, _: &SharedEnv) -> Result<R
     if args.is_empty() {
         Ok(RuntimeValue::new_dict())
     } else {
-        let mut dict = BTreeMap::default();
+        let mut dict = Dict::default();
         let entries: Cow<'_, [RuntimeValue]> = match args.as_slice() {
             [RuntimeValue::Array(entries)] => match entries.as_slice() {
                 [RuntimeValue::Array(_)] if args.len() == 1 => Cow::Borrowed(entries),
@@ -3335,7 +3363,7 @@ fn _csv_parse_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEn
             .records()
             .map(|record| {
                 let record = record.map_err(|e| Error::Runtime(format!("Failed to parse CSV record: {e}")))?;
-                let map: BTreeMap<Ident, RuntimeValue> = headers
+                let map: Dict = headers
                     .iter()
                     .zip(record.iter())
                     .map(|(k, v)| (Ident::new(k), RuntimeValue::String(v.to_string())))
@@ -3458,11 +3486,11 @@ fn _xml_parse_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEn
             reader.config_mut().trim_text(true);
             let mut buf = Vec::new();
             #[allow(clippy::type_complexity)]
-            let mut stack: Vec<(String, BTreeMap<Ident, RuntimeValue>, Vec<RuntimeValue>, Option<String>)> = Vec::new();
+            let mut stack: Vec<(String, Dict, Vec<RuntimeValue>, Option<String>)> = Vec::new();
             let mut root: Option<RuntimeValue> = None;
 
             let parse_attrs = |e: &quick_xml::events::BytesStart<'_>, reader: &quick_xml::Reader<&[u8]>| {
-                let mut attrs = BTreeMap::new();
+                let mut attrs = Dict::default();
                 for attr in e.attributes() {
                     let attr = attr.map_err(|e| Error::Runtime(format!("XML attribute error: {}", e)))?;
                     let key = String::from_utf8_lossy(attr.key.as_ref()).to_string();
@@ -3501,7 +3529,7 @@ fn _xml_parse_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEn
                             )));
                         }
 
-                        let mut dict = BTreeMap::new();
+                        let mut dict = Dict::default();
                         dict.insert(Ident::new("tag"), RuntimeValue::String(tag));
                         dict.insert(Ident::new("attributes"), RuntimeValue::Dict(Shared::new(attrs)));
                         dict.insert(Ident::new("children"), RuntimeValue::Array(Shared::new(children)));
@@ -3521,7 +3549,7 @@ fn _xml_parse_impl(ident: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEn
                     Ok(quick_xml::events::Event::Empty(e)) => {
                         let tag = String::from_utf8_lossy(e.name().as_ref()).to_string();
                         let attrs = parse_attrs(&e, &reader)?;
-                        let mut dict = BTreeMap::new();
+                        let mut dict = Dict::default();
                         dict.insert(Ident::new("tag"), RuntimeValue::String(tag));
                         dict.insert(Ident::new("attributes"), RuntimeValue::Dict(Shared::new(attrs)));
                         dict.insert(Ident::new("children"), RuntimeValue::empty_array());
@@ -3786,20 +3814,20 @@ fn build_char_inline_diff(s1: &str, s2: &str) -> (Vec<RuntimeValue>, Vec<Runtime
         let val = RuntimeValue::String(c.value().to_string());
         match c.tag() {
             ChangeTag::Delete => {
-                let mut m = BTreeMap::new();
+                let mut m = Dict::default();
                 m.insert(Ident::new("tag"), RuntimeValue::String("delete".into()));
                 m.insert(Ident::new("value"), val);
                 del_inline.push(RuntimeValue::Dict(Shared::new(m)));
             }
             ChangeTag::Insert => {
-                let mut m = BTreeMap::new();
+                let mut m = Dict::default();
                 m.insert(Ident::new("tag"), RuntimeValue::String("insert".into()));
                 m.insert(Ident::new("value"), val);
                 ins_inline.push(RuntimeValue::Dict(Shared::new(m)));
             }
             ChangeTag::Equal => {
                 for inline in [&mut del_inline, &mut ins_inline] {
-                    let mut m = BTreeMap::new();
+                    let mut m = Dict::default();
                     m.insert(Ident::new("tag"), RuntimeValue::String("equal".into()));
                     m.insert(Ident::new("value"), RuntimeValue::String(c.value().to_string()));
                     inline.push(RuntimeValue::Dict(Shared::new(m)));
@@ -3833,22 +3861,22 @@ fn _diff_impl(_: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Res
                     let new_val = &a2[new_idx];
                     if let (RuntimeValue::String(s1), RuntimeValue::String(s2)) = (old_val, new_val) {
                         let (del_inline, ins_inline) = build_char_inline_diff(s1.as_str(), s2.as_str());
-                        let mut del_map = BTreeMap::new();
+                        let mut del_map = Dict::default();
                         del_map.insert(Ident::new("tag"), RuntimeValue::String("delete".into()));
                         del_map.insert(Ident::new("value"), old_val.clone());
                         del_map.insert(Ident::new("inline"), RuntimeValue::Array(Shared::new(del_inline)));
                         result.push(RuntimeValue::Dict(Shared::new(del_map)));
-                        let mut ins_map = BTreeMap::new();
+                        let mut ins_map = Dict::default();
                         ins_map.insert(Ident::new("tag"), RuntimeValue::String("insert".into()));
                         ins_map.insert(Ident::new("value"), new_val.clone());
                         ins_map.insert(Ident::new("inline"), RuntimeValue::Array(Shared::new(ins_inline)));
                         result.push(RuntimeValue::Dict(Shared::new(ins_map)));
                     } else {
-                        let mut del_map = BTreeMap::new();
+                        let mut del_map = Dict::default();
                         del_map.insert(Ident::new("tag"), RuntimeValue::String("delete".into()));
                         del_map.insert(Ident::new("value"), old_val.clone());
                         result.push(RuntimeValue::Dict(Shared::new(del_map)));
-                        let mut ins_map = BTreeMap::new();
+                        let mut ins_map = Dict::default();
                         ins_map.insert(Ident::new("tag"), RuntimeValue::String("insert".into()));
                         ins_map.insert(Ident::new("value"), new_val.clone());
                         result.push(RuntimeValue::Dict(Shared::new(ins_map)));
@@ -3864,7 +3892,7 @@ fn _diff_impl(_: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Res
                         ChangeTag::Equal | ChangeTag::Delete => a1[changes[i].old_index().unwrap()].clone(),
                         ChangeTag::Insert => a2[changes[i].new_index().unwrap()].clone(),
                     };
-                    let mut map = BTreeMap::new();
+                    let mut map = Dict::default();
                     map.insert(Ident::new("tag"), RuntimeValue::String(tag_str.into()));
                     map.insert(Ident::new("value"), value);
                     result.push(RuntimeValue::Dict(Shared::new(map)));
@@ -3888,12 +3916,12 @@ fn _diff_impl(_: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Res
                     let old_val = changes[i].value().trim_end_matches('\n');
                     let new_val = changes[i + 1].value().trim_end_matches('\n');
                     let (del_inline, ins_inline) = build_char_inline_diff(old_val, new_val);
-                    let mut del_map = BTreeMap::new();
+                    let mut del_map = Dict::default();
                     del_map.insert(Ident::new("tag"), RuntimeValue::String("delete".into()));
                     del_map.insert(Ident::new("value"), RuntimeValue::String(old_val.to_string()));
                     del_map.insert(Ident::new("inline"), RuntimeValue::Array(Shared::new(del_inline)));
                     result.push(RuntimeValue::Dict(Shared::new(del_map)));
-                    let mut ins_map = BTreeMap::new();
+                    let mut ins_map = Dict::default();
                     ins_map.insert(Ident::new("tag"), RuntimeValue::String("insert".into()));
                     ins_map.insert(Ident::new("value"), RuntimeValue::String(new_val.to_string()));
                     ins_map.insert(Ident::new("inline"), RuntimeValue::Array(Shared::new(ins_inline)));
@@ -3906,7 +3934,7 @@ fn _diff_impl(_: &Ident, _: &RuntimeValue, mut args: Args, _: &SharedEnv) -> Res
                         ChangeTag::Insert => "insert",
                     };
                     let val = changes[i].value().trim_end_matches('\n').to_string();
-                    let mut map = BTreeMap::new();
+                    let mut map = Dict::default();
                     map.insert(Ident::new("tag"), RuntimeValue::String(tag_str.into()));
                     map.insert(Ident::new("value"), RuntimeValue::String(val));
                     result.push(RuntimeValue::Dict(Shared::new(map)));
@@ -4180,7 +4208,7 @@ fn collection_record(path: String, raw: &str) -> Result<RuntimeValue, Error> {
         body_nodes.iter().cloned().map(RuntimeValue::from).collect(),
     ));
 
-    let mut record = BTreeMap::new();
+    let mut record = Dict::default();
     record.insert(Ident::new("path"), RuntimeValue::String(path));
     record.insert(Ident::new("title"), title);
     record.insert(Ident::new("frontmatter"), frontmatter);
@@ -4860,6 +4888,27 @@ pub static INTERNAL_FUNCTION_DOC: LazyLock<FxHashMap<SmolStr, BuiltinFunctionDoc
             params: &["markdown_node"],
             },
         );
+    map.insert(
+        SmolStr::new("pmap"),
+        BuiltinFunctionDoc {
+            description: "Applies a function to each element of an array like `map`, evaluating elements in parallel across worker threads when the runtime supports it. Results preserve input order.",
+            params: &["array", "function"],
+        },
+    );
+    map.insert(
+        SmolStr::new("pfilter"),
+        BuiltinFunctionDoc {
+            description: "Filters an array like `filter`, evaluating the predicate on elements in parallel across worker threads when the runtime supports it. Results preserve input order.",
+            params: &["array", "function"],
+        },
+    );
+    map.insert(
+        SmolStr::new("pgroup_by"),
+        BuiltinFunctionDoc {
+            description: "Groups array elements by the stringified result of a key function like `group_by`, evaluating keys in parallel across worker threads when the runtime supports it. Groups preserve first-occurrence order.",
+            params: &["array", "function"],
+        },
+    );
     map.insert(
         SmolStr::new("is_debug_mode"),
         BuiltinFunctionDoc {
@@ -6304,56 +6353,52 @@ impl From<env::EnvError> for Error {
 
 impl Error {
     #[cold]
-    pub fn to_runtime_error(
-        &self,
-        node: ast::Node,
-        token_arena: Shared<SharedCell<Arena<Shared<Token>>>>,
-    ) -> RuntimeError {
+    pub fn to_runtime_error(&self, node: ast::Node, token_arena: Shared<SharedCell<Arena<Token>>>) -> RuntimeError {
         match self {
             Error::UserDefined(message) => RuntimeError::UserDefined {
                 message: message.to_owned(),
-                token: (*get_token(token_arena, node.token_id)).clone(),
+                token: get_token(token_arena, node.token_id),
             },
             Error::InvalidBase64String(e) => {
-                RuntimeError::InvalidBase64String((*get_token(token_arena, node.token_id)).clone(), e.to_string())
+                RuntimeError::InvalidBase64String(get_token(token_arena, node.token_id), e.to_string())
             }
             Error::NotDefined(name, candidates) => RuntimeError::NotDefined(
-                (*get_token(token_arena, node.token_id)).clone(),
+                get_token(token_arena, node.token_id),
                 name.clone(),
                 candidates.clone().into(),
             ),
             Error::UndefinedReference(a, candidates) => RuntimeError::UndefinedReference(
-                (*get_token(token_arena, node.token_id)).clone(),
+                get_token(token_arena, node.token_id),
                 a.clone(),
                 candidates.clone().into(),
             ),
             Error::InvalidDateTimeFormat(msg) => {
-                RuntimeError::DateTimeFormatError((*get_token(token_arena, node.token_id)).clone(), msg.clone())
+                RuntimeError::DateTimeFormatError(get_token(token_arena, node.token_id), msg.clone())
             }
             Error::InvalidTypes(name, args) => RuntimeError::InvalidTypes {
-                token: (*get_token(token_arena, node.token_id)).clone(),
+                token: get_token(token_arena, node.token_id),
                 name: name.clone(),
                 args: args.iter().map(|o| o.name().into()).collect::<Vec<_>>(),
             },
             Error::InvalidNumberOfArguments(name, expected, got) => RuntimeError::InvalidNumberOfArguments {
-                token: (*get_token(token_arena, node.token_id)).clone(),
+                token: get_token(token_arena, node.token_id),
                 name: name.clone(),
                 expected: *expected,
                 actual: *got,
             },
             Error::InvalidRegularExpression(regex) => {
-                RuntimeError::InvalidRegularExpression((*get_token(token_arena, node.token_id)).clone(), regex.clone())
+                RuntimeError::InvalidRegularExpression(get_token(token_arena, node.token_id), regex.clone())
             }
-            Error::Runtime(msg) => RuntimeError::Runtime((*get_token(token_arena, node.token_id)).clone(), msg.clone()),
-            Error::ZeroDivision => RuntimeError::ZeroDivision((*get_token(token_arena, node.token_id)).clone()),
+            Error::Runtime(msg) => RuntimeError::Runtime(get_token(token_arena, node.token_id), msg.clone()),
+            Error::ZeroDivision => RuntimeError::ZeroDivision(get_token(token_arena, node.token_id)),
             Error::AssignToImmutable(name) => {
-                RuntimeError::AssignToImmutable((*get_token(token_arena, node.token_id)).clone(), name.clone())
+                RuntimeError::AssignToImmutable(get_token(token_arena, node.token_id), name.clone())
             }
             Error::UndefinedVariable(name) => {
-                RuntimeError::UndefinedVariable((*get_token(token_arena, node.token_id)).clone(), name.clone())
+                RuntimeError::UndefinedVariable(get_token(token_arena, node.token_id), name.clone())
             }
             Error::InvalidConvert(format) => {
-                RuntimeError::InvalidConvert((*get_token(token_arena, node.token_id)).clone(), format.clone())
+                RuntimeError::InvalidConvert(get_token(token_arena, node.token_id), format.clone())
             }
         }
     }
@@ -6821,6 +6866,9 @@ fn truncate_str(text: &str, max_width: usize, ellipsis: &str) -> String {
 }
 
 fn repeat(value: &mut RuntimeValue, n: usize) -> Result<RuntimeValue, Error> {
+    if n == 1 && matches!(value, RuntimeValue::String(_)) {
+        return Ok(std::mem::take(value));
+    }
     match &*value {
         RuntimeValue::String(s) => {
             let total_size = s.len().saturating_mul(n);
@@ -6892,7 +6940,6 @@ fn repeat(value: &mut RuntimeValue, n: usize) -> Result<RuntimeValue, Error> {
 
 #[cfg(test)]
 mod tests {
-    use std::collections::BTreeMap;
 
     use mq_markdown::Node;
     use rstest::rstest;
@@ -7825,30 +7872,26 @@ mod tests {
     // Tests for Dict functions
     #[rstest]
     #[case(
-        BTreeMap::from([("a".into(), RuntimeValue::Number(1.0.into())), ("b".into(), RuntimeValue::Number(2.0.into()))]),
-        BTreeMap::from([("c".into(), RuntimeValue::Number(3.0.into()))]),
-        BTreeMap::from([("a".into(), RuntimeValue::Number(1.0.into())), ("b".into(), RuntimeValue::Number(2.0.into())), ("c".into(), RuntimeValue::Number(3.0.into()))]),
+        Dict::from_iter([("a".into(), RuntimeValue::Number(1.0.into())), ("b".into(), RuntimeValue::Number(2.0.into()))]),
+        Dict::from_iter([("c".into(), RuntimeValue::Number(3.0.into()))]),
+        Dict::from_iter([("a".into(), RuntimeValue::Number(1.0.into())), ("b".into(), RuntimeValue::Number(2.0.into())), ("c".into(), RuntimeValue::Number(3.0.into()))]),
     )]
     #[case(
-        BTreeMap::from([("a".into(), RuntimeValue::Number(1.0.into()))]),
-        BTreeMap::from([("a".into(), RuntimeValue::Number(99.0.into())), ("b".into(), RuntimeValue::Number(2.0.into()))]),
-        BTreeMap::from([("a".into(), RuntimeValue::Number(99.0.into())), ("b".into(), RuntimeValue::Number(2.0.into()))]),
+        Dict::from_iter([("a".into(), RuntimeValue::Number(1.0.into()))]),
+        Dict::from_iter([("a".into(), RuntimeValue::Number(99.0.into())), ("b".into(), RuntimeValue::Number(2.0.into()))]),
+        Dict::from_iter([("a".into(), RuntimeValue::Number(99.0.into())), ("b".into(), RuntimeValue::Number(2.0.into()))]),
     )]
     #[case(
-        BTreeMap::new(),
-        BTreeMap::from([("x".into(), RuntimeValue::String("hello".into()))]),
-        BTreeMap::from([("x".into(), RuntimeValue::String("hello".into()))]),
+        Dict::default(),
+        Dict::from_iter([("x".into(), RuntimeValue::String("hello".into()))]),
+        Dict::from_iter([("x".into(), RuntimeValue::String("hello".into()))]),
     )]
     #[case(
-        BTreeMap::from([("x".into(), RuntimeValue::String("hello".into()))]),
-        BTreeMap::new(),
-        BTreeMap::from([("x".into(), RuntimeValue::String("hello".into()))]),
-    )]
-    fn test_eval_builtin_add_dict(
-        #[case] d1: BTreeMap<Ident, RuntimeValue>,
-        #[case] d2: BTreeMap<Ident, RuntimeValue>,
-        #[case] expected: BTreeMap<Ident, RuntimeValue>,
-    ) {
+        Dict::from_iter([("x".into(), RuntimeValue::String("hello".into()))]),
+        Dict::default(),
+        Dict::from_iter([("x".into(), RuntimeValue::String("hello".into()))]),
+    )]
+    fn test_eval_builtin_add_dict(#[case] d1: Dict, #[case] d2: Dict, #[case] expected: Dict) {
         let ident = Ident::new("add");
         let result = eval_builtin(
             &RuntimeValue::None,
@@ -7888,7 +7931,7 @@ mod tests {
         );
         assert_eq!(
             result,
-            Ok(RuntimeValue::Dict(Shared::new(BTreeMap::from([(
+            Ok(RuntimeValue::Dict(Shared::new(Dict::from_iter([(
                 "key".into(),
                 RuntimeValue::String("value".into())
             )]))))
@@ -7974,7 +8017,7 @@ mod tests {
             _ => panic!("Expected Dict, got {:?}", map_val3),
         }
 
-        let mut nested_map_data = BTreeMap::default();
+        let mut nested_map_data = Dict::default();
         nested_map_data.insert(Ident::new("level"), RuntimeValue::Number(2.into()));
         let nested_map: RuntimeValue = nested_map_data.into();
         let args4 = vec![
@@ -8047,7 +8090,7 @@ mod tests {
     #[test]
     fn test_eval_builtin_get_map() {
         let ident_get = Ident::new("get");
-        let mut map_data = BTreeMap::default();
+        let mut map_data = Dict::default();
         map_data.insert("name".into(), RuntimeValue::String("Jules".into()));
         map_data.insert("age".into(), RuntimeValue::Number(30.into()));
         let map_val: RuntimeValue = map_data.into();
@@ -8120,7 +8163,7 @@ mod tests {
         );
         assert_eq!(result1, Ok(RuntimeValue::Array(Shared::new(vec![]))));
 
-        let mut map_data = BTreeMap::default();
+        let mut map_data = Dict::default();
         map_data.insert("name".into(), RuntimeValue::String("Jules".into()));
         map_data.insert("age".into(), RuntimeValue::Number(30.into()));
         let map_val: RuntimeValue = map_data.into();
@@ -8188,7 +8231,7 @@ mod tests {
         );
         assert_eq!(result1, Ok(RuntimeValue::Array(Shared::new(vec![]))));
 
-        let mut map_data = BTreeMap::default();
+        let mut map_data = Dict::default();
         map_data.insert("name".into(), RuntimeValue::String("Jules".into()));
         map_data.insert("age".into(), RuntimeValue::Number(30.into()));
         let map_val: RuntimeValue = map_data.into();
@@ -8421,10 +8464,10 @@ mod tests {
     #[case::simple_with_header(
         "name,age\nAlice,30\nBob,25",
         {
-            let mut alice = BTreeMap::new();
+            let mut alice = Dict::default();
             alice.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
             alice.insert(Ident::new("age"), RuntimeValue::String("30".to_string()));
-            let mut bob = BTreeMap::new();
+            let mut bob = Dict::default();
             bob.insert(Ident::new("name"), RuntimeValue::String("Bob".to_string()));
             bob.insert(Ident::new("age"), RuntimeValue::String("25".to_string()));
             Ok(RuntimeValue::Array(Shared::new(vec![
@@ -8436,7 +8479,7 @@ mod tests {
     #[case::single_row_with_header(
         "id,value\n1,hello",
         {
-            let mut row = BTreeMap::new();
+            let mut row = Dict::default();
             row.insert(Ident::new("id"), RuntimeValue::String("1".to_string()));
             row.insert(Ident::new("value"), RuntimeValue::String("hello".to_string()));
             Ok(RuntimeValue::Array(Shared::new(vec![RuntimeValue::Dict(Shared::new(row))])))
@@ -8445,7 +8488,7 @@ mod tests {
     #[case::quoted_fields_with_header(
         "name,note\n\"Doe, Jane\",\"says \"\"hi\"\"\"",
         {
-            let mut row = BTreeMap::new();
+            let mut row = Dict::default();
             row.insert(Ident::new("name"), RuntimeValue::String("Doe, Jane".to_string()));
             row.insert(Ident::new("note"), RuntimeValue::String("says \"hi\"".to_string()));
             Ok(RuntimeValue::Array(Shared::new(vec![RuntimeValue::Dict(Shared::new(row))])))
@@ -8489,7 +8532,7 @@ mod tests {
         "\t",
         true,
         {
-            let mut row = BTreeMap::new();
+            let mut row = Dict::default();
             row.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
             row.insert(Ident::new("age"), RuntimeValue::String("30".to_string()));
             Ok(RuntimeValue::Array(Shared::new(vec![RuntimeValue::Dict(Shared::new(row))])))
@@ -8533,7 +8576,7 @@ mod tests {
     #[case::simple_object(
         r#"{"key": "value"}"#,
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("key"), RuntimeValue::String("value".to_string()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8549,12 +8592,12 @@ mod tests {
     #[case::nested(
         r#"{"a": [true, null], "b": {"c": 1.2}}"#,
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("a"), RuntimeValue::Array(Shared::new(vec![
                 RuntimeValue::Boolean(true),
                 RuntimeValue::NONE,
             ])));
-            let mut inner = BTreeMap::new();
+            let mut inner = Dict::default();
             inner.insert(Ident::new("c"), RuntimeValue::Number(1.2.into()));
             map.insert(Ident::new("b"), RuntimeValue::Dict(Shared::new(inner)));
             Ok(RuntimeValue::Dict(Shared::new(map)))
@@ -8597,7 +8640,7 @@ mod tests {
     #[case::mapping(
         "key: value",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("key"), RuntimeValue::String("value".to_string()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8613,9 +8656,9 @@ mod tests {
     #[case::nested(
         "a:\n  b: 42",
         {
-            let mut inner = BTreeMap::new();
+            let mut inner = Dict::default();
             inner.insert(Ident::new("b"), RuntimeValue::Number(42.into()));
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(inner)));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8623,7 +8666,7 @@ mod tests {
     #[case::boolean(
         "flag: true",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("flag"), RuntimeValue::Boolean(true));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8631,7 +8674,7 @@ mod tests {
     #[case::null(
         "value: null",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("value"), RuntimeValue::NONE);
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8639,7 +8682,7 @@ mod tests {
     #[case::float(
         "ratio: 1.5",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("ratio"), RuntimeValue::Number(1.5.into()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8676,7 +8719,7 @@ mod tests {
     #[case::simple_kv(
         "a: 1\nb: 2",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
             map.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
@@ -8685,9 +8728,9 @@ mod tests {
     #[case::nested_indent(
         "parent:\n  child: value",
         {
-            let mut child_map = BTreeMap::new();
+            let mut child_map = Dict::default();
             child_map.insert(Ident::new("child"), RuntimeValue::String("value".to_string()));
-            let mut parent_map = BTreeMap::new();
+            let mut parent_map = Dict::default();
             parent_map.insert(Ident::new("parent"), RuntimeValue::Dict(Shared::new(child_map)));
             Ok(RuntimeValue::Dict(Shared::new(parent_map)))
         }
@@ -8695,13 +8738,13 @@ mod tests {
     #[case::tabular_data(
         "hikes[2]{id,name}:\n  1,Blue Lake\n  2,Ridge Trail",
         {
-            let mut row1 = BTreeMap::new();
+            let mut row1 = Dict::default();
             row1.insert(Ident::new("id"), RuntimeValue::Number(1.into()));
             row1.insert(Ident::new("name"), RuntimeValue::String("Blue Lake".to_string()));
-            let mut row2 = BTreeMap::new();
+            let mut row2 = Dict::default();
             row2.insert(Ident::new("id"), RuntimeValue::Number(2.into()));
             row2.insert(Ident::new("name"), RuntimeValue::String("Ridge Trail".to_string()));
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("hikes"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Dict(Shared::new(row1)), RuntimeValue::Dict(Shared::new(row2))])));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8709,7 +8752,7 @@ mod tests {
     #[case::inline_array(
         "items[3]: 1, 2, 3",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![
                 RuntimeValue::Number(1.into()),
                 RuntimeValue::Number(2.into()),
@@ -8721,7 +8764,7 @@ mod tests {
     #[case::expanded_array(
         "items[2]:\n  - 1\n  - 2",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![
                 RuntimeValue::Number(1.into()),
                 RuntimeValue::Number(2.into()),
@@ -8732,7 +8775,7 @@ mod tests {
     #[case::primitives(
         "s: \"string\"\nb: true\nn: null\nf: false",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("s"), RuntimeValue::String("string".to_string()));
             map.insert(Ident::new("b"), RuntimeValue::TRUE);
             map.insert(Ident::new("n"), RuntimeValue::NONE);
@@ -8755,7 +8798,7 @@ mod tests {
     #[case::simple_kv(
         "name = \"Alice\"\nage = 30",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
             map.insert(Ident::new("age"), RuntimeValue::Number(30.into()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
@@ -8764,7 +8807,7 @@ mod tests {
     #[case::boolean(
         "enabled = true\ndisabled = false",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("enabled"), RuntimeValue::Boolean(true));
             map.insert(Ident::new("disabled"), RuntimeValue::Boolean(false));
             Ok(RuntimeValue::Dict(Shared::new(map)))
@@ -8773,10 +8816,10 @@ mod tests {
     #[case::nested_table(
         "[server]\nhost = \"localhost\"\nport = 8080",
         {
-            let mut inner = BTreeMap::new();
+            let mut inner = Dict::default();
             inner.insert(Ident::new("host"), RuntimeValue::String("localhost".to_string()));
             inner.insert(Ident::new("port"), RuntimeValue::Number(8080.into()));
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("server"), RuntimeValue::Dict(Shared::new(inner)));
             Ok(RuntimeValue::Dict(Shared::new(map)))
         }
@@ -8784,7 +8827,7 @@ mod tests {
     #[case::array(
         "tags = [\"rust\", \"toml\"]",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("tags"), RuntimeValue::Array(Shared::new(vec![
                 RuntimeValue::String("rust".to_string()),
                 RuntimeValue::String("toml".to_string()),
@@ -8834,7 +8877,7 @@ mod tests {
         // {"name": "Alice", "age": 30}
         "omRuYW1lZUFsaWNlY2FnZRge",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
             map.insert(Ident::new("age"), RuntimeValue::Number(30.into()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
@@ -8883,7 +8926,7 @@ mod tests {
         // {"name": "Alice", "age": 30} encoded as CBOR then base64
         "omRuYW1lZUFsaWNlY2FnZRge",
         {
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
             map.insert(Ident::new("age"), RuntimeValue::Number(30.into()));
             Ok(RuntimeValue::Dict(Shared::new(map)))
@@ -8924,7 +8967,7 @@ mod tests {
             &Shared::new(SharedCell::new(Env::default())),
         );
         assert!(result.is_ok());
-        let mut expected = BTreeMap::new();
+        let mut expected = Dict::default();
         expected.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
         assert_eq!(result.unwrap(), RuntimeValue::Dict(Shared::new(expected)));
     }
@@ -9258,7 +9301,7 @@ mod tests {
     #[case::simple(
         "<root>hello</root>",
         {
-            let mut root = BTreeMap::new();
+            let mut root = Dict::default();
             root.insert(Ident::new("tag"), RuntimeValue::String("root".to_string()));
             root.insert(Ident::new("attributes"), RuntimeValue::new_dict());
             root.insert(Ident::new("children"), RuntimeValue::empty_array());
@@ -9269,8 +9312,8 @@ mod tests {
     #[case::with_attributes(
         "<root id=\"1\" class=\"main\">hello</root>",
         {
-            let mut root = BTreeMap::new();
-            let mut attrs = BTreeMap::new();
+            let mut root = Dict::default();
+            let mut attrs = Dict::default();
             attrs.insert(Ident::new("id"), RuntimeValue::String("1".to_string()));
             attrs.insert(Ident::new("class"), RuntimeValue::String("main".to_string()));
             root.insert(Ident::new("tag"), RuntimeValue::String("root".to_string()));
@@ -9283,17 +9326,17 @@ mod tests {
     #[case::nested(
         "<root><child id=\"1\">hello</child><child id=\"2\">world</child></root>",
         {
-            let mut root = BTreeMap::new();
-            let mut child1 = BTreeMap::new();
-            let mut attrs1 = BTreeMap::new();
+            let mut root = Dict::default();
+            let mut child1 = Dict::default();
+            let mut attrs1 = Dict::default();
             attrs1.insert(Ident::new("id"), RuntimeValue::String("1".to_string()));
             child1.insert(Ident::new("tag"), RuntimeValue::String("child".to_string()));
             child1.insert(Ident::new("attributes"), RuntimeValue::Dict(Shared::new(attrs1)));
             child1.insert(Ident::new("children"), RuntimeValue::empty_array());
             child1.insert(Ident::new("text"), RuntimeValue::String("hello".to_string()));
 
-            let mut child2 = BTreeMap::new();
-            let mut attrs2 = BTreeMap::new();
+            let mut child2 = Dict::default();
+            let mut attrs2 = Dict::default();
             attrs2.insert(Ident::new("id"), RuntimeValue::String("2".to_string()));
             child2.insert(Ident::new("tag"), RuntimeValue::String("child".to_string()));
             child2.insert(Ident::new("attributes"), RuntimeValue::Dict(Shared::new(attrs2)));
@@ -9313,9 +9356,9 @@ mod tests {
     #[case::self_closing(
         "<root><child id=\"1\"/></root>",
         {
-            let mut root = BTreeMap::new();
-            let mut child = BTreeMap::new();
-            let mut attrs = BTreeMap::new();
+            let mut root = Dict::default();
+            let mut child = Dict::default();
+            let mut attrs = Dict::default();
             attrs.insert(Ident::new("id"), RuntimeValue::String("1".to_string()));
             child.insert(Ident::new("tag"), RuntimeValue::String("child".to_string()));
             child.insert(Ident::new("attributes"), RuntimeValue::Dict(Shared::new(attrs)));
@@ -10212,7 +10255,7 @@ mod tests {
 
             // sorted by path: a.md, b.md, c.md
             assert_eq!(get(&entries[0], "title"), RuntimeValue::String("World".into()));
-            let mut toml_frontmatter = BTreeMap::new();
+            let mut toml_frontmatter = Dict::default();
             toml_frontmatter.insert(Ident::new("title"), RuntimeValue::String("World".into()));
             assert_eq!(
                 get(&entries[0], "frontmatter"),
@@ -9,7 +9,6 @@
 //! and DNS resolution filtered to publicly routable addresses so a hostname can't be rebound to
 //! an internal address after the initial check.
 
-use std::collections::BTreeMap;
 use std::sync::LazyLock;
 
 use ureq::http;
@@ -18,7 +17,7 @@ use super::Error;
 #[cfg(test)]
 use super::capability;
 use crate::module::resolver::ssrf::{is_https, ssrf_safe_agent};
-use crate::{Ident, RuntimeValue};
+use crate::{Dict, RuntimeValue};
 
 /// Maximum response body size read from `http` (10 MiB).
 const MAX_RESPONSE_SIZE: u64 = 10 * 1024 * 1024;
@@ -68,10 +67,7 @@ fn read_body(mut response: http::Response<ureq::Body>) -> Result<RuntimeValue, E
 
 /// Applies `headers` to `builder`, requiring every value to be a string. Invalid header
 /// names/values (e.g. containing CR/LF) are caught later when the request is built.
-fn apply_headers(
-    mut builder: http::request::Builder,
-    headers: Option<&BTreeMap<Ident, RuntimeValue>>,
-) -> Result<http::request::Builder, Error> {
+fn apply_headers(mut builder: http::request::Builder, headers: Option<&Dict>) -> Result<http::request::Builder, Error> {
     let Some(headers) = headers else {
         return Ok(builder);
     };
@@ -92,7 +88,7 @@ pub(super) fn request(
     method: &RuntimeValue,
     url: &str,
     body: Option<&str>,
-    headers: Option<&BTreeMap<Ident, RuntimeValue>>,
+    headers: Option<&Dict>,
 ) -> Result<RuntimeValue, Error> {
     ensure_https(url)?;
     let method = parse_method(method)?;
@@ -225,7 +221,7 @@ mod tests {
                 &symbol("get"),
                 "https://this-domain-should-not-exist-mq-test.invalid",
                 None,
-                Some(&BTreeMap::from([(
+                Some(&Dict::from_iter([(
                     Ident::new("Authorization"),
                     RuntimeValue::String("Bearer token".into())
                 )]))
@@ -242,7 +238,7 @@ mod tests {
         let builder = http::Request::builder()
             .method(http::Method::GET)
             .uri("https://example.invalid");
-        let headers = BTreeMap::from([
+        let headers = Dict::from_iter([
             (Ident::new("X-Test"), RuntimeValue::String("value".into())),
             (
                 Ident::new("Content-Type"),
@@ -260,7 +256,7 @@ mod tests {
         let builder = http::Request::builder()
             .method(http::Method::GET)
             .uri("https://example.invalid");
-        let headers = BTreeMap::from([(Ident::new("X-Test"), RuntimeValue::from(1usize))]);
+        let headers = Dict::from_iter([(Ident::new("X-Test"), RuntimeValue::from(1usize))]);
 
         assert!(apply_headers(builder, Some(&headers)).is_err());
     }
@@ -3,7 +3,6 @@ use crate::Shared;
 use crate::eval::runtime_value::RuntimeValue;
 use regex_lite::{Regex, RegexBuilder};
 use rustc_hash::{FxBuildHasher, FxHashMap};
-use std::collections::BTreeMap;
 use std::sync::{LazyLock, RwLock};
 
 use super::Error;
@@ -46,7 +45,7 @@ pub(super) fn is_match_re(input: &str, pattern: &str) -> Result<RuntimeValue, Er
 pub(super) fn capture_re_inner(re: &Regex, input: &str) -> Result<RuntimeValue, Error> {
     match (re.capture_names(), re.captures(input)) {
         (names, Some(caps)) => {
-            let mut result = BTreeMap::new();
+            let mut result = crate::Dict::default();
             for name in names.flatten() {
                 if let Some(m) = caps.name(name) {
                     result.insert(Ident::new(name), RuntimeValue::String(m.as_str().to_string()));
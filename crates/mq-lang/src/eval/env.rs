@@ -37,15 +37,15 @@ impl EnvError {
     pub fn to_runtime_error(&self, token_id: TokenId, token_arena: TokenArena) -> RuntimeError {
         match self {
             EnvError::UndefinedReference(def, candidates) => RuntimeError::UndefinedReference(
-                (*get_token(token_arena, token_id)).clone(),
+                get_token(token_arena, token_id),
                 def.to_string(),
                 candidates.clone().into(),
             ),
             EnvError::AssignToImmutable(var) => {
-                RuntimeError::AssignToImmutable((*get_token(token_arena, token_id)).clone(), var.to_string())
+                RuntimeError::AssignToImmutable(get_token(token_arena, token_id), var.to_string())
             }
             EnvError::UndefinedVariable(var) => {
-                RuntimeError::UndefinedVariable((*get_token(token_arena, token_id)).clone(), var.to_string())
+                RuntimeError::UndefinedVariable(get_token(token_arena, token_id), var.to_string())
             }
         }
     }
@@ -300,6 +300,22 @@ impl Env {
         }
     }
 
+    /// Clears this scope so it can be reused as a fresh call frame parented at `parent`.
+    ///
+    /// Keeps the `Small` storage allocation where possible so pooled frames avoid
+    /// re-allocating on every call; a frame that was promoted to `Large` is demoted
+    /// back, since call scopes should start in the cheap linear-search representation.
+    pub(crate) fn reset_for_call(&mut self, parent: Weak<SharedCell<Env>>) {
+        match &mut self.context {
+            EnvContext::Small(v) => v.clear(),
+            context @ EnvContext::Large(_) => *context = EnvContext::new_small(),
+        }
+        if let Some(vars) = &mut self.mutable_vars {
+            vars.clear();
+        }
+        self.parent = Some(parent);
+    }
+
     /// Collects the names of every binding visible from this scope (this scope plus all
     /// ancestors) so a failed lookup can suggest a "did you mean" among user-defined
     /// functions/variables, not just builtins. Cold path only - never called on the
@@ -0,0 +1,131 @@
+//! Per-expression profiler for query evaluation.
+//!
+//! When profiling is enabled on an [`Engine`](crate::Engine), the evaluator
+//! records an invocation count and cumulative wall time for every AST node it
+//! evaluates, keyed by the node's token. Times are inclusive: a pipeline
+//! stage's total contains the time spent in its sub-expressions, so sorting by
+//! total time surfaces the stages worth bisecting first.
+//!
+//! The overhead while disabled is a single branch per expression; while enabled
+//! it is one `Instant` sample pair and a hash-map update per expression.
+//! Available with the `profiler` feature.
+
+use std::time::Duration;
+
+use rustc_hash::FxHashMap;
+
+use crate::ast::TokenId;
+use crate::{TokenArena, get_token};
+
+/// Accumulated count and time for one AST node.
+#[derive(Debug, Default, Clone, Copy)]
+struct ProfileEntry {
+    count: u64,
+    total: Duration,
+}
+
+/// Collects per-expression timings during evaluation.
+#[derive(Debug, Default, Clone)]
+pub(crate) struct Profiler {
+    entries: FxHashMap<TokenId, ProfileEntry>,
+}
+
+/// One row of a profile report: a source expression with its invocation count
+/// and cumulative (inclusive) evaluation time.
+#[derive(Debug, Clone, PartialEq, Eq)]
+pub struct ProfileRecord {
+    /// Source text of the profiled expression's token.
+    pub expr: String,
+    /// 1-based source line of the expression.
+    pub line: u32,
+    /// 1-based source column of the expression.
+    pub column: usize,
+    /// Number of times the expression was evaluated.
+    pub count: u64,
+    /// Cumulative wall time spent evaluating the expression, including its
+    /// sub-expressions.
+    pub total: Duration,
+}
+
+impl Profiler {
+    /// Adds one evaluation of the node identified by `token_id`.
+    #[inline(always)]
+    pub(crate) fn record(&mut self, token_id: TokenId, elapsed: Duration) {
+        let entry = self.entries.entry(token_id).or_default();
+        entry.count += 1;
+        entry.total += elapsed;
+    }
+
+    /// Resolves the collected entries against `token_arena` and returns them
+    /// sorted by cumulative time, hottest first. Clears the profiler.
+    pub(crate) fn take_records(&mut self, token_arena: TokenArena) -> Vec<ProfileRecord> {
+        let mut records: Vec<ProfileRecord> = std::mem::take(&mut self.entries)
+            .into_iter()
+            .map(|(token_id, entry)| {
+                let token = get_token(TokenArena::clone(&token_arena), token_id);
+                ProfileRecord {
+                    expr: token.to_string(),
+                    line: token.range.start.line,
+                    column: token.range.start.column,
+                    count: entry.count,
+                    total: entry.total,
+                }
+            })
+            .collect();
+        records.sort_by(|a, b| b.total.cmp(&a.total).then_with(|| a.line.cmp(&b.line)));
+        records
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_record_accumulates_count_and_time() {
+        let mut profiler = Profiler::default();
+        let arena = crate::Shared::new(crate::SharedCell::new(crate::arena::Arena::new(10)));
+        let token_id = crate::token_alloc(
+            &arena,
+            &crate::Shared::new(crate::Token {
+                range: crate::range::Range::default(),
+                kind: crate::TokenKind::Selector("h".into()),
+                module_id: crate::Module::TOP_LEVEL_MODULE_ID,
+            }),
+        );
+
+        profiler.record(token_id, Duration::from_millis(2));
+        profiler.record(token_id, Duration::from_millis(3));
+
+        let records = profiler.take_records(arena);
+        assert_eq!(records.len(), 1);
+        assert_eq!(records[0].count, 2);
+        assert_eq!(records[0].total, Duration::from_millis(5));
+        assert!(profiler.entries.is_empty(), "take_records must clear the profiler");
+    }
+
+    #[test]
+    fn test_records_sorted_by_total_time_descending() {
+        let mut profiler = Profiler::default();
+        let arena = crate::Shared::new(crate::SharedCell::new(crate::arena::Arena::new(10)));
+        let token = |kind: crate::TokenKind| {
+            crate::token_alloc(
+                &arena,
+                &crate::Shared::new(crate::Token {
+                    range: crate::range::Range::default(),
+                    kind,
+                    module_id: crate::Module::TOP_LEVEL_MODULE_ID,
+                }),
+            )
+        };
+
+        let fast = token(crate::TokenKind::Selector("text".into()));
+        let slow = token(crate::TokenKind::Selector("code".into()));
+        profiler.record(fast, Duration::from_millis(1));
+        profiler.record(slow, Duration::from_millis(10));
+
+        let records = profiler.take_records(arena);
+        assert_eq!(records[0].total, Duration::from_millis(10));
+        assert_eq!(records[1].total, Duration::from_millis(1));
+    }
+}
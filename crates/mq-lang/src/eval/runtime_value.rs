@@ -5,10 +5,17 @@ use smol_str::SmolStr;
 use std::{
     borrow::Cow,
     cmp::Ordering,
-    collections::BTreeMap,
     ops::{Index, IndexMut},
 };
 
+/// Insertion-ordered dictionary backing [`RuntimeValue::Dict`].
+///
+/// Keys are interned [`Ident`]s, so a lookup hashes a single interner symbol with
+/// `FxHasher` instead of walking B-tree nodes, and iteration follows insertion
+/// order, keeping output deterministic and mirroring the order keys first
+/// appeared in the input (e.g. frontmatter field order).
+pub type Dict = indexmap::IndexMap<Ident, RuntimeValue, rustc_hash::FxBuildHasher>;
+
 /// Runtime selector for indexing into markdown nodes.
 #[derive(Debug, Clone, PartialEq)]
 pub enum Selector {
@@ -101,7 +108,7 @@ pub enum RuntimeValue {
     /// A dictionary mapping identifiers to runtime values.
     ///
     /// Same clone-on-write scheme as [`RuntimeValue::Array`]; see [`dict_mut`].
-    Dict(Shared<BTreeMap<Ident, RuntimeValue>>),
+    Dict(Shared<Dict>),
     /// A module with its exports.
     Module(ModuleEnv),
     /// An AST node (quoted expression).
@@ -189,8 +196,8 @@ impl From<Vec<RuntimeValue>> for RuntimeValue {
     }
 }
 
-impl From<BTreeMap<Ident, RuntimeValue>> for RuntimeValue {
-    fn from(map: BTreeMap<Ident, RuntimeValue>) -> Self {
+impl From<Dict> for RuntimeValue {
+    fn from(map: Dict) -> Self {
         RuntimeValue::Dict(Shared::new(map))
     }
 }
@@ -200,7 +207,7 @@ impl From<Vec<(String, Number)>> for RuntimeValue {
         RuntimeValue::Dict(Shared::new(
             v.into_iter()
                 .map(|(k, v)| (Ident::new(&k), RuntimeValue::Number(v)))
-                .collect::<BTreeMap<Ident, RuntimeValue>>(),
+                .collect::<Dict>(),
         ))
     }
 }
@@ -235,15 +242,15 @@ impl From<yaml_rust2::Yaml> for RuntimeValue {
                 RuntimeValue::Array(Shared::new(arr.into_iter().map(RuntimeValue::from).collect()))
             }
             yaml_rust2::Yaml::Hash(map) => {
-                let mut btree = BTreeMap::new();
+                let mut dict = Dict::default();
                 for (k, v) in map {
                     let key = match k {
                         yaml_rust2::Yaml::String(s) => s,
                         other => format!("{other:?}"),
                     };
-                    btree.insert(Ident::new(&key), RuntimeValue::from(v));
+                    dict.insert(Ident::new(&key), RuntimeValue::from(v));
                 }
-                RuntimeValue::Dict(Shared::new(btree))
+                RuntimeValue::Dict(Shared::new(dict))
             }
             yaml_rust2::Yaml::Alias(_) => RuntimeValue::NONE,
         }
@@ -267,7 +274,7 @@ impl From<serde_json::Value> for RuntimeValue {
                 RuntimeValue::Array(Shared::new(arr.into_iter().map(RuntimeValue::from).collect()))
             }
             serde_json::Value::Object(obj) => {
-                let mut map = BTreeMap::new();
+                let mut map = Dict::default();
                 for (k, v) in obj {
                     map.insert(Ident::new(&k), RuntimeValue::from(v));
                 }
@@ -294,7 +301,7 @@ impl From<ciborium::Value> for RuntimeValue {
                 RuntimeValue::Array(Shared::new(items))
             }
             ciborium::Value::Map(pairs) => {
-                let mut map = BTreeMap::new();
+                let mut map = Dict::default();
                 for (k, v) in pairs {
                     let key = match k {
                         ciborium::Value::Text(s) => Ident::new(&s),
@@ -393,8 +400,8 @@ pub(crate) fn array_mut(array: &mut Shared<Vec<RuntimeValue>>) -> &mut Vec<Runti
 
 /// Clone-on-write access to a dict's entries; see [`array_mut`].
 #[inline(always)]
-pub(crate) fn dict_mut(map: &mut Shared<BTreeMap<Ident, RuntimeValue>>) -> &mut BTreeMap<Ident, RuntimeValue> {
-    Shared::<BTreeMap<Ident, RuntimeValue>>::make_mut(map)
+pub(crate) fn dict_mut(map: &mut Shared<Dict>) -> &mut Dict {
+    Shared::<Dict>::make_mut(map)
 }
 
 impl RuntimeValue {
@@ -416,7 +423,7 @@ impl RuntimeValue {
     /// Creates a new empty dictionary.
     #[inline(always)]
     pub fn new_dict() -> RuntimeValue {
-        RuntimeValue::Dict(Shared::new(BTreeMap::new()))
+        RuntimeValue::Dict(Shared::new(Dict::default()))
     }
 
     /// Creates a new markdown runtime value from the given node.
@@ -795,7 +802,7 @@ impl RuntimeValues {
                         )),
                         RuntimeValue::Bytes(b) => RuntimeValue::new_markdown(node.with_value(bytes_to_hex(b).as_str())),
                         RuntimeValue::Dict(map) => {
-                            let mut new_dict = BTreeMap::new();
+                            let mut new_dict = Dict::default();
                             for (k, v) in map.iter() {
                                 if !v.is_none() && !v.is_empty() {
                                     new_dict.insert(
@@ -849,7 +856,7 @@ mod tests {
             RuntimeValue::String("test".to_string())
         ])), r#"[1, "test"]"#)]
     #[case(RuntimeValue::Dict({
-            let mut map = BTreeMap::new();
+            let mut map = Dict::default();
             map.insert(Ident::new("key1"), RuntimeValue::String("value1".to_string()));
             map.insert(Ident::new("key2"), RuntimeValue::Number(Number::from(42.0)));
             Shared::new(map)
@@ -864,7 +871,7 @@ mod tests {
         assert_eq!(format!("{}", RuntimeValue::Number(Number::from(42.0))), "42");
         assert_eq!(format!("{}", RuntimeValue::String(String::from("test"))), "test");
         assert_eq!(format!("{}", RuntimeValue::None), "");
-        let map_val = RuntimeValue::Dict(Shared::new(BTreeMap::default()));
+        let map_val = RuntimeValue::Dict(Shared::new(Dict::default()));
         assert_eq!(format!("{}", map_val), "{}");
     }
 
@@ -875,7 +882,7 @@ mod tests {
         assert_eq!(format!("{:?}", RuntimeValue::String(String::from("test"))), "\"test\"");
         assert_eq!(format!("{:?}", RuntimeValue::None), "None");
 
-        let mut map = BTreeMap::default();
+        let mut map = Dict::default();
         map.insert(Ident::new("name"), RuntimeValue::String("MQ".to_string()));
         map.insert(Ident::new("version"), RuntimeValue::Number(Number::from(1.0)));
         let map_val = RuntimeValue::Dict(Shared::new(map));
@@ -913,7 +920,7 @@ mod tests {
             .name(),
             "markdown"
         );
-        assert_eq!(RuntimeValue::Dict(Shared::new(BTreeMap::default())).name(), "dict");
+        assert_eq!(RuntimeValue::Dict(Shared::new(Dict::default())).name(), "dict");
     }
 
     #[test]
@@ -957,7 +964,7 @@ mod tests {
             )
             .is_truthy()
         );
-        assert!(RuntimeValue::Dict(Shared::new(BTreeMap::default())).is_truthy());
+        assert!(RuntimeValue::Dict(Shared::new(Dict::default())).is_truthy());
     }
 
     #[test]
@@ -1014,7 +1021,7 @@ mod tests {
             .len(),
             1
         );
-        let mut map = BTreeMap::default();
+        let mut map = Dict::default();
         map.insert(Ident::new("a"), RuntimeValue::String("alpha".to_string()));
         map.insert(Ident::new("b"), RuntimeValue::String("beta".to_string()));
         assert_eq!(RuntimeValue::Dict(Shared::new(map)).len(), 2);
@@ -1055,7 +1062,7 @@ mod tests {
         let native_fn = RuntimeValue::NativeFunction(Ident::new("debug"));
         assert_eq!(format!("{:?}", native_fn), "native_function");
 
-        let mut map = BTreeMap::default();
+        let mut map = Dict::default();
         map.insert(Ident::new("a"), RuntimeValue::String("alpha".to_string()));
         let map_val = RuntimeValue::Dict(Shared::new(map));
         assert_eq!(format!("{:?}", map_val), r#"{"a": "alpha"}"#);
@@ -1127,17 +1134,17 @@ mod tests {
 
     #[test]
     fn test_runtime_value_map_creation_and_equality() {
-        let mut map1_data = BTreeMap::default();
+        let mut map1_data = Dict::default();
         map1_data.insert(Ident::new("a"), RuntimeValue::Number(Number::from(1.0)));
         map1_data.insert(Ident::new("b"), RuntimeValue::String("hello".to_string()));
         let map1 = RuntimeValue::Dict(Shared::new(map1_data));
 
-        let mut map2_data = BTreeMap::default();
+        let mut map2_data = Dict::default();
         map2_data.insert(Ident::new("a"), RuntimeValue::Number(Number::from(1.0)));
         map2_data.insert(Ident::new("b"), RuntimeValue::String("hello".to_string()));
         let map2 = RuntimeValue::Dict(Shared::new(map2_data));
 
-        let mut map3_data = BTreeMap::default();
+        let mut map3_data = Dict::default();
         map3_data.insert(Ident::new("a"), RuntimeValue::Number(Number::from(1.0)));
         map3_data.insert(Ident::new("c"), RuntimeValue::String("world".to_string()));
         let map3 = RuntimeValue::Dict(Shared::new(map3_data));
@@ -1148,10 +1155,10 @@ mod tests {
 
     #[test]
     fn test_runtime_value_map_is_empty() {
-        let empty_map = RuntimeValue::Dict(Shared::new(BTreeMap::default()));
+        let empty_map = RuntimeValue::Dict(Shared::new(Dict::default()));
         assert!(empty_map.is_empty());
 
-        let mut map_data = BTreeMap::default();
+        let mut map_data = Dict::default();
         map_data.insert(Ident::new("a"), RuntimeValue::Number(Number::from(1.0)));
         let non_empty_map = RuntimeValue::Dict(Shared::new(map_data));
         assert!(!non_empty_map.is_empty());
@@ -1159,11 +1166,11 @@ mod tests {
 
     #[test]
     fn test_runtime_value_map_partial_ord() {
-        let mut map1_data = BTreeMap::default();
+        let mut map1_data = Dict::default();
         map1_data.insert(Ident::new("a"), RuntimeValue::Number(Number::from(1.0)));
         let map1 = RuntimeValue::Dict(Shared::new(map1_data));
 
-        let mut map2_data = BTreeMap::default();
+        let mut map2_data = Dict::default();
         map2_data.insert(Ident::new("b"), RuntimeValue::Number(Number::from(2.0)));
         let map2 = RuntimeValue::Dict(Shared::new(map2_data));
 
@@ -1264,7 +1271,7 @@ mod tests {
 
     #[test]
     fn test_to_json_value_dict() {
-        let mut map = BTreeMap::new();
+        let mut map = Dict::default();
         map.insert(Ident::new("k"), RuntimeValue::Boolean(false));
         let obj = RuntimeValue::Dict(Shared::new(map)).to_json_value();
         match obj {
@@ -1318,7 +1325,7 @@ mod tests {
     #[case(RuntimeValue::Boolean(true), false)]
     #[case(RuntimeValue::String("".to_string()), true)]
     #[case(RuntimeValue::Array(Shared::new(vec![])), true)]
-    #[case(RuntimeValue::Dict(Shared::new(BTreeMap::new())), true)]
+    #[case(RuntimeValue::Dict(Shared::new(Dict::default())), true)]
     #[case(RuntimeValue::Bytes(vec![]), true)]
     #[case(RuntimeValue::Bytes(vec![1]), false)]
     fn test_is_empty(#[case] value: RuntimeValue, #[case] expected: bool) {
@@ -1364,7 +1371,7 @@ mod tests {
     fn test_is_array_dict() {
         assert!(RuntimeValue::Array(Shared::new(vec![])).is_array());
         assert!(!RuntimeValue::None.is_array());
-        assert!(RuntimeValue::Dict(Shared::new(BTreeMap::new())).is_dict());
+        assert!(RuntimeValue::Dict(Shared::new(Dict::default())).is_dict());
         assert!(!RuntimeValue::None.is_dict());
     }
 
@@ -1387,7 +1394,7 @@ mod tests {
 
     #[test]
     fn test_from_btree_map() {
-        let mut map = BTreeMap::new();
+        let mut map = Dict::default();
         map.insert(Ident::new("x"), RuntimeValue::Boolean(true));
         let dict: RuntimeValue = map.into();
         assert!(dict.is_dict());
@@ -1513,7 +1520,7 @@ mod tests {
 
     #[test]
     fn test_to_cbor_value_dict() {
-        let mut map = BTreeMap::new();
+        let mut map = Dict::default();
         map.insert(Ident::new("k"), RuntimeValue::Boolean(true));
         let obj = RuntimeValue::Dict(Shared::new(map)).to_cbor_value();
         match obj {
@@ -1738,7 +1745,7 @@ mod tests {
     #[test]
     fn test_update_with_markdown_to_dict() {
         let orig: RuntimeValues = vec![md("d")].into();
-        let mut map = BTreeMap::new();
+        let mut map = Dict::default();
         map.insert(Ident::new("a"), RuntimeValue::String("val".to_string()));
         map.insert(Ident::new("b"), RuntimeValue::None);
         let updated: RuntimeValues = vec![RuntimeValue::Dict(Shared::new(map))].into();
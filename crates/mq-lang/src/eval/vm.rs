@@ -0,0 +1,710 @@
+//! Stack-based bytecode backend for the evaluator.
+//!
+//! [`Compiler`] lowers an [`ast::Program`](crate::ast::Program) into a flat [`Chunk`] of
+//! [`Op`]s so the hot loop dispatches over a contiguous instruction stream instead of
+//! chasing `Shared<ast::Node>` pointers per expression. The lowering is deliberately
+//! conservative: constructs that are rare on hot paths (closures, `match`, quoting,
+//! dynamic calls, module access) are not lowered and make [`Compiler::compile`] return
+//! `None`, in which case the engine transparently falls back to the AST walker.
+//!
+//! Semantics are shared with the tree-walking evaluator: variable scoping still goes
+//! through [`Env`], user-defined functions are invoked through
+//! [`Evaluator::call_fn_with_values`], and builtins through [`builtin::eval_builtin`],
+//! so both backends produce identical results and errors for lowered programs.
+use smallvec::SmallVec;
+
+use super::{ControlFlow, EvalError, EvalResult, Evaluator, builtin, define, define_mutable, env::Env};
+use crate::{
+    Ident, IdentWithToken, ModuleResolver, Program, RuntimeValue, Shared, SharedCell,
+    ast::{TokenId, node as ast},
+    error::runtime::RuntimeError,
+    get_token,
+    selector::Selector,
+};
+
+/// Selects how the engine executes a compiled program.
+#[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
+pub enum EvalBackend {
+    /// Walk the AST directly (the default).
+    #[default]
+    Ast,
+    /// Lower the program to flat bytecode and run it on a stack VM, falling back to
+    /// the AST walker for programs the compiler does not lower yet.
+    Bytecode,
+}
+
+/// A single VM instruction.
+///
+/// Every lowered expression leaves exactly one value on the operand stack; the
+/// `SetCurrent` instruction moves a pipeline stage's result into the current value
+/// that the next stage (and selector/builtin calls) observe.
+#[derive(Debug, Clone)]
+pub(crate) enum Op {
+    /// Push a constant value.
+    Push(RuntimeValue),
+    /// Push a clone of the current pipeline value (`self`/`.`).
+    PushCurrent,
+    /// Pop the top of the stack into the current pipeline value.
+    SetCurrent,
+    /// Pop and discard the top of the stack.
+    Pop,
+    /// Resolve a variable and push it; fails like `eval_ident` when undefined.
+    Load(Ident, TokenId),
+    /// Apply pipeline auto-call semantics to the top of the stack (bare identifiers
+    /// naming zero/one-argument functions are invoked instead of returned).
+    AutoCall(Shared<ast::Node>),
+    /// Pop a value, bind it immutably, then push the current pipeline value
+    /// (`let`/`as` expressions evaluate to the incoming value).
+    Let(Ident),
+    /// Pop a value and bind it mutably, then push the current pipeline value.
+    Var(Ident),
+    /// Pop a value and assign it to an existing mutable binding, then push the
+    /// current pipeline value.
+    Assign(Box<IdentWithToken>, TokenId),
+    /// Apply a selector to the current pipeline value and push the result.
+    Selector(Selector),
+    /// Apply a merged selector chain to the current pipeline value.
+    SelectorChain(SmallVec<[Selector; 4]>),
+    /// Pop `argc` evaluated arguments and call `ident`: a user-defined function when
+    /// the name resolves in the environment, otherwise a native builtin.
+    Call {
+        node: Shared<ast::Node>,
+        ident: Ident,
+        argc: usize,
+    },
+    /// Evaluate an interpolated string against the current pipeline value.
+    Interpolate {
+        segments: Vec<ast::StringSegment>,
+        token_id: TokenId,
+    },
+    /// Unconditional jump to an instruction index.
+    Jump(usize),
+    /// Pop the top of the stack and jump when it is falsy.
+    JumpIfFalse(usize),
+    /// Jump when the top of the stack is falsy, leaving the value in place.
+    JumpIfFalsePeek(usize),
+    /// Jump when the top of the stack is truthy, leaving the value in place.
+    JumpIfTruthyPeek(usize),
+    /// Run a sub-chunk in a fresh child scope and push its result.
+    Block(Chunk),
+    /// `while` loop: `(cond, body)` chunks re-run per iteration in a shared child scope.
+    While(Box<(Chunk, Chunk)>),
+    /// `loop`: run the body chunk until `break`.
+    Loop(Chunk),
+    /// `foreach`: pop the iterable, run the body chunk per element, push the results.
+    Foreach {
+        ident: Ident,
+        token_id: TokenId,
+        body: Chunk,
+    },
+    /// Raise a `break` control-flow signal, optionally carrying the popped value.
+    Break { token_id: TokenId, has_value: bool },
+    /// Raise a `continue` control-flow signal.
+    Continue(TokenId),
+}
+
+/// A flat sequence of instructions produced by [`Compiler::compile`].
+#[derive(Debug, Clone, Default)]
+pub(crate) struct Chunk {
+    pub(crate) ops: Vec<Op>,
+}
+
+/// Lowers AST programs into [`Chunk`]s.
+pub(crate) struct Compiler;
+
+impl Compiler {
+    /// Lowers `program` to bytecode, or returns `None` when it contains a construct
+    /// the compiler does not support so the caller can fall back to the AST walker.
+    pub(crate) fn compile(program: &Program) -> Option<Chunk> {
+        let mut ops = Vec::with_capacity(program.len() * 4);
+        Self::compile_program(program, &mut ops)?;
+        Some(Chunk { ops })
+    }
+
+    fn compile_program(program: &Program, ops: &mut Vec<Op>) -> Option<()> {
+        for node in program {
+            Self::compile_expr(node, ops)?;
+            // Mirror `eval_program`: a pipeline stage that is a bare identifier
+            // auto-calls the function it resolves to.
+            if matches!(&*node.expr, ast::Expr::Ident(_)) {
+                ops.push(Op::AutoCall(Shared::clone(node)));
+            }
+            ops.push(Op::SetCurrent);
+        }
+        Some(())
+    }
+
+    /// Compiles a single expression into its own chunk whose result becomes the
+    /// chunk's final current value (used for loop conditions and bodies).
+    fn compile_expr_chunk(node: &Shared<ast::Node>) -> Option<Chunk> {
+        let mut ops = Vec::new();
+        Self::compile_expr(node, &mut ops)?;
+        ops.push(Op::SetCurrent);
+        Some(Chunk { ops })
+    }
+
+    fn compile_program_chunk(program: &Program) -> Option<Chunk> {
+        let mut ops = Vec::with_capacity(program.len() * 4);
+        Self::compile_program(program, &mut ops)?;
+        Some(Chunk { ops })
+    }
+
+    fn compile_expr(node: &Shared<ast::Node>, ops: &mut Vec<Op>) -> Option<()> {
+        match &*node.expr {
+            ast::Expr::Literal(literal) => {
+                ops.push(Op::Push(Self::literal_value(literal)));
+            }
+            ast::Expr::Self_ | ast::Expr::Nodes => ops.push(Op::PushCurrent),
+            ast::Expr::Ident(ident) => ops.push(Op::Load(ident.name, node.token_id)),
+            ast::Expr::Selector(selector) => ops.push(Op::Selector(selector.clone())),
+            ast::Expr::SelectorChain(selectors) => ops.push(Op::SelectorChain(selectors.clone())),
+            ast::Expr::Paren(inner) => Self::compile_expr(inner, ops)?,
+            ast::Expr::Call(ident, args) => {
+                #[cfg(feature = "debugger")]
+                if ident.name == crate::ast::constants::builtins::BREAKPOINT.into() {
+                    // Breakpoints need the AST walker's debugger interception.
+                    return None;
+                }
+
+                // Spread arguments to `array`/`dict` are expanded by the AST walker.
+                if args
+                    .iter()
+                    .any(|arg| matches!(&*arg.expr, ast::Expr::Call(spread, _) if spread.name == *super::SPREAD_IDENT))
+                {
+                    return None;
+                }
+
+                for arg in args {
+                    Self::compile_expr(arg, ops)?;
+                }
+                ops.push(Op::Call {
+                    node: Shared::clone(node),
+                    ident: ident.name,
+                    argc: args.len(),
+                });
+            }
+            ast::Expr::And(operands) => {
+                if operands.is_empty() {
+                    ops.push(Op::Push(RuntimeValue::Boolean(true)));
+                    return Some(());
+                }
+                let mut falsy_jumps = Vec::with_capacity(operands.len());
+                for (i, operand) in operands.iter().enumerate() {
+                    Self::compile_expr(operand, ops)?;
+                    falsy_jumps.push(ops.len());
+                    ops.push(Op::JumpIfFalsePeek(usize::MAX));
+                    if i + 1 < operands.len() {
+                        ops.push(Op::Pop);
+                    }
+                }
+                let end_jump = ops.len();
+                ops.push(Op::Jump(usize::MAX));
+                let falsy_target = ops.len();
+                ops.push(Op::Pop);
+                ops.push(Op::Push(RuntimeValue::Boolean(false)));
+                let end = ops.len();
+                for idx in falsy_jumps {
+                    ops[idx] = Op::JumpIfFalsePeek(falsy_target);
+                }
+                ops[end_jump] = Op::Jump(end);
+            }
+            ast::Expr::Or(operands) => {
+                let mut truthy_jumps = Vec::with_capacity(operands.len());
+                for operand in operands {
+                    Self::compile_expr(operand, ops)?;
+                    truthy_jumps.push(ops.len());
+                    ops.push(Op::JumpIfTruthyPeek(usize::MAX));
+                    ops.push(Op::Pop);
+                }
+                ops.push(Op::Push(RuntimeValue::Boolean(false)));
+                let end = ops.len();
+                for idx in truthy_jumps {
+                    ops[idx] = Op::JumpIfTruthyPeek(end);
+                }
+            }
+            ast::Expr::If(branches) => {
+                let mut end_jumps = Vec::with_capacity(branches.len());
+                let mut has_else = false;
+                for (cond, body) in branches {
+                    match cond {
+                        Some(cond) => {
+                            Self::compile_expr(cond, ops)?;
+                            let skip_jump = ops.len();
+                            ops.push(Op::JumpIfFalse(usize::MAX));
+                            Self::compile_expr(body, ops)?;
+                            end_jumps.push(ops.len());
+                            ops.push(Op::Jump(usize::MAX));
+                            let next_branch = ops.len();
+                            ops[skip_jump] = Op::JumpIfFalse(next_branch);
+                        }
+                        None => {
+                            Self::compile_expr(body, ops)?;
+                            end_jumps.push(ops.len());
+                            ops.push(Op::Jump(usize::MAX));
+                            has_else = true;
+                            break;
+                        }
+                    }
+                }
+                if !has_else {
+                    ops.push(Op::Push(RuntimeValue::NONE));
+                }
+                let end = ops.len();
+                for idx in end_jumps {
+                    ops[idx] = Op::Jump(end);
+                }
+            }
+            ast::Expr::While(cond, body) => {
+                let cond_chunk = Self::compile_expr_chunk(cond)?;
+                let body_chunk = Self::compile_program_chunk(body)?;
+                ops.push(Op::While(Box::new((cond_chunk, body_chunk))));
+            }
+            ast::Expr::Loop(body) => {
+                ops.push(Op::Loop(Self::compile_program_chunk(body)?));
+            }
+            ast::Expr::Foreach(ident, values, body) => {
+                Self::compile_expr(values, ops)?;
+                ops.push(Op::Foreach {
+                    ident: ident.name,
+                    token_id: node.token_id,
+                    body: Self::compile_program_chunk(body)?,
+                });
+            }
+            ast::Expr::Let(ast::Pattern::Ident(ident), rhs) => {
+                Self::compile_expr(rhs, ops)?;
+                ops.push(Op::Let(ident.name));
+            }
+            ast::Expr::Var(ast::Pattern::Ident(ident), rhs) => {
+                Self::compile_expr(rhs, ops)?;
+                ops.push(Op::Var(ident.name));
+            }
+            ast::Expr::As(ident, rhs) => {
+                Self::compile_expr(rhs, ops)?;
+                ops.push(Op::Let(ident.name));
+            }
+            ast::Expr::Assign(ident, rhs) => {
+                Self::compile_expr(rhs, ops)?;
+                ops.push(Op::Assign(Box::new(ident.clone()), node.token_id));
+            }
+            ast::Expr::Block(program) => {
+                ops.push(Op::Block(Self::compile_program_chunk(program)?));
+            }
+            ast::Expr::InterpolatedString(segments) => {
+                ops.push(Op::Interpolate {
+                    segments: segments.clone(),
+                    token_id: node.token_id,
+                });
+            }
+            ast::Expr::Break(value) => {
+                if let Some(value) = value {
+                    Self::compile_expr(value, ops)?;
+                }
+                ops.push(Op::Break {
+                    token_id: node.token_id,
+                    has_value: value.is_some(),
+                });
+            }
+            ast::Expr::Continue => ops.push(Op::Continue(node.token_id)),
+            // Destructuring patterns, closures, macros, quoting, pattern matching,
+            // dynamic/module calls, error handling, and module loading keep the
+            // AST walker's implementation; their presence disables lowering.
+            ast::Expr::Let(_, _)
+            | ast::Expr::Var(_, _)
+            | ast::Expr::Def(_, _, _)
+            | ast::Expr::Fn(_, _)
+            | ast::Expr::Macro(_, _, _)
+            | ast::Expr::Match(_, _)
+            | ast::Expr::Try(_, _, _)
+            | ast::Expr::Quote(_)
+            | ast::Expr::Unquote(_)
+            | ast::Expr::CallDynamic(_, _)
+            | ast::Expr::SelectorCall(_, _)
+            | ast::Expr::QualifiedAccess(_, _)
+            | ast::Expr::Include(_)
+            | ast::Expr::Import(_, _)
+            | ast::Expr::Module(_, _) => return None,
+        }
+        Some(())
+    }
+
+    fn literal_value(literal: &ast::Literal) -> RuntimeValue {
+        match literal {
+            ast::Literal::None => RuntimeValue::None,
+            ast::Literal::Bool(b) => RuntimeValue::Boolean(*b),
+            ast::Literal::String(s) => RuntimeValue::String(s.clone()),
+            ast::Literal::Bytes(b) => RuntimeValue::Bytes(b.clone()),
+            ast::Literal::Symbol(i) => RuntimeValue::Symbol(*i),
+            ast::Literal::Number(n) => RuntimeValue::Number(*n),
+        }
+    }
+}
+
+/// Executes [`Chunk`]s against an [`Evaluator`]'s environment.
+pub(crate) struct Vm;
+
+impl Vm {
+    /// Runs `chunk` with `input` as the initial pipeline value and returns the final
+    /// pipeline value, raising the same errors and control-flow signals as the AST walker.
+    pub(crate) fn run<T: ModuleResolver>(
+        evaluator: &mut Evaluator<T>,
+        chunk: &Chunk,
+        input: RuntimeValue,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        let mut current = input;
+        let mut stack: Vec<RuntimeValue> = Vec::with_capacity(8);
+        let mut pc = 0;
+
+        while pc < chunk.ops.len() {
+            match &chunk.ops[pc] {
+                Op::Push(value) => stack.push(value.clone()),
+                Op::PushCurrent => stack.push(current.clone()),
+                Op::SetCurrent => current = Self::pop(&mut stack),
+                Op::Pop => {
+                    Self::pop(&mut stack);
+                }
+                Op::Load(ident, token_id) => stack.push(evaluator.eval_ident(*ident, *token_id, env)?),
+                Op::AutoCall(node) => {
+                    let value = Self::pop(&mut stack);
+                    stack.push(evaluator.maybe_auto_call_pipeline_ident(value, &current, node, env)?);
+                }
+                Op::Let(ident) => {
+                    let value = Self::pop(&mut stack);
+                    define(env, *ident, value);
+                    stack.push(current.clone());
+                }
+                Op::Var(ident) => {
+                    let value = Self::pop(&mut stack);
+                    define_mutable(env, *ident, value);
+                    stack.push(current.clone());
+                }
+                Op::Assign(ident, token_id) => {
+                    let value = Self::pop(&mut stack);
+                    Self::assign(evaluator, env, ident.as_ref(), *token_id, value)?;
+                    stack.push(current.clone());
+                }
+                Op::Selector(selector) => stack.push(Evaluator::<T>::eval_selector_expr(&current, selector)),
+                Op::SelectorChain(selectors) => stack.push(Evaluator::<T>::eval_selector_chain(&current, selectors)),
+                Op::Call { node, ident, argc } => {
+                    let args = stack.split_off(stack.len() - argc);
+                    stack.push(Self::call(evaluator, node, *ident, args, &current, env)?);
+                }
+                Op::Interpolate { segments, token_id } => {
+                    stack.push(evaluator.eval_interpolated_string(&current, segments, *token_id, env)?);
+                }
+                Op::Jump(target) => {
+                    pc = *target;
+                    continue;
+                }
+                Op::JumpIfFalse(target) => {
+                    if !Self::pop(&mut stack).is_truthy() {
+                        pc = *target;
+                        continue;
+                    }
+                }
+                Op::JumpIfFalsePeek(target) => {
+                    if !Self::peek(&stack).is_truthy() {
+                        pc = *target;
+                        continue;
+                    }
+                }
+                Op::JumpIfTruthyPeek(target) => {
+                    if Self::peek(&stack).is_truthy() {
+                        pc = *target;
+                        continue;
+                    }
+                }
+                Op::Block(block) => {
+                    let block_env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(env))));
+                    stack.push(Self::run(evaluator, block, current.clone(), &block_env)?);
+                }
+                Op::While(chunks) => {
+                    let (cond, body) = &**chunks;
+                    stack.push(Self::run_while(evaluator, cond, body, &current, env)?);
+                }
+                Op::Loop(body) => stack.push(Self::run_loop(evaluator, body, &current, env)?),
+                Op::Foreach { ident, token_id, body } => {
+                    let values = Self::pop(&mut stack);
+                    stack.push(Self::run_foreach(evaluator, *ident, values, body, *token_id, env)?);
+                }
+                Op::Break { token_id, has_value } => {
+                    let value = has_value.then(|| Box::new(Self::pop(&mut stack)));
+                    let token = get_token(Shared::clone(&evaluator.token_arena), *token_id);
+                    return Err(EvalError::Flow(ControlFlow::Break(token, value)));
+                }
+                Op::Continue(token_id) => {
+                    let token = get_token(Shared::clone(&evaluator.token_arena), *token_id);
+                    return Err(EvalError::Flow(ControlFlow::Continue(token)));
+                }
+            }
+            pc += 1;
+        }
+
+        Ok(current)
+    }
+
+    #[inline(always)]
+    fn pop(stack: &mut Vec<RuntimeValue>) -> RuntimeValue {
+        stack.pop().expect("vm operand stack underflow")
+    }
+
+    #[inline(always)]
+    fn peek(stack: &[RuntimeValue]) -> &RuntimeValue {
+        stack.last().expect("vm operand stack underflow")
+    }
+
+    fn call<T: ModuleResolver>(
+        evaluator: &mut Evaluator<T>,
+        node: &Shared<ast::Node>,
+        ident: Ident,
+        args: Vec<RuntimeValue>,
+        current: &RuntimeValue,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        #[cfg(not(feature = "sync"))]
+        let resolved = env.borrow().resolve(ident);
+        #[cfg(feature = "sync")]
+        let resolved = env.read().unwrap().resolve(ident);
+
+        match resolved {
+            Ok(fn_value) => evaluator.call_fn_with_values(&fn_value, Shared::clone(node), ident, args, current, env),
+            Err(_) => {
+                if let Some(kind) = super::ParallelCollection::from_ident(&ident) {
+                    return evaluator.eval_parallel_collection(kind, Shared::clone(node), ident, args, env);
+                }
+                builtin::eval_builtin(current, &ident, args, env).map_err(|e| {
+                    EvalError::from(e.to_runtime_error((**node).clone(), Shared::clone(&evaluator.token_arena)))
+                })
+            }
+        }
+    }
+
+    fn assign<T: ModuleResolver>(
+        evaluator: &Evaluator<T>,
+        env: &Shared<SharedCell<Env>>,
+        ident: &IdentWithToken,
+        token_id: TokenId,
+        value: RuntimeValue,
+    ) -> Result<(), EvalError> {
+        #[cfg(not(feature = "sync"))]
+        let result = env.borrow_mut().assign(ident.name, value);
+        #[cfg(feature = "sync")]
+        let result = env.write().unwrap().assign(ident.name, value);
+
+        result.map_err(|e| {
+            EvalError::from(
+                e.to_runtime_error_with_token(
+                    ident
+                        .token
+                        .clone()
+                        .unwrap_or(get_token(Shared::clone(&evaluator.token_arena), token_id)),
+                ),
+            )
+        })
+    }
+
+    /// Mirrors `Evaluator::eval_while` over compiled condition/body chunks.
+    fn run_while<T: ModuleResolver>(
+        evaluator: &mut Evaluator<T>,
+        cond: &Chunk,
+        body: &Chunk,
+        current: &RuntimeValue,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        let mut runtime_value = current.clone();
+        let env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(env))));
+        let mut cond_value = Self::run(evaluator, cond, runtime_value.clone(), &env)?;
+
+        if !cond_value.is_truthy() {
+            return Ok(RuntimeValue::NONE);
+        }
+        let mut first = true;
+
+        while cond_value.is_truthy() {
+            evaluator.check_timeout()?;
+            match Self::run(evaluator, body, runtime_value.clone(), &env) {
+                Ok(mut new_runtime_value) => {
+                    std::mem::swap(&mut runtime_value, &mut new_runtime_value);
+                    cond_value = Self::run(evaluator, cond, runtime_value.clone(), &env)?;
+                }
+                Err(EvalError::Flow(ControlFlow::Break(_, Some(v)))) => {
+                    runtime_value = *v;
+                    break;
+                }
+                Err(EvalError::Flow(ControlFlow::Break(_, None))) if first => {
+                    runtime_value = RuntimeValue::NONE;
+                    break;
+                }
+                Err(EvalError::Flow(ControlFlow::Break(_, None))) => break,
+                Err(EvalError::Flow(ControlFlow::Continue(_))) if first => {
+                    runtime_value = RuntimeValue::NONE;
+                    continue;
+                }
+                Err(EvalError::Flow(ControlFlow::Continue(_))) => continue,
+                Err(e) => return Err(e),
+            }
+
+            first = false;
+        }
+
+        Ok(runtime_value)
+    }
+
+    /// Mirrors `Evaluator::eval_loop` over a compiled body chunk.
+    fn run_loop<T: ModuleResolver>(
+        evaluator: &mut Evaluator<T>,
+        body: &Chunk,
+        current: &RuntimeValue,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        let mut runtime_value = current.clone();
+        let env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(env))));
+
+        loop {
+            evaluator.check_timeout()?;
+            match Self::run(evaluator, body, runtime_value.clone(), &env) {
+                Ok(mut new_runtime_value) => {
+                    std::mem::swap(&mut runtime_value, &mut new_runtime_value);
+                }
+                Err(EvalError::Flow(ControlFlow::Break(_, Some(v)))) => {
+                    runtime_value = *v;
+                    break;
+                }
+                Err(EvalError::Flow(ControlFlow::Break(_, None))) => break,
+                Err(EvalError::Flow(ControlFlow::Continue(_))) => continue,
+                Err(e) => return Err(e),
+            }
+        }
+
+        Ok(runtime_value)
+    }
+
+    /// Mirrors `Evaluator::eval_foreach` over a compiled body chunk.
+    fn run_foreach<T: ModuleResolver>(
+        evaluator: &mut Evaluator<T>,
+        ident: Ident,
+        values: RuntimeValue,
+        body: &Chunk,
+        token_id: TokenId,
+        env: &Shared<SharedCell<Env>>,
+    ) -> EvalResult {
+        let results = match values {
+            RuntimeValue::Array(values) => {
+                let env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(env))));
+                let mut results = Vec::with_capacity(values.len());
+
+                for value in Shared::unwrap_or_clone(values) {
+                    evaluator.check_timeout()?;
+                    define(&env, ident, value.clone());
+                    match Self::run(evaluator, body, value, &env) {
+                        Ok(result) => results.push(result),
+                        Err(EvalError::Flow(ControlFlow::Break(_, Some(v)))) => return Ok(*v),
+                        Err(EvalError::Flow(ControlFlow::Break(_, None))) => break,
+                        Err(EvalError::Flow(ControlFlow::Continue(_))) => continue,
+                        Err(e) => return Err(e),
+                    }
+                }
+
+                results
+            }
+            RuntimeValue::String(s) => {
+                let env = Shared::new(SharedCell::new(Env::with_parent(Shared::downgrade(env))));
+                let mut results = Vec::with_capacity(s.len());
+
+                for c in s.chars() {
+                    evaluator.check_timeout()?;
+                    define(&env, ident, RuntimeValue::String(c.to_string()));
+                    match Self::run(evaluator, body, RuntimeValue::String(c.to_string()), &env) {
+                        Ok(result) => results.push(result),
+                        Err(EvalError::Flow(ControlFlow::Break(_, Some(v)))) => return Ok(*v),
+                        Err(EvalError::Flow(ControlFlow::Break(_, None))) => break,
+                        Err(EvalError::Flow(ControlFlow::Continue(_))) => continue,
+                        Err(e) => return Err(e),
+                    }
+                }
+
+                results
+            }
+            _ => {
+                return Err(RuntimeError::InvalidTypes {
+                    token: get_token(Shared::clone(&evaluator.token_arena), token_id),
+                    name: crate::TokenKind::Foreach.to_string(),
+                    args: vec![values.to_string().into()],
+                }
+                .into());
+            }
+        };
+
+        Ok(RuntimeValue::Array(Shared::new(results)))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use crate::{DefaultEngine, null_input};
+    use rstest::rstest;
+
+    fn eval_with_backend(query: &str, backend: EvalBackend) -> Vec<RuntimeValue> {
+        let mut engine = DefaultEngine::default();
+        engine.set_eval_backend(backend);
+        engine.load_builtin_module();
+        engine
+            .eval(query, null_input().into_iter())
+            .unwrap_or_else(|e| panic!("{backend:?} backend failed for {query:?}: {e:?}"))
+            .values()
+            .to_vec()
+    }
+
+    #[rstest]
+    #[case::arithmetic("1 + 2 * 3")]
+    #[case::builtin_call("add(1, 2)")]
+    #[case::let_binding("let x = 10 | x + 5")]
+    #[case::var_and_assign("var i = 3 | i -= 1 | i")]
+    #[case::while_loop("var i = 100 | while(i > 0): i -= 1; | i")]
+    #[case::foreach_loop("foreach(x, range(0, 10, 1)): x * 2;")]
+    #[case::if_branches("if (1 > 2): \"a\" elif (2 > 1): \"b\" else: \"c\"")]
+    #[case::if_no_else("if (false): 1")]
+    #[case::and_or("1 == 1 && 2 == 2 || false")]
+    #[case::interpolation(r#"let world = "world" | s"hello ${world}""#)]
+    #[case::string_builtins(r#"upcase("hello") | split(" ")"#)]
+    #[case::user_function("def double(x): x * 2; | double(21)")]
+    #[case::recursion("def fib(x): if (x < 2): x else: fib(x - 1) + fib(x - 2); | fib(10)")]
+    #[case::break_in_loop("var i = 0 | loop: i += 1 | if (i > 3): break else: i;")]
+    #[case::continue_in_foreach("foreach(x, range(0, 5, 1)): if (x == 2): continue else: x;")]
+    #[case::block_scope("let x = 1 | x + 1")]
+    fn test_bytecode_matches_ast(#[case] query: &str) {
+        assert_eq!(
+            eval_with_backend(query, EvalBackend::Ast),
+            eval_with_backend(query, EvalBackend::Bytecode),
+            "backends disagree for {query:?}"
+        );
+    }
+
+    #[rstest]
+    #[case::closures("map(range(0, 3, 1), fn(x): x;)")]
+    #[case::match_expr("match (1): | 1: \"one\" | _: \"other\" end")]
+    fn test_bytecode_falls_back_without_changing_results(#[case] query: &str) {
+        // Programs the compiler does not lower must still evaluate correctly
+        // through the AST fallback when the bytecode backend is selected.
+        assert_eq!(
+            eval_with_backend(query, EvalBackend::Ast),
+            eval_with_backend(query, EvalBackend::Bytecode),
+            "fallback disagrees for {query:?}"
+        );
+    }
+
+    #[test]
+    fn test_compile_supported_program() {
+        let token_arena = Shared::new(SharedCell::new(crate::Arena::new(64)));
+        let program = crate::parse("var i = 10 | while(i > 0): i -= 1; | i", token_arena).unwrap();
+        assert!(Compiler::compile(&program).is_some());
+    }
+
+    #[test]
+    fn test_compile_unsupported_program_returns_none() {
+        let token_arena = Shared::new(SharedCell::new(crate::Arena::new(64)));
+        let program = crate::parse("map(range(0, 3, 1), fn(x): x;)", token_arena).unwrap();
+        assert!(Compiler::compile(&program).is_none());
+    }
+}
@@ -1,18 +1,18 @@
 pub mod token;
 
-use nom::Parser;
-use nom::bytes::complete::{is_not, take_until, take_while1};
+use nom::bytes::complete::{is_not, take_until};
 use nom::character::complete::{digit1, line_ending};
 use nom::combinator::{cut, opt};
 use nom::{
     IResult,
     branch::alt,
     bytes::complete::{escaped_transform, tag, take_while_m_n},
-    character::complete::{alpha1, alphanumeric1, anychar, char, multispace0, none_of, satisfy},
+    character::complete::{alphanumeric1, anychar, char, multispace0, none_of, satisfy},
     combinator::{map, map_opt, map_res, recognize, value},
     multi::{many0, many1},
     sequence::{delimited, pair, preceded},
 };
+use nom::{Input, Parser};
 use nom_locate::{LocatedSpan, position};
 use smol_str::SmolStr;
 use token::{StringSegment, Token, TokenKind};
@@ -20,7 +20,7 @@ use token::{StringSegment, Token, TokenKind};
 use crate::error::syntax::SyntaxError;
 use crate::module::ModuleId;
 use crate::number::Number;
-use crate::range::Range;
+use crate::range::{Position, Range};
 
 const MARKDOWN: &str = ".";
 
@@ -173,30 +173,55 @@ fn newline(input: Span) -> IResult<Span, Token> {
     .parse(input)
 }
 
+/// Returns the byte length of the run of `byte` at the start of `input`.
+///
+/// Runs of a single ASCII byte are the hottest scanning loops in the lexer
+/// (indentation, space runs); a plain byte-compare loop over the raw fragment
+/// vectorizes well, unlike going char-by-char through the nom combinators.
+#[inline]
+fn byte_run_len(input: &Span, byte: u8) -> usize {
+    input.fragment().as_bytes().iter().take_while(|&&b| b == byte).count()
+}
+
+#[inline]
+fn scan_error(input: Span) -> nom::Err<nom::error::Error<Span>> {
+    nom::Err::Error(nom::error::Error::new(input, nom::error::ErrorKind::TakeWhile1))
+}
+
 fn tab(input: Span) -> IResult<Span, Token> {
-    map(take_while1(|c| c == '\t'), |span: Span| {
-        let module_id = span.extra;
-        let num = span.fragment().len();
+    let num = byte_run_len(&input, b'\t');
+    if num == 0 {
+        return Err(scan_error(input));
+    }
+    let (rest, span) = input.take_split(num);
+    let module_id = span.extra;
+
+    Ok((
+        rest,
         Token {
             range: span.into(),
             kind: TokenKind::Tab(num),
             module_id,
-        }
-    })
-    .parse(input)
+        },
+    ))
 }
 
 fn spaces(input: Span) -> IResult<Span, Token> {
-    map(take_while1(|c| c == ' '), |span: Span| {
-        let module_id = span.extra;
-        let num = span.fragment().len();
+    let num = byte_run_len(&input, b' ');
+    if num == 0 {
+        return Err(scan_error(input));
+    }
+    let (rest, span) = input.take_split(num);
+    let module_id = span.extra;
+
+    Ok((
+        rest,
         Token {
             range: span.into(),
             kind: TokenKind::Whitespace(num),
             module_id,
-        }
-    })
-    .parse(input)
+        },
+    ))
 }
 
 define_token_parser!(colon, ":", TokenKind::Colon);
@@ -546,6 +571,35 @@ pub(crate) fn parse_interpolation_segments(
 }
 
 fn string_literal(input: Span) -> IResult<Span, Token> {
+    // Fast path: escape-free literals (the overwhelmingly common case) are
+    // found by scanning bytes to the first `"` or `\` and sliced straight out
+    // of the source, skipping the escape-transform machinery entirely. The
+    // byte scan is safe for UTF-8 content since neither delimiter byte can
+    // occur inside a multi-byte sequence.
+    let bytes = input.fragment().as_bytes();
+    if bytes.first() == Some(&b'"') {
+        let mut i = 1;
+        while i < bytes.len() && bytes[i] != b'"' && bytes[i] != b'\\' {
+            i += 1;
+        }
+        if bytes.get(i) == Some(&b'"') {
+            let content = input.fragment()[1..i].to_string();
+            let module_id = input.extra;
+            let start: Position = input.into();
+            let (rest, _) = input.take_split(i + 1);
+            let end: Position = rest.into();
+
+            return Ok((
+                rest,
+                Token {
+                    range: Range { start, end },
+                    kind: TokenKind::StringLiteral(content),
+                    module_id,
+                },
+            ));
+        }
+    }
+
     let (span, start) = position(input)?;
     let (span, s) = delimited(
         char('"'),
@@ -655,14 +709,22 @@ fn selector(input: Span) -> IResult<Span, Token> {
 
 /// Parses an identifier or keyword in a single pass.
 ///
-/// The ASCII base `[A-Za-z0-9_]+` is parsed first. Keywords are only matched
-/// at a word boundary (next char is not alphanumeric and not `_`). When the
-/// next char after the base is `-` or `*`, a second parse extends the span to
-/// cover the full identifier; otherwise `base_span` is used directly, avoiding
-/// a redundant re-parse.
+/// The ASCII base `[A-Za-z0-9_]+` is scanned first as a byte-classification
+/// loop over the raw fragment, the other hot scanning kernel besides
+/// whitespace runs. Keywords are only matched at a word boundary (next char
+/// is not alphanumeric and not `_`). When the next char after the base is
+/// `-` or `*`, a second scan extends the span to cover the full identifier;
+/// otherwise `base_span` is used directly.
 fn ident_or_keyword(input: Span) -> IResult<Span, Token> {
-    let (after_base, base_span) =
-        recognize(pair(alt((alpha1, tag("_"))), many0(alt((alphanumeric1, tag("_")))))).parse(input)?;
+    let bytes = input.fragment().as_bytes();
+    if !bytes.first().is_some_and(|&b| b.is_ascii_alphabetic() || b == b'_') {
+        return Err(scan_error(input));
+    }
+    let base_len = bytes
+        .iter()
+        .take_while(|&&b| b.is_ascii_alphanumeric() || b == b'_')
+        .count();
+    let (after_base, base_span) = input.take_split(base_len);
 
     let module_id = base_span.extra;
     let base_frag = *base_span.fragment();
@@ -716,15 +778,15 @@ fn ident_or_keyword(input: Span) -> IResult<Span, Token> {
         }
     }
 
-    // When the next character can extend the identifier (`-` or `*`), re-parse
+    // When the next character can extend the identifier (`-` or `*`), re-scan
     // from the original input to capture the full span. Otherwise `base_span`
     // already covers the complete identifier, so we reuse it directly.
     if next_char == Some('-') || next_char == Some('*') {
-        let (after_full, full_span) = recognize(pair(
-            alt((alpha1, tag("_"))),
-            many0(alt((alphanumeric1, tag("_"), tag("-"), tag("*")))),
-        ))
-        .parse(input)?;
+        let full_len = bytes
+            .iter()
+            .take_while(|&&b| b.is_ascii_alphanumeric() || matches!(b, b'_' | b'-' | b'*'))
+            .count();
+        let (after_full, full_span) = input.take_split(full_len);
 
         let full_frag = *full_span.fragment();
         let kind = match full_frag {
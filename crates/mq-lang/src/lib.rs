@@ -38,9 +38,16 @@
 //! - `ast-json`: Enables serialization and deserialization of the AST (Abstract Syntax Tree)
 //!   to/from JSON format (`ast_to_json` / `ast_from_json`). Use `Engine::compile` and
 //!   `Engine::eval_compiled` to execute programs constructed from deserialized ASTs.
+//!   Also enables [`CompileCache`], a persistent on-disk cache of compiled programs.
 //!   When this feature is enabled, `serde` and `serde_json` dependencies are included.
+//! - `profiler`: Enables per-expression profiling of query evaluation. Use
+//!   `Engine::set_profiling` to turn it on and `Engine::take_profile_records`
+//!   to retrieve invocation counts and cumulative wall time per expression as
+//!   [`ProfileRecord`]s, sorted hottest first.
 mod arena;
 mod ast;
+#[cfg(feature = "ast-json")]
+mod compile_cache;
 #[cfg(feature = "cst")]
 mod cst;
 mod engine;
@@ -77,13 +84,18 @@ pub use ast::node::Pattern as AstPattern;
 pub use ast::parser::Parser as AstParser;
 #[cfg(feature = "ast-json")]
 pub use ast::{ast_from_json, ast_to_json};
+#[cfg(feature = "ast-json")]
+pub use compile_cache::CompileCache;
 pub use engine::CompiledProgram;
 pub use engine::Engine;
 pub use error::Error;
 pub use eval::builtin::{
     BUILTIN_FUNCTION_DOC, BUILTIN_SELECTOR_DOC, BuiltinFunctionDoc, BuiltinSelectorDoc, INTERNAL_FUNCTION_DOC,
 };
-pub use eval::runtime_value::{RuntimeValue, RuntimeValues};
+#[cfg(feature = "profiler")]
+pub use eval::profiler::ProfileRecord;
+pub use eval::runtime_value::{Dict, RuntimeValue, RuntimeValues};
+pub use eval::vm::EvalBackend;
 pub use ident::Ident;
 pub use lexer::Options as LexerOptions;
 pub use lexer::token::{StringSegment, Token, TokenKind};
@@ -144,7 +156,7 @@ pub type SharedCell<T> = RefCell<T>;
 #[cfg(feature = "sync")]
 pub type SharedCell<T> = RwLock<T>;
 
-pub(crate) type TokenArena = Shared<SharedCell<Arena<Shared<Token>>>>;
+pub(crate) type TokenArena = Shared<SharedCell<Arena<Token>>>;
 
 #[cfg(feature = "cst")]
 pub fn parse_recovery(code: &str) -> (Vec<Shared<CstNode>>, CstErrorReporter) {
@@ -176,13 +188,9 @@ pub fn parse(code: &str, token_arena: TokenArena) -> Result<Program, Box<error::
         }
     };
 
-    AstParser::new(
-        tokens.into_iter().map(Shared::new).collect::<Vec<_>>().iter(),
-        &mut token_arena,
-        Module::TOP_LEVEL_MODULE_ID,
-    )
-    .parse()
-    .map_err(|e| Box::new(error::Error::from_error(code, e.into(), DefaultModuleLoader::default())))
+    AstParser::new(tokens.iter(), &mut token_arena, Module::TOP_LEVEL_MODULE_ID)
+        .parse()
+        .map_err(|e| Box::new(error::Error::from_error(code, e.into(), DefaultModuleLoader::default())))
 }
 
 /// Parses an MDX string and returns an iterator over `Value` nodes.
@@ -204,6 +212,33 @@ pub fn parse_html_input_with_options(
     Ok(html.nodes.into_iter().map(RuntimeValue::from).collect())
 }
 
+/// Parses an HTML string with the streaming converter, which converts one
+/// top-level element at a time so peak memory is bounded by the largest
+/// element instead of the whole document. Intended for large pages; unlike
+/// [`parse_html_input_with_options`] it emits all body content rather than
+/// extracting `main`/`article` regions.
+pub fn parse_html_input_streaming(
+    input: &str,
+    options: mq_markdown::ConversionOptions,
+) -> miette::Result<Vec<RuntimeValue>> {
+    const CHUNK_SIZE: usize = 64 * 1024;
+
+    let mut converter = mq_markdown::StreamingHtmlConverter::new(options);
+    let mut values = Vec::new();
+    let mut rest = input;
+    while !rest.is_empty() {
+        let mut end = CHUNK_SIZE.min(rest.len());
+        while !rest.is_char_boundary(end) {
+            end += 1;
+        }
+        let (chunk, tail) = rest.split_at(end);
+        values.extend(converter.push_chunk(chunk)?.into_iter().map(RuntimeValue::from));
+        rest = tail;
+    }
+    values.extend(converter.finish()?.into_iter().map(RuntimeValue::from));
+    Ok(values)
+}
+
 /// Parses a Markdown string and returns an iterator over `Value` nodes.
 pub fn parse_markdown_input(input: &str) -> miette::Result<Vec<RuntimeValue>> {
     let md = mq_markdown::Markdown::from_markdown_str(input)?;
@@ -231,28 +266,28 @@ pub fn bytes_input(bytes: &[u8]) -> Vec<RuntimeValue> {
 }
 
 #[inline(always)]
-pub(crate) fn token_alloc(arena: &TokenArena, token: &Shared<Token>) -> TokenId {
+pub(crate) fn token_alloc(arena: &TokenArena, token: &Token) -> TokenId {
     #[cfg(not(feature = "sync"))]
     {
-        arena.borrow_mut().alloc(Shared::clone(token))
+        arena.borrow_mut().alloc(token.clone())
     }
 
     #[cfg(feature = "sync")]
     {
-        arena.write().unwrap().alloc(Shared::clone(token))
+        arena.write().unwrap().alloc(token.clone())
     }
 }
 
 #[inline(always)]
-pub(crate) fn get_token(arena: TokenArena, token_id: TokenId) -> Shared<Token> {
+pub(crate) fn get_token(arena: TokenArena, token_id: TokenId) -> Token {
     #[cfg(not(feature = "sync"))]
     {
-        Shared::clone(&arena.borrow()[token_id])
+        arena.borrow()[token_id].clone()
     }
 
     #[cfg(feature = "sync")]
     {
-        Shared::clone(&arena.read().unwrap()[token_id])
+        arena.read().unwrap()[token_id].clone()
     }
 }
 
@@ -26,10 +26,20 @@ struct MacroDefinition {
     body: Shared<Program>,
 }
 
+/// Cache key for a memoized expansion: the macro's identity, whether the call
+/// used the implicit-`self` arity, and a canonical token-id-free encoding of
+/// the argument ASTs (see [`expansion_cache_key`]).
+type ExpansionKey = (Ident, bool, String);
+
 /// Expands macros in an AST before evaluation.
 #[derive(Debug, Clone)]
 pub struct Macro {
     macros: FxHashMap<Ident, MacroDefinition>,
+    /// Memoized results of [`Macro::expand_macro_call`]. Expanded subtrees are
+    /// `Shared` nodes, so a hit clones pointers instead of rebuilding the tree.
+    /// Cleared whenever a macro is (re)defined, since cached expansions may
+    /// embed expansions of other macros.
+    expansion_cache: FxHashMap<ExpansionKey, Vec<Shared<Node>>>,
     recursion_depth: u32,
     max_recursion: u32,
 }
@@ -38,6 +48,7 @@ impl Macro {
     pub fn new() -> Self {
         Self {
             macros: FxHashMap::default(),
+            expansion_cache: FxHashMap::default(),
             recursion_depth: 0,
             max_recursion: MAX_RECURSION_DEPTH,
         }
@@ -101,6 +112,9 @@ impl Macro {
                                 body: Shared::new(program),
                             },
                         );
+                        // A (re)definition invalidates every memoized expansion:
+                        // cached results of other macros may embed calls to this one.
+                        self.expansion_cache.clear();
                     } else {
                         unreachable!("Macro body did not evaluate to AST");
                     }
@@ -446,6 +460,18 @@ impl Macro {
             }
         };
 
+        // Memoize: equal macro plus structurally equal arguments always expand
+        // to the same tree, so repeated expansions (the same helper called
+        // across a module library, or the library re-expanded per compilation)
+        // are a pointer clone instead of a fresh tree build. Token ids inside
+        // a cached expansion refer to the first call site that produced it.
+        let cache_key = expansion_cache_key(args).map(|args_key| (name, params.len() == args.len() + 1, args_key));
+        if let Some(key) = &cache_key
+            && let Some(cached) = self.expansion_cache.get(key)
+        {
+            return Ok(cached.clone());
+        }
+
         // Create substitution map
         let mut substitutions = FxHashMap::with_capacity_and_hasher(params.len(), FxBuildHasher);
 
@@ -470,6 +496,10 @@ impl Macro {
         let result = self.substitute_and_expand_program(&body, &substitutions, evaluator);
         self.recursion_depth -= 1;
 
+        if let (Some(key), Ok(expanded)) = (cache_key, &result) {
+            self.expansion_cache.insert(key, expanded.clone());
+        }
+
         result
     }
 
@@ -1128,6 +1158,156 @@ impl Default for Macro {
     }
 }
 
+/// Builds the argument part of an [`ExpansionKey`]: a canonical encoding of
+/// the argument ASTs that ignores token ids, so structurally equal arguments
+/// from different call sites (or different compilations) share one entry.
+///
+/// Returns `None` when an argument contains a construct the encoding does not
+/// cover, in which case the call is simply not memoized.
+fn expansion_cache_key(args: &[Shared<Node>]) -> Option<String> {
+    let mut key = String::with_capacity(args.len() * 16);
+    for arg in args {
+        if !write_fingerprint(arg, &mut key) {
+            return None;
+        }
+        key.push(';');
+    }
+    Some(key)
+}
+
+/// Appends a canonical encoding of `node` to `out`, returning `false` for
+/// constructs that are not encoded (definitions, control flow, ...).
+///
+/// Every covered construct is encoded exactly — variable-length text is
+/// length-prefixed so the encoding is unambiguous — meaning equal keys imply
+/// structurally equal arguments, never a hash collision.
+fn write_fingerprint(node: &Node, out: &mut String) -> bool {
+    use std::fmt::Write;
+
+    fn write_all(nodes: &[Shared<Node>], out: &mut String) -> bool {
+        for node in nodes {
+            if !write_fingerprint(node, out) {
+                return false;
+            }
+            out.push(',');
+        }
+        true
+    }
+
+    match &*node.expr {
+        Expr::Literal(literal) => write_literal_fingerprint(literal, out),
+        Expr::Ident(ident) => {
+            let _ = write!(out, "i({})", ident.name);
+        }
+        Expr::Self_ => out.push_str("self"),
+        Expr::Nodes => out.push_str("nodes"),
+        Expr::Selector(selector) => {
+            let _ = write!(out, "sel({:?})", selector);
+        }
+        Expr::SelectorChain(selectors) => {
+            let _ = write!(out, "selc({:?})", selectors);
+        }
+        Expr::SelectorCall(selector, args) => {
+            let _ = write!(out, "selcall({:?};", selector);
+            if !write_all(args, out) {
+                return false;
+            }
+            out.push(')');
+        }
+        Expr::Call(ident, args) => {
+            let _ = write!(out, "c({};", ident.name);
+            if !write_all(args, out) {
+                return false;
+            }
+            out.push(')');
+        }
+        Expr::CallDynamic(callable, args) => {
+            out.push_str("cd(");
+            if !write_fingerprint(callable, out) {
+                return false;
+            }
+            out.push(';');
+            if !write_all(args, out) {
+                return false;
+            }
+            out.push(')');
+        }
+        Expr::Paren(inner) | Expr::Quote(inner) | Expr::Unquote(inner) => {
+            out.push_str(match &*node.expr {
+                Expr::Paren(_) => "p(",
+                Expr::Quote(_) => "q(",
+                _ => "uq(",
+            });
+            if !write_fingerprint(inner, out) {
+                return false;
+            }
+            out.push(')');
+        }
+        Expr::And(nodes) | Expr::Or(nodes) => {
+            out.push_str(if matches!(&*node.expr, Expr::And(_)) {
+                "and("
+            } else {
+                "or("
+            });
+            if !write_all(nodes, out) {
+                return false;
+            }
+            out.push(')');
+        }
+        Expr::InterpolatedString(segments) => {
+            out.push_str("is(");
+            for segment in segments {
+                match segment {
+                    StringSegment::Text(text) => {
+                        let _ = write!(out, "t({}:{})", text.len(), text);
+                    }
+                    StringSegment::Expr(expr) => {
+                        out.push_str("e(");
+                        if !write_fingerprint(expr, out) {
+                            return false;
+                        }
+                        out.push(')');
+                    }
+                    StringSegment::Env(name) => {
+                        let _ = write!(out, "env({}:{})", name.len(), name);
+                    }
+                    StringSegment::Self_ => out.push_str("self"),
+                }
+                out.push(',');
+            }
+            out.push(')');
+        }
+        _ => return false,
+    }
+
+    true
+}
+
+/// Appends a canonical encoding of a literal to `out`.
+fn write_literal_fingerprint(literal: &crate::ast::node::Literal, out: &mut String) {
+    use crate::ast::node::Literal;
+    use std::fmt::Write;
+
+    match literal {
+        Literal::String(s) => {
+            let _ = write!(out, "ls({}:{})", s.len(), s);
+        }
+        Literal::Bytes(bytes) => {
+            let _ = write!(out, "lb({:?})", bytes);
+        }
+        Literal::Number(n) => {
+            let _ = write!(out, "ln({})", n);
+        }
+        Literal::Symbol(ident) => {
+            let _ = write!(out, "ly({})", ident);
+        }
+        Literal::Bool(b) => {
+            let _ = write!(out, "lo({})", b);
+        }
+        Literal::None => out.push_str("lnone"),
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -1153,16 +1333,16 @@ mod tests {
         }
     }
 
-    fn create_token_arena() -> Shared<SharedCell<Arena<Shared<Token>>>> {
+    fn create_token_arena() -> Shared<SharedCell<Arena<Token>>> {
         let token_arena = Shared::new(SharedCell::new(Arena::new(10240)));
         // Ensure at least one token for ArenaId::new(0)
         crate::token_alloc(
             &token_arena,
-            &Shared::new(Token {
+            &Token {
                 kind: TokenKind::Eof,
                 range: crate::range::Range::default(),
                 module_id: crate::arena::ArenaId::new(0),
-            }),
+            },
         );
         token_arena
     }
@@ -2823,4 +3003,114 @@ mod tests {
 
         assert!(!expanded.is_empty(), "Expected non-empty expansion from quote context");
     }
+
+    #[test]
+    fn test_expansion_cache_reuses_expanded_subtrees() {
+        let mut macro_expander = Macro::new();
+        let defs = parse_program("macro double(x): x + x | 1").expect("Failed to parse macro definition");
+        macro_expander
+            .collect_macros(&defs, &mut MockMacroEvaluator)
+            .expect("Failed to collect macros");
+
+        // Same call from two independently parsed programs (distinct token ids,
+        // distinct node pointers) must share one cached expansion.
+        let first = macro_expander
+            .expand(&parse_program("double(5)").unwrap(), &mut MockMacroEvaluator)
+            .expect("Failed to expand first call");
+        assert_eq!(macro_expander.expansion_cache.len(), 1);
+
+        let second = macro_expander
+            .expand(&parse_program("double(5)").unwrap(), &mut MockMacroEvaluator)
+            .expect("Failed to expand second call");
+        assert_eq!(
+            macro_expander.expansion_cache.len(),
+            1,
+            "Repeat call must be a cache hit"
+        );
+        assert!(
+            first.iter().zip(second.iter()).all(|(a, b)| Shared::ptr_eq(a, b)),
+            "Cache hit must reuse the expanded subtree, not rebuild it"
+        );
+
+        // Structurally different arguments get their own entry.
+        macro_expander
+            .expand(&parse_program("double(6)").unwrap(), &mut MockMacroEvaluator)
+            .expect("Failed to expand call with different argument");
+        assert_eq!(macro_expander.expansion_cache.len(), 2);
+    }
+
+    #[test]
+    fn test_expansion_cache_cleared_on_macro_redefinition() {
+        let mut macro_expander = Macro::new();
+        macro_expander
+            .collect_macros(
+                &parse_program("macro double(x): x + x | 1").unwrap(),
+                &mut MockMacroEvaluator,
+            )
+            .expect("Failed to collect macros");
+        macro_expander
+            .expand(&parse_program("double(5)").unwrap(), &mut MockMacroEvaluator)
+            .expect("Failed to expand");
+        assert_eq!(macro_expander.expansion_cache.len(), 1);
+
+        // Redefining any macro drops all memoized expansions, since cached
+        // results may embed expansions of other macros.
+        macro_expander
+            .collect_macros(
+                &parse_program("macro double(x): x * x | 1").unwrap(),
+                &mut MockMacroEvaluator,
+            )
+            .expect("Failed to re-collect macros");
+        assert!(macro_expander.expansion_cache.is_empty());
+
+        let expanded = macro_expander
+            .expand(&parse_program("double(5)").unwrap(), &mut MockMacroEvaluator)
+            .expect("Failed to expand after redefinition");
+        assert!(!expanded.is_empty());
+    }
+
+    #[rstest]
+    #[case::literal("double(5)", true)]
+    #[case::ident("double(y)", true)]
+    #[case::selector("double(.h)", true)]
+    #[case::nested_call("double(add(1, 2))", true)]
+    #[case::interpolated_string(r#"double(s"v${x}")"#, true)]
+    #[case::control_flow_not_encoded("double(if (true): 1 else: 2)", false)]
+    fn test_expansion_cache_key_coverage(#[case] call: &str, #[case] cached: bool) {
+        let mut macro_expander = Macro::new();
+        macro_expander
+            .collect_macros(
+                &parse_program("macro double(x): x + x | 1").unwrap(),
+                &mut MockMacroEvaluator,
+            )
+            .expect("Failed to collect macros");
+
+        macro_expander
+            .expand(&parse_program(call).unwrap(), &mut MockMacroEvaluator)
+            .expect("Failed to expand");
+        assert_eq!(
+            !macro_expander.expansion_cache.is_empty(),
+            cached,
+            "Unexpected cache state for {call}"
+        );
+    }
+
+    #[test]
+    fn test_expansion_cache_does_not_change_eval_result() {
+        // Evaluate the same macro-using program twice through one engine; the
+        // second run hits the expansion cache and must produce the same value.
+        let program = parse_program("macro double(x): x + x | double(5)").expect("Failed to parse program");
+        let mut engine = DefaultEngine::default();
+        engine.load_builtin_module();
+
+        let first = engine
+            .evaluator
+            .eval(&program, [RuntimeValue::Number(0.into())].into_iter())
+            .expect("First evaluation failed");
+        let second = engine
+            .evaluator
+            .eval(&program, [RuntimeValue::Number(0.into())].into_iter())
+            .expect("Second evaluation failed");
+        assert_eq!(first, second);
+    }
 }
@@ -152,7 +152,7 @@ impl DefaultModuleResolver {
         self.http_resolver.set_allowed_domains(domains);
     }
 
-    /// Clears all locally-cached HTTP module files (mutable/HEAD only).
+    /// Marks all locally-cached HTTP module files stale for revalidation (mutable/HEAD only).
     #[cfg(feature = "http-import-ureq")]
     pub fn clear_http_cache(&self) -> Result<(), crate::module::error::ModuleError> {
         self.http_resolver.clear_cache()
@@ -133,6 +133,29 @@ struct CachedModule {
     hash: String,
 }
 
+/// HTTP cache validators (`ETag`/`Last-Modified`) recorded when a module is downloaded,
+/// stored in a `.mq.meta` sidecar next to the cached content.
+///
+/// When a stale (marked by [`UreqFetcher::clear_cache`]) cache entry is re-fetched, the
+/// validators are sent as `If-None-Match`/`If-Modified-Since` so an unchanged module is
+/// confirmed with an HTTP `304` instead of re-downloaded.
+#[cfg(feature = "http-import-ureq")]
+#[derive(Debug, Default, serde::Serialize, serde::Deserialize)]
+#[serde(default)]
+struct ModuleValidators {
+    #[serde(skip_serializing_if = "Option::is_none")]
+    etag: Option<String>,
+    #[serde(skip_serializing_if = "Option::is_none")]
+    last_modified: Option<String>,
+}
+
+#[cfg(feature = "http-import-ureq")]
+impl ModuleValidators {
+    fn is_empty(&self) -> bool {
+        self.etag.is_none() && self.last_modified.is_none()
+    }
+}
+
 /// Fetcher backed by `ureq` with local filesystem caching.
 ///
 /// Fetched modules are stored under `{system_cache_dir}/mq/` in one of two subdirectories:
@@ -140,9 +163,12 @@ struct CachedModule {
 /// - `versioned/` — URLs resolved to a specific tag (e.g. `@v0.1.0`); never cleared by
 ///   [`UreqFetcher::clear_cache`].
 /// - `mutable/` — URLs resolved to `HEAD`, `main`, `master`, or any non-GitHub HTTP URL;
-///   cleared by [`UreqFetcher::clear_cache`].
+///   marked stale by [`UreqFetcher::clear_cache`].
 ///
-/// Each cached module is accompanied by a `.mq.sha256` sidecar for tamper detection.
+/// Each cached module is accompanied by a `.mq.sha256` sidecar for tamper detection and,
+/// when the server supplied `ETag`/`Last-Modified` headers, a `.mq.meta` sidecar with
+/// those validators. Stale entries are revalidated with a conditional request so an
+/// unchanged module costs an HTTP `304` rather than a re-download.
 #[cfg(feature = "http-import-ureq")]
 #[derive(Debug, Clone)]
 pub struct UreqFetcher {
@@ -195,12 +221,22 @@ impl UreqFetcher {
         self.lockfile_enabled
     }
 
-    /// Removes mutable-ref cached modules and their `mq.lock` entries, regardless of
-    /// whether the lock check is currently enabled.
+    /// Marks mutable-ref cached modules stale and removes their `mq.lock` entries,
+    /// regardless of whether the lock check is currently enabled.
+    ///
+    /// Stale content is kept on disk: the next fetch revalidates it against the server
+    /// using its recorded `ETag`/`Last-Modified` validators and re-downloads only if the
+    /// remote content actually changed.
     pub fn clear_cache(&self) -> Result<(), ModuleError> {
         let mutable_dir = self.cache_dir.join("mutable");
         if mutable_dir.exists() {
-            std::fs::remove_dir_all(&mutable_dir).map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+            for entry in std::fs::read_dir(&mutable_dir).map_err(|e| ModuleError::IOError(e.to_string().into()))? {
+                let path = entry.map_err(|e| ModuleError::IOError(e.to_string().into()))?.path();
+                if path.extension().is_some_and(|ext| ext == "mq") {
+                    std::fs::write(path.with_extension("mq.stale"), b"")
+                        .map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+                }
+            }
         }
         self.with_lockfile_guard(|| {
             if !self.lockfile_path.exists() {
@@ -264,6 +300,27 @@ impl UreqFetcher {
         }
     }
 
+    /// Reads the `.mq.meta` validator sidecar, if present and well-formed.
+    ///
+    /// A missing or corrupt sidecar just means the next revalidation falls back to an
+    /// unconditional fetch, so errors are deliberately swallowed.
+    fn read_validators(meta_file: &std::path::Path) -> Option<ModuleValidators> {
+        let content = std::fs::read_to_string(meta_file).ok()?;
+        serde_json::from_str(&content).ok()
+    }
+
+    /// Writes (or removes, when there is nothing to record) the `.mq.meta` validator sidecar.
+    fn write_validators(meta_file: &std::path::Path, validators: &ModuleValidators) -> Result<(), ModuleError> {
+        if validators.is_empty() {
+            if meta_file.exists() {
+                std::fs::remove_file(meta_file).map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+            }
+            return Ok(());
+        }
+        let content = serde_json::to_string(validators).map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+        std::fs::write(meta_file, content).map_err(|e| ModuleError::IOError(e.to_string().into()))
+    }
+
     fn load_lock(path: &std::path::Path) -> Result<super::lockfile::ModuleLock, ModuleError> {
         if !path.exists() {
             return Ok(super::lockfile::ModuleLock::default());
@@ -345,7 +402,7 @@ impl UreqFetcher {
                     Ok(())
                 }
                 lockfile::LockCheck::Mismatch { locked } => {
-                    // --refresh-modules only clears mutable-ref cache and lock entries, so
+                    // --refresh-modules only refreshes mutable-ref cache and lock entries, so
                     // a drifted versioned (tagged) module needs the full reset instead.
 
                     let hint = if http_import::is_versioned_url(url) {
@@ -384,8 +441,12 @@ impl HttpFetcher for UreqFetcher {
         let stem = Self::cache_stem(url);
         let cache_file = cache_subdir.join(format!("{}.mq", stem));
         let hash_file = cache_subdir.join(format!("{}.mq.sha256", stem));
+        let meta_file = cache_subdir.join(format!("{}.mq.meta", stem));
+        let stale_file = cache_subdir.join(format!("{}.mq.stale", stem));
 
-        if let Some(cached) = self.try_read_cache(&cache_file, &hash_file)? {
+        if !stale_file.exists()
+            && let Some(cached) = self.try_read_cache(&cache_file, &hash_file)?
+        {
             self.check_lock(url, &cached.hash)?;
             return Ok(cached.content);
         }
@@ -402,17 +463,40 @@ impl HttpFetcher for UreqFetcher {
             .lock()
             .map_err(|e| ModuleError::IOError(e.to_string().into()))?;
 
-        if let Some(cached) = self.try_read_cache(&cache_file, &hash_file)? {
+        if !stale_file.exists()
+            && let Some(cached) = self.try_read_cache(&cache_file, &hash_file)?
+        {
             self.check_lock(url, &cached.hash)?;
             return Ok(cached.content);
         }
 
+        // A stale entry (marked by --refresh-modules) is revalidated conditionally: if the
+        // server still has its recorded validators, an HTTP 304 confirms the cached content
+        // is current without re-downloading it.
+        let stale_cached = self.try_read_cache(&cache_file, &hash_file)?;
+        let validators = stale_cached.as_ref().and_then(|_| Self::read_validators(&meta_file));
+
         let agent = super::ssrf::ssrf_safe_agent(self.timeout, true);
 
-        let mut response = agent
-            .get(url)
-            .call()
-            .map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+        let mut request = agent.get(url);
+        if let Some(validators) = &validators {
+            if let Some(etag) = &validators.etag {
+                request = request.header("if-none-match", etag.as_str());
+            }
+            if let Some(last_modified) = &validators.last_modified {
+                request = request.header("if-modified-since", last_modified.as_str());
+            }
+        }
+
+        let mut response = request.call().map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+
+        if response.status() == 304
+            && let Some(cached) = stale_cached
+        {
+            let _ = std::fs::remove_file(&stale_file);
+            self.check_lock(url, &cached.hash)?;
+            return Ok(cached.content);
+        }
 
         if response.status() != 200 {
             return Err(ModuleError::IOError(
@@ -436,6 +520,18 @@ impl HttpFetcher for UreqFetcher {
             ));
         }
 
+        let header_value = |name: &str| {
+            response
+                .headers()
+                .get(name)
+                .and_then(|v| v.to_str().ok())
+                .map(|s| s.to_string())
+        };
+        let response_validators = ModuleValidators {
+            etag: header_value("etag"),
+            last_modified: header_value("last-modified"),
+        };
+
         let content = response
             .body_mut()
             .with_config()
@@ -448,6 +544,10 @@ impl HttpFetcher for UreqFetcher {
 
         std::fs::write(&cache_file, content.as_bytes()).map_err(|e| ModuleError::IOError(e.to_string().into()))?;
         std::fs::write(&hash_file, hash.as_bytes()).map_err(|e| ModuleError::IOError(e.to_string().into()))?;
+        Self::write_validators(&meta_file, &response_validators)?;
+        if stale_file.exists() {
+            let _ = std::fs::remove_file(&stale_file);
+        }
 
         drop(lock_file);
         Ok(content)
@@ -457,7 +557,7 @@ impl HttpFetcher for UreqFetcher {
 /// Cache management methods specific to the `ureq`-backed resolver.
 #[cfg(feature = "http-import-ureq")]
 impl HttpModuleResolver<UreqFetcher> {
-    /// Removes only mutable-ref cached modules.
+    /// Marks mutable-ref cached modules stale so the next fetch revalidates them.
     pub fn clear_cache(&self) -> Result<(), ModuleError> {
         self.fetcher.clear_cache()
     }
@@ -903,7 +1003,7 @@ mod tests {
 
     #[test]
     #[cfg(feature = "http-import-ureq")]
-    fn test_clear_cache_removes_only_mutable() {
+    fn test_clear_cache_marks_only_mutable_stale() {
         let dir = TempDir::new().unwrap();
         let mutable_dir = dir.path().join("mutable");
         let versioned_dir = dir.path().join("versioned");
@@ -919,8 +1019,73 @@ mod tests {
         };
         let resolver = HttpModuleResolver::new(vec![], fetcher);
         resolver.clear_cache().unwrap();
-        assert!(!mutable_dir.exists());
+        // Mutable content is kept for conditional revalidation but flagged stale.
+        assert!(mutable_dir.join("a.mq").exists());
+        assert!(mutable_dir.join("a.mq.stale").exists());
         assert!(versioned_dir.join("b.mq").exists());
+        assert!(!versioned_dir.join("b.mq.stale").exists());
+    }
+
+    #[test]
+    #[cfg(feature = "http-import-ureq")]
+    fn test_fetch_stale_entry_requires_revalidation() {
+        let dir = TempDir::new().unwrap();
+        // "localhost" is rejected by the SSRF-safe resolver before any connection is
+        // attempted, so a network round trip here fails deterministically without I/O.
+        let url = "https://localhost/mymod.mq";
+        let content = "def cached(): 42;";
+        seed_cache(dir.path(), "mutable", url, content);
+
+        let fetcher = UreqFetcher {
+            cache_dir: dir.path().to_path_buf(),
+            lockfile_path: dir.path().join("mq.lock"),
+            ..UreqFetcher::default()
+        };
+
+        // Fresh entry: served from the cache without touching the network.
+        assert_eq!(fetcher.fetch(url).unwrap(), content);
+
+        // Stale entry: must revalidate against the server, which fails here.
+        let stem = UreqFetcher::cache_stem(url);
+        std::fs::write(dir.path().join("mutable").join(format!("{}.mq.stale", stem)), b"").unwrap();
+        assert!(matches!(fetcher.fetch(url), Err(ModuleError::IOError(_))));
+    }
+
+    #[test]
+    #[cfg(feature = "http-import-ureq")]
+    fn test_validators_sidecar_roundtrip() {
+        let dir = TempDir::new().unwrap();
+        let meta_file = dir.path().join("mod.mq.meta");
+
+        let validators = ModuleValidators {
+            etag: Some("\"abc123\"".to_string()),
+            last_modified: Some("Wed, 01 Jan 2025 00:00:00 GMT".to_string()),
+        };
+        UreqFetcher::write_validators(&meta_file, &validators).unwrap();
+
+        let loaded = UreqFetcher::read_validators(&meta_file).unwrap();
+        assert_eq!(loaded.etag.as_deref(), Some("\"abc123\""));
+        assert_eq!(loaded.last_modified.as_deref(), Some("Wed, 01 Jan 2025 00:00:00 GMT"));
+    }
+
+    #[test]
+    #[cfg(feature = "http-import-ureq")]
+    fn test_validators_sidecar_removed_when_empty() {
+        let dir = TempDir::new().unwrap();
+        let meta_file = dir.path().join("mod.mq.meta");
+        std::fs::write(&meta_file, b"{\"etag\":\"\\\"old\\\"\"}").unwrap();
+
+        UreqFetcher::write_validators(&meta_file, &ModuleValidators::default()).unwrap();
+        assert!(!meta_file.exists());
+    }
+
+    #[test]
+    #[cfg(feature = "http-import-ureq")]
+    fn test_read_validators_corrupt_sidecar_returns_none() {
+        let dir = TempDir::new().unwrap();
+        let meta_file = dir.path().join("mod.mq.meta");
+        std::fs::write(&meta_file, b"not json").unwrap();
+        assert!(UreqFetcher::read_validators(&meta_file).is_none());
     }
 
     #[test]
@@ -48,7 +48,8 @@ fn ptr_eq<T: ?Sized>(a: &Shared<T>, b: &Shared<T>) -> bool {
 ///
 /// - `None` (default): no transformations; the AST is returned unchanged.
 /// - `Basic`: constant folding, dead-branch elimination, and selector-chain merging.
-/// - `Full`: all passes — `Basic` plus let-literal propagation, function inlining, and tail-call optimization.
+/// - `Full`: all passes — `Basic` plus let-literal propagation, function inlining,
+///   loop-invariant hoisting, and tail-call optimization.
 #[derive(Debug, Clone, Copy, PartialEq, Eq, Default)]
 pub enum OptimizationLevel {
     #[default]
@@ -87,12 +88,18 @@ where
 #[derive(Default)]
 pub struct Optimizer {
     level: OptimizationLevel,
+    /// Monotonic counter for `__hoist_N` bindings, so nested loops hoisted in the
+    /// same program never shadow each other's bindings.
+    hoist_counter: std::cell::Cell<usize>,
 }
 
 impl Optimizer {
     /// Creates an `Optimizer` that runs only the passes enabled by `level`.
     pub fn with_level(level: OptimizationLevel) -> Self {
-        Self { level }
+        Self {
+            level,
+            hoist_counter: std::cell::Cell::new(0),
+        }
     }
 
     /// Runs all enabled optimization passes on `program` and returns the transformed AST.
@@ -556,6 +563,11 @@ impl Optimizer {
             ast::Expr::While(cond, program) => {
                 let opt_cond = self.optimize_node(Shared::clone(cond), user_defs);
                 let opt_body = self.optimize_nested(program.clone(), user_defs);
+                if matches!(self.level, OptimizationLevel::Full)
+                    && let Some(hoisted) = self.hoist_while_invariants(token_id, &opt_cond, &opt_body, user_defs)
+                {
+                    return hoisted;
+                }
                 if ptr_eq(&opt_cond, cond) && program.iter().zip(opt_body.iter()).all(|(a, b)| ptr_eq(a, b)) {
                     return node;
                 }
@@ -1146,6 +1158,74 @@ impl Optimizer {
             })
             .collect()
     }
+
+    /// Loop-invariant hoisting for `while` loops.
+    ///
+    /// Invariant subexpressions of the loop *condition* — pure builtin calls whose
+    /// arguments are literals or variables never rebound inside the loop — are
+    /// computed once in a `let` before the loop, so `while(i < len(arr)): ...` stops
+    /// re-evaluating `len(arr)` on every iteration. Occurrences of a hoisted
+    /// expression in the loop body are rewritten to the same binding.
+    ///
+    /// Only condition subexpressions are hoisted: the condition is always evaluated
+    /// before the first iteration, so computing it slightly earlier cannot surface an
+    /// error that the original program would not have raised. Body-only expressions
+    /// may never execute at all (the condition can be false up front), so hoisting
+    /// them would not be semantics-preserving.
+    fn hoist_while_invariants(
+        &self,
+        token_id: TokenId,
+        cond: &Shared<ast::Node>,
+        body: &Program,
+        user_defs: &FxHashSet<Ident>,
+    ) -> Option<Shared<ast::Node>> {
+        // A candidate referencing a variable that is rebound or assigned anywhere
+        // inside the loop (condition or body, at any depth) is not invariant.
+        let mut bound = FxHashSet::default();
+        collect_bound_names(cond, &mut bound);
+        for node in body {
+            collect_bound_names(node, &mut bound);
+        }
+
+        let mut candidates: Vec<Shared<ast::Node>> = Vec::new();
+        collect_hoist_candidates(cond, user_defs, &bound, &mut candidates);
+        if candidates.is_empty() {
+            return None;
+        }
+
+        let mut hoisted: Program = Vec::with_capacity(candidates.len() + 1);
+        let mut new_cond = Shared::clone(cond);
+        let mut new_body = body.clone();
+
+        for candidate in candidates {
+            let binding = IdentWithToken::new(&format!("__hoist_{}", self.hoist_counter.get()));
+            self.hoist_counter.set(self.hoist_counter.get() + 1);
+
+            hoisted.push(Shared::new(ast::Node {
+                token_id,
+                expr: Shared::new(ast::Expr::Let(
+                    Pattern::Ident(binding.clone()),
+                    Shared::clone(&candidate),
+                )),
+            }));
+            new_cond = replace_subtree(new_cond, &candidate, &binding);
+            new_body = new_body
+                .into_iter()
+                .map(|n| replace_subtree(n, &candidate, &binding))
+                .collect();
+        }
+
+        hoisted.push(Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::While(new_cond, new_body)),
+        }));
+        // `let` passes its input through unchanged, so wrapping in a block preserves
+        // both the value flowing into the loop and the loop's own result.
+        Some(Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Block(hoisted)),
+        }))
+    }
 }
 
 struct InlinableFn {
@@ -1314,6 +1394,511 @@ fn substitute_params(
     }
 }
 
+/// Pure builtins that are safe to hoist out of a loop when called with this exact
+/// arity: evaluation never touches the piped-in value (a smaller arity would make
+/// the builtin operate on `self`, which changes every iteration) and has no side
+/// effects. Mirrors the set handled by `try_fold_call`.
+fn hoistable_builtin(name: &str, arity: usize) -> bool {
+    use crate::ast::constants::builtins;
+    matches!(
+        (name, arity),
+        (
+            builtins::LEN
+                | builtins::TO_STRING
+                | builtins::TO_NUMBER
+                | builtins::TRIM
+                | builtins::LTRIM
+                | builtins::RTRIM
+                | builtins::UPCASE
+                | builtins::DOWNCASE
+                | builtins::NOT
+                | builtins::NEGATE
+                | builtins::FLOOR
+                | builtins::CEIL
+                | builtins::ROUND
+                | builtins::ABS
+                | builtins::TRUNC,
+            1
+        ) | (
+            builtins::ADD
+                | builtins::SUB
+                | builtins::MUL
+                | builtins::DIV
+                | builtins::MOD
+                | builtins::EQ
+                | builtins::NE
+                | builtins::LT
+                | builtins::LTE
+                | builtins::GT
+                | builtins::GTE
+                | builtins::STARTS_WITH
+                | builtins::ENDS_WITH
+                | builtins::INDEX
+                | builtins::RINDEX
+                | builtins::COALESCE,
+            2
+        ) | (builtins::REPLACE, 3)
+    )
+}
+
+/// Returns `true` when evaluating `node` reads neither the piped-in value nor any
+/// mutable state: literals, plain variable references, and full-arity calls to
+/// hoistable builtins (not shadowed by a user `def`) over such expressions.
+fn is_invariant_expr(node: &Shared<ast::Node>, user_defs: &FxHashSet<Ident>) -> bool {
+    match &*node.expr {
+        ast::Expr::Literal(_) | ast::Expr::Ident(_) => true,
+        ast::Expr::Paren(inner) => is_invariant_expr(inner, user_defs),
+        ast::Expr::Call(ident, args) => {
+            !user_defs.contains(&ident.name)
+                && hoistable_builtin(ident.name.as_str().as_str(), args.len())
+                && args.iter().all(|a| is_invariant_expr(a, user_defs))
+        }
+        _ => false,
+    }
+}
+
+/// Structural equality over the invariant-expression fragment (literals, idents,
+/// parens, calls), ignoring the source tokens attached to identifiers. Two
+/// occurrences of the same expression in different source positions carry
+/// different tokens, so derived `PartialEq` would never match them.
+fn same_invariant_expr(a: &ast::Expr, b: &ast::Expr) -> bool {
+    match (a, b) {
+        (ast::Expr::Literal(a), ast::Expr::Literal(b)) => a == b,
+        (ast::Expr::Ident(a), ast::Expr::Ident(b)) => a.name == b.name,
+        (ast::Expr::Paren(a), ast::Expr::Paren(b)) => same_invariant_expr(&a.expr, &b.expr),
+        (ast::Expr::Call(a_ident, a_args), ast::Expr::Call(b_ident, b_args)) => {
+            a_ident.name == b_ident.name
+                && a_args.len() == b_args.len()
+                && a_args
+                    .iter()
+                    .zip(b_args.iter())
+                    .all(|(x, y)| same_invariant_expr(&x.expr, &y.expr))
+        }
+        _ => false,
+    }
+}
+
+/// Returns `true` if the expression references at least one variable. Expressions
+/// without any are fully constant and already handled by constant folding.
+fn references_ident(node: &Shared<ast::Node>) -> bool {
+    match &*node.expr {
+        ast::Expr::Ident(_) => true,
+        ast::Expr::Paren(inner) => references_ident(inner),
+        ast::Expr::Call(_, args) => args.iter().any(references_ident),
+        _ => false,
+    }
+}
+
+/// Collects maximal hoistable subexpressions of a loop condition, deduplicated
+/// structurally. An expression reading a name in `bound` (rebound or assigned
+/// inside the loop) is rejected, but its arguments are still visited so an
+/// invariant subexpression of a variant comparison is found. Only positions that
+/// are unconditionally evaluated are visited: descending past the first operand
+/// of `&&`/`||` would hoist an expression the original program might have
+/// short-circuited away.
+fn collect_hoist_candidates(
+    node: &Shared<ast::Node>,
+    user_defs: &FxHashSet<Ident>,
+    bound: &FxHashSet<Ident>,
+    out: &mut Vec<Shared<ast::Node>>,
+) {
+    if matches!(&*node.expr, ast::Expr::Call(..)) && is_invariant_expr(node, user_defs) && references_ident(node) {
+        let mut free = FxHashSet::default();
+        collect_free_idents(node, &mut free);
+        if free.iter().all(|name| !bound.contains(name)) {
+            if !out.iter().any(|c| same_invariant_expr(&c.expr, &node.expr)) {
+                out.push(Shared::clone(node));
+            }
+            return;
+        }
+    }
+
+    match &*node.expr {
+        ast::Expr::Call(_, args) => {
+            for arg in args {
+                collect_hoist_candidates(arg, user_defs, bound, out);
+            }
+        }
+        ast::Expr::And(operands) | ast::Expr::Or(operands) => {
+            if let Some(first) = operands.first() {
+                collect_hoist_candidates(first, user_defs, bound, out);
+            }
+        }
+        ast::Expr::Paren(inner) => collect_hoist_candidates(inner, user_defs, bound, out),
+        _ => {}
+    }
+}
+
+/// Collects the variables an invariant candidate reads (its call names are builtins
+/// by construction, so only `Ident` leaves count).
+fn collect_free_idents(node: &Shared<ast::Node>, out: &mut FxHashSet<Ident>) {
+    match &*node.expr {
+        ast::Expr::Ident(ident) => {
+            out.insert(ident.name);
+        }
+        ast::Expr::Paren(inner) => collect_free_idents(inner, out),
+        ast::Expr::Call(_, args) => {
+            for arg in args {
+                collect_free_idents(arg, out);
+            }
+        }
+        _ => {}
+    }
+}
+
+fn collect_pattern_names(pattern: &Pattern, bound: &mut FxHashSet<Ident>) {
+    match pattern {
+        Pattern::Ident(ident) => {
+            bound.insert(ident.name);
+        }
+        Pattern::Array(patterns) | Pattern::Or(patterns) => {
+            for p in patterns {
+                collect_pattern_names(p, bound);
+            }
+        }
+        Pattern::ArrayRest(patterns, rest) => {
+            for p in patterns {
+                collect_pattern_names(p, bound);
+            }
+            bound.insert(rest.name);
+        }
+        Pattern::Dict(pairs) => {
+            for (_, p) in pairs {
+                collect_pattern_names(p, bound);
+            }
+        }
+        Pattern::Literal(_) | Pattern::Wildcard | Pattern::Type(_) => {}
+    }
+}
+
+/// Collects every name that is bound or assigned anywhere under `node`, at any
+/// scope depth. Used as a conservative invariance check: a candidate touching any
+/// such name is never hoisted, even if the binding is in an inner scope that could
+/// not actually shadow it.
+fn collect_bound_names(node: &Shared<ast::Node>, bound: &mut FxHashSet<Ident>) {
+    match &*node.expr {
+        ast::Expr::Let(pattern, rhs) | ast::Expr::Var(pattern, rhs) => {
+            collect_pattern_names(pattern, bound);
+            collect_bound_names(rhs, bound);
+        }
+        ast::Expr::Assign(ident, rhs) | ast::Expr::As(ident, rhs) => {
+            bound.insert(ident.name);
+            collect_bound_names(rhs, bound);
+        }
+        ast::Expr::Def(ident, params, program) => {
+            bound.insert(ident.name);
+            for param in params {
+                bound.insert(param.ident.name);
+                if let Some(default) = &param.default {
+                    collect_bound_names(default, bound);
+                }
+            }
+            for n in program {
+                collect_bound_names(n, bound);
+            }
+        }
+        ast::Expr::Fn(params, program) => {
+            for param in params {
+                bound.insert(param.ident.name);
+                if let Some(default) = &param.default {
+                    collect_bound_names(default, bound);
+                }
+            }
+            for n in program {
+                collect_bound_names(n, bound);
+            }
+        }
+        ast::Expr::Macro(ident, params, body) => {
+            bound.insert(ident.name);
+            for param in params {
+                bound.insert(param.ident.name);
+            }
+            collect_bound_names(body, bound);
+        }
+        ast::Expr::Foreach(ident, values, program) => {
+            bound.insert(ident.name);
+            collect_bound_names(values, bound);
+            for n in program {
+                collect_bound_names(n, bound);
+            }
+        }
+        ast::Expr::While(cond, program) => {
+            collect_bound_names(cond, bound);
+            for n in program {
+                collect_bound_names(n, bound);
+            }
+        }
+        ast::Expr::Block(program) | ast::Expr::Loop(program) | ast::Expr::Module(_, program) => {
+            for n in program {
+                collect_bound_names(n, bound);
+            }
+        }
+        ast::Expr::Call(_, args) | ast::Expr::SelectorCall(_, args) => {
+            for arg in args {
+                collect_bound_names(arg, bound);
+            }
+        }
+        ast::Expr::CallDynamic(callable, args) => {
+            collect_bound_names(callable, bound);
+            for arg in args {
+                collect_bound_names(arg, bound);
+            }
+        }
+        ast::Expr::And(operands) | ast::Expr::Or(operands) => {
+            for op in operands {
+                collect_bound_names(op, bound);
+            }
+        }
+        ast::Expr::If(branches) => {
+            for (cond, body) in branches {
+                if let Some(c) = cond {
+                    collect_bound_names(c, bound);
+                }
+                collect_bound_names(body, bound);
+            }
+        }
+        ast::Expr::Match(value, arms) => {
+            collect_bound_names(value, bound);
+            for arm in arms {
+                collect_pattern_names(&arm.pattern, bound);
+                if let Some(guard) = &arm.guard {
+                    collect_bound_names(guard, bound);
+                }
+                collect_bound_names(&arm.body, bound);
+            }
+        }
+        ast::Expr::Try(try_expr, error_binder, catch_expr) => {
+            if let Some(binder) = error_binder {
+                bound.insert(binder.name);
+            }
+            collect_bound_names(try_expr, bound);
+            collect_bound_names(catch_expr, bound);
+        }
+        ast::Expr::Paren(inner)
+        | ast::Expr::Quote(inner)
+        | ast::Expr::Unquote(inner)
+        | ast::Expr::Break(Some(inner)) => {
+            collect_bound_names(inner, bound);
+        }
+        ast::Expr::InterpolatedString(segments) => {
+            for segment in segments {
+                if let StringSegment::Expr(inner) = segment {
+                    collect_bound_names(inner, bound);
+                }
+            }
+        }
+        ast::Expr::Literal(_)
+        | ast::Expr::Ident(_)
+        | ast::Expr::Selector(_)
+        | ast::Expr::SelectorChain(_)
+        | ast::Expr::Self_
+        | ast::Expr::Nodes
+        | ast::Expr::Break(None)
+        | ast::Expr::Continue
+        | ast::Expr::Include(_)
+        | ast::Expr::Import(_, _)
+        | ast::Expr::QualifiedAccess(_, _) => {}
+    }
+}
+
+/// Replaces every subtree structurally equal to `target` with a reference to
+/// `binding`. Recursion stops at `def`/`fn`/macro bodies and quoted expressions:
+/// leaving an occurrence unreplaced is always correct, it just recomputes.
+fn replace_subtree(node: Shared<ast::Node>, target: &Shared<ast::Node>, binding: &IdentWithToken) -> Shared<ast::Node> {
+    if same_invariant_expr(&node.expr, &target.expr) {
+        return Shared::new(ast::Node {
+            token_id: node.token_id,
+            expr: Shared::new(ast::Expr::Ident(binding.clone())),
+        });
+    }
+    let token_id = node.token_id;
+
+    match &*node.expr {
+        ast::Expr::Call(ident, args) => {
+            let replaced: Args = args
+                .iter()
+                .map(|a| replace_subtree(Shared::clone(a), target, binding))
+                .collect();
+            if args.iter().zip(replaced.iter()).all(|(a, b)| ptr_eq(a, b)) {
+                return node;
+            }
+            Shared::new(ast::Node {
+                token_id,
+                expr: Shared::new(ast::Expr::Call(ident.clone(), replaced)),
+            })
+        }
+        ast::Expr::CallDynamic(callable, args) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::CallDynamic(
+                replace_subtree(Shared::clone(callable), target, binding),
+                args.iter()
+                    .map(|a| replace_subtree(Shared::clone(a), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::SelectorCall(selector, args) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::SelectorCall(
+                selector.clone(),
+                args.iter()
+                    .map(|a| replace_subtree(Shared::clone(a), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::And(operands) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::And(
+                operands
+                    .iter()
+                    .map(|o| replace_subtree(Shared::clone(o), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::Or(operands) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Or(
+                operands
+                    .iter()
+                    .map(|o| replace_subtree(Shared::clone(o), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::If(branches) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::If(
+                branches
+                    .iter()
+                    .map(|(cond, body)| {
+                        (
+                            cond.as_ref()
+                                .map(|c| replace_subtree(Shared::clone(c), target, binding)),
+                            replace_subtree(Shared::clone(body), target, binding),
+                        )
+                    })
+                    .collect(),
+            )),
+        }),
+        ast::Expr::Let(pattern, rhs) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Let(
+                pattern.clone(),
+                replace_subtree(Shared::clone(rhs), target, binding),
+            )),
+        }),
+        ast::Expr::Var(pattern, rhs) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Var(
+                pattern.clone(),
+                replace_subtree(Shared::clone(rhs), target, binding),
+            )),
+        }),
+        ast::Expr::Assign(ident, rhs) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Assign(
+                ident.clone(),
+                replace_subtree(Shared::clone(rhs), target, binding),
+            )),
+        }),
+        ast::Expr::As(ident, rhs) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::As(
+                ident.clone(),
+                replace_subtree(Shared::clone(rhs), target, binding),
+            )),
+        }),
+        ast::Expr::Block(program) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Block(
+                program
+                    .iter()
+                    .map(|n| replace_subtree(Shared::clone(n), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::Loop(program) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Loop(
+                program
+                    .iter()
+                    .map(|n| replace_subtree(Shared::clone(n), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::While(cond, program) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::While(
+                replace_subtree(Shared::clone(cond), target, binding),
+                program
+                    .iter()
+                    .map(|n| replace_subtree(Shared::clone(n), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::Foreach(ident, values, program) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Foreach(
+                ident.clone(),
+                replace_subtree(Shared::clone(values), target, binding),
+                program
+                    .iter()
+                    .map(|n| replace_subtree(Shared::clone(n), target, binding))
+                    .collect(),
+            )),
+        }),
+        ast::Expr::Match(value, arms) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Match(
+                replace_subtree(Shared::clone(value), target, binding),
+                arms.iter()
+                    .map(|arm| MatchArm {
+                        pattern: arm.pattern.clone(),
+                        guard: arm
+                            .guard
+                            .as_ref()
+                            .map(|g| replace_subtree(Shared::clone(g), target, binding)),
+                        body: replace_subtree(Shared::clone(&arm.body), target, binding),
+                    })
+                    .collect(),
+            )),
+        }),
+        ast::Expr::Try(try_expr, error_binder, catch_expr) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Try(
+                replace_subtree(Shared::clone(try_expr), target, binding),
+                error_binder.clone(),
+                replace_subtree(Shared::clone(catch_expr), target, binding),
+            )),
+        }),
+        ast::Expr::Paren(inner) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Paren(replace_subtree(Shared::clone(inner), target, binding))),
+        }),
+        ast::Expr::Break(Some(value)) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::Break(Some(replace_subtree(
+                Shared::clone(value),
+                target,
+                binding,
+            )))),
+        }),
+        ast::Expr::InterpolatedString(segments) => Shared::new(ast::Node {
+            token_id,
+            expr: Shared::new(ast::Expr::InterpolatedString(
+                segments
+                    .iter()
+                    .map(|segment| match segment {
+                        StringSegment::Expr(inner) => {
+                            StringSegment::Expr(replace_subtree(Shared::clone(inner), target, binding))
+                        }
+                        other => other.clone(),
+                    })
+                    .collect(),
+            )),
+        }),
+        _ => node,
+    }
+}
+
 fn literal_of(node: &Shared<ast::Node>) -> Option<Literal> {
     match &*node.expr {
         ast::Expr::Literal(lit) => Some(lit.clone()),
@@ -3149,4 +3734,130 @@ mod tests {
             "Full: def with default param must not be inlined; expected Call"
         );
     }
+
+    // ---- loop-invariant hoisting ----
+
+    /// Returns `true` if any node under `node` is a call to `name`.
+    fn contains_call(node: &crate::Shared<crate::AstNode>, name: &str) -> bool {
+        match &*node.expr {
+            Expr::Call(ident, args) => ident.name.as_str() == name || args.iter().any(|a| contains_call(a, name)),
+            Expr::Assign(_, rhs) | Expr::Let(_, rhs) | Expr::Var(_, rhs) | Expr::Paren(rhs) => contains_call(rhs, name),
+            Expr::While(cond, body) => contains_call(cond, name) || body.iter().any(|n| contains_call(n, name)),
+            Expr::Block(body) => body.iter().any(|n| contains_call(n, name)),
+            _ => false,
+        }
+    }
+
+    #[test]
+    fn full_while_invariant_condition_call_hoisted() {
+        let prog = ast_full("var i = 0 | let arr = array(1, 2, 3) | while (i < len(arr)): i += 1;");
+        let last = prog.last().unwrap();
+        let Expr::Block(block) = &*last.expr else {
+            panic!("Full: expected While to be wrapped in a Block, got {:?}", last.expr);
+        };
+        // let __hoist_0 = len(arr) | while (i < __hoist_0): ...
+        let Expr::Let(crate::ast::node::Pattern::Ident(binding), rhs) = &*block[0].expr else {
+            panic!(
+                "Full: expected hoisted Let as first block node, got {:?}",
+                block[0].expr
+            );
+        };
+        assert!(
+            binding.name.as_str().starts_with("__hoist_"),
+            "Full: hoisted binding must use the __hoist_ prefix, got {}",
+            binding.name
+        );
+        assert!(contains_call(rhs, "len"), "Full: hoisted RHS must be the len(arr) call");
+        let Expr::While(cond, _) = &*block.last().unwrap().expr else {
+            panic!(
+                "Full: expected While as last block node, got {:?}",
+                block.last().unwrap().expr
+            );
+        };
+        assert!(
+            !contains_call(cond, "len"),
+            "Full: len(arr) must be replaced by the hoisted binding in the condition"
+        );
+    }
+
+    #[test]
+    fn full_while_body_occurrence_rewritten_to_hoisted_binding() {
+        let prog = ast_full("var i = 0 | let arr = array(1, 2, 3) | while (i < len(arr)): i += len(arr);");
+        let last = prog.last().unwrap();
+        let Expr::Block(block) = &*last.expr else {
+            panic!("Full: expected While to be wrapped in a Block, got {:?}", last.expr);
+        };
+        let Expr::While(_, body) = &*block.last().unwrap().expr else {
+            panic!("Full: expected While as last block node");
+        };
+        assert!(
+            !body.iter().any(|n| contains_call(n, "len")),
+            "Full: body occurrences of len(arr) must reuse the hoisted binding"
+        );
+    }
+
+    #[test]
+    fn full_while_condition_on_rebound_var_not_hoisted() {
+        // `s` is reassigned in the body, so len(s) is not invariant.
+        let prog = ast_full("var s = \"aaa\" | while (len(s) > 0): s = \"\";");
+        let last = prog.last().unwrap();
+        assert!(
+            matches!(&*last.expr, Expr::While(..)),
+            "Full: len of a reassigned variable must not be hoisted, got {:?}",
+            last.expr
+        );
+    }
+
+    #[test]
+    fn full_while_short_circuit_operand_not_hoisted() {
+        // len(arr) sits behind `&&`: it may be short-circuited away on some
+        // iterations, so it must stay where it is.
+        let prog = ast_full("var i = 0 | let arr = array(1) | while (i < 3 && len(arr) > 0): i += 1;");
+        let last = prog.last().unwrap();
+        assert!(
+            matches!(&*last.expr, Expr::While(..)),
+            "Full: short-circuited operand must not be hoisted, got {:?}",
+            last.expr
+        );
+    }
+
+    #[test]
+    fn full_while_user_def_shadowing_builtin_not_hoisted() {
+        // A user `def len` may be impure; its calls must stay in the loop.
+        let prog = ast_full("def len(x): 1; | var i = 0 | let arr = array(1) | while (i < len(arr)): i += 1;");
+        let last = prog.last().unwrap();
+        assert!(
+            !matches!(&*last.expr, Expr::Block(_)),
+            "Full: call to user-defined len must not be hoisted, got {:?}",
+            last.expr
+        );
+    }
+
+    #[test]
+    fn basic_while_invariant_not_hoisted() {
+        let prog = ast_basic("var i = 0 | let arr = array(1, 2, 3) | while (i < len(arr)): i += 1;");
+        let last = prog.last().unwrap();
+        assert!(
+            matches!(&*last.expr, Expr::While(..)),
+            "Basic: loop-invariant hoisting is a Full-only pass, got {:?}",
+            last.expr
+        );
+    }
+
+    #[test]
+    fn full_while_hoisting_preserves_result() {
+        let query = "var i = 0 | let arr = array(1, 2, 3) | while (i < len(arr)): i += 1;";
+        let mut unoptimized = DefaultEngine::default();
+        unoptimized.load_builtin_module();
+        let mut optimized = DefaultEngine::default();
+        optimized.load_builtin_module();
+        optimized.set_optimization_level(OptimizationLevel::Full);
+
+        let input = vec![crate::RuntimeValue::NONE];
+        assert_eq!(
+            optimized.eval(query, input.clone().into_iter()),
+            unoptimized.eval(query, input.into_iter()),
+            "Full: hoisting must not change the loop result"
+        );
+    }
 }
@@ -1,5 +1,3 @@
-use std::collections::BTreeMap;
-
 use mq_lang::{DefaultEngine, Engine, Ident, MqResult, RuntimeValue, Shared};
 use rstest::{fixture, rstest};
 
@@ -552,6 +550,18 @@ fn engine() -> DefaultEngine {
       ",
         vec![RuntimeValue::Number(10.into())],
         Ok(vec![RuntimeValue::Number(15.into())].into()))]
+#[case::closure_frames_stay_distinct("
+      def make_adder(x):
+        fn(y): add(x, y);
+      end
+      def inc(v): add(v, 1);
+      let add_one = make_adder(1)
+      | let add_two = make_adder(2)
+      | let _ = map(array(1, 2, 3, 4, 5, 6, 7, 8), inc)
+      | add(add_one(10), add_two(10))
+      ",
+        vec![RuntimeValue::Number(0.into())],
+        Ok(vec![RuntimeValue::Number(23.into())].into()))]
 #[case::map("def test(x): add(x, 1); | map(array(1, 2, 3), test)",
             vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into())]))],
             Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(4.into())]))].into()))]
@@ -975,7 +985,7 @@ fn engine() -> DefaultEngine {
 #[case::dict_map_identity(r#"let m = dict(["a", 1], ["b", 2]) | map(m, fn(kv): kv;)"#,
         vec![RuntimeValue::Number(0.into())],
         Ok(vec![{
-          let mut dict = BTreeMap::new();
+          let mut dict = mq_lang::Dict::default();
           dict.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
           dict.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
           dict.into()
@@ -983,7 +993,7 @@ fn engine() -> DefaultEngine {
 #[case::dict_spread_basic("let base = {x: 1, y: 2} | {...base, z: 3}",
         vec![RuntimeValue::Number(0.into())],
         Ok(vec![{
-          let mut dict = BTreeMap::new();
+          let mut dict = mq_lang::Dict::default();
           dict.insert(Ident::new("x"), RuntimeValue::Number(1.into()));
           dict.insert(Ident::new("y"), RuntimeValue::Number(2.into()));
           dict.insert(Ident::new("z"), RuntimeValue::Number(3.into()));
@@ -992,7 +1002,7 @@ fn engine() -> DefaultEngine {
 #[case::dict_spread_later_key_overrides("let base = {x: 1, y: 2} | {...base, y: 99, z: 3}",
         vec![RuntimeValue::Number(0.into())],
         Ok(vec![{
-          let mut dict = BTreeMap::new();
+          let mut dict = mq_lang::Dict::default();
           dict.insert(Ident::new("x"), RuntimeValue::Number(1.into()));
           dict.insert(Ident::new("y"), RuntimeValue::Number(99.into()));
           dict.insert(Ident::new("z"), RuntimeValue::Number(3.into()));
@@ -1001,7 +1011,7 @@ fn engine() -> DefaultEngine {
 #[case::dict_spread_multiple("let a = {x: 1} | let b = {y: 2} | {...a, ...b}",
         vec![RuntimeValue::Number(0.into())],
         Ok(vec![{
-          let mut dict = BTreeMap::new();
+          let mut dict = mq_lang::Dict::default();
           dict.insert(Ident::new("x"), RuntimeValue::Number(1.into()));
           dict.insert(Ident::new("y"), RuntimeValue::Number(2.into()));
           dict.into()
@@ -1009,7 +1019,7 @@ fn engine() -> DefaultEngine {
 #[case::dict_spread_none_contributes_nothing("{...None, x: 1}",
         vec![RuntimeValue::Number(0.into())],
         Ok(vec![{
-          let mut dict = BTreeMap::new();
+          let mut dict = mq_lang::Dict::default();
           dict.insert(Ident::new("x"), RuntimeValue::Number(1.into()));
           dict.into()
         }].into()))]
@@ -1021,7 +1031,7 @@ fn engine() -> DefaultEngine {
         ",
           vec![RuntimeValue::Number(0.into())],
           Ok(vec![{
-            let mut dict = BTreeMap::new();
+            let mut dict = mq_lang::Dict::default();
             dict.insert(Ident::new("x"), RuntimeValue::Number(10.into()));
             dict.insert(Ident::new("y"), RuntimeValue::Number(20.into()));
             dict.into()
@@ -1034,7 +1044,7 @@ fn engine() -> DefaultEngine {
           "#,
             vec![RuntimeValue::Number(0.into())],
             Ok(vec![{
-              let mut dict = BTreeMap::new();
+              let mut dict = mq_lang::Dict::default();
               dict.insert(Ident::new("prefix_a"), RuntimeValue::Number(1.into()));
               dict.insert(Ident::new("prefix_b"), RuntimeValue::Number(2.into()));
               dict.into()
@@ -1052,7 +1062,7 @@ fn engine() -> DefaultEngine {
           "#,
             vec![RuntimeValue::Number(0.into())],
             Ok(vec![{
-              let mut dict = BTreeMap::new();
+              let mut dict = mq_lang::Dict::default();
               dict.insert(Ident::new("num1_transformed"), RuntimeValue::Number(101.into()));
               dict.insert(Ident::new("num2_transformed"), RuntimeValue::Number(102.into()));
               dict.into()
@@ -1065,7 +1075,7 @@ fn engine() -> DefaultEngine {
             "#,
             vec![RuntimeValue::Number(0.into())],
             Ok(vec![{
-              let mut dict = BTreeMap::new();
+              let mut dict = mq_lang::Dict::default();
               dict.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
               dict.insert(Ident::new("c"), RuntimeValue::Number(4.into()));
               dict.into()
@@ -1080,7 +1090,7 @@ fn engine() -> DefaultEngine {
             ",
               vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(4.into()), RuntimeValue::Number(5.into()), RuntimeValue::Number(6.into()), RuntimeValue::Number(7.into()), RuntimeValue::Number(8.into()), RuntimeValue::Number(9.into())]))],
               Ok(vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("0"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(3.into()), RuntimeValue::Number(6.into()), RuntimeValue::Number(9.into())])));
                 dict.insert(Ident::new("1"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(4.into()), RuntimeValue::Number(7.into())])));
                 dict.insert(Ident::new("2"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(2.into()), RuntimeValue::Number(5.into()), RuntimeValue::Number(8.into())])));
@@ -1093,7 +1103,7 @@ fn engine() -> DefaultEngine {
             "#,
               vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("cat".to_string()), RuntimeValue::String("dog".to_string()), RuntimeValue::String("bird".to_string()), RuntimeValue::String("fish".to_string()), RuntimeValue::String("elephant".to_string())]))],
               Ok(vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("3"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("cat".to_string()), RuntimeValue::String("dog".to_string())])));
                 dict.insert(Ident::new("4"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("bird".to_string()), RuntimeValue::String("fish".to_string())])));
                 dict.insert(Ident::new("8"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("elephant".to_string())])));
@@ -1113,7 +1123,7 @@ fn engine() -> DefaultEngine {
             ",
               vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(42.into())]))],
               Ok(vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("42"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(42.into())])));
                 dict.into()
               }].into()))]
@@ -1124,7 +1134,7 @@ fn engine() -> DefaultEngine {
             "#,
               vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(4.into())]))],
               Ok(vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("same"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(4.into())])));
                 dict.into()
               }].into()))]
@@ -1135,11 +1145,40 @@ fn engine() -> DefaultEngine {
             ",
               vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(4.into()), RuntimeValue::Number(5.into()), RuntimeValue::Number(6.into())]))],
               Ok(vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("false"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(5.into())])));
                 dict.insert(Ident::new("true"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(2.into()), RuntimeValue::Number(4.into()), RuntimeValue::Number(6.into())])));
                 dict.into()
               }].into()))]
+#[case::pmap("def test(x): add(x, 1); | pmap(array(1, 2, 3), test)",
+      vec![RuntimeValue::Number(10.into())],
+      Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(2.into()), RuntimeValue::Number(3.into()), RuntimeValue::Number(4.into())]))].into()))]
+#[case::pmap_none("def test(x): add(x, 1); | pmap(None, test)",
+      vec![RuntimeValue::Number(10.into())],
+      Ok(vec![RuntimeValue::NONE].into()))]
+#[case::pmap_large("def test(x): add(x, 1); | pmap(range(0, 64), test)",
+      vec![RuntimeValue::Number(10.into())],
+      Ok(vec![RuntimeValue::Array(Shared::new((1..=65).map(|i: i64| RuntimeValue::Number(i.into())).collect()))].into()))]
+#[case::pfilter("
+            def is_even(x):
+              eq(mod(x, 2), 0);
+            | pfilter(array(1, 2, 3, 4, 5, 6), is_even)
+            ",
+      vec![RuntimeValue::Number(10.into())],
+      Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(2.into()), RuntimeValue::Number(4.into()), RuntimeValue::Number(6.into())]))].into()))]
+#[case::pgroup_by("
+            def get_remainder(x):
+              mod(x, 3);
+            | pgroup_by(array(1, 2, 3, 4, 5, 6, 7, 8, 9), get_remainder)
+            ",
+      vec![RuntimeValue::Number(10.into())],
+      Ok(vec![{
+        let mut dict = mq_lang::Dict::default();
+        dict.insert(Ident::new("0"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(3.into()), RuntimeValue::Number(6.into()), RuntimeValue::Number(9.into())])));
+        dict.insert(Ident::new("1"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(4.into()), RuntimeValue::Number(7.into())])));
+        dict.insert(Ident::new("2"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(2.into()), RuntimeValue::Number(5.into()), RuntimeValue::Number(8.into())])));
+        dict.into()
+      }].into()))]
 #[case::is_h_true("is_h()",
         vec![RuntimeValue::new_markdown(mq_markdown::Node::Heading(mq_markdown::Heading {
             values: vec![],
@@ -1593,7 +1632,7 @@ fn engine() -> DefaultEngine {
               Ok(vec![RuntimeValue::Boolean(false)].into()))]
 #[case::any_dict_true(r#"any(dict(["a", 1], ["b", 2]), fn(kv): last(kv) == 2;)"#,
               vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
                 dict.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
                 dict.into()
@@ -1601,7 +1640,7 @@ fn engine() -> DefaultEngine {
               Ok(vec![RuntimeValue::Boolean(true)].into()))]
 #[case::any_dict_false(r#"any(dict(["a", 1], ["b", 2]), fn(kv): last(kv) == 3;)"#,
               vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
                 dict.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
                 dict.into()
@@ -1621,7 +1660,7 @@ fn engine() -> DefaultEngine {
               Ok(vec![RuntimeValue::Boolean(true)].into()))]
 #[case::all_dict_true(r#"all(dict(["a", 2], ["b", 4]), fn(kv): mod(last(kv), 2) == 0;)"#,
               vec![{
-              let mut dict = BTreeMap::new();
+              let mut dict = mq_lang::Dict::default();
               dict.insert(Ident::new("a"), RuntimeValue::Number(2.into()));
               dict.insert(Ident::new("b"), RuntimeValue::Number(4.into()));
               dict.into()
@@ -1629,7 +1668,7 @@ fn engine() -> DefaultEngine {
               Ok(vec![RuntimeValue::Boolean(true)].into()))]
 #[case::all_dict_false(r#"all(dict(["a", 2], ["b", 3]), fn(kv): mod(last(kv), 2) == 0;)"#,
               vec![{
-              let mut dict = BTreeMap::new();
+              let mut dict = mq_lang::Dict::default();
               dict.insert(Ident::new("a"), RuntimeValue::Number(2.into()));
               dict.insert(Ident::new("b"), RuntimeValue::Number(3.into()));
               dict.into()
@@ -1716,7 +1755,7 @@ fn engine() -> DefaultEngine {
 #[case::dict_literal_simple(r#"let d = {"a": 1, "b": "two"} | d"#, // Mixing string and ident keys
             vec![RuntimeValue::Number(0.into())],
             Ok(vec![{
-                let mut dict = BTreeMap::new();
+                let mut dict = mq_lang::Dict::default();
                 dict.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
                 dict.insert(Ident::new("b"), RuntimeValue::String("two".to_string()));
                 dict.into()
@@ -1943,7 +1982,7 @@ fn engine() -> DefaultEngine {
   } | d"#,
   vec![RuntimeValue::Number(0.into())],
   Ok(vec![{
-    let mut dict = BTreeMap::new();
+    let mut dict = mq_lang::Dict::default();
     dict.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
     dict.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
     dict.insert(Ident::new("c"), RuntimeValue::Number(3.into()));
@@ -1978,12 +2017,12 @@ fn engine() -> DefaultEngine {
         vec![RuntimeValue::Number(0.into())],
         Ok(vec![RuntimeValue::Array(Shared::new(vec![
             {
-                let mut d = BTreeMap::new();
+                let mut d = mq_lang::Dict::default();
                 d.insert(Ident::new("a"), RuntimeValue::Number(1.into()));
                 RuntimeValue::Dict(Shared::new(d))
             },
             {
-                let mut d = BTreeMap::new();
+                let mut d = mq_lang::Dict::default();
                 d.insert(Ident::new("b"), RuntimeValue::Number(2.into()));
                 RuntimeValue::Dict(Shared::new(d))
             },
@@ -2710,21 +2749,21 @@ fn engine() -> DefaultEngine {
 #[case::lte_simple("lte(1, 2)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::Boolean(true)].into()))]
 #[case::ne_simple("ne(1, 2)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::Boolean(true)].into()))]
 #[case::csv_parse_simple(r##"_csv_parse("a,b\n1,2", ",", true)"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Array(Shared::new(vec![
-    RuntimeValue::Dict(Shared::new(BTreeMap::from([
+    RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
         (Ident::new("a"), RuntimeValue::String("1".to_string())),
         (Ident::new("b"), RuntimeValue::String("2".to_string())),
     ])))
 ]))].into()))]
-#[case::json_parse_simple(r##"_json_parse("{\"a\": 1}")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::json_parse_simple(r##"_json_parse("{\"a\": 1}")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("a"), RuntimeValue::Number(1.into())),
 ])))].into()))]
-#[case::yaml_parse_simple(r##"_yaml_parse("a: 1")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::yaml_parse_simple(r##"_yaml_parse("a: 1")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("a"), RuntimeValue::Number(1.into())),
 ])))].into()))]
-#[case::toml_parse_simple(r##"_toml_parse("a = 1")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::toml_parse_simple(r##"_toml_parse("a = 1")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("a"), RuntimeValue::Number(1.into())),
 ])))].into()))]
-#[case::xml_parse_simple(r##"_xml_parse("<root>text</root>")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::xml_parse_simple(r##"_xml_parse("<root>text</root>")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("tag"), RuntimeValue::String("root".to_string())),
     (Ident::new("attributes"), RuntimeValue::new_dict()),
     (Ident::new("children"), RuntimeValue::Array(Shared::new(vec![]))),
@@ -2763,10 +2802,10 @@ fn engine() -> DefaultEngine {
 #[case::set_list_ordered_simple(r##"to_markdown("- item") | first() | set_list_ordered(true) | .list.ordered"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Boolean(true)].into()))]
 #[case::diff_simple(r##"_diff("abc", "abd") | len()"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Number(2.into())].into()))]
 #[case::get_markdown_position_simple(r##"to_markdown("# title") | first() | _get_markdown_position() | get("start_line")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Number(1.into())].into()))]
-#[case::toon_parse_simple(r##"_toon_parse("a: 1")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::toon_parse_simple(r##"_toon_parse("a: 1")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("a"), RuntimeValue::Number(1.into())),
 ])))].into()))]
-#[case::capture_simple(r##"capture("abc123def", "(?P<num>\\d+)")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::capture_simple(r##"capture("abc123def", "(?P<num>\\d+)")"##, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("num"), RuntimeValue::String("123".to_string())),
 ])))].into()))]
 #[case::is_debug_mode_simple("is_debug_mode()", vec![RuntimeValue::None], Ok(vec![RuntimeValue::Boolean(cfg!(feature = "debugger"))].into()))]
@@ -2875,27 +2914,27 @@ fn engine() -> DefaultEngine {
 // partial: 2-param function can be partially applied — the scenario that triggered the redesign
 #[case::partial_two_param("def plus(a, b): a + b; | let plus10 = partial(plus, 10) | plus10(5)", vec![RuntimeValue::Number(0.into())], Ok(vec![RuntimeValue::Number(15.into())].into()))]
 // property selector: quoted form (."key") is the only way to access dict keys
-#[case::property_selector_quoted_h1(r#"."h1""#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("h1"), RuntimeValue::String("title".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("title".to_string())].into()))]
-#[case::property_selector_quoted_url(r#"."url""#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("url"), RuntimeValue::String("https://example.com".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("https://example.com".to_string())].into()))]
-#[case::property_selector_quoted_text(r#"."text""#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("text"), RuntimeValue::String("hello".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("hello".to_string())].into()))]
+#[case::property_selector_quoted_h1(r#"."h1""#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("h1"), RuntimeValue::String("title".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("title".to_string())].into()))]
+#[case::property_selector_quoted_url(r#"."url""#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("url"), RuntimeValue::String("https://example.com".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("https://example.com".to_string())].into()))]
+#[case::property_selector_quoted_text(r#"."text""#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("text"), RuntimeValue::String("hello".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("hello".to_string())].into()))]
 // property selector: quoted form with spaces in key
-#[case::property_selector_quoted_space(r#"."my key""#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("my key"), RuntimeValue::String("val".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("val".to_string())].into()))]
+#[case::property_selector_quoted_space(r#"."my key""#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("my key"), RuntimeValue::String("val".to_string())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("val".to_string())].into()))]
 // property selector: missing key returns None
-#[case::property_selector_quoted_missing(r#"."h1""#, vec![{let d = std::collections::BTreeMap::new(); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::None].into()))]
+#[case::property_selector_quoted_missing(r#"."h1""#, vec![{let d = mq_lang::Dict::default(); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::None].into()))]
 // nested property selector: ."a"."b" accesses {"a": {"b": 1}}
-#[case::property_selector_nested(r#"."a"."b""#, vec![{let mut outer = std::collections::BTreeMap::new(); let mut inner = std::collections::BTreeMap::new(); inner.insert(Ident::new("b"), RuntimeValue::Number(1.into())); outer.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(inner))); RuntimeValue::Dict(Shared::new(outer))}], Ok(vec![RuntimeValue::Number(1.into())].into()))]
+#[case::property_selector_nested(r#"."a"."b""#, vec![{let mut outer = mq_lang::Dict::default(); let mut inner = mq_lang::Dict::default(); inner.insert(Ident::new("b"), RuntimeValue::Number(1.into())); outer.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(inner))); RuntimeValue::Dict(Shared::new(outer))}], Ok(vec![RuntimeValue::Number(1.into())].into()))]
 // nested property selector: ."a"."b"."c" accesses three levels deep
-#[case::property_selector_nested_three(r#"."a"."b"."c""#, vec![{let mut outer = std::collections::BTreeMap::new(); let mut mid = std::collections::BTreeMap::new(); let mut inner = std::collections::BTreeMap::new(); inner.insert(Ident::new("c"), RuntimeValue::Number(42.into())); mid.insert(Ident::new("b"), RuntimeValue::Dict(Shared::new(inner))); outer.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(mid))); RuntimeValue::Dict(Shared::new(outer))}], Ok(vec![RuntimeValue::Number(42.into())].into()))]
+#[case::property_selector_nested_three(r#"."a"."b"."c""#, vec![{let mut outer = mq_lang::Dict::default(); let mut mid = mq_lang::Dict::default(); let mut inner = mq_lang::Dict::default(); inner.insert(Ident::new("c"), RuntimeValue::Number(42.into())); mid.insert(Ident::new("b"), RuntimeValue::Dict(Shared::new(inner))); outer.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(mid))); RuntimeValue::Dict(Shared::new(outer))}], Ok(vec![RuntimeValue::Number(42.into())].into()))]
 // nested property selector: missing intermediate key returns None
-#[case::property_selector_nested_missing(r#"."a"."b""#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("a"), RuntimeValue::Number(1.into())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::None].into()))]
+#[case::property_selector_nested_missing(r#"."a"."b""#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("a"), RuntimeValue::Number(1.into())); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::None].into()))]
 // property iterator: ."items"[] iterates all elements of the array stored at the key
-#[case::property_selector_iterator(r#"."items"[]"#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string()), RuntimeValue::String("c".to_string())]))); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string()), RuntimeValue::String("c".to_string())]))].into()))]
+#[case::property_selector_iterator(r#"."items"[]"#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string()), RuntimeValue::String("c".to_string())]))); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string()), RuntimeValue::String("c".to_string())]))].into()))]
 // property iterator with index: ."items"[0] accesses the first element of the array
-#[case::property_selector_iterator_index(r#"."items"[0]"#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string())]))); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("a".to_string())].into()))]
+#[case::property_selector_iterator_index(r#"."items"[0]"#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string())]))); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("a".to_string())].into()))]
 // property iterator with index: ."items"[1] accesses the second element
-#[case::property_selector_iterator_index_1(r#"."items"[1]"#, vec![{let mut d = std::collections::BTreeMap::new(); d.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string())]))); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("b".to_string())].into()))]
+#[case::property_selector_iterator_index_1(r#"."items"[1]"#, vec![{let mut d = mq_lang::Dict::default(); d.insert(Ident::new("items"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::String("a".to_string()), RuntimeValue::String("b".to_string())]))); RuntimeValue::Dict(Shared::new(d))}], Ok(vec![RuntimeValue::String("b".to_string())].into()))]
 // chained property iterator: ."a"."b"[] iterates all elements of a nested array
-#[case::property_selector_nested_iterator(r#"."a"."b"[]"#, vec![{let mut outer = std::collections::BTreeMap::new(); let mut inner = std::collections::BTreeMap::new(); inner.insert(Ident::new("b"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into())]))); outer.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(inner))); RuntimeValue::Dict(Shared::new(outer))}], Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into())]))].into()))]
+#[case::property_selector_nested_iterator(r#"."a"."b"[]"#, vec![{let mut outer = mq_lang::Dict::default(); let mut inner = mq_lang::Dict::default(); inner.insert(Ident::new("b"), RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into())]))); outer.insert(Ident::new("a"), RuntimeValue::Dict(Shared::new(inner))); RuntimeValue::Dict(Shared::new(outer))}], Ok(vec![RuntimeValue::Array(Shared::new(vec![RuntimeValue::Number(1.into()), RuntimeValue::Number(2.into())]))].into()))]
 // paren-free calls: 0-arg user-defined function called without parentheses
 #[case::paren_free_zero_arg_user_fn("def greet(): \"Hello!\"; | greet", vec![RuntimeValue::None], Ok(vec![RuntimeValue::String("Hello!".to_string())].into()))]
 // paren-free calls: 1-arg user-defined function called without parentheses uses current value
@@ -3027,7 +3066,7 @@ fn engine() -> DefaultEngine {
 // try/catch(e): error binder is bound to a dict with the failure message
 #[case::try_catch_binder(r#"try: error("boom") catch(e): e["message"]"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::String("boom".to_string())].into()))]
 // try/catch(e): the full error dict is accessible when bound directly
-#[case::try_catch_binder_dict(r#"try: error("boom") catch(e): e"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(BTreeMap::from([
+#[case::try_catch_binder_dict(r#"try: error("boom") catch(e): e"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::from_iter([
     (Ident::new("message"), RuntimeValue::String("boom".to_string())),
 ])))].into()))]
 // try/catch(e): the binder is unused when the try expression succeeds
@@ -3176,7 +3215,7 @@ fn engine() -> DefaultEngine {
 // del: None returns None
 #[case::del_none("del(None, 0)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::None].into()))]
 // del: remove key from dict by string
-#[case::del_dict_string(r#"del({"a": 1, "b": 2}, "a")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict({let mut m = std::collections::BTreeMap::new(); m.insert(mq_lang::Ident::new("b"), RuntimeValue::Number(2.into())); Shared::new(m)})].into()))]
+#[case::del_dict_string(r#"del({"a": 1, "b": 2}, "a")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Dict({let mut m = mq_lang::Dict::default(); m.insert(mq_lang::Ident::new("b"), RuntimeValue::Number(2.into())); Shared::new(m)})].into()))]
 // index: bytes haystack
 #[case::index_bytes(r#"index(b"hello", b"ll")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Number(2.into())].into()))]
 // index: bytes not found
@@ -3199,6 +3238,8 @@ fn engine() -> DefaultEngine {
 #[case::slice_array_empty("slice([1, 2, 3], 5, 10)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::Array(Shared::new(vec![]))].into()))]
 // slice: string with negative indices
 #[case::slice_string_negative(r#"slice("hello", -3, -1)"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::String("ll".to_string())].into()))]
+// slice: multi-byte characters are counted as characters, not bytes
+#[case::slice_string_multibyte(r#"slice("aéあ😀b", 1, 4)"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::String("éあ😀".to_string())].into()))]
 // slice: bytes
 #[case::slice_bytes(r#"slice(b"hello", 1, 4)"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::Bytes(vec![b'e', b'l', b'l'])].into()))]
 // slice: bytes empty (out of bounds)
@@ -3372,6 +3413,8 @@ fn engine() -> DefaultEngine {
 #[case::gsub_none(r#"gsub(None, "x", "y")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::None].into()))]
 // replace: None input → None
 #[case::replace_none(r#"replace(None, "x", "y")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::None].into()))]
+// replace: pattern absent → input passes through unchanged
+#[case::replace_no_match(r#"replace("hello", "xyz", "!")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::String("hello".to_string())].into()))]
 // split: None input → empty array
 #[case::split_none(r#"split(None, " ")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::empty_array()].into()))]
 // to_link: empty title → link with no title
@@ -3418,6 +3461,8 @@ fn engine() -> DefaultEngine {
 #[case::ascii_downcase_none("ascii_downcase(None)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::None].into()))]
 // trim: None input → None
 #[case::trim_none("trim(None)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::None].into()))]
+// trim: whitespace on both sides is removed in place
+#[case::trim_both_sides(r#"trim("  hello  ")"#, vec![RuntimeValue::None], Ok(vec![RuntimeValue::String("hello".to_string())].into()))]
 // html_escape: None input → None
 #[case::html_escape_none("html_escape(None)", vec![RuntimeValue::None], Ok(vec![RuntimeValue::None].into()))]
 // html_unescape: None input → None
@@ -3824,7 +3869,7 @@ mod ast_json {
     use rstest::rstest;
     use smallvec::smallvec;
 
-    fn default_token_id() -> ArenaId<Shared<mq_lang::Token>> {
+    fn default_token_id() -> ArenaId<mq_lang::Token> {
         ArenaId::new(0)
     }
 
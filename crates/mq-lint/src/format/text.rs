@@ -148,7 +148,7 @@ mod tests {
     fn test_write_text_report_with_diagnostics() {
         let config = LintConfig::default();
         let linter = Linter::with_default_rules();
-        let diagnostics = crate::collect_diagnostics(r#".checked == true"#, &linter, &config, Severity::Style);
+        let diagnostics = crate::collect_diagnostics(r#".checked == true"#, &linter, &config, Severity::Style, false);
 
         let mut buf = Vec::new();
         let had_diagnostics = write_text_report(&mut buf, "test.mq", &diagnostics).unwrap();
@@ -181,4 +181,72 @@ impl Linter {
             .flat_map(|rule| rule.check(ctx))
             .collect()
     }
+
+    /// Runs the enabled rules fanned out across a thread pool.
+    ///
+    /// Rules are read-only over the shared HIR ([`LintRule`] is `Send + Sync`),
+    /// so rule execution parallelizes safely; diagnostics are collected back in
+    /// rule registration order, making the output identical to [`Linter::run`].
+    pub fn run_parallel(&self, ctx: &LintContext<'_>) -> Vec<Diagnostic> {
+        let enabled: Vec<&Box<dyn LintRule>> = self
+            .rules
+            .iter()
+            .filter(|rule| ctx.config.is_rule_enabled(rule.id()))
+            .collect();
+
+        let threads = std::thread::available_parallelism()
+            .map(|n| n.get())
+            .unwrap_or(1)
+            .min(enabled.len());
+        if threads <= 1 {
+            return self.run(ctx);
+        }
+
+        let chunk_size = enabled.len().div_ceil(threads);
+        std::thread::scope(|scope| {
+            let handles: Vec<_> = enabled
+                .chunks(chunk_size)
+                .map(|rules| scope.spawn(move || rules.iter().flat_map(|rule| rule.check(ctx)).collect::<Vec<_>>()))
+                .collect();
+
+            // Joining in spawn order keeps diagnostics in rule order.
+            handles
+                .into_iter()
+                .flat_map(|handle| handle.join().expect("lint rule thread panicked"))
+                .collect()
+        })
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    /// `run_parallel` must report exactly what `run` reports, in the same
+    /// order, so callers can switch between them freely.
+    #[test]
+    fn test_run_parallel_matches_run() {
+        let mut hir = Hir::default();
+        // Triggers multiple rules: shadowing, unused variable, string-literal
+        // interpolation and a try/catch that maps to `?`.
+        let (source_id, _) = hir.add_code(
+            None,
+            r#"let x = 1 | let x = 2 | let unused = s"${x}" | try: get("k") catch: none"#,
+        );
+
+        let config = LintConfig::default();
+        let ctx = LintContext::new(&hir, source_id, &config);
+        let linter = Linter::with_default_rules();
+
+        let serial = linter.run(&ctx);
+        let parallel = linter.run_parallel(&ctx);
+
+        assert!(!serial.is_empty());
+        assert_eq!(serial.len(), parallel.len());
+        for (s, p) in serial.iter().zip(parallel.iter()) {
+            assert_eq!(s.rule_id(), p.rule_id());
+            assert_eq!(s.message(), p.message());
+            assert_eq!(s.range, p.range);
+        }
+    }
 }
@@ -103,20 +103,21 @@ fn run() -> io::Result<bool> {
             return Ok(false);
         }
 
-        let diagnostics = collect_diagnostics(&code, &linter, &config, min_severity);
+        let diagnostics = collect_diagnostics(&code, &linter, &config, min_severity, true);
         let had_diagnostics = !diagnostics.is_empty();
         format::write_report(&mut w, cli.format, &[("<stdin>".to_string(), diagnostics)])?;
         return Ok(had_diagnostics);
     }
 
-    let mut results: Vec<(String, Vec<Diagnostic>)> = Vec::with_capacity(cli.files.len());
+    let results: Vec<(String, Vec<Diagnostic>)> = if cli.fix {
+        // --fix rewrites files in place and reports per file, so it stays serial.
+        let mut results: Vec<(String, Vec<Diagnostic>)> = Vec::with_capacity(cli.files.len());
 
-    for path in &cli.files {
-        let code = std::fs::read_to_string(path)
-            .map_err(|e| io::Error::other(format!("reading file {}: {}", path.display(), e)))?;
-        let label = path.display().to_string();
+        for path in &cli.files {
+            let code = std::fs::read_to_string(path)
+                .map_err(|e| io::Error::other(format!("reading file {}: {}", path.display(), e)))?;
+            let label = path.display().to_string();
 
-        let code = if cli.fix {
             let (fixed, fix_count) = fix_source(&code, &linter, &config);
             if fixed != code {
                 std::fs::write(path, &fixed)
@@ -132,13 +133,14 @@ fn run() -> io::Result<bool> {
                     eprintln!("fixed {fix_count} {issue_word} in {label}");
                 }
             }
-            fixed
-        } else {
-            code
-        };
 
-        results.push((label, collect_diagnostics(&code, &linter, &config, min_severity)));
-    }
+            results.push((label, collect_diagnostics(&fixed, &linter, &config, min_severity, true)));
+        }
+
+        results
+    } else {
+        lint_files_parallel(&cli.files, &linter, &config, min_severity)?
+    };
 
     let had_diagnostics = results.iter().any(|(_, diagnostics)| !diagnostics.is_empty());
     format::write_report(&mut w, cli.format, &results)?;
@@ -146,6 +148,50 @@ fn run() -> io::Result<bool> {
     Ok(had_diagnostics)
 }
 
+/// Lints many files concurrently, preserving the input order in the result.
+///
+/// Files are split into contiguous chunks across the available cores; each
+/// worker parses its files once and runs every rule over the shared HIR, so
+/// total work scales with cores instead of rule-count × file-count serially.
+/// A single file skips the thread pool and fans the rules out instead.
+fn lint_files_parallel(
+    files: &[PathBuf],
+    linter: &Linter,
+    config: &LintConfig,
+    min_severity: Severity,
+) -> io::Result<Vec<(String, Vec<Diagnostic>)>> {
+    let lint_file = |path: &PathBuf, parallel_rules: bool| -> io::Result<(String, Vec<Diagnostic>)> {
+        let code = std::fs::read_to_string(path)
+            .map_err(|e| io::Error::other(format!("reading file {}: {}", path.display(), e)))?;
+        Ok((
+            path.display().to_string(),
+            collect_diagnostics(&code, linter, config, min_severity, parallel_rules),
+        ))
+    };
+
+    let threads = std::thread::available_parallelism()
+        .map(|n| n.get())
+        .unwrap_or(1)
+        .min(files.len());
+    if threads <= 1 {
+        return files.iter().map(|path| lint_file(path, true)).collect();
+    }
+
+    let chunk_size = files.len().div_ceil(threads);
+    std::thread::scope(|scope| {
+        let handles: Vec<_> = files
+            .chunks(chunk_size)
+            .map(|chunk| scope.spawn(move || chunk.iter().map(|path| lint_file(path, false)).collect::<Vec<_>>()))
+            .collect();
+
+        // Joining in spawn order keeps results in input file order.
+        handles
+            .into_iter()
+            .flat_map(|handle| handle.join().expect("lint file thread panicked"))
+            .collect()
+    })
+}
+
 /// Applies every diagnostic with a fix to `code`, returning the rewritten source and how many
 /// fixes were applied.
 fn fix_source(code: &str, linter: &Linter, config: &LintConfig) -> (String, usize) {
@@ -173,22 +219,26 @@ fn list_rules(w: &mut impl Write) -> io::Result<()> {
 }
 
 /// Runs the linter over a single source, returning diagnostics at or above `min_severity`
-/// sorted by source position.
+/// sorted by source position. `parallel_rules` fans rule execution out across
+/// threads; callers already running one thread per file pass `false` to avoid
+/// oversubscribing the cores.
 pub(crate) fn collect_diagnostics(
     code: &str,
     linter: &Linter,
     config: &LintConfig,
     min_severity: Severity,
+    parallel_rules: bool,
 ) -> Vec<Diagnostic> {
     let mut hir = Hir::default();
     let (source_id, _) = hir.add_code(None, code);
     let ctx = LintContext::new(&hir, source_id, config);
 
-    let mut diagnostics: Vec<_> = linter
-        .run(&ctx)
-        .into_iter()
-        .filter(|d| d.severity >= min_severity)
-        .collect();
+    let raw = if parallel_rules {
+        linter.run_parallel(&ctx)
+    } else {
+        linter.run(&ctx)
+    };
+    let mut diagnostics: Vec<_> = raw.into_iter().filter(|d| d.severity >= min_severity).collect();
     diagnostics.sort_by_key(|d| d.range.map(|r| (r.start.line, r.start.column)));
     diagnostics
 }
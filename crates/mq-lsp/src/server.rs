@@ -31,6 +31,9 @@ struct Backend {
     type_env_map: DashMap<String, mq_check::TypeEnv>,
     error_map: DashMap<String, Vec<LspError>>,
     text_map: DashMap<String, Arc<String>>,
+    /// Per-document incremental CST parsers, so edits only re-parse the
+    /// affected top-level statements instead of the whole document.
+    cst_parser_map: DashMap<String, mq_lang::IncrementalParser>,
     config: LspConfig,
 }
 
@@ -75,6 +78,7 @@ impl LanguageServer for Backend {
         self.error_map.remove(&uri_string);
         self.text_map.remove(&uri_string);
         self.type_env_map.remove(&uri_string);
+        self.cst_parser_map.remove(&uri_string);
 
         // Remove from source map
         self.source_map.write().unwrap().remove_by_left(&uri_string);
@@ -314,12 +318,22 @@ impl LanguageServer for Backend {
         };
 
         let text = Arc::clone(&self.text_map.get(&params.text_document.uri.to_string()).unwrap());
+        // Reuse the incrementally maintained CST when available (cloning the
+        // nodes is cheap reference-count bumping); otherwise parse from text.
+        // The syntax-error guard above guarantees the cached CST is clean.
+        let cached_nodes = self
+            .cst_parser_map
+            .get(&params.text_document.uri.to_string())
+            .map(|parser| parser.result().0.to_vec());
         let formatted_text = tokio::task::spawn_blocking(move || {
-            mq_formatter::Formatter::new(Some(mq_formatter::FormatterConfig {
+            let mut formatter = mq_formatter::Formatter::new(Some(mq_formatter::FormatterConfig {
                 indent_width: 2,
                 ..Default::default()
-            }))
-            .format(&text)
+            }));
+            match cached_nodes {
+                Some(mut nodes) => formatter.format_with_cst(&mut nodes),
+                None => formatter.format(&text),
+            }
         })
         .await
         .map_err(|_| jsonrpc::Error::new(jsonrpc::ErrorCode::InternalError))?
@@ -433,9 +447,18 @@ impl LanguageServer for Backend {
 impl Backend {
     async fn on_change(&self, uri: Url, text: String) {
         let (nodes, errors) = if text.is_empty() {
+            self.cst_parser_map.remove(&uri.to_string());
             (Vec::new(), mq_lang::CstErrorReporter::default())
         } else {
-            mq_lang::parse_recovery(&text)
+            // Reuse the per-document incremental parser so a keystroke only
+            // re-parses the affected top-level statements; unaffected siblings
+            // are shared with the previous parse.
+            let mut parser = self
+                .cst_parser_map
+                .entry(uri.to_string())
+                .or_insert_with(|| mq_lang::IncrementalParser::new(&text));
+            let (nodes, errors) = parser.update(&text);
+            (nodes.to_vec(), errors.clone())
         };
         let (source_id, _) = self.hir.write().unwrap().add_nodes(uri.clone(), &nodes);
 
@@ -629,6 +652,7 @@ pub async fn start(config: LspConfig) {
         type_env_map: DashMap::new(),
         error_map: DashMap::new(),
         text_map: DashMap::new(),
+        cst_parser_map: DashMap::new(),
         config,
     });
 
@@ -650,6 +674,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -690,6 +715,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -735,6 +761,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -765,6 +792,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -794,6 +822,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -822,6 +851,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -869,6 +899,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -914,6 +945,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -974,6 +1006,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1012,6 +1045,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1064,6 +1098,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1136,6 +1171,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1206,6 +1242,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1245,6 +1282,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1322,6 +1360,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1366,6 +1405,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1439,6 +1479,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1484,6 +1525,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1531,6 +1573,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1577,6 +1620,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1612,6 +1656,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1649,6 +1694,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1682,6 +1728,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1730,6 +1777,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1765,6 +1813,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1809,6 +1858,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 false,
@@ -1862,6 +1912,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1897,6 +1948,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1941,6 +1993,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
 
@@ -1992,6 +2045,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
         let backend = service.inner();
@@ -2033,6 +2087,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
         let backend = service.inner();
@@ -2073,6 +2128,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::default(),
         });
         let backend = service.inner();
@@ -2145,6 +2201,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 false,
@@ -2187,6 +2244,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 true,
@@ -2230,6 +2288,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 true,
@@ -2273,6 +2332,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 true,
@@ -2315,6 +2375,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 true,
@@ -2360,6 +2421,7 @@ mod tests {
             type_env_map: DashMap::new(),
             error_map: DashMap::new(),
             text_map: DashMap::new(),
+            cst_parser_map: DashMap::new(),
             config: LspConfig::new(
                 vec![],
                 true,
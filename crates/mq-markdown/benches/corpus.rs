@@ -0,0 +1,123 @@
+//! Corpus-scale benchmarks for the parser and the output writers.
+//!
+//! `benchmark.rs` covers micro-patterns; this suite exercises multi-megabyte
+//! documents shaped like real-world content (headings, paragraphs, lists,
+//! code fences, tables, blockquotes, links) so regressions in
+//! `Markdown::from_markdown_str` and the Markdown/HTML writers show up before
+//! production. Throughput counters report MB/s and nodes/s alongside wall
+//! time, and the divan `AllocProfiler` adds allocation counts and peak heap
+//! bytes (a proxy for peak RSS). Corpora are generated from a fixed-seed PRNG
+//! so runs are comparable across machines.
+
+use divan::counter::{BytesCount, ItemsCount};
+
+#[global_allocator]
+static ALLOC: divan::AllocProfiler = divan::AllocProfiler::system();
+
+fn main() {
+    divan::main();
+}
+
+/// xorshift64*: deterministic across platforms without pulling `rand` into
+/// the benchmark, so every run sees byte-identical corpora.
+struct Rng(u64);
+
+impl Rng {
+    fn new(seed: u64) -> Self {
+        Self(seed.max(1))
+    }
+
+    fn next(&mut self) -> u64 {
+        self.0 ^= self.0 >> 12;
+        self.0 ^= self.0 << 25;
+        self.0 ^= self.0 >> 27;
+        self.0.wrapping_mul(0x2545F4914F6CDD1D)
+    }
+
+    fn pick<'a>(&mut self, items: &[&'a str]) -> &'a str {
+        items[(self.next() % items.len() as u64) as usize]
+    }
+}
+
+const WORDS: &[&str] = &[
+    "markdown",
+    "query",
+    "filter",
+    "node",
+    "heading",
+    "table",
+    "value",
+    "section",
+    "content",
+    "reference",
+    "example",
+    "output",
+    "format",
+    "parser",
+    "stream",
+    "module",
+    "select",
+];
+
+/// Generates a Markdown document of at least `target_bytes` bytes mixing the
+/// block kinds a typical documentation corpus contains.
+fn corpus_markdown(target_bytes: usize) -> String {
+    let mut rng = Rng::new(0x6d71_c0de);
+    let mut doc = String::with_capacity(target_bytes + 1024);
+    let mut section = 0;
+
+    while doc.len() < target_bytes {
+        section += 1;
+        doc.push_str(&format!("## Section {} {}\n\n", section, rng.pick(WORDS)));
+        for _ in 0..3 {
+            for _ in 0..20 {
+                doc.push_str(rng.pick(WORDS));
+                doc.push(' ');
+            }
+            doc.push_str(&format!("[{}](https://example.com/{})\n\n", rng.pick(WORDS), section));
+        }
+        doc.push_str(&format!(
+            "- {}\n- {}\n- nested\n  - {}\n\n",
+            rng.pick(WORDS),
+            rng.pick(WORDS),
+            rng.pick(WORDS)
+        ));
+        doc.push_str(&format!("```rust\nlet {} = {};\n```\n\n", rng.pick(WORDS), section));
+        doc.push_str("|name|value|\n|---|---|\n");
+        for _ in 0..4 {
+            doc.push_str(&format!("|{}|{}|\n", rng.pick(WORDS), rng.pick(WORDS)));
+        }
+        doc.push('\n');
+        doc.push_str(&format!("> {} {}\n\n", rng.pick(WORDS), rng.pick(WORDS)));
+    }
+
+    doc
+}
+
+/// Parser throughput on multi-megabyte documents, in MB/s.
+#[divan::bench(name = "corpus/from_markdown_str", args = [1, 4])]
+fn corpus_from_markdown_str(bencher: divan::Bencher, mebibytes: usize) {
+    let doc = corpus_markdown(mebibytes * 1024 * 1024);
+    bencher
+        .counter(BytesCount::of_str(&doc))
+        .bench(|| mq_markdown::Markdown::from_markdown_str(divan::black_box(&doc)).unwrap());
+}
+
+/// Markdown writer throughput over a parsed multi-megabyte document, in
+/// nodes/s.
+#[divan::bench(name = "corpus/to_string", args = [1, 4])]
+fn corpus_to_string(bencher: divan::Bencher, mebibytes: usize) {
+    let md = mq_markdown::Markdown::from_markdown_str(&corpus_markdown(mebibytes * 1024 * 1024)).unwrap();
+    bencher
+        .counter(ItemsCount::new(md.nodes.len()))
+        .bench(|| divan::black_box(&md).to_string());
+}
+
+/// HTML writer throughput over a parsed multi-megabyte document, in nodes/s.
+#[divan::bench(name = "corpus/to_html", args = [1, 4])]
+fn corpus_to_html(bencher: divan::Bencher, mebibytes: usize) {
+    let md = mq_markdown::Markdown::from_markdown_str(&corpus_markdown(mebibytes * 1024 * 1024)).unwrap();
+    bencher
+        .counter(ItemsCount::new(md.nodes.len()))
+        .bench(|| divan::black_box(&md).to_html());
+}
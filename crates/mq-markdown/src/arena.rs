@@ -0,0 +1,243 @@
+//! Arena-backed storage for Markdown nodes.
+//!
+//! Flattens a parsed document into a single contiguous, breadth-first buffer with
+//! index-based parent/child links, mirroring the token arena in mq-lang. Bulk
+//! pipelines can then scan every node of a large document linearly instead of
+//! chasing per-node heap pointers through nested `Vec<Node>` trees.
+
+use miette::miette;
+
+use crate::{Markdown, Node};
+
+/// A type-safe index of a node stored in a [`NodeArena`].
+#[derive(Clone, Copy, Debug, PartialEq, Eq, PartialOrd, Ord, Hash)]
+pub struct NodeId(u32);
+
+impl NodeId {
+    /// Returns the raw index into [`NodeArena::nodes`].
+    pub const fn index(self) -> usize {
+        self.0 as usize
+    }
+}
+
+/// Parent link and the contiguous run of children for one arena node.
+#[derive(Clone, Copy, Debug)]
+struct NodeEntry {
+    parent: Option<NodeId>,
+    children_start: u32,
+    children_len: u32,
+}
+
+/// A flattened Markdown document for cache-friendly bulk traversal.
+///
+/// Nodes are stored shallow (children detached) in breadth-first order, so the
+/// direct children of any node occupy one contiguous run. Use [`NodeArena::nodes`]
+/// for linear scans, [`NodeArena::children_ids`]/[`NodeArena::parent`] to walk the
+/// structure, and [`NodeArena::deep_node`]/[`NodeArena::to_markdown`] to rebuild
+/// owned subtrees when handing nodes back to tree-based APIs.
+///
+/// # Examples
+///
+/// ```rust
+/// use mq_markdown::NodeArena;
+///
+/// use mq_markdown::Markdown;
+///
+/// let source = "# Title\n\nSome *text*.";
+/// let arena = NodeArena::parse(source).unwrap();
+/// assert!(arena.nodes().len() >= 2);
+///
+/// let rebuilt = arena.to_markdown();
+/// assert_eq!(rebuilt.to_string(), source.parse::<Markdown>().unwrap().to_string());
+/// ```
+#[derive(Clone, Debug, Default)]
+pub struct NodeArena {
+    nodes: Vec<Node>,
+    entries: Vec<NodeEntry>,
+    root_len: u32,
+}
+
+impl NodeArena {
+    /// Parses `content` as Markdown and flattens it into an arena.
+    pub fn parse(content: &str) -> miette::Result<Self> {
+        Markdown::from_markdown_str(content).map(|markdown| Self::from_markdown(&markdown))
+    }
+
+    /// Flattens an already parsed document into an arena.
+    pub fn from_markdown(markdown: &Markdown) -> Self {
+        let mut arena = Self {
+            nodes: Vec::with_capacity(markdown.nodes.len()),
+            entries: Vec::with_capacity(markdown.nodes.len()),
+            root_len: markdown.nodes.len() as u32,
+        };
+        // Children of node `i` that still have to be placed behind all nodes of the
+        // current level, keyed by the same index as `nodes`/`entries`.
+        let mut pending: Vec<Vec<Node>> = Vec::with_capacity(markdown.nodes.len());
+
+        for node in &markdown.nodes {
+            Self::push_shallow(node.clone(), None, &mut arena, &mut pending);
+        }
+
+        let mut index = 0;
+        while index < arena.nodes.len() {
+            let children = std::mem::take(&mut pending[index]);
+            arena.entries[index].children_start = arena.nodes.len() as u32;
+            arena.entries[index].children_len = children.len() as u32;
+            for child in children {
+                Self::push_shallow(child, Some(NodeId(index as u32)), &mut arena, &mut pending);
+            }
+            index += 1;
+        }
+
+        arena
+    }
+
+    /// Detaches `node`'s children and appends the shallow node to the arena,
+    /// parking the children in `pending` until their level is reached. Variants
+    /// whose children cannot be detached keep their subtree embedded.
+    fn push_shallow(mut node: Node, parent: Option<NodeId>, arena: &mut Self, pending: &mut Vec<Vec<Node>>) {
+        let mut children = node.children();
+        if !children.is_empty() {
+            node.set_children(Vec::new());
+            if !node.children().is_empty() {
+                children = Vec::new();
+            }
+        }
+        arena.nodes.push(node);
+        arena.entries.push(NodeEntry {
+            parent,
+            children_start: 0,
+            children_len: 0,
+        });
+        pending.push(children);
+    }
+
+    /// Returns the number of nodes in the arena.
+    pub fn len(&self) -> usize {
+        self.nodes.len()
+    }
+
+    /// Returns `true` if the arena contains no nodes.
+    pub fn is_empty(&self) -> bool {
+        self.nodes.is_empty()
+    }
+
+    /// Returns all nodes as one contiguous slice for linear scans.
+    /// Nodes are shallow: structure lives in the arena, not in nested `Vec`s.
+    pub fn nodes(&self) -> &[Node] {
+        &self.nodes
+    }
+
+    /// Returns a reference to the shallow node at `id`, or `None` if out of bounds.
+    pub fn get(&self, id: NodeId) -> Option<&Node> {
+        self.nodes.get(id.index())
+    }
+
+    /// Returns the parent of `id`, or `None` for top-level nodes.
+    pub fn parent(&self, id: NodeId) -> Option<NodeId> {
+        self.entries.get(id.index()).and_then(|entry| entry.parent)
+    }
+
+    /// Returns the ids of the document's top-level nodes.
+    pub fn root_ids(&self) -> impl Iterator<Item = NodeId> + '_ {
+        (0..self.root_len).map(NodeId)
+    }
+
+    /// Returns the ids of the direct children of `id`, in document order.
+    pub fn children_ids(&self, id: NodeId) -> impl Iterator<Item = NodeId> + '_ {
+        let (start, len) = self
+            .entries
+            .get(id.index())
+            .map(|entry| (entry.children_start, entry.children_len))
+            .unwrap_or((0, 0));
+        (start..start + len).map(NodeId)
+    }
+
+    /// Rebuilds the full node at `id` with its subtree reattached.
+    pub fn deep_node(&self, id: NodeId) -> miette::Result<Node> {
+        let mut node = self
+            .get(id)
+            .cloned()
+            .ok_or_else(|| miette!("Invalid node id: {}", id.0))?;
+        let children: miette::Result<Vec<Node>> = self.children_ids(id).map(|child| self.deep_node(child)).collect();
+        let children = children?;
+        if !children.is_empty() {
+            node.set_children(children);
+        }
+        Ok(node)
+    }
+
+    /// Rebuilds the original document from the arena.
+    pub fn to_markdown(&self) -> Markdown {
+        Markdown::new(self.root_ids().filter_map(|id| self.deep_node(id).ok()).collect())
+    }
+}
+
+impl From<Markdown> for NodeArena {
+    fn from(markdown: Markdown) -> Self {
+        Self::from_markdown(&markdown)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use rstest::rstest;
+
+    #[rstest]
+    #[case::empty("")]
+    #[case::single_paragraph("Hello")]
+    #[case::heading_and_paragraph("# Title\n\nText")]
+    #[case::nested_list("- a\n- b")]
+    fn test_root_count(#[case] input: &str) {
+        // The arena must mirror the document's top-level structure exactly;
+        // the absolute count varies with parser features, so compare against
+        // the parse rather than hardcoding it.
+        let arena = NodeArena::parse(input).expect("input should parse");
+        let markdown = Markdown::from_markdown_str(input).expect("input should parse");
+        assert_eq!(arena.root_ids().count(), markdown.nodes.len());
+    }
+
+    #[rstest]
+    #[case::paragraph("Some *text* here.\n")]
+    #[case::heading("# Title\n")]
+    #[case::list("- one\n- two\n- three\n")]
+    #[case::nested("> quote with **bold**\n")]
+    #[case::code("```rust\nlet a = 1;\n```\n")]
+    #[case::table("| a | b |\n| - | - |\n| 1 | 2 |\n")]
+    #[case::mixed("# Title\n\nText with [link](https://example.com).\n\n- item\n")]
+    fn test_roundtrip(#[case] input: &str) {
+        let original = Markdown::from_markdown_str(input).expect("input should parse");
+        let arena = NodeArena::from_markdown(&original);
+        assert_eq!(arena.to_markdown().to_string(), original.to_string());
+    }
+
+    #[test]
+    fn test_parent_and_children_links() {
+        let arena = NodeArena::parse("# A *b*").expect("input should parse");
+        let root = arena.root_ids().next().expect("one root");
+
+        let children: Vec<NodeId> = arena.children_ids(root).collect();
+        assert!(!children.is_empty(), "heading should have inline children");
+        for child in children {
+            assert_eq!(arena.parent(child), Some(root));
+        }
+        assert_eq!(arena.parent(root), None);
+    }
+
+    #[test]
+    fn test_children_are_contiguous() {
+        let arena = NodeArena::parse("- one\n- two\n- three").expect("input should parse");
+        let root = arena.root_ids().next().expect("one root");
+        let children: Vec<usize> = arena.children_ids(root).map(NodeId::index).collect();
+        for pair in children.windows(2) {
+            assert_eq!(pair[1], pair[0] + 1, "sibling nodes must be adjacent in the arena");
+        }
+    }
+
+    #[test]
+    fn test_deep_node_invalid_id() {
+        let arena = NodeArena::parse("text").expect("input should parse");
+        assert!(arena.deep_node(NodeId(u32::MAX)).is_err());
+    }
+}
@@ -4,6 +4,7 @@ mod iframe;
 pub mod node;
 pub mod options;
 pub mod parser;
+pub mod streaming;
 
 use miette::miette;
 pub use options::ConversionOptions;
@@ -82,6 +83,36 @@ fn extract_front_matter_from_head_ref(html: &Html) -> Option<BTreeMap<String, se
     if fm_map.is_empty() { None } else { Some(fm_map) }
 }
 
+/// Serializes the `<head>` metadata of `html` as a YAML front matter block
+/// (including the surrounding `---` fences and a trailing blank line), or an
+/// empty string when there is no usable metadata.
+fn front_matter_block(html: &Html) -> miette::Result<String> {
+    let Some(fm_data) = extract_front_matter_from_head_ref(html) else {
+        return Ok(String::new());
+    };
+
+    // Convert BTreeMap<String, Value> to serde_yaml::Mapping (which is BTreeMap<Value, Value>)
+    let mut yaml_map = serde_yaml::Mapping::new();
+    for (k, v) in fm_data {
+        yaml_map.insert(serde_yaml::Value::String(k), v);
+    }
+    let yaml_value = serde_yaml::Value::Mapping(yaml_map);
+
+    match serde_yaml::to_string(&yaml_value) {
+        Ok(yaml) => {
+            // serde_yaml::to_string might add its own "---" if it's a single doc,
+            // or not if it's just a mapping. We want to ensure our format.
+            // It typically does not add --- for a Value::Mapping.
+            let content = yaml
+                .trim_start_matches("---\n")
+                .trim_end_matches('\n')
+                .trim_end_matches("...");
+            Ok(format!("---\n{}\n---\n\n", content.trim()))
+        }
+        Err(_) => Err(miette!("YAML serialization failed")),
+    }
+}
+
 pub fn convert_html_to_markdown(html_input: &str, options: ConversionOptions) -> miette::Result<String> {
     if html_input.trim().is_empty() {
         return Ok("".to_string());
@@ -89,35 +120,11 @@ pub fn convert_html_to_markdown(html_input: &str, options: ConversionOptions) ->
 
     let html = Html::parse_document(html_input);
 
-    let mut front_matter_str = String::new();
-
-    if options.generate_front_matter
-        && let Some(fm_data) = extract_front_matter_from_head_ref(&html)
-        && !fm_data.is_empty()
-    {
-        // Convert BTreeMap<String, Value> to serde_yaml::Mapping (which is BTreeMap<Value, Value>)
-        let mut yaml_map = serde_yaml::Mapping::new();
-        for (k, v) in fm_data {
-            yaml_map.insert(serde_yaml::Value::String(k), v);
-        }
-        let yaml_value = serde_yaml::Value::Mapping(yaml_map);
-
-        match serde_yaml::to_string(&yaml_value) {
-            Ok(yaml) => {
-                // serde_yaml::to_string might add its own "---" if it's a single doc,
-                // or not if it's just a mapping. We want to ensure our format.
-                // It typically does not add --- for a Value::Mapping.
-                let content = yaml
-                    .trim_start_matches("---\n")
-                    .trim_end_matches('\n')
-                    .trim_end_matches("...");
-                front_matter_str = format!("---\n{}\n---\n\n", content.trim());
-            }
-            Err(_) => {
-                return Err(miette!("YAML serialization failed"));
-            }
-        }
-    }
+    let front_matter_str = if options.generate_front_matter {
+        front_matter_block(&html)?
+    } else {
+        String::new()
+    };
 
     // Smart extraction: prefer main → [role="main"] → article, fall back to full document
     let doc_children = ["main", "[role=\"main\"]", "article"]
@@ -0,0 +1,481 @@
+//! Incremental HTML → Markdown conversion.
+//!
+//! The regular [`convert_html_to_markdown`](super::convert_html_to_markdown)
+//! pipeline parses the whole document into a DOM before emitting anything, so
+//! peak memory scales with page size. [`StreamingHtmlConverter`] instead scans
+//! the raw tag stream, cuts out one complete top-level element at a time and
+//! converts it on its own, so memory stays bounded by the largest element
+//! rather than the whole page and Markdown nodes become available while the
+//! rest of the document is still arriving.
+
+use scraper::Html;
+
+use super::{ConversionOptions, converter, front_matter_block, parser};
+use crate::markdown::Markdown;
+use crate::node::Node;
+
+/// Elements that never have content and therefore never contribute to depth.
+const VOID_ELEMENTS: &[&str] = &[
+    "area", "base", "br", "col", "embed", "hr", "img", "input", "link", "meta", "param", "source", "track", "wbr",
+];
+
+/// Elements whose content is raw text: tags inside them (for example a
+/// `"</div>"` string literal in a script) must not affect depth tracking.
+const RAW_TEXT_ELEMENTS: &[&str] = &["script", "style", "textarea", "title"];
+
+/// Structural wrappers that are streamed through rather than buffered: their
+/// children are emitted as they complete instead of waiting for the wrapper's
+/// close tag, since a single `<div id="app">` around the whole page would
+/// otherwise force the entire document into the buffer.
+const TRANSPARENT_CONTAINERS: &[&str] = &["html", "body", "main", "article", "section", "div"];
+
+/// Converts HTML to Markdown nodes incrementally as chunks are pushed.
+///
+/// Each complete top-level element (with [`TRANSPARENT_CONTAINERS`] unwrapped)
+/// is converted through the same parser/converter used by the whole-document
+/// pipeline, so per-element output matches it. The `<head>` element is turned
+/// into front matter and an optional title heading according to the
+/// [`ConversionOptions`]. Unlike the whole-document pipeline there is no smart
+/// `main`/`[role="main"]`/`article` extraction — all body content is emitted —
+/// which is the fidelity trade streaming makes for bounded memory.
+///
+/// # Examples
+///
+/// ```rust
+/// use mq_markdown::{ConversionOptions, StreamingHtmlConverter};
+///
+/// let mut converter = StreamingHtmlConverter::new(ConversionOptions::default());
+/// let mut nodes = converter.push_chunk("<body><h1>Title</h1><p>te").unwrap();
+/// nodes.extend(converter.push_chunk("xt</p></body>").unwrap());
+/// nodes.extend(converter.finish().unwrap());
+/// assert_eq!(mq_markdown::Markdown::new(nodes).to_string(), "# Title\n\ntext\n");
+/// ```
+#[derive(Debug)]
+pub struct StreamingHtmlConverter {
+    options: ConversionOptions,
+    /// Unconsumed input: a possibly incomplete tag plus any open element.
+    buffer: String,
+    /// Scan position within `buffer`.
+    pos: usize,
+    /// Start of the pending unit (an open element, or bare text at depth 0).
+    unit_start: Option<usize>,
+    /// Open-element depth inside the pending unit.
+    depth: usize,
+    /// The pending unit is a `<head>` element, handled as metadata.
+    in_head: bool,
+    /// `</body>`/`</html>` was seen at the top level; remaining input is ignored.
+    done: bool,
+    /// Line the next emitted unit starts on. Each unit is parsed on its own,
+    /// so its positions restart at line 1; renumbering them to continue after
+    /// the previous unit keeps the renderer's blank-line logic intact.
+    next_line: usize,
+}
+
+/// One scanned construct starting at a `<`.
+enum Scan {
+    /// The construct is not complete yet; more input is needed.
+    Incomplete,
+    /// A comment, doctype or processing instruction ending at `end`.
+    Skip {
+        end: usize,
+    },
+    Open {
+        name: String,
+        end: usize,
+        self_closing: bool,
+    },
+    Close {
+        name: String,
+        end: usize,
+    },
+}
+
+impl StreamingHtmlConverter {
+    /// Creates a converter that emits nodes according to `options`.
+    pub fn new(options: ConversionOptions) -> Self {
+        Self {
+            options,
+            buffer: String::new(),
+            pos: 0,
+            unit_start: None,
+            depth: 0,
+            in_head: false,
+            done: false,
+            next_line: 1,
+        }
+    }
+
+    /// Feeds the next chunk of HTML (chunks may split anywhere on a character
+    /// boundary) and returns the Markdown nodes for every top-level element
+    /// that completed within it.
+    pub fn push_chunk(&mut self, chunk: &str) -> miette::Result<Vec<Node>> {
+        if self.done {
+            return Ok(Vec::new());
+        }
+        self.buffer.push_str(chunk);
+        self.drain_ready()
+    }
+
+    /// Flushes whatever remains buffered (an unclosed element or trailing
+    /// text) as a final best-effort unit, mirroring how the whole-document
+    /// parser recovers from truncated input.
+    pub fn finish(mut self) -> miette::Result<Vec<Node>> {
+        if self.done {
+            return Ok(Vec::new());
+        }
+        let start = self.unit_start.unwrap_or(self.pos);
+        if self.buffer[start..].trim().is_empty() {
+            return Ok(Vec::new());
+        }
+        if self.in_head {
+            self.emit_head(start, self.buffer.len())
+        } else {
+            self.emit_unit(start, self.buffer.len())
+        }
+    }
+
+    /// Scans the buffer, emitting every unit that is now complete, and then
+    /// compacts the buffer down to the still-pending tail.
+    fn drain_ready(&mut self) -> miette::Result<Vec<Node>> {
+        let mut out = Vec::new();
+
+        loop {
+            let Some(lt) = self.buffer[self.pos..].find('<').map(|i| self.pos + i) else {
+                self.mark_pending_text(self.buffer.len());
+                self.pos = self.buffer.len();
+                break;
+            };
+            self.mark_pending_text(lt);
+
+            match self.buffer.as_bytes().get(lt + 1) {
+                None => {
+                    self.pos = lt;
+                    break;
+                }
+                // A `<` that does not begin markup is literal text.
+                Some(b) if !(b.is_ascii_alphabetic() || matches!(b, b'/' | b'!' | b'?')) => {
+                    self.pos = lt + 1;
+                    continue;
+                }
+                Some(_) => {}
+            }
+
+            match Self::scan_tag(&self.buffer, lt) {
+                Scan::Incomplete => {
+                    self.pos = lt;
+                    break;
+                }
+                Scan::Skip { end } => self.pos = end,
+                Scan::Open {
+                    name,
+                    end,
+                    self_closing,
+                } => {
+                    let void = self_closing || VOID_ELEMENTS.contains(&name.as_str());
+                    let raw = !void && RAW_TEXT_ELEMENTS.contains(&name.as_str());
+                    let content_end = if raw {
+                        match Self::raw_text_end(&self.buffer, end, &name) {
+                            Some(end) => end,
+                            None => {
+                                self.pos = lt;
+                                break;
+                            }
+                        }
+                    } else {
+                        end
+                    };
+
+                    if self.depth > 0 {
+                        if !void && !raw {
+                            self.depth += 1;
+                        }
+                        self.pos = content_end;
+                    } else if !void && TRANSPARENT_CONTAINERS.contains(&name.as_str()) {
+                        self.flush_text(lt, &mut out)?;
+                        self.pos = end;
+                    } else {
+                        self.flush_text(lt, &mut out)?;
+                        if void || raw {
+                            out.extend(self.emit_unit(lt, content_end)?);
+                            self.pos = content_end;
+                        } else {
+                            self.unit_start = Some(lt);
+                            self.depth = 1;
+                            self.in_head = name == "head";
+                            self.pos = end;
+                        }
+                    }
+                }
+                Scan::Close { name, end } => {
+                    self.pos = end;
+                    if self.depth > 0 {
+                        self.depth -= 1;
+                        if self.depth == 0 {
+                            let start = self.unit_start.take().expect("open unit has a start");
+                            if self.in_head {
+                                self.in_head = false;
+                                out.extend(self.emit_head(start, end)?);
+                            } else {
+                                out.extend(self.emit_unit(start, end)?);
+                            }
+                        }
+                    } else {
+                        self.flush_text(lt, &mut out)?;
+                        if name == "body" || name == "html" {
+                            self.done = true;
+                            self.buffer.clear();
+                            self.pos = 0;
+                            return Ok(out);
+                        }
+                        // Stray or transparent-container close tag: ignore.
+                    }
+                }
+            }
+        }
+
+        // Drop everything already consumed so the buffer only holds the
+        // pending unit (or incomplete tag), keeping memory bounded.
+        let keep_from = self.unit_start.unwrap_or(self.pos);
+        if keep_from > 0 {
+            self.buffer.drain(..keep_from);
+            self.pos -= keep_from;
+            if let Some(start) = self.unit_start.as_mut() {
+                *start -= keep_from;
+            }
+        }
+
+        Ok(out)
+    }
+
+    /// Starts a bare-text unit at the current position when the text up to
+    /// `upto` contains something other than whitespace.
+    fn mark_pending_text(&mut self, upto: usize) {
+        if self.depth == 0 && self.unit_start.is_none() && !self.buffer[self.pos..upto].trim().is_empty() {
+            self.unit_start = Some(self.pos);
+        }
+    }
+
+    /// Emits bare top-level text preceding a tag at `upto` as its own unit.
+    fn flush_text(&mut self, upto: usize, out: &mut Vec<Node>) -> miette::Result<()> {
+        if let Some(start) = self.unit_start.take() {
+            out.extend(self.emit_unit(start, upto)?);
+        }
+        Ok(())
+    }
+
+    /// Converts one complete unit through the same parser/converter pipeline
+    /// the whole-document conversion uses.
+    fn emit_unit(&mut self, start: usize, end: usize) -> miette::Result<Vec<Node>> {
+        let html = Html::parse_document(&self.buffer[start..end]);
+        let html_nodes = parser::map_nodes_to_html_nodes(html.root_element().children().collect())?;
+        let markdown = converter::convert_nodes_to_markdown(&html_nodes, self.options)?;
+        if markdown.trim().is_empty() {
+            return Ok(Vec::new());
+        }
+        Ok(self.renumber(Markdown::from_markdown_str(&markdown)?.nodes))
+    }
+
+    /// Turns a complete `<head>` element into front matter and/or a title
+    /// heading, depending on the conversion options.
+    fn emit_head(&mut self, start: usize, end: usize) -> miette::Result<Vec<Node>> {
+        let html = Html::parse_document(&self.buffer[start..end]);
+        let mut prefix = String::new();
+        if self.options.generate_front_matter {
+            prefix.push_str(&front_matter_block(&html)?);
+        }
+        if self.options.use_title_as_h1
+            && let Some(title) = super::extract_title_text(&html)
+        {
+            prefix.push_str(&format!("# {}\n\n", title));
+        }
+        if prefix.is_empty() {
+            return Ok(Vec::new());
+        }
+        Ok(self.renumber(Markdown::from_markdown_str(&prefix)?.nodes))
+    }
+
+    /// Shifts a freshly parsed unit's positions so it starts one blank line
+    /// after the previously emitted unit.
+    fn renumber(&mut self, mut nodes: Vec<Node>) -> Vec<Node> {
+        let offset = self.next_line - 1;
+        let mut max_end = self.next_line;
+        for node in &mut nodes {
+            if let Some(mut pos) = node.position() {
+                pos.start.line += offset;
+                pos.end.line += offset;
+                max_end = max_end.max(pos.end.line);
+                node.set_position(Some(pos));
+            }
+        }
+        if !nodes.is_empty() {
+            self.next_line = max_end + 2;
+        }
+        nodes
+    }
+
+    /// Scans the markup construct starting at the `<` at `start`.
+    fn scan_tag(buf: &str, start: usize) -> Scan {
+        let rest = &buf[start..];
+        if let Some(comment) = rest.strip_prefix("<!--") {
+            return match comment.find("-->") {
+                Some(i) => Scan::Skip { end: start + 4 + i + 3 },
+                None => Scan::Incomplete,
+            };
+        }
+        if rest.starts_with("<!") || rest.starts_with("<?") {
+            return match rest.find('>') {
+                Some(i) => Scan::Skip { end: start + i + 1 },
+                None => Scan::Incomplete,
+            };
+        }
+        if let Some(close) = rest.strip_prefix("</") {
+            return match close.find('>') {
+                Some(i) => Scan::Close {
+                    name: Self::tag_name(close),
+                    end: start + 2 + i + 1,
+                },
+                None => Scan::Incomplete,
+            };
+        }
+
+        // Open tag: `>` inside a quoted attribute value does not end it.
+        let mut quote: Option<u8> = None;
+        for (i, byte) in rest.bytes().enumerate().skip(1) {
+            match quote {
+                Some(q) if byte == q => quote = None,
+                Some(_) => {}
+                None => match byte {
+                    b'"' | b'\'' => quote = Some(byte),
+                    b'>' => {
+                        let inner = &rest[1..i];
+                        return Scan::Open {
+                            name: Self::tag_name(inner),
+                            end: start + i + 1,
+                            self_closing: inner.trim_end().ends_with('/'),
+                        };
+                    }
+                    _ => {}
+                },
+            }
+        }
+        Scan::Incomplete
+    }
+
+    /// Extracts the lowercase tag name from the text following `<` or `</`.
+    fn tag_name(after_bracket: &str) -> String {
+        after_bracket
+            .split(|c: char| c.is_ascii_whitespace() || c == '/' || c == '>')
+            .next()
+            .unwrap_or("")
+            .to_ascii_lowercase()
+    }
+
+    /// Finds the end of a raw-text element's closing tag (case-insensitive),
+    /// starting from the end of its opening tag.
+    fn raw_text_end(buf: &str, from: usize, name: &str) -> Option<usize> {
+        let needle = format!("</{}", name);
+        let haystack = buf[from..].to_ascii_lowercase();
+        let close = from + haystack.find(&needle)?;
+        buf[close..].find('>').map(|i| close + i + 1)
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use rstest::rstest;
+
+    /// Pushes `input` in `chunk_size`-byte pieces and renders the result.
+    fn convert_chunked(input: &str, chunk_size: usize, options: ConversionOptions) -> String {
+        let mut converter = StreamingHtmlConverter::new(options);
+        let mut nodes = Vec::new();
+        let mut rest = input;
+        while !rest.is_empty() {
+            let mut end = chunk_size.min(rest.len());
+            while !rest.is_char_boundary(end) {
+                end += 1;
+            }
+            let (chunk, tail) = rest.split_at(end);
+            nodes.extend(converter.push_chunk(chunk).expect("push_chunk should succeed"));
+            rest = tail;
+        }
+        nodes.extend(converter.finish().expect("finish should succeed"));
+        Markdown::new(nodes).to_string()
+    }
+
+    #[rstest]
+    #[case::simple_blocks("<body><h1>Title</h1><p>Some <em>text</em>.</p></body>", "# Title\n\nSome *text*.\n")]
+    #[case::bare_text("<body>just text<p>para</p></body>", "just text\n\npara\n")]
+    #[case::transparent_div("<body><div><p>a</p><p>b</p></div></body>", "a\n\nb\n")]
+    #[case::nested_list(
+        "<ul><li>one</li><li>two<ul><li>deep</li></ul></li></ul>",
+        "- one\n- two\n  - deep\n"
+    )]
+    #[case::void_element("<p>a</p><hr><p>b</p>", "a\n\n---\n\nb\n")]
+    #[case::comment_skipped("<!-- note --><p>a</p>", "a\n")]
+    #[case::script_with_fake_close_tag("<p>a</p><script>document.write(\"</div><p>\");</script><p>b</p>", "a\n\nb\n")]
+    #[case::quoted_gt_in_attribute("<p title=\"a > b\">text</p>", "text\n")]
+    #[case::literal_lt_in_text("<p>a < b</p>", "a < b\n")]
+    #[case::after_body_ignored("<body><p>a</p></body><p>ignored</p>", "a\n")]
+    #[case::unclosed_element_flushed("<blockquote><p>tail", "> tail\n")]
+    fn test_streaming_conversion(#[case] input: &str, #[case] expected: &str) {
+        // Every chunk size must produce the same result, including sizes that
+        // split the input in the middle of tags.
+        for chunk_size in [1, 3, 7, input.len()] {
+            assert_eq!(
+                convert_chunked(input, chunk_size, ConversionOptions::default()),
+                expected,
+                "chunk_size {}",
+                chunk_size
+            );
+        }
+    }
+
+    #[test]
+    fn test_matches_whole_document_conversion() {
+        let input = "<html><head><title>T</title></head><body>\
+                     <h1>Heading</h1><p>Some <strong>bold</strong> text.</p>\
+                     <ul><li>one</li><li>two</li></ul>\
+                     <pre><code>let a = 1;</code></pre>\
+                     <table><tr><th>h</th></tr><tr><td>v</td></tr></table>\
+                     </body></html>";
+        let whole = super::super::convert_html_to_markdown(input, ConversionOptions::default())
+            .expect("whole-document conversion should succeed");
+        let streamed = convert_chunked(input, 5, ConversionOptions::default());
+        assert_eq!(
+            streamed.parse::<Markdown>().unwrap().to_string(),
+            whole.parse::<Markdown>().unwrap().to_string()
+        );
+    }
+
+    #[test]
+    fn test_head_front_matter_and_title() {
+        let input = "<html><head><title>Page</title>\
+                     <meta name=\"description\" content=\"desc\"></head>\
+                     <body><p>body</p></body></html>";
+        let options = ConversionOptions {
+            generate_front_matter: true,
+            use_title_as_h1: true,
+            ..ConversionOptions::default()
+        };
+        let output = convert_chunked(input, 9, options);
+        assert!(output.contains("title: Page"), "front matter missing: {}", output);
+        assert!(output.contains("description: desc"), "front matter missing: {}", output);
+        assert!(output.contains("# Page"), "title heading missing: {}", output);
+        assert!(output.contains("body"), "body content missing: {}", output);
+    }
+
+    #[test]
+    fn test_emits_before_wrapper_closes_and_buffer_stays_bounded() {
+        let mut converter = StreamingHtmlConverter::new(ConversionOptions::default());
+        let nodes = converter.push_chunk("<div id=\"app\"><p>first</p><p>second").unwrap();
+        // The two complete paragraphs are emitted even though the surrounding
+        // div is still open, and the buffer holds only the unfinished one.
+        assert_eq!(Markdown::new(nodes).to_string(), "first\n");
+        assert!(converter.buffer.len() < "<p>second".len() + 1);
+
+        let nodes = converter.push_chunk("</p></div>").unwrap();
+        assert_eq!(Markdown::new(nodes).to_string(), "second\n");
+        assert!(converter.finish().unwrap().is_empty());
+    }
+}
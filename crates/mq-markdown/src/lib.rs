@@ -78,9 +78,12 @@
 //! # #[cfg(not(feature = "html-to-markdown"))]
 //! # fn main() {}
 //! ```
+mod arena;
 mod html_to_markdown;
 mod markdown;
 mod node;
+mod streaming;
+pub use arena::{NodeArena, NodeId};
 pub use markdown::{Markdown, to_html};
 pub use node::{
     Blockquote, Break, Code, CodeInline, ColorTheme, Definition, Delete, Emphasis, Footnote, FootnoteRef, Fragment,
@@ -89,6 +92,7 @@ pub use node::{
     RenderOptions, Strong, TableAlign, TableAlignKind, TableCell, TableRow, Text, Title, TitleSurroundStyle, Toml, Url,
     UrlSurroundStyle, Yaml, attr_value::AttrValue,
 };
+pub use streaming::MarkdownBlockSplitter;
 
 #[cfg(feature = "wikilink")]
 pub use node::WikiLink;
@@ -99,6 +103,8 @@ pub use node::Callout;
 #[cfg(feature = "embed")]
 pub use node::Embed;
 
+#[cfg(feature = "html-to-markdown")]
+pub use html_to_markdown::streaming::StreamingHtmlConverter;
 #[cfg(feature = "html-to-markdown")]
 pub use html_to_markdown::{ConversionOptions, convert_html_to_markdown};
 
@@ -0,0 +1,159 @@
+//! Incremental splitting of Markdown text into top-level blocks.
+//!
+//! Powers mq's streaming mode: input is consumed line by line and complete
+//! top-level blocks are handed to the evaluator as soon as they end, so memory
+//! stays bounded by the largest block instead of the whole input.
+
+/// Splits Markdown into top-level blocks as lines are pushed.
+///
+/// A block ends at a blank line outside a fenced code block, so fenced code
+/// (<code>```</code> or `~~~`, including blank lines inside the fence) stays intact.
+/// Constructs that legitimately span blank lines (loose lists, multi-paragraph
+/// list items, footnote definitions) are split at the blank line — streaming
+/// trades exact fidelity for bounded memory.
+///
+/// # Examples
+///
+/// ```rust
+/// use mq_markdown::MarkdownBlockSplitter;
+///
+/// let mut splitter = MarkdownBlockSplitter::new();
+/// assert_eq!(splitter.push_line("# Heading"), None);
+/// assert_eq!(splitter.push_line(""), Some("# Heading\n".to_string()));
+/// assert_eq!(splitter.push_line("Paragraph"), None);
+/// assert_eq!(splitter.finish(), Some("Paragraph\n".to_string()));
+/// ```
+#[derive(Debug, Default)]
+pub struct MarkdownBlockSplitter {
+    buffer: String,
+    fence: Option<Fence>,
+}
+
+/// An open fenced code block: its marker character and opening run length.
+#[derive(Clone, Copy, Debug)]
+struct Fence {
+    marker: char,
+    len: usize,
+}
+
+impl MarkdownBlockSplitter {
+    /// Creates a new splitter with an empty buffer.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Feeds one line (without its trailing newline) and returns a completed
+    /// top-level block if this line finished one.
+    pub fn push_line(&mut self, line: &str) -> Option<String> {
+        if let Some(fence) = self.fence {
+            self.append(line);
+            if Self::closes_fence(line, fence) {
+                self.fence = None;
+            }
+            return None;
+        }
+
+        if line.trim().is_empty() {
+            return self.take_buffer();
+        }
+
+        if let Some(fence) = Self::opens_fence(line) {
+            self.fence = Some(fence);
+        }
+        self.append(line);
+        None
+    }
+
+    /// Returns any remaining buffered content as the final block.
+    /// Call once the input is exhausted; an unclosed fence is flushed as-is.
+    pub fn finish(&mut self) -> Option<String> {
+        self.fence = None;
+        self.take_buffer()
+    }
+
+    fn append(&mut self, line: &str) {
+        self.buffer.push_str(line);
+        self.buffer.push('\n');
+    }
+
+    fn take_buffer(&mut self) -> Option<String> {
+        if self.buffer.is_empty() {
+            None
+        } else {
+            Some(std::mem::take(&mut self.buffer))
+        }
+    }
+
+    /// Returns the fence opened by `line`, if any: up to three spaces of
+    /// indentation followed by a run of at least three backticks or tildes.
+    fn opens_fence(line: &str) -> Option<Fence> {
+        let trimmed = line.trim_start_matches(' ');
+        if line.len() - trimmed.len() > 3 {
+            return None;
+        }
+        let marker = trimmed.chars().next()?;
+        if marker != '`' && marker != '~' {
+            return None;
+        }
+        let len = trimmed.chars().take_while(|&c| c == marker).count();
+        (len >= 3).then_some(Fence { marker, len })
+    }
+
+    /// Returns `true` if `line` closes `fence`: a run of the same marker at
+    /// least as long as the opening run, with nothing but whitespace after it.
+    fn closes_fence(line: &str, fence: Fence) -> bool {
+        let trimmed = line.trim_start_matches(' ');
+        if line.len() - trimmed.len() > 3 {
+            return false;
+        }
+        let len = trimmed.chars().take_while(|&c| c == fence.marker).count();
+        len >= fence.len && trimmed.trim_start_matches(fence.marker).trim().is_empty()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use rstest::rstest;
+
+    fn split_all(input: &str) -> Vec<String> {
+        let mut splitter = MarkdownBlockSplitter::new();
+        let mut blocks: Vec<String> = input.lines().filter_map(|line| splitter.push_line(line)).collect();
+        if let Some(block) = splitter.finish() {
+            blocks.push(block);
+        }
+        blocks
+    }
+
+    #[rstest]
+    #[case::empty("", vec![])]
+    #[case::blank_lines_only("\n\n\n", vec![])]
+    #[case::single_paragraph("Hello world", vec!["Hello world\n"])]
+    #[case::two_blocks("# Heading\n\nParagraph", vec!["# Heading\n", "Paragraph\n"])]
+    #[case::consecutive_blank_lines("a\n\n\n\nb", vec!["a\n", "b\n"])]
+    #[case::heading_and_paragraph_joined("# Heading\nParagraph", vec!["# Heading\nParagraph\n"])]
+    #[case::fenced_code_with_blank_line(
+        "```rust\nlet a = 1;\n\nlet b = 2;\n```\n\nafter",
+        vec!["```rust\nlet a = 1;\n\nlet b = 2;\n```\n", "after\n"]
+    )]
+    #[case::tilde_fence("~~~\n\ntext\n~~~\n\nafter", vec!["~~~\n\ntext\n~~~\n", "after\n"])]
+    #[case::longer_closing_fence("```\ncode\n`````\n\nafter", vec!["```\ncode\n`````\n", "after\n"])]
+    #[case::shorter_run_does_not_close("````\n```\ncode\n````\n\nafter", vec!["````\n```\ncode\n````\n", "after\n"])]
+    #[case::unclosed_fence_flushed_on_finish("```\ncode\n", vec!["```\ncode\n"])]
+    #[case::indented_fence("   ```\n\n   ```\n\nafter", vec!["   ```\n\n   ```\n", "after\n"])]
+    fn test_block_splitter(#[case] input: &str, #[case] expected: Vec<&str>) {
+        assert_eq!(split_all(input), expected);
+    }
+
+    #[test]
+    fn test_blocks_parse_like_whole_document() {
+        let input = "# Title\n\nSome *text*.\n\n```sh\necho hi\n\necho bye\n```\n\n> quote";
+        let blocks = split_all(input);
+        let combined: Vec<crate::Node> = blocks
+            .iter()
+            .flat_map(|block| block.parse::<crate::Markdown>().expect("block should parse").nodes)
+            .collect();
+        let whole = input.parse::<crate::Markdown>().expect("input should parse");
+        assert_eq!(combined.len(), whole.nodes.len());
+    }
+}
@@ -114,10 +114,23 @@ impl From<String> for Command {
     }
 }
 
+/// Maximum number of pipeline results kept for prefix-extension reuse.
+/// Values are shared pointers, so an entry costs one `Vec` of handles, not a
+/// copy of the document.
+const PIPELINE_CACHE_LIMIT: usize = 32;
+
 pub struct CommandContext {
     pub(crate) engine: mq_lang::DefaultEngine,
     pub(crate) input: Vec<mq_lang::RuntimeValue>,
     initial_input: Vec<mq_lang::RuntimeValue>,
+    /// The document loaded via `/load`, kept parsed so `/reset` gets back to
+    /// it without re-parsing the file.
+    loaded_document: Option<Vec<mq_lang::RuntimeValue>>,
+    /// Results of previously evaluated pipelines, keyed by the cumulative
+    /// query that produced them. When a new line extends a cached query with
+    /// `| stage`, only the appended stages are evaluated against the cached
+    /// values instead of re-running the whole pipeline.
+    pipeline_cache: Vec<(String, Vec<mq_lang::RuntimeValue>)>,
     pub(crate) hir: mq_hir::Hir,
     pub(crate) source_id: mq_hir::SourceId,
     pub(crate) scope_id: mq_hir::ScopeId,
@@ -134,6 +147,8 @@ impl CommandContext {
             engine,
             initial_input: input.clone(),
             input,
+            loaded_document: None,
+            pipeline_cache: Vec::new(),
             hir,
             source_id,
             scope_id,
@@ -227,6 +242,52 @@ impl CommandContext {
         }
     }
 
+    /// Finds the longest cached pipeline that `code` extends and returns the
+    /// stages appended after it together with that pipeline's cached values.
+    /// An exact repeat returns an empty stage.
+    fn cached_stage<'a>(&self, code: &'a str) -> Option<(&'a str, Vec<mq_lang::RuntimeValue>)> {
+        let code = code.trim();
+        self.pipeline_cache
+            .iter()
+            .filter_map(|(prefix, values)| {
+                let rest = code.strip_prefix(prefix.as_str())?;
+                if rest.is_empty() {
+                    Some((prefix.len(), "", values))
+                } else {
+                    let stage = rest.trim_start().strip_prefix('|')?.trim_start();
+                    // A leading `||` is the or-operator extending the previous
+                    // expression, not a new pipeline stage.
+                    if stage.starts_with('|') {
+                        return None;
+                    }
+                    Some((prefix.len(), stage, values))
+                }
+            })
+            .max_by_key(|(prefix_len, _, _)| *prefix_len)
+            .map(|(_, stage, values)| (stage, values.clone()))
+    }
+
+    /// Records a successful evaluation's values under the cumulative pipeline
+    /// text so later lines can extend it. Lines that did not extend a cached
+    /// pipeline are chained onto the previous one, matching how evaluation
+    /// folds each result into the next line's input.
+    fn cache_pipeline_result(&mut self, code: &str, extended_cached: bool, values: Vec<mq_lang::RuntimeValue>) {
+        let code = code.trim();
+        let cumulative = if extended_cached {
+            code.to_string()
+        } else {
+            match self.pipeline_cache.last() {
+                Some((previous, _)) => format!("{} | {}", previous, code),
+                None => code.to_string(),
+            }
+        };
+
+        if self.pipeline_cache.len() >= PIPELINE_CACHE_LIMIT {
+            self.pipeline_cache.remove(0);
+        }
+        self.pipeline_cache.push((cumulative, values));
+    }
+
     pub fn execute(&mut self, to_run: &str) -> miette::Result<CommandOutput> {
         match to_run.to_string().into() {
             Command::Clear => {
@@ -245,7 +306,13 @@ impl CommandContext {
                 self.source_id = source_id;
                 self.scope_id = scope_id;
                 self.engine = engine;
-                self.input = self.initial_input.clone();
+                // A document loaded with /load is kept parsed, so resetting
+                // gets back to it without re-reading or re-parsing the file.
+                self.input = self
+                    .loaded_document
+                    .clone()
+                    .unwrap_or_else(|| self.initial_input.clone());
+                self.pipeline_cache.clear();
                 Ok(CommandOutput::None)
             }
             Command::Copy => {
@@ -314,6 +381,9 @@ impl CommandContext {
 
                     self.hir.add_line_of_code(self.source_id, self.scope_id, code);
                     self.input = eval_result.values().clone();
+                    // Edited code did not go through the pipeline cache, so
+                    // cached cumulative queries no longer describe the input.
+                    self.pipeline_cache.clear();
 
                     Ok(CommandOutput::Value(eval_result.values().clone()))
                 }
@@ -354,7 +424,11 @@ impl CommandContext {
                         let markdown: mq_markdown::Markdown =
                             mq_markdown::Markdown::from_markdown_str(&markdown_content)?;
 
-                        self.input = markdown.nodes.into_iter().map(mq_lang::RuntimeValue::from).collect();
+                        let nodes: Vec<mq_lang::RuntimeValue> =
+                            markdown.nodes.into_iter().map(mq_lang::RuntimeValue::from).collect();
+                        self.loaded_document = Some(nodes.clone());
+                        self.input = nodes;
+                        self.pipeline_cache.clear();
                         Ok(CommandOutput::None)
                     })
             }
@@ -409,12 +483,27 @@ impl CommandContext {
                     return Ok(CommandOutput::None);
                 }
 
-                let result = self.engine.eval(&code, self.input.clone().into_iter());
+                // Retyping a cached pipeline with extra stages appended only
+                // evaluates the new stages against the cached intermediate
+                // values, so exploring a large document stays interactive.
+                let (stage, base_input, matched_prefix) = match self.cached_stage(&code) {
+                    Some((stage, values)) => {
+                        if stage.is_empty() {
+                            self.input = values.clone();
+                            return Ok(CommandOutput::Value(values));
+                        }
+                        (stage.to_string(), values, true)
+                    }
+                    None => (code.clone(), self.input.clone(), false),
+                };
+
+                let result = self.engine.eval(&stage, base_input.into_iter());
 
                 result
                     .map(|result| {
                         self.hir.add_line_of_code(self.source_id, self.scope_id, &code);
                         self.input = result.values().clone();
+                        self.cache_pipeline_result(&code, matched_prefix, result.values().clone());
                         Ok(CommandOutput::Value(result.values().clone()))
                     })
                     .map_err(|e| *e)?
@@ -684,6 +773,114 @@ mod tests {
         assert_eq!(saved_content, "# Header\nParagraph text.");
     }
 
+    #[test]
+    fn test_pipeline_cache_extends_previous_query() {
+        let mut engine = mq_lang::DefaultEngine::default();
+        engine.load_builtin_module();
+        let input = mq_lang::parse_markdown_input("# Head\n\ntext\n").unwrap();
+        let mut ctx = CommandContext::new(engine, input);
+
+        ctx.execute(".h").unwrap();
+
+        // Replace the folded input with a sentinel: if the extended pipeline
+        // is re-run from scratch it would see the sentinel, while the cache
+        // serves the `.h` result and only `upcase()` is evaluated.
+        ctx.input = vec!["sentinel".to_string().into()];
+
+        let result = ctx.execute(".h | upcase()").unwrap();
+        if let CommandOutput::Value(values) = result {
+            let rendered: Vec<String> = values.iter().map(|v| v.to_string()).collect();
+            assert!(rendered.iter().any(|s| s.contains("HEAD")));
+            assert!(rendered.iter().all(|s| !s.contains("SENTINEL")));
+        } else {
+            panic!("Expected Value output");
+        }
+    }
+
+    #[test]
+    fn test_pipeline_cache_exact_repeat() {
+        let mut engine = mq_lang::DefaultEngine::default();
+        engine.load_builtin_module();
+        let input = mq_lang::parse_markdown_input("# Head\n\ntext\n").unwrap();
+        let mut ctx = CommandContext::new(engine, input);
+
+        let first = ctx.execute(".h").unwrap();
+        ctx.input = vec!["sentinel".to_string().into()];
+        let second = ctx.execute(".h").unwrap();
+
+        match (first, second) {
+            (CommandOutput::Value(first), CommandOutput::Value(second)) => {
+                assert_eq!(first.len(), second.len());
+                assert_eq!(first[0].to_string(), second[0].to_string());
+            }
+            _ => panic!("Expected Value output"),
+        }
+    }
+
+    #[test]
+    fn test_pipeline_cache_prefix_must_end_at_stage_boundary() {
+        let mut engine = mq_lang::DefaultEngine::default();
+        engine.load_builtin_module();
+        let input = mq_lang::parse_markdown_input("# Head\n\n## Sub\n").unwrap();
+        let mut ctx = CommandContext::new(engine, input.clone());
+
+        ctx.execute(".h").unwrap();
+        // `.h2` shares the `.h` text prefix but is a different selector, so
+        // the cache must not serve the `.h` result for it.
+        ctx.input = input;
+        let result = ctx.execute(".h2").unwrap();
+        if let CommandOutput::Value(values) = result {
+            let rendered: Vec<String> = values.iter().map(|v| v.to_string()).filter(|s| !s.is_empty()).collect();
+            assert_eq!(rendered, vec!["## Sub".to_string()]);
+        } else {
+            panic!("Expected Value output");
+        }
+    }
+
+    #[test]
+    fn test_pipeline_cache_rejects_or_operator_as_stage_boundary() {
+        let mut engine = mq_lang::DefaultEngine::default();
+        engine.load_builtin_module();
+        let input = mq_lang::parse_markdown_input("# Head\n").unwrap();
+        let mut ctx = CommandContext::new(engine, input);
+
+        ctx.execute("true").unwrap();
+        // `true || false` extends the cached `true` with the or-operator, not
+        // a new pipeline stage; splitting it would evaluate `| false`, which
+        // is a syntax error.
+        let result = ctx.execute("true || false").unwrap();
+        if let CommandOutput::Value(values) = result {
+            assert!(values.iter().any(|v| v.to_string() == "true"));
+        } else {
+            panic!("Expected Value output");
+        }
+    }
+
+    #[test]
+    fn test_reset_restores_loaded_document() {
+        let engine = mq_lang::DefaultEngine::default();
+        let mut ctx = CommandContext::new(engine, vec!["".to_string().into()]);
+        let (_, temp_file_path) = create_file("test_reset_restores_loaded_document.md", "# Header\n\ntext\n");
+        let temp_file_path_clone = temp_file_path.clone();
+
+        defer! {
+            if temp_file_path_clone.exists() {
+                std::fs::remove_file(&temp_file_path_clone).expect("Failed to delete temp file");
+            }
+        }
+
+        ctx.execute(&format!("/load {}", temp_file_path.to_str().unwrap()))
+            .unwrap();
+        let loaded_len = ctx.input.len();
+
+        ctx.execute(".h").unwrap();
+        ctx.execute("/reset").unwrap();
+
+        // /reset returns to the loaded document without re-reading the file.
+        assert_eq!(ctx.input.len(), loaded_len);
+        assert!(ctx.input.iter().any(|v| v.to_string().contains("Header")));
+    }
+
     #[test]
     fn test_execute_eval() {
         let engine = mq_lang::DefaultEngine::default();
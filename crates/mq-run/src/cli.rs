@@ -5,7 +5,6 @@ use miette::miette;
 use mq_lang::DefaultEngine;
 use mq_lang::Shared;
 use rayon::prelude::*;
-use std::collections::BTreeMap;
 use std::io::BufRead;
 use std::io::IsTerminal;
 use std::io::{self, BufWriter, Read, Write};
@@ -78,12 +77,15 @@ pub struct Cli {
     #[arg(long, default_value_t = false)]
     doc: bool,
 
-    /// Number of files to process before switching to parallel processing
+    /// Number of files to process before switching to parallel processing.
+    /// Output is always written in input file order, even when processed in parallel.
     #[arg(short = 'P', default_value_t = 10)]
     parallel_threshold: usize,
 
     #[arg(value_name = "QUERY OR FILE")]
     query: Option<String>,
+    /// Input files. Directory arguments are expanded into the Markdown files they
+    /// contain, walking recursively and honouring .gitignore/.ignore files.
     files: Option<Vec<PathBuf>>,
 
     /// Positional string arguments, available as ARGS."positional" in queries.
@@ -98,11 +100,28 @@ pub struct Cli {
     /// No timeout by default.
     #[arg(long, value_name = "SECONDS")]
     timeout: Option<f64>,
+
+    /// Collect per-expression timings during evaluation and print a table to stderr
+    /// after the run, sorted by cumulative time (hottest first).
+    /// Disables parallel file processing so timings aggregate in a single engine.
+    #[arg(long, default_value_t = false)]
+    profile: bool,
+
+    /// Watch input files and re-evaluate them when they change. The query stays
+    /// compiled and only files whose content actually changed are re-parsed and
+    /// re-evaluated. Requires file inputs; press Ctrl-C to stop.
+    #[arg(short = 'w', long, default_value_t = false, conflicts_with_all = ["stream", "eval_all", "count", "mmap"])]
+    watch: bool,
 }
 
 #[cfg(unix)]
 const UNIX_EXECUTABLE_BITS: u32 = 0o111;
 
+/// How often `--watch` polls input files for modification-time changes.
+/// Polling (rather than OS file notifications) keeps the dependency surface
+/// small and behaves identically across platforms and network filesystems.
+const WATCH_POLL_INTERVAL: std::time::Duration = std::time::Duration::from_millis(200);
+
 /// Represents the input format for processing.
 ///
 /// Native formats (no module import):
@@ -180,10 +199,12 @@ impl InputFormat {
     }
 }
 
-/// Holds file/stdin content as either UTF-8 text or raw bytes.
+/// Holds file/stdin content as either UTF-8 text, raw bytes, or a read-only memory
+/// mapping (`--mmap`), which hands out borrowed slices without an owned copy.
 enum ContentData {
     Text(String),
     Bytes(Vec<u8>),
+    Mapped(memmap2::Mmap),
 }
 
 impl ContentData {
@@ -195,6 +216,9 @@ impl ContentData {
         match self {
             ContentData::Text(s) => Some(s),
             ContentData::Bytes(_) => None,
+            // Text-format mappings are validated as UTF-8 when created (see `map_file`),
+            // so this only returns `None` for binary content.
+            ContentData::Mapped(m) => std::str::from_utf8(m).ok(),
         }
     }
 
@@ -202,6 +226,7 @@ impl ContentData {
         match self {
             ContentData::Text(s) => s.as_bytes(),
             ContentData::Bytes(b) => b,
+            ContentData::Mapped(m) => m,
         }
     }
 }
@@ -321,10 +346,22 @@ struct InputArgs {
     #[arg(long = "slurpfile", num_args = 2, value_names = ["NAME", "FILE"])]
     slurp_file: Option<Vec<String>>,
 
-    /// Enable streaming mode for processing large files line by line
+    /// Enable streaming mode for processing large inputs incrementally with bounded
+    /// memory. Markdown/MDX input is evaluated block by block; other text formats line by line
     #[arg(long, default_value_t = false)]
     stream: bool,
 
+    /// Memory-map input files instead of reading them into memory up front.
+    /// Reduces peak memory on large files; has no effect on stdin input
+    #[arg(long, default_value_t = false)]
+    mmap: bool,
+
+    /// Cache compiled queries on disk so repeated invocations skip parsing.
+    /// Entries are keyed by query, optimization level, and mq version and are
+    /// stored under the system cache directory
+    #[arg(long = "compile-cache", default_value_t = false)]
+    compile_cache: bool,
+
     /// Evaluate the query once against all input files combined (like yq's `eval-all`),
     /// instead of once per file. Enables cross-file aggregation in a single query.
     #[arg(
@@ -343,7 +380,8 @@ struct InputArgs {
     #[arg(long = "allowed-domain")]
     allowed_domains: Option<Vec<String>>,
 
-    /// Force re-fetch of mutable-ref (HEAD/branch) HTTP-imported modules, ignoring the local cache.
+    /// Revalidate mutable-ref (HEAD/branch) HTTP-imported modules against the server instead
+    /// of trusting the local cache; unchanged modules (HTTP 304) are reused, changed ones re-downloaded.
     /// Versioned (tagged) modules are never re-fetched regardless of this flag.
     #[cfg(feature = "http-import")]
     #[arg(long = "refresh-modules", default_value_t = false)]
@@ -783,7 +821,9 @@ impl Cli {
             Some(Commands::Dap) => mq_dap::start().map_err(|e| miette!(e.to_string())),
             Some(Commands::Completion { shell }) => Self::generate_completion(shell),
             None => {
-                let result = if self.input.stream {
+                let result = if self.watch {
+                    self.process_watch()
+                } else if self.input.stream {
                     self.process_streaming()
                 } else {
                     self.process_batch()
@@ -810,6 +850,10 @@ impl Cli {
         engine.load_builtin_module();
         engine.set_optimization_level(self.optimize_level.clone().into());
 
+        if self.input.compile_cache {
+            engine.set_compile_cache(Some(mq_lang::CompileCache::default()));
+        }
+
         if self.input.aggregate {
             engine.import_module("section").map_err(|e| *e)?;
         }
@@ -835,7 +879,7 @@ impl Cli {
             || self.input.argjson.is_some()
             || self.input.slurp_file.is_some()
         {
-            let mut named: BTreeMap<mq_lang::Ident, mq_lang::RuntimeValue> = BTreeMap::new();
+            let mut named = mq_lang::Dict::default();
             if let Some(args) = &self.input.args {
                 for v in args.chunks(2) {
                     engine.define_string_value(&v[0], &v[1]);
@@ -880,7 +924,7 @@ impl Cli {
                 .iter()
                 .map(|s| mq_lang::RuntimeValue::String(s.clone()))
                 .collect();
-            let args_map: BTreeMap<mq_lang::Ident, mq_lang::RuntimeValue> = [
+            let args_map: mq_lang::Dict = [
                 (
                     mq_lang::Ident::new("positional"),
                     mq_lang::RuntimeValue::Array(Shared::new(positional)),
@@ -937,6 +981,10 @@ impl Cli {
             engine.set_timeout(std::time::Duration::from_secs_f64(secs));
         }
 
+        if self.profile {
+            engine.set_profiling(true);
+        }
+
         #[cfg(feature = "debugger")]
         {
             use crate::debugger::DebuggerHandler;
@@ -1040,13 +1088,10 @@ impl Cli {
         Ok(current_values.update_with(results))
     }
 
-    fn emit_results(
-        &self,
-        runtime_values: mq_lang::RuntimeValues,
-        grep_input: Option<Vec<mq_lang::RuntimeValue>>,
-        file: &Option<PathBuf>,
-    ) -> miette::Result<()> {
-        let runtime_values = if self.output.skip.is_some() || self.output.limit.is_some() {
+    /// Applies `--skip`/`--limit` pagination to the results, stripping positions from
+    /// Markdown nodes when empty values were compacted away.
+    fn paginate_results(&self, runtime_values: mq_lang::RuntimeValues) -> mq_lang::RuntimeValues {
+        if self.output.skip.is_some() || self.output.limit.is_some() {
             let compact = runtime_values.compact();
             let had_empties = compact.len() < runtime_values.len();
             let paginated: Vec<mq_lang::RuntimeValue> = self
@@ -1070,7 +1115,16 @@ impl Cli {
             paginated.into()
         } else {
             runtime_values
-        };
+        }
+    }
+
+    fn emit_results(
+        &self,
+        runtime_values: mq_lang::RuntimeValues,
+        grep_input: Option<Vec<mq_lang::RuntimeValue>>,
+        file: &Option<PathBuf>,
+    ) -> miette::Result<()> {
+        let runtime_values = self.paginate_results(runtime_values);
 
         if let Some(input) = grep_input {
             let (before, after) = self.output.context_counts();
@@ -1088,6 +1142,25 @@ impl Cli {
         }
     }
 
+    /// Variant of [`Self::emit_results`] that writes to a caller-provided writer.
+    /// See [`Self::print_to`] for why the parallel batch path needs this.
+    fn emit_results_to(
+        &self,
+        runtime_values: mq_lang::RuntimeValues,
+        grep_input: Option<Vec<mq_lang::RuntimeValue>>,
+        file: &Option<PathBuf>,
+        handle: &mut dyn Write,
+    ) -> miette::Result<()> {
+        let runtime_values = self.paginate_results(runtime_values);
+
+        if let Some(input) = grep_input {
+            let (before, after) = self.output.context_counts();
+            grep::print_grep_to(runtime_values, &input, file, handle, before, after)
+        } else {
+            self.print_to(runtime_values, handle)
+        }
+    }
+
     fn execute(
         &self,
         engine: &mut mq_lang::DefaultEngine,
@@ -1149,6 +1222,57 @@ impl Cli {
         files[1..].iter().all(|(f, _)| self.auto_query_prefix(f) == first)
     }
 
+    /// Prints the per-expression profile collected by `engine` to stderr as a
+    /// table sorted by cumulative time, hottest first. Does nothing unless
+    /// `--profile` was given. Written to stderr so it never mixes with piped
+    /// query output.
+    fn report_profile(&self, engine: &mut mq_lang::DefaultEngine) {
+        if !self.profile {
+            return;
+        }
+
+        let records = engine.take_profile_records();
+        if records.is_empty() {
+            return;
+        }
+
+        eprintln!("{:>14}  {:>10}  {:>9}  EXPR", "TOTAL TIME", "CALLS", "LINE:COL");
+        for record in records {
+            eprintln!(
+                "{:>14}  {:>10}  {:>9}  {}",
+                format!("{:.3?}", record.total),
+                record.count,
+                format!("{}:{}", record.line, record.column),
+                record.expr
+            );
+        }
+    }
+
+    /// Drops files whose raw bytes cannot produce any grep output for a
+    /// selector-only query (see [`crate::search::Prefilter`]), so they are never
+    /// parsed or evaluated. Only applies to grep output — where files without
+    /// matches print nothing — and only to plain Markdown inputs, since other
+    /// input formats go through a module import that rewrites the query.
+    fn prefilter_files(
+        &self,
+        query: &str,
+        files: Vec<(Option<PathBuf>, ContentData)>,
+    ) -> Vec<(Option<PathBuf>, ContentData)> {
+        if !matches!(self.output.output_format, OutputFormat::Grep) || self.output.update {
+            return files;
+        }
+
+        match crate::search::Prefilter::from_query(query) {
+            Some(prefilter) => files
+                .into_iter()
+                .filter(|(file, content)| {
+                    file.is_none() || self.auto_query_prefix(file).is_some() || prefilter.may_match(content.as_bytes())
+                })
+                .collect(),
+            None => files,
+        }
+    }
+
     fn process_batch(&self) -> Result<(), miette::Error> {
         let query = self.get_query()?;
         let files = self.read_contents()?;
@@ -1161,11 +1285,10 @@ impl Cli {
             return self.execute_eval_all(&query, &files);
         }
 
-        if files.len() > self.parallel_threshold {
-            files.par_iter().try_for_each(|(file, content)| {
-                let mut engine = self.create_engine()?;
-                self.execute(&mut engine, &query, file, content)
-            })?;
+        let files = self.prefilter_files(&query, files);
+
+        if files.len() > self.parallel_threshold && !self.profile {
+            self.process_batch_parallel(&query, &files)?;
         } else {
             let mut engine = self.create_engine()?;
 
@@ -1181,11 +1304,114 @@ impl Cli {
                     .iter()
                     .try_for_each(|(file, content)| self.execute(&mut engine, &query, file, content))?;
             }
+
+            self.report_profile(&mut engine);
         }
 
         Ok(())
     }
 
+    /// Evaluates `files` across the rayon pool, buffering each file's rendered output so
+    /// results are written in input order regardless of which worker finishes first.
+    ///
+    /// `DefaultEngine` and `RuntimeValue` are reference-counted and cannot cross threads,
+    /// so each worker keeps its own engine and compiles the effective query once, reusing
+    /// the compiled program for every file it picks up instead of re-compiling per file.
+    /// On error the whole batch fails before anything is written.
+    fn process_batch_parallel(&self, query: &str, files: &[(Option<PathBuf>, ContentData)]) -> miette::Result<()> {
+        let outputs: Vec<Vec<u8>> = files
+            .par_iter()
+            .map_init(
+                || {
+                    self.create_engine()
+                        .map(|engine| (engine, None::<(String, mq_lang::CompiledProgram)>))
+                },
+                |state, (file, content)| {
+                    let (engine, compiled) = state.as_mut().map_err(|e| miette!("{}", e))?;
+                    let mut buf = Vec::new();
+                    self.execute_buffered(engine, compiled, query, file, content, &mut buf)?;
+                    Ok(buf)
+                },
+            )
+            .collect::<miette::Result<Vec<Vec<u8>>>>()?;
+
+        let stdout = io::stdout();
+        let mut handle: Box<dyn Write> = if let Some(output_file) = &self.output.output_file {
+            let file = fs::File::create(output_file).into_diagnostic()?;
+            Box::new(BufWriter::new(file))
+        } else if self.output.unbuffered {
+            Box::new(stdout.lock())
+        } else {
+            Box::new(BufWriter::new(stdout.lock()))
+        };
+
+        for output in &outputs {
+            Self::write_ignore_pipe(&mut handle, output)?;
+        }
+
+        if !self.output.unbuffered
+            && let Err(e) = handle.flush()
+            && e.kind() != std::io::ErrorKind::BrokenPipe
+        {
+            return Err(miette!(e));
+        }
+
+        Ok(())
+    }
+
+    /// Evaluates a single file with a per-worker compiled-program cache, rendering all
+    /// output into `handle` instead of stdout. `compiled` is reused across calls on the
+    /// same worker and only re-compiled when the effective query (query plus any
+    /// auto-import prefix) changes between files.
+    fn execute_buffered(
+        &self,
+        engine: &mut mq_lang::DefaultEngine,
+        compiled: &mut Option<(String, mq_lang::CompiledProgram)>,
+        query: &str,
+        file: &Option<PathBuf>,
+        content: &ContentData,
+        handle: &mut dyn Write,
+    ) -> miette::Result<()> {
+        let effective_query = self.effective_query(query, file);
+        let program = match compiled {
+            Some((source, program)) if *source == effective_query => program.clone(),
+            _ => {
+                let program = engine.compile(&effective_query).map_err(|e| *e)?;
+                *compiled = Some((effective_query, program.clone()));
+                program
+            }
+        };
+
+        if let Some(f) = file {
+            self.set_file_vars(engine, f);
+        }
+
+        let input = self.resolve_input(file, content)?;
+        let is_grep = matches!(self.output.output_format, OutputFormat::Grep);
+        let grep_input: Option<Vec<mq_lang::RuntimeValue>> = is_grep.then(|| input.clone());
+
+        let runtime_values = if self.output.update {
+            let results = engine
+                .eval_compiled(&program, input.clone().into_iter())
+                .map_err(|e| *e)?;
+            self.apply_update(input, results)?
+        } else {
+            engine.eval_compiled(&program, input.into_iter()).map_err(|e| *e)?
+        };
+
+        if let Some(separator) = &self.output.separator {
+            let separator = engine
+                .eval(
+                    separator,
+                    vec![mq_lang::RuntimeValue::String("".to_string())].into_iter(),
+                )
+                .map_err(|e| *e)?;
+            self.print_to(separator, handle)?;
+        }
+
+        self.emit_results_to(runtime_values, grep_input, file, handle)
+    }
+
     /// `__FILE__`-family vars aren't set here: no single file is "current" once combined.
     fn execute_eval_all(&self, query: &str, files: &[(Option<PathBuf>, ContentData)]) -> miette::Result<()> {
         if !self.all_files_same_prefix(files) {
@@ -1209,7 +1435,9 @@ impl Cli {
             .eval(&effective_query, combined_input.into_iter())
             .map_err(|e| *e)?;
 
-        self.emit_results(runtime_values, grep_input, &None)
+        let result = self.emit_results(runtime_values, grep_input, &None);
+        self.report_profile(&mut engine);
+        result
     }
 
     fn execute_compiled(
@@ -1239,6 +1467,117 @@ impl Cli {
         self.emit_results(runtime_values, grep_input, file)
     }
 
+    /// Runs the query once over every input file, then keeps the process warm:
+    /// compiled programs are reused for the whole session and a polling loop
+    /// re-parses and re-evaluates only files whose content actually changed.
+    /// Evaluation errors on a changed file are reported to stderr without ending
+    /// the session, since files are often saved mid-edit.
+    fn process_watch(&self) -> miette::Result<()> {
+        let query = self.get_query()?;
+        let files = self.read_contents()?;
+        let paths: Vec<PathBuf> = files.iter().filter_map(|(file, _)| file.clone()).collect();
+
+        if paths.is_empty() || paths.len() != files.len() {
+            return Err(miette!("--watch requires file inputs"));
+        }
+
+        let mut engine = self.create_engine()?;
+        // Compiled programs keyed by effective query: files with different
+        // auto-import prefixes (e.g. .md vs .json) compile to different
+        // programs, but each program is compiled exactly once per session.
+        let mut programs: Vec<(String, mq_lang::CompiledProgram)> = Vec::new();
+        // Last seen content per file, so mtime-only changes (editors re-touching
+        // files) skip parsing and evaluation entirely.
+        let mut contents: std::collections::HashMap<PathBuf, Vec<u8>> = std::collections::HashMap::new();
+
+        for (file, content) in &files {
+            self.execute_watched(&mut engine, &mut programs, &query, file, content, &mut contents)?;
+        }
+
+        eprintln!("mq: watching {} file(s); press Ctrl-C to stop", paths.len());
+
+        let mut mtimes: std::collections::HashMap<PathBuf, Option<std::time::SystemTime>> = paths
+            .iter()
+            .map(|path| (path.clone(), Self::modified_time(path)))
+            .collect();
+
+        loop {
+            std::thread::sleep(WATCH_POLL_INTERVAL);
+
+            for path in &paths {
+                let modified = Self::modified_time(path);
+                if mtimes.get(path) == Some(&modified) {
+                    continue;
+                }
+                mtimes.insert(path.clone(), modified);
+
+                // Plain reads rather than mmap: the file is being rewritten under
+                // us, and a remap per change would defeat the point anyway.
+                let content: ContentData = if self.needs_binary_read_for_file(path) {
+                    match fs::read(path) {
+                        Ok(bytes) => bytes.into(),
+                        // The file may be mid-rename (editors save via a temp
+                        // file); the next poll will pick it up.
+                        Err(_) => continue,
+                    }
+                } else {
+                    match fs::read_to_string(path) {
+                        Ok(text) => text.into(),
+                        Err(_) => continue,
+                    }
+                };
+
+                let started = std::time::Instant::now();
+                let file = Some(path.clone());
+                match self.execute_watched(&mut engine, &mut programs, &query, &file, &content, &mut contents) {
+                    Ok(true) => eprintln!("mq: re-evaluated {} in {:.1?}", path.display(), started.elapsed()),
+                    Ok(false) => {}
+                    Err(e) => eprintln!("mq: {}: {:?}", path.display(), e),
+                }
+            }
+        }
+    }
+
+    /// Evaluates one watched file with the session-wide compiled-program cache,
+    /// skipping files whose bytes are unchanged since the last evaluation.
+    /// Returns `Ok(true)` if the file was (re-)evaluated and `Ok(false)` if it
+    /// was skipped as unchanged.
+    fn execute_watched(
+        &self,
+        engine: &mut mq_lang::DefaultEngine,
+        programs: &mut Vec<(String, mq_lang::CompiledProgram)>,
+        query: &str,
+        file: &Option<PathBuf>,
+        content: &ContentData,
+        contents: &mut std::collections::HashMap<PathBuf, Vec<u8>>,
+    ) -> miette::Result<bool> {
+        let path = file.as_ref().ok_or_else(|| miette!("--watch requires file inputs"))?;
+
+        if contents.get(path).is_some_and(|last| last == content.as_bytes()) {
+            return Ok(false);
+        }
+
+        let effective = self.effective_query(query, file);
+        let program = match programs.iter().find(|(compiled_for, _)| *compiled_for == effective) {
+            Some((_, program)) => program.clone(),
+            None => {
+                let program = engine.compile(&effective).map_err(|e| *e)?;
+                programs.push((effective, program.clone()));
+                program
+            }
+        };
+
+        contents.insert(path.clone(), content.as_bytes().to_vec());
+        self.execute_compiled(engine, &program, file, content)?;
+        Ok(true)
+    }
+
+    /// Returns the last modification time of `path`, or `None` if the file is
+    /// currently unreadable (e.g. mid-rename during an editor save).
+    fn modified_time(path: &Path) -> Option<std::time::SystemTime> {
+        fs::metadata(path).and_then(|metadata| metadata.modified()).ok()
+    }
+
     fn count_file(
         &self,
         engine: &mut mq_lang::DefaultEngine,
@@ -1302,6 +1641,8 @@ impl Cli {
             return Err(miette!(e));
         }
 
+        self.report_profile(&mut engine);
+
         Ok(())
     }
 
@@ -1314,35 +1655,74 @@ impl Cli {
         let query = self.get_query()?;
         let mut engine = self.create_engine()?;
 
-        self.process_lines(|file, line| self.execute(&mut engine, &query, &file.cloned(), &line.into()))
+        // If files are specified, stream each file; otherwise stream stdin.
+        let result = if let Some(files) = &self.files {
+            files.iter().try_for_each(|file| {
+                let file_handle = fs::File::open(file).into_diagnostic()?;
+                self.stream_source(&mut engine, &query, Some(file), io::BufReader::new(file_handle))
+            })
+        } else {
+            let stdin = io::stdin();
+            self.stream_source(&mut engine, &query, None, io::BufReader::new(stdin.lock()))
+        };
+
+        self.report_profile(&mut engine);
+        result
     }
 
-    fn process_lines<F>(&self, mut process: F) -> miette::Result<()>
-    where
-        F: FnMut(Option<&PathBuf>, String) -> miette::Result<()>,
-    {
-        // If files are specified, process each file line by line
-        if let Some(files) = &self.files {
-            for file in files {
-                let file_handle = fs::File::open(file).into_diagnostic()?;
-                let reader = io::BufReader::new(file_handle);
-                for line_result in reader.lines() {
-                    let line = line_result.into_diagnostic()?;
-                    process(Some(file), line)?;
+    /// Streams one input source, evaluating and emitting results incrementally so
+    /// memory stays bounded regardless of input size.
+    ///
+    /// Markdown/MDX input is split into complete top-level blocks (fence-aware, via
+    /// [`mq_markdown::MarkdownBlockSplitter`]) so multi-line constructs like fenced
+    /// code survive streaming; other text formats are processed line by line.
+    fn stream_source<R: BufRead>(
+        &self,
+        engine: &mut mq_lang::DefaultEngine,
+        query: &str,
+        file: Option<&PathBuf>,
+        reader: R,
+    ) -> miette::Result<()> {
+        let file = file.cloned();
+
+        if self.stream_as_markdown_blocks(&file) {
+            let mut splitter = mq_markdown::MarkdownBlockSplitter::new();
+            for line_result in reader.lines() {
+                let line = line_result.into_diagnostic()?;
+                if let Some(block) = splitter.push_line(&line) {
+                    self.execute(engine, query, &file, &block.into())?;
                 }
             }
+            if let Some(block) = splitter.finish() {
+                self.execute(engine, query, &file, &block.into())?;
+            }
         } else {
-            // Otherwise, process stdin line by line
-            let stdin = io::stdin();
-            let reader = io::BufReader::new(stdin.lock());
             for line_result in reader.lines() {
                 let line = line_result.into_diagnostic()?;
-                process(None, line)?;
+                self.execute(engine, query, &file, &line.into())?;
             }
         }
+
         Ok(())
     }
 
+    /// Returns `true` if streaming input for `file` should be split into Markdown
+    /// blocks rather than lines, mirroring the format detection in `resolve_input`.
+    fn stream_as_markdown_blocks(&self, file: &Option<PathBuf>) -> bool {
+        match &self.input.input_format {
+            Some(InputFormat::Markdown) | Some(InputFormat::Mdx) => true,
+            Some(_) => false,
+            None => match file {
+                Some(file) => matches!(
+                    InputFormat::from_extension(&file.extension().unwrap_or_default().to_string_lossy()),
+                    InputFormat::Markdown | InputFormat::Mdx
+                ),
+                // Piped stdin defaults to Markdown in `resolve_input`.
+                None => !io::stdin().is_terminal(),
+            },
+        }
+    }
+
     fn is_binary_format(&self) -> bool {
         matches!(
             self.input.input_format,
@@ -1361,6 +1741,35 @@ impl Cli {
             })
     }
 
+    /// Memory-maps `file` for zero-copy input (`--mmap`).
+    ///
+    /// Empty files are read normally since zero-length mappings are rejected on some
+    /// platforms. Text-format files are validated as UTF-8 up front so that later
+    /// [`ContentData::as_str`] access cannot fail, mirroring `fs::read_to_string`.
+    fn map_file(&self, file: &Path) -> miette::Result<ContentData> {
+        let handle = fs::File::open(file).into_diagnostic()?;
+        let len = handle.metadata().into_diagnostic()?.len();
+
+        if len == 0 {
+            return if self.needs_binary_read_for_file(file) {
+                fs::read(file).map(Into::into).into_diagnostic()
+            } else {
+                fs::read_to_string(file).map(Into::into).into_diagnostic()
+            };
+        }
+
+        // SAFETY: the mapping is read-only and mq never writes to its input files. The
+        // documented hazard (the underlying file being truncated by another process while
+        // mapped) is outside our control, just as concurrent modification is for `fs::read`.
+        let mmap = unsafe { memmap2::Mmap::map(&handle).into_diagnostic()? };
+
+        if !self.needs_binary_read_for_file(file) && std::str::from_utf8(&mmap).is_err() {
+            return Err(miette!("Invalid UTF-8 in file: {}", file.display()));
+        }
+
+        Ok(ContentData::Mapped(mmap))
+    }
+
     fn read_contents(&self) -> miette::Result<Vec<(Option<PathBuf>, ContentData)>> {
         if matches!(self.input.input_format, Some(InputFormat::Null)) {
             return Ok(vec![(None, ContentData::empty())]);
@@ -1369,10 +1778,13 @@ impl Cli {
         self.files
             .clone()
             .map(|files| {
+                let files = crate::search::expand_directories(files)?;
                 let load_contents: miette::Result<Vec<ContentData>> = files
                     .iter()
                     .map(|file| {
-                        if self.needs_binary_read_for_file(file) {
+                        if self.input.mmap {
+                            self.map_file(file)
+                        } else if self.needs_binary_read_for_file(file) {
                             fs::read(file).map(Into::into).into_diagnostic()
                         } else {
                             fs::read_to_string(file).map(Into::into).into_diagnostic()
@@ -1418,6 +1830,31 @@ impl Cli {
         }
     }
 
+    /// Writer adapter that turns `BrokenPipe` into a successful no-op, matching
+    /// [`Self::write_ignore_pipe`] for the streaming output paths that write
+    /// directly to the handle instead of going through a rendered `String`.
+    fn ignore_pipe(handle: &mut dyn Write) -> impl Write + '_ {
+        struct IgnorePipe<'a>(&'a mut dyn Write);
+
+        impl Write for IgnorePipe<'_> {
+            fn write(&mut self, buf: &[u8]) -> io::Result<usize> {
+                match self.0.write(buf) {
+                    Err(e) if e.kind() == io::ErrorKind::BrokenPipe => Ok(buf.len()),
+                    result => result,
+                }
+            }
+
+            fn flush(&mut self) -> io::Result<()> {
+                match self.0.flush() {
+                    Err(e) if e.kind() == io::ErrorKind::BrokenPipe => Ok(()),
+                    result => result,
+                }
+            }
+        }
+
+        IgnorePipe(handle)
+    }
+
     /// Recursively collects Markdown nodes from a `RuntimeValue`.
     ///
     /// Flattens nested `Array` values so that any Markdown nodes contained
@@ -1435,7 +1872,7 @@ impl Cli {
     }
 
     /// Returns `true` if the dict is a known expandable typed dict (has `type: :symbol`).
-    fn is_typed_dict(map: &std::collections::BTreeMap<mq_lang::Ident, mq_lang::RuntimeValue>) -> bool {
+    fn is_typed_dict(map: &mq_lang::Dict) -> bool {
         let type_key = mq_lang::Ident::new("type");
         matches!(
             map.get(&type_key),
@@ -1447,9 +1884,7 @@ impl Cli {
     ///
     /// Returns `None` if the dict is not a known expandable type.
     /// To add support for a new type, add a match arm for the type name.
-    fn expand_typed_dict(
-        map: &std::collections::BTreeMap<mq_lang::Ident, mq_lang::RuntimeValue>,
-    ) -> Option<Vec<mq_markdown::Node>> {
+    fn expand_typed_dict(map: &mq_lang::Dict) -> Option<Vec<mq_markdown::Node>> {
         let type_key = mq_lang::Ident::new("type");
         match map.get(&type_key) {
             Some(mq_lang::RuntimeValue::Symbol(s)) => match s.as_str().as_str() {
@@ -1552,6 +1987,23 @@ impl Cli {
         } else {
             Box::new(BufWriter::new(stdout.lock()))
         };
+
+        self.print_to(runtime_values, &mut handle)?;
+
+        if !self.output.unbuffered
+            && let Err(e) = handle.flush()
+            && e.kind() != std::io::ErrorKind::BrokenPipe
+        {
+            return Err(miette!(e));
+        }
+
+        Ok(())
+    }
+
+    /// Variant of [`Self::print`] that writes to a caller-provided writer instead of opening
+    /// stdout or the output file. Used by the parallel batch path, where each worker renders
+    /// into an in-memory buffer that is written out in input order afterwards.
+    fn print_to(&self, runtime_values: mq_lang::RuntimeValues, mut handle: &mut dyn Write) -> miette::Result<()> {
         let runtime_values = runtime_values.values();
 
         // Track truthy output for --exit-status.
@@ -1570,8 +2022,8 @@ impl Cli {
             }
             OutputFormat::Json => {
                 let theme = (self.output.color_output && !Self::is_no_color()).then(mq_markdown::ColorTheme::from_env);
-                let json_str = crate::output::json::runtime_values_to_json(runtime_values, theme.as_ref())?;
-                Self::write_ignore_pipe(&mut handle, json_str.as_bytes())?;
+                let mut out = Self::ignore_pipe(handle);
+                crate::output::json::write_runtime_values_as_json(runtime_values, theme.as_ref(), &mut out)?;
             }
             OutputFormat::Html => {
                 let markdown = self.build_markdown(runtime_values);
@@ -1600,31 +2052,24 @@ impl Cli {
                 Self::write_ignore_pipe(&mut handle, markdown.to_string().as_bytes())?;
             }
             OutputFormat::Csv => {
-                let csv_str = crate::output::csv::runtime_values_to_csv(runtime_values)?;
-                Self::write_ignore_pipe(&mut handle, csv_str.as_bytes())?;
+                let mut out = Self::ignore_pipe(handle);
+                crate::output::csv::write_runtime_values_as_csv(runtime_values, &mut out)?;
             }
             OutputFormat::Toml => {
                 let toml_str = crate::output::toml::runtime_values_to_toml(runtime_values)?;
                 Self::write_ignore_pipe(&mut handle, toml_str.as_bytes())?;
             }
             OutputFormat::Xml => {
-                let xml_str = crate::output::xml::runtime_values_to_xml(runtime_values)?;
-                Self::write_ignore_pipe(&mut handle, xml_str.as_bytes())?;
+                let mut out = Self::ignore_pipe(handle);
+                crate::output::xml::write_runtime_values_as_xml(runtime_values, &mut out)?;
             }
             OutputFormat::Yaml => {
-                let yaml_str = crate::output::yaml::runtime_values_to_yaml(runtime_values)?;
-                Self::write_ignore_pipe(&mut handle, yaml_str.as_bytes())?;
+                let mut out = Self::ignore_pipe(handle);
+                crate::output::yaml::write_runtime_values_as_yaml(runtime_values, &mut out)?;
             }
             OutputFormat::None => {}
         }
 
-        if !self.output.unbuffered
-            && let Err(e) = handle.flush()
-            && e.kind() != std::io::ErrorKind::BrokenPipe
-        {
-            return Err(miette!(e));
-        }
-
         Ok(())
     }
 }
@@ -1733,6 +2178,24 @@ mod tests {
         assert!(cli.run().is_err());
     }
 
+    #[test]
+    fn test_profile_runs_query_successfully() {
+        let cli = Cli {
+            input: InputArgs {
+                input_format: Some(InputFormat::Null),
+                ..Default::default()
+            },
+            output: OutputArgs::default(),
+            commands: None,
+            query: Some("1 + 1".to_string()),
+            files: None,
+            profile: true,
+            ..Cli::default()
+        };
+
+        assert!(cli.run().is_ok());
+    }
+
     #[test]
     fn test_timeout_aborts_infinite_loop() {
         let cli = Cli {
@@ -3013,6 +3476,122 @@ mod tests {
         assert!(cli.run().is_ok());
     }
 
+    #[test]
+    fn test_stream_markdown_blocks_keep_fences_intact() {
+        let (_, temp_file_path) = create_file("test_stream_blocks.md", "# Title\n\n```sh\necho hi\n\necho bye\n```");
+        let output_file = std::env::temp_dir().join("test_stream_blocks_output.md");
+
+        let temp_file_path_clone = temp_file_path.clone();
+        let output_file_clone = output_file.clone();
+        defer! {
+            if temp_file_path_clone.exists() {
+                std::fs::remove_file(&temp_file_path_clone).ok();
+            }
+            if output_file_clone.exists() {
+                std::fs::remove_file(&output_file_clone).ok();
+            }
+        }
+
+        let cli = Cli {
+            input: InputArgs {
+                stream: true,
+                ..Default::default()
+            },
+            output: OutputArgs {
+                output_file: Some(output_file.clone()),
+                ..Default::default()
+            },
+            commands: None,
+            query: Some(".code".to_string()),
+            files: Some(vec![temp_file_path]),
+            ..Cli::default()
+        };
+
+        assert!(cli.run().is_ok());
+
+        let output = std::fs::read_to_string(&output_file).expect("Failed to read output file");
+        assert!(
+            output.contains("echo hi") && output.contains("echo bye"),
+            "fenced code spanning blank lines must be streamed as one block, got: {output:?}"
+        );
+    }
+
+    #[rstest]
+    #[case::markdown("test_mmap_input.md", "# Mapped Heading")]
+    #[case::empty("test_mmap_empty.md", "")]
+    fn test_mmap_input(#[case] name: &str, #[case] content: &str) {
+        let (_, temp_file_path) = create_file(name, content);
+        let temp_file_path_clone = temp_file_path.clone();
+
+        defer! {
+            if temp_file_path_clone.exists() {
+                std::fs::remove_file(&temp_file_path_clone).ok();
+            }
+        }
+
+        let cli = Cli {
+            input: InputArgs {
+                mmap: true,
+                ..Default::default()
+            },
+            output: OutputArgs::default(),
+            commands: None,
+            query: Some("self".to_string()),
+            files: Some(vec![temp_file_path]),
+            ..Cli::default()
+        };
+
+        assert!(cli.run().is_ok());
+    }
+
+    #[test]
+    fn test_parallel_output_preserves_input_order() {
+        let files: Vec<PathBuf> = (0..15)
+            .map(|i| {
+                let (_, path) = create_file(&format!("test_parallel_order_{}.md", i), &format!("# Heading {}", i));
+                path
+            })
+            .collect();
+        let output_file = std::env::temp_dir().join("test_parallel_order_output.md");
+
+        let files_clone = files.clone();
+        let output_file_clone = output_file.clone();
+        defer! {
+            for file in &files_clone {
+                if file.exists() {
+                    std::fs::remove_file(file).ok();
+                }
+            }
+            if output_file_clone.exists() {
+                std::fs::remove_file(&output_file_clone).ok();
+            }
+        }
+
+        let cli = Cli {
+            input: InputArgs::default(),
+            output: OutputArgs {
+                output_file: Some(output_file.clone()),
+                ..Default::default()
+            },
+            commands: None,
+            query: Some("self".to_string()),
+            files: Some(files),
+            parallel_threshold: 10,
+            ..Cli::default()
+        };
+
+        assert!(cli.run().is_ok());
+
+        let output = std::fs::read_to_string(&output_file).expect("Failed to read output file");
+        let headings: Vec<String> = output
+            .lines()
+            .filter(|line| !line.is_empty())
+            .map(String::from)
+            .collect();
+        let expected: Vec<String> = (0..15).map(|i| format!("# Heading {}", i)).collect();
+        assert_eq!(headings, expected, "parallel output must follow input file order");
+    }
+
     #[rstest]
     #[case("mq-exec-owner", 0o700, true)]
     #[case("mq-exec-group", 0o010, true)]
@@ -3854,9 +4433,8 @@ mod tests {
 
         assert!(cli.run().is_ok());
         let result = fs::read_to_string(&output_file).expect("Failed to read output");
-        // `named` is backed by a `BTreeMap<Ident, _>`, whose key order depends on the
-        // global string interner's symbol assignment order rather than the key text,
-        // so compare parsed JSON values instead of the raw serialized string.
+        // Compare parsed JSON values so the test doesn't depend on the order the
+        // --args/--argjson flags happen to insert the `named` dict keys in.
         let actual: serde_json::Value = serde_json::from_str(result.trim()).expect("output should be valid JSON");
         let expected: serde_json::Value = serde_json::from_str(r#"{"count": 42, "name": "Alice"}"#).unwrap();
         assert_eq!(actual, expected);
@@ -636,14 +636,14 @@ mod tests {
                 name: None,
                 code: "a\nb\nc\nd\ne\nf\ng\nh\ni\nj".to_string(),
             },
-            token: Shared::new(mq_lang::Token {
+            token: mq_lang::Token {
                 range: mq_lang::Range {
                     start: mq_lang::Position { line: 4, column: 0 },
                     end: mq_lang::Position { line: 4, column: 1 },
                 },
                 kind: mq_lang::TokenKind::Eof,
                 module_id: ModuleId::new(0),
-            }),
+            },
             ..Default::default()
         };
         let handler = DebuggerHandler::new(mq_lang::DefaultEngine::default());
@@ -33,6 +33,30 @@ pub(crate) fn print_grep(
         Box::new(BufWriter::new(stdout.lock()))
     };
 
+    print_grep_to(runtime_values, original_input, file, &mut handle, before, after)?;
+
+    if !unbuffered
+        && let Err(e) = handle.flush()
+        && e.kind() != std::io::ErrorKind::BrokenPipe
+    {
+        return Err(miette!(e));
+    }
+
+    Ok(())
+}
+
+/// Prints query results in grep-like format to a caller-provided writer.
+///
+/// Used by the parallel batch path in the CLI, where each worker renders into an
+/// in-memory buffer so that per-file output can be written out in input order.
+pub(crate) fn print_grep_to(
+    runtime_values: mq_lang::RuntimeValues,
+    original_input: &[mq_lang::RuntimeValue],
+    file: &Option<PathBuf>,
+    mut handle: &mut dyn Write,
+    before: usize,
+    after: usize,
+) -> miette::Result<()> {
     let filename = file.as_ref().map(|p| p.to_string_lossy().into_owned());
 
     // Collect start lines of matched nodes for quick lookup.
@@ -113,13 +137,6 @@ pub(crate) fn print_grep(
         }
     }
 
-    if !unbuffered
-        && let Err(e) = handle.flush()
-        && e.kind() != std::io::ErrorKind::BrokenPipe
-    {
-        return Err(miette!(e));
-    }
-
     Ok(())
 }
 
@@ -216,7 +233,6 @@ fn flatten(value: &mq_lang::RuntimeValue) -> Vec<(String, mq_lang::RuntimeValue)
 mod tests {
     use super::*;
     use rstest::rstest;
-    use std::collections::BTreeMap;
 
     #[rstest]
     #[case::with_filename_and_line(Some("file.md".to_string()), Some(5), "## Heading", ":", "file.md:5:## Heading\n")]
@@ -280,7 +296,7 @@ mod tests {
 
     #[test]
     fn test_flatten_flat_dict() {
-        let mut m = BTreeMap::new();
+        let mut m = mq_lang::Dict::default();
         m.insert(
             mq_lang::Ident::new("key"),
             mq_lang::RuntimeValue::String("val".to_string()),
@@ -293,12 +309,12 @@ mod tests {
 
     #[test]
     fn test_flatten_nested_dict() {
-        let mut inner = BTreeMap::new();
+        let mut inner = mq_lang::Dict::default();
         inner.insert(
             mq_lang::Ident::new("b"),
             mq_lang::RuntimeValue::String("deep".to_string()),
         );
-        let mut outer = BTreeMap::new();
+        let mut outer = mq_lang::Dict::default();
         outer.insert(
             mq_lang::Ident::new("a"),
             mq_lang::RuntimeValue::Dict(Shared::new(inner)),
@@ -312,7 +328,7 @@ mod tests {
     #[test]
     fn test_flatten_dict_with_array() {
         // dict["key"][0] → "key[0]"
-        let mut m = BTreeMap::new();
+        let mut m = mq_lang::Dict::default();
         m.insert(
             mq_lang::Ident::new("key"),
             mq_lang::RuntimeValue::Array(Shared::new(vec![mq_lang::RuntimeValue::String("val".to_string())])),
@@ -326,7 +342,7 @@ mod tests {
     #[test]
     fn test_flatten_array_with_dict() {
         // [0].key → "[0].key"
-        let mut m = BTreeMap::new();
+        let mut m = mq_lang::Dict::default();
         m.insert(
             mq_lang::Ident::new("b"),
             mq_lang::RuntimeValue::String("val".to_string()),
@@ -365,7 +381,7 @@ mod tests {
 
     #[test]
     fn test_to_nodes_dict() {
-        let mut m = BTreeMap::new();
+        let mut m = mq_lang::Dict::default();
         m.insert(
             mq_lang::Ident::new("key"),
             mq_lang::RuntimeValue::String("val".to_string()),
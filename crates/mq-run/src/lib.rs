@@ -46,6 +46,7 @@ pub mod cli;
 pub(crate) mod grep;
 pub(crate) mod output;
 pub(crate) mod reference;
+pub(crate) mod search;
 
 #[cfg(feature = "debugger")]
 pub mod debugger;
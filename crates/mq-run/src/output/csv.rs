@@ -21,8 +21,14 @@ fn cell_value(value: &RuntimeValue) -> String {
     }
 }
 
-/// Converts a list of [`RuntimeValue`]s into a CSV string.
-pub(crate) fn runtime_values_to_csv(runtime_values: &[RuntimeValue]) -> miette::Result<String> {
+/// Writes the CSV rendering of `runtime_values` to `out`, streaming records as
+/// they are produced instead of buffering the whole document, so output memory is
+/// bounded by a single record. The header pass over dict keys only collects key
+/// names, not rendered cells.
+pub(crate) fn write_runtime_values_as_csv(
+    runtime_values: &[RuntimeValue],
+    out: &mut dyn std::io::Write,
+) -> miette::Result<()> {
     let non_none: Vec<&RuntimeValue> = runtime_values.iter().filter(|v| !v.is_none()).collect();
 
     // unwrap a single top-level Array, matching table.rs's behavior
@@ -33,7 +39,7 @@ pub(crate) fn runtime_values_to_csv(runtime_values: &[RuntimeValue]) -> miette::
     };
     let candidates: &[&RuntimeValue] = expanded.as_deref().unwrap_or(&non_none);
 
-    let mut writer = csv::WriterBuilder::new().from_writer(vec![]);
+    let mut writer = csv::WriterBuilder::new().from_writer(out);
 
     let all_dicts = !candidates.is_empty() && candidates.iter().all(|v| matches!(*v, RuntimeValue::Dict(_)));
     let all_arrays = !candidates.is_empty() && candidates.iter().all(|v| matches!(*v, RuntimeValue::Array(_)));
@@ -79,20 +85,25 @@ pub(crate) fn runtime_values_to_csv(runtime_values: &[RuntimeValue]) -> miette::
         }
     }
 
-    let bytes = writer.into_inner().map_err(|e| miette!("Failed to write CSV: {}", e))?;
-    String::from_utf8(bytes).map_err(|e| miette!("Failed to convert CSV output to UTF-8: {}", e))
+    writer.flush().map_err(|e| miette!("Failed to write CSV: {}", e))
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
 
+    fn runtime_values_to_csv(runtime_values: &[RuntimeValue]) -> miette::Result<String> {
+        let mut buf = Vec::new();
+        write_runtime_values_as_csv(runtime_values, &mut buf)?;
+        String::from_utf8(buf).map_err(|e| miette!("Failed to convert CSV output to UTF-8: {}", e))
+    }
+
     #[test]
     fn test_array_of_dicts() {
-        let mut m1 = std::collections::BTreeMap::new();
+        let mut m1 = mq_lang::Dict::default();
         m1.insert(mq_lang::Ident::new("name"), RuntimeValue::String("Alice".to_string()));
         m1.insert(mq_lang::Ident::new("age"), RuntimeValue::String("30".to_string()));
-        let mut m2 = std::collections::BTreeMap::new();
+        let mut m2 = mq_lang::Dict::default();
         m2.insert(mq_lang::Ident::new("name"), RuntimeValue::String("Bob".to_string()));
         m2.insert(mq_lang::Ident::new("age"), RuntimeValue::String("25".to_string()));
         let values = vec![RuntimeValue::Array(Shared::new(vec![
@@ -105,7 +116,7 @@ mod tests {
 
     #[test]
     fn test_single_dict() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("a"), RuntimeValue::String("1".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let result = runtime_values_to_csv(&values).unwrap();
@@ -114,7 +125,7 @@ mod tests {
 
     #[test]
     fn test_needs_quoting() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("a"), RuntimeValue::String("has,comma".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let result = runtime_values_to_csv(&values).unwrap();
@@ -133,10 +144,10 @@ mod tests {
 
     #[test]
     fn test_missing_key_is_empty() {
-        let mut m1 = std::collections::BTreeMap::new();
+        let mut m1 = mq_lang::Dict::default();
         m1.insert(mq_lang::Ident::new("a"), RuntimeValue::String("1".to_string()));
         m1.insert(mq_lang::Ident::new("b"), RuntimeValue::String("2".to_string()));
-        let mut m2 = std::collections::BTreeMap::new();
+        let mut m2 = mq_lang::Dict::default();
         m2.insert(mq_lang::Ident::new("a"), RuntimeValue::String("3".to_string()));
         let values = vec![RuntimeValue::Array(Shared::new(vec![
             RuntimeValue::Dict(Shared::new(m1)),
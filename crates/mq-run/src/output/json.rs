@@ -56,10 +56,10 @@ fn colorize_json_value(value: &serde_json::Value, indent: usize, theme: &ColorTh
     }
 }
 
-/// Merges a list of [`mq_lang::RuntimeValue`]s into a single [`serde_json::Value`].
-/// A lone non-Markdown value is returned as-is; otherwise all values (with empty
-/// Markdown nodes filtered out) are collected into a JSON array.
-pub(crate) fn runtime_values_to_json_value(runtime_values: &[mq_lang::RuntimeValue]) -> serde_json::Value {
+/// Filters out empty Markdown nodes (which render to nothing) and reports whether the
+/// remaining values are all Markdown, in which case the document is always an array.
+/// Shared by the JSON/YAML/XML writers so they agree on the document shape.
+pub(crate) fn structured_values(runtime_values: &[mq_lang::RuntimeValue]) -> (Vec<&mq_lang::RuntimeValue>, bool) {
     let filtered: Vec<&mq_lang::RuntimeValue> = runtime_values
         .iter()
         .filter(|v| match v {
@@ -72,34 +72,87 @@ pub(crate) fn runtime_values_to_json_value(runtime_values: &[mq_lang::RuntimeVal
         .iter()
         .all(|v| matches!(v, mq_lang::RuntimeValue::Markdown(_, _)));
 
+    (filtered, all_markdown)
+}
+
+/// Converts a single [`mq_lang::RuntimeValue`] into a [`serde_json::Value`]. Markdown
+/// nodes use their serde representation; everything else goes through `to_json_value`.
+pub(crate) fn runtime_value_to_json_value(value: &mq_lang::RuntimeValue) -> serde_json::Value {
+    match value {
+        mq_lang::RuntimeValue::Markdown(node, _) => {
+            serde_json::to_value(node.as_ref()).unwrap_or(serde_json::Value::Null)
+        }
+        _ => value.clone().to_json_value(),
+    }
+}
+
+/// Merges a list of [`mq_lang::RuntimeValue`]s into a single [`serde_json::Value`].
+/// A lone non-Markdown value is returned as-is; otherwise all values (with empty
+/// Markdown nodes filtered out) are collected into a JSON array.
+pub(crate) fn runtime_values_to_json_value(runtime_values: &[mq_lang::RuntimeValue]) -> serde_json::Value {
+    let (filtered, all_markdown) = structured_values(runtime_values);
+
     if !all_markdown && filtered.len() == 1 {
         filtered[0].clone().to_json_value()
     } else {
-        let json_values: Vec<serde_json::Value> = filtered
-            .iter()
-            .map(|v| match v {
-                mq_lang::RuntimeValue::Markdown(node, _) => {
-                    serde_json::to_value(node.as_ref()).unwrap_or(serde_json::Value::Null)
-                }
-                _ => (*v).clone().to_json_value(),
-            })
-            .collect();
-        serde_json::Value::Array(json_values)
+        serde_json::Value::Array(filtered.iter().map(|v| runtime_value_to_json_value(v)).collect())
     }
 }
 
-/// Converts a list of [`mq_lang::RuntimeValue`]s into a JSON string.
-/// Pass `Some(theme)` to enable ANSI color output.
-pub(crate) fn runtime_values_to_json(
+/// Writes the JSON rendering of `runtime_values` to `out`, serializing each value
+/// as it is rendered instead of materializing the whole document, so output memory is
+/// bounded by the largest single value rather than the full result set. The output is
+/// byte-identical to pretty-printing the whole result at once.
+pub(crate) fn write_runtime_values_as_json(
     runtime_values: &[mq_lang::RuntimeValue],
     theme: Option<&ColorTheme<'_>>,
-) -> miette::Result<String> {
-    let result = runtime_values_to_json_value(runtime_values);
+    out: &mut dyn std::io::Write,
+) -> miette::Result<()> {
+    let write_err = |e: std::io::Error| miette!("Failed to write JSON: {}", e);
+    let ser_err = |e: serde_json::Error| miette!("Failed to serialize to JSON: {}", e);
+    let (filtered, all_markdown) = structured_values(runtime_values);
 
-    if let Some(theme) = theme {
-        Ok(colorize_json_value(&result, 0, theme))
+    if !all_markdown && filtered.len() == 1 {
+        let value = filtered[0].clone().to_json_value();
+        if let Some(theme) = theme {
+            out.write_all(colorize_json_value(&value, 0, theme).as_bytes())
+                .map_err(write_err)
+        } else {
+            serde_json::to_writer_pretty(&mut *out, &value).map_err(ser_err)
+        }
+    } else if filtered.is_empty() {
+        out.write_all(b"[]").map_err(write_err)
     } else {
-        serde_json::to_string_pretty(&result).map_err(|e| miette!("Failed to serialize to JSON: {}", e))
+        out.write_all(b"[\n").map_err(write_err)?;
+        let mut buf = Vec::new();
+        for (i, value) in filtered.iter().enumerate() {
+            if i > 0 {
+                out.write_all(b",\n").map_err(write_err)?;
+            }
+            let json_value = runtime_value_to_json_value(value);
+            if let Some(theme) = theme {
+                // `colorize_json_value` already indents nested lines to their absolute
+                // depth, so only the first line needs the array-item indent.
+                out.write_all(b"  ").map_err(write_err)?;
+                out.write_all(colorize_json_value(&json_value, 1, theme).as_bytes())
+                    .map_err(write_err)?;
+            } else {
+                // Re-indent the standalone rendering by one level so the result is
+                // byte-identical to pretty-printing the whole array at once.
+                buf.clear();
+                serde_json::to_writer_pretty(&mut buf, &json_value).map_err(ser_err)?;
+                let rendered =
+                    std::str::from_utf8(&buf).map_err(|e| miette!("Failed to convert JSON output to UTF-8: {}", e))?;
+                for (j, line) in rendered.lines().enumerate() {
+                    if j > 0 {
+                        out.write_all(b"\n").map_err(write_err)?;
+                    }
+                    out.write_all(b"  ").map_err(write_err)?;
+                    out.write_all(line.as_bytes()).map_err(write_err)?;
+                }
+            }
+        }
+        out.write_all(b"\n]").map_err(write_err)
     }
 }
 
@@ -109,6 +162,15 @@ mod tests {
     use mq_lang::RuntimeValue;
     use rstest::rstest;
 
+    fn runtime_values_to_json(
+        runtime_values: &[mq_lang::RuntimeValue],
+        theme: Option<&ColorTheme<'_>>,
+    ) -> miette::Result<String> {
+        let mut buf = Vec::new();
+        write_runtime_values_as_json(runtime_values, theme, &mut buf)?;
+        String::from_utf8(buf).map_err(|e| miette!("Failed to convert JSON output to UTF-8: {}", e))
+    }
+
     fn plain_theme() -> ColorTheme<'static> {
         ColorTheme::PLAIN
     }
@@ -201,15 +263,33 @@ mod tests {
     #[test]
     fn test_colorize_object_empty() {
         let theme = plain_theme();
-        let values = vec![RuntimeValue::Dict(Shared::new(std::collections::BTreeMap::new()))];
+        let values = vec![RuntimeValue::Dict(Shared::new(mq_lang::Dict::default()))];
         let result = runtime_values_to_json(&values, Some(&theme)).unwrap();
         assert_eq!(result, "{}");
     }
 
+    #[test]
+    fn test_streaming_matches_whole_document_pretty() {
+        let mut map = mq_lang::Dict::default();
+        map.insert(mq_lang::Ident::new("key"), RuntimeValue::String("val".to_string()));
+        let values = vec![
+            RuntimeValue::String("a".to_string()),
+            RuntimeValue::Dict(Shared::new(map)),
+            RuntimeValue::Array(Shared::new(vec![
+                RuntimeValue::from(1usize),
+                RuntimeValue::from(2usize),
+            ])),
+            RuntimeValue::None,
+        ];
+        let streamed = runtime_values_to_json(&values, None).unwrap();
+        let whole = serde_json::to_string_pretty(&runtime_values_to_json_value(&values)).unwrap();
+        assert_eq!(streamed, whole);
+    }
+
     #[test]
     fn test_colorize_object_non_empty() {
         let theme = plain_theme();
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("key"), RuntimeValue::String("val".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let result = runtime_values_to_json(&values, Some(&theme)).unwrap();
@@ -9,7 +9,7 @@
 use mq_lang::RuntimeValue;
 use mq_lang::Shared;
 use mq_markdown::ColorTheme;
-use std::collections::{BTreeMap, BTreeSet};
+use std::collections::BTreeSet;
 use tabled::Table;
 use tabled::builder::Builder;
 use tabled::settings::location::Locator;
@@ -82,15 +82,15 @@ pub(crate) fn runtime_values_to_table<'a>(runtime_values: &[RuntimeValue], theme
                     rows.push(vec!["children".to_string(), children_str]);
                 }
                 if let Some(pos) = node.position() {
-                    let mut start_map = BTreeMap::new();
+                    let mut start_map = mq_lang::Dict::default();
                     start_map.insert(mq_lang::Ident::new("line"), pos.start.line.to_string().into());
                     start_map.insert(mq_lang::Ident::new("column"), pos.start.column.to_string().into());
 
-                    let mut end_map = BTreeMap::new();
+                    let mut end_map = mq_lang::Dict::default();
                     end_map.insert(mq_lang::Ident::new("line"), pos.end.line.to_string().into());
                     end_map.insert(mq_lang::Ident::new("column"), pos.end.column.to_string().into());
 
-                    let mut pos_map = BTreeMap::new();
+                    let mut pos_map = mq_lang::Dict::default();
                     pos_map.insert(mq_lang::Ident::new("start"), RuntimeValue::Dict(Shared::new(start_map)));
                     pos_map.insert(mq_lang::Ident::new("end"), RuntimeValue::Dict(Shared::new(end_map)));
                     let pos_str = format_cell_value(&RuntimeValue::Dict(Shared::new(pos_map)), theme);
@@ -279,7 +279,7 @@ mod tests {
 
     #[test]
     fn test_table_dict_values() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("name"), RuntimeValue::String("Alice".to_string()));
         map.insert(mq_lang::Ident::new("age"), RuntimeValue::String("30".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
@@ -292,9 +292,9 @@ mod tests {
     #[test]
     fn test_table_multiple_dicts() {
         let make_dict = |name: &str, val: &str| {
-            let mut map = std::collections::BTreeMap::new();
+            let mut map = mq_lang::Dict::default();
             map.insert(mq_lang::Ident::new("key"), RuntimeValue::String(val.to_string()));
-            let mut outer = std::collections::BTreeMap::new();
+            let mut outer = mq_lang::Dict::default();
             outer.insert(mq_lang::Ident::new("name"), RuntimeValue::String(name.to_string()));
             RuntimeValue::Dict(Shared::new(outer))
         };
@@ -306,7 +306,7 @@ mod tests {
 
     #[test]
     fn test_table_dict_with_theme() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("x"), RuntimeValue::Boolean(true));
         map.insert(mq_lang::Ident::new("y"), RuntimeValue::Boolean(false));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
@@ -318,9 +318,9 @@ mod tests {
 
     #[test]
     fn test_table_array_of_dicts() {
-        let mut m1 = std::collections::BTreeMap::new();
+        let mut m1 = mq_lang::Dict::default();
         m1.insert(mq_lang::Ident::new("a"), RuntimeValue::String("1".to_string()));
-        let mut m2 = std::collections::BTreeMap::new();
+        let mut m2 = mq_lang::Dict::default();
         m2.insert(mq_lang::Ident::new("a"), RuntimeValue::String("2".to_string()));
         let values = vec![RuntimeValue::Array(Shared::new(vec![
             RuntimeValue::Dict(Shared::new(m1)),
@@ -344,9 +344,9 @@ mod tests {
 
     #[test]
     fn test_table_nested_dict_in_cell() {
-        let mut inner = std::collections::BTreeMap::new();
+        let mut inner = mq_lang::Dict::default();
         inner.insert(mq_lang::Ident::new("sub"), RuntimeValue::String("val".to_string()));
-        let mut outer = std::collections::BTreeMap::new();
+        let mut outer = mq_lang::Dict::default();
         outer.insert(mq_lang::Ident::new("nested"), RuntimeValue::Dict(Shared::new(inner)));
         let values = vec![RuntimeValue::Dict(Shared::new(outer))];
         let table = runtime_values_to_table(&values, None);
@@ -367,7 +367,7 @@ mod tests {
 
     #[test]
     fn test_table_empty_array_in_cell() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("arr"), RuntimeValue::Array(Shared::new(vec![])));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let table = runtime_values_to_table(&values, None);
@@ -448,11 +448,11 @@ mod tests {
 
     #[test]
     fn test_table_dict_with_nested_array_of_dicts() {
-        let mut inner1 = std::collections::BTreeMap::new();
+        let mut inner1 = mq_lang::Dict::default();
         inner1.insert(mq_lang::Ident::new("k"), RuntimeValue::String("v1".to_string()));
-        let mut inner2 = std::collections::BTreeMap::new();
+        let mut inner2 = mq_lang::Dict::default();
         inner2.insert(mq_lang::Ident::new("k"), RuntimeValue::String("v2".to_string()));
-        let mut outer = std::collections::BTreeMap::new();
+        let mut outer = mq_lang::Dict::default();
         outer.insert(
             mq_lang::Ident::new("items"),
             RuntimeValue::Array(Shared::new(vec![
@@ -472,7 +472,7 @@ mod tests {
             value: "node_value".to_string(),
             position: None,
         });
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("md"), RuntimeValue::Markdown(Box::new(node), None));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let table = runtime_values_to_table(&values, None);
@@ -482,7 +482,7 @@ mod tests {
 
     #[test]
     fn test_table_empty_dict() {
-        let map = std::collections::BTreeMap::new();
+        let map = mq_lang::Dict::default();
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let table = runtime_values_to_table(&values, None);
         assert!(!table.to_string().is_empty());
@@ -490,10 +490,10 @@ mod tests {
 
     #[test]
     fn test_table_multiple_dicts_missing_key() {
-        let mut m1 = std::collections::BTreeMap::new();
+        let mut m1 = mq_lang::Dict::default();
         m1.insert(mq_lang::Ident::new("a"), RuntimeValue::String("1".to_string()));
         m1.insert(mq_lang::Ident::new("b"), RuntimeValue::String("2".to_string()));
-        let mut m2 = std::collections::BTreeMap::new();
+        let mut m2 = mq_lang::Dict::default();
         m2.insert(mq_lang::Ident::new("a"), RuntimeValue::String("3".to_string()));
         // m2 is missing key "b" — format_cell_value should return ""
         let values = vec![RuntimeValue::Dict(Shared::new(m1)), RuntimeValue::Dict(Shared::new(m2))];
@@ -31,7 +31,7 @@ mod tests {
 
     #[test]
     fn test_dict_value() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("name"), RuntimeValue::String("Alice".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let result = runtime_values_to_toml(&values).unwrap();
@@ -40,9 +40,9 @@ mod tests {
 
     #[test]
     fn test_nested_dict() {
-        let mut inner = std::collections::BTreeMap::new();
+        let mut inner = mq_lang::Dict::default();
         inner.insert(mq_lang::Ident::new("city"), RuntimeValue::String("NYC".to_string()));
-        let mut outer = std::collections::BTreeMap::new();
+        let mut outer = mq_lang::Dict::default();
         outer.insert(mq_lang::Ident::new("address"), RuntimeValue::Dict(Shared::new(inner)));
         let values = vec![RuntimeValue::Dict(Shared::new(outer))];
         let result = runtime_values_to_toml(&values).unwrap();
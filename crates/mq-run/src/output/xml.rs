@@ -3,30 +3,29 @@
 //! When the (sole) value is shaped like the `xml_parse()` module's output
 //! (a dict with a string `tag` key, plus `attributes`/`children`/`text`), it is
 //! rendered back into a faithful XML element tree, giving a true round trip with
-//! `-I xml`. Otherwise the values are merged into a [`serde_json::Value`] (see
-//! [`crate::json`]) and rendered generically under a `<root>` element, with JSON
-//! arrays becoming repeated `<item>` elements.
+//! `-I xml`. Otherwise each value's [`serde_json::Value`] form (see [`crate::json`])
+//! is rendered generically under a `<root>` element, with multiple values becoming
+//! repeated `<item>` elements.
 
 use miette::miette;
 #[cfg(test)]
 use mq_lang::Shared;
-use mq_lang::{Ident, RuntimeValue};
+use mq_lang::{Dict, Ident, RuntimeValue};
 use quick_xml::Writer;
 use quick_xml::escape::escape;
 use quick_xml::events::{BytesDecl, BytesEnd, BytesStart, BytesText, Event};
-use std::collections::BTreeMap;
 
 fn xml_err(e: std::io::Error) -> miette::Report {
     miette!("Failed to write XML: {}", e)
 }
 
-fn is_element_shape(map: &BTreeMap<Ident, RuntimeValue>) -> bool {
+fn is_element_shape(map: &Dict) -> bool {
     matches!(map.get(&Ident::new("tag")), Some(RuntimeValue::String(_)))
 }
 
 /// Writes a `{tag, attributes, children, text}`-shaped dict (the shape produced by
 /// `xml_parse()`) as a real XML element, recursing into `children` of the same shape.
-fn write_element(writer: &mut Writer<&mut Vec<u8>>, map: &BTreeMap<Ident, RuntimeValue>) -> std::io::Result<()> {
+fn write_element<W: std::io::Write>(writer: &mut Writer<W>, map: &Dict) -> std::io::Result<()> {
     let tag = match map.get(&Ident::new("tag")) {
         Some(RuntimeValue::String(s)) => s.clone(),
         _ => return Ok(()),
@@ -68,7 +67,11 @@ fn write_element(writer: &mut Writer<&mut Vec<u8>>, map: &BTreeMap<Ident, Runtim
 
 /// Writes an arbitrary JSON value under `tag`, mapping objects to child elements,
 /// arrays to repeated `<item>` elements, and scalars to text content.
-fn write_json_as_xml(writer: &mut Writer<&mut Vec<u8>>, tag: &str, value: &serde_json::Value) -> std::io::Result<()> {
+fn write_json_as_xml<W: std::io::Write>(
+    writer: &mut Writer<W>,
+    tag: &str,
+    value: &serde_json::Value,
+) -> std::io::Result<()> {
     match value {
         serde_json::Value::Null => {
             writer.write_event(Event::Empty(BytesStart::new(tag)))?;
@@ -109,12 +112,16 @@ fn write_json_as_xml(writer: &mut Writer<&mut Vec<u8>>, tag: &str, value: &serde
     Ok(())
 }
 
-/// Converts a list of [`RuntimeValue`]s into an XML string.
-pub(crate) fn runtime_values_to_xml(runtime_values: &[RuntimeValue]) -> miette::Result<String> {
+/// Writes the XML rendering of `runtime_values` to `out`, emitting events as each
+/// value is converted, so output memory is bounded by the largest single value rather
+/// than the whole document.
+pub(crate) fn write_runtime_values_as_xml(
+    runtime_values: &[RuntimeValue],
+    out: &mut dyn std::io::Write,
+) -> miette::Result<()> {
     let non_none: Vec<&RuntimeValue> = runtime_values.iter().filter(|v| !v.is_none()).collect();
 
-    let mut buf = Vec::new();
-    let mut writer = Writer::new_with_indent(&mut buf, b' ', 2);
+    let mut writer = Writer::new_with_indent(out, b' ', 2);
     writer
         .write_event(Event::Decl(BytesDecl::new("1.0", Some("UTF-8"), None)))
         .map_err(xml_err)?;
@@ -124,24 +131,43 @@ pub(crate) fn runtime_values_to_xml(runtime_values: &[RuntimeValue]) -> miette::
     {
         write_element(&mut writer, map).map_err(xml_err)?;
     } else {
-        let json_value = super::json::runtime_values_to_json_value(runtime_values);
-        write_json_as_xml(&mut writer, "root", &json_value).map_err(xml_err)?;
+        let (filtered, all_markdown) = super::json::structured_values(runtime_values);
+        if !all_markdown && filtered.len() == 1 {
+            write_json_as_xml(&mut writer, "root", &filtered[0].clone().to_json_value()).map_err(xml_err)?;
+        } else if filtered.is_empty() {
+            writer
+                .write_event(Event::Empty(BytesStart::new("root")))
+                .map_err(xml_err)?;
+        } else {
+            writer
+                .write_event(Event::Start(BytesStart::new("root")))
+                .map_err(xml_err)?;
+            for value in filtered {
+                write_json_as_xml(&mut writer, "item", &super::json::runtime_value_to_json_value(value))
+                    .map_err(xml_err)?;
+            }
+            writer.write_event(Event::End(BytesEnd::new("root"))).map_err(xml_err)?;
+        }
     }
 
-    let mut result = String::from_utf8(buf).map_err(|e| miette!("Failed to convert XML output to UTF-8: {}", e))?;
-    result.push('\n');
-    Ok(result)
+    writer.into_inner().write_all(b"\n").map_err(xml_err)
 }
 
 #[cfg(test)]
 mod tests {
     use super::*;
 
+    fn runtime_values_to_xml(runtime_values: &[RuntimeValue]) -> miette::Result<String> {
+        let mut buf = Vec::new();
+        write_runtime_values_as_xml(runtime_values, &mut buf)?;
+        String::from_utf8(buf).map_err(|e| miette!("Failed to convert XML output to UTF-8: {}", e))
+    }
+
     #[test]
     fn test_element_shape_round_trip() {
-        let mut attrs = BTreeMap::new();
+        let mut attrs = Dict::default();
         attrs.insert(Ident::new("id"), RuntimeValue::String("1".to_string()));
-        let mut map = BTreeMap::new();
+        let mut map = Dict::default();
         map.insert(Ident::new("tag"), RuntimeValue::String("root".to_string()));
         map.insert(Ident::new("attributes"), RuntimeValue::Dict(Shared::new(attrs)));
         map.insert(Ident::new("children"), RuntimeValue::Array(Shared::new(vec![])));
@@ -154,7 +180,7 @@ mod tests {
 
     #[test]
     fn test_generic_dict() {
-        let mut map = BTreeMap::new();
+        let mut map = Dict::default();
         map.insert(Ident::new("name"), RuntimeValue::String("Alice".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let result = runtime_values_to_xml(&values).unwrap();
@@ -182,7 +208,7 @@ mod tests {
 
     #[test]
     fn test_empty_dict() {
-        let values = vec![RuntimeValue::Dict(Shared::new(BTreeMap::new()))];
+        let values = vec![RuntimeValue::Dict(Shared::new(Dict::default()))];
         let result = runtime_values_to_xml(&values).unwrap();
         assert!(result.contains("<root/>"));
     }
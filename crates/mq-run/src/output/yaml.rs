@@ -1,16 +1,40 @@
 //! YAML output rendering for the `--output-format yaml` CLI option.
 //!
-//! Converts [`mq_lang::RuntimeValue`]s into YAML by first merging them into a
-//! [`serde_json::Value`] (see [`crate::json`]) and serializing that with `serde_yaml`.
+//! Converts [`mq_lang::RuntimeValue`]s into YAML by serializing each value's
+//! [`serde_json::Value`] form (see [`crate::json`]) with `serde_yaml`, one sequence
+//! entry at a time.
 
 use miette::miette;
 #[cfg(test)]
 use mq_lang::Shared;
 
-/// Converts a list of [`mq_lang::RuntimeValue`]s into a YAML string.
-pub(crate) fn runtime_values_to_yaml(runtime_values: &[mq_lang::RuntimeValue]) -> miette::Result<String> {
-    let value = super::json::runtime_values_to_json_value(runtime_values);
-    serde_yaml::to_string(&value).map_err(|e| miette!("Failed to serialize to YAML: {}", e))
+/// Writes the YAML rendering of `runtime_values` to `out`: each sequence entry is
+/// serialized on its own and re-indented under a `- ` marker, so output memory is
+/// bounded by the largest single value rather than the whole document.
+pub(crate) fn write_runtime_values_as_yaml(
+    runtime_values: &[mq_lang::RuntimeValue],
+    out: &mut dyn std::io::Write,
+) -> miette::Result<()> {
+    let ser_err = |e: serde_yaml::Error| miette!("Failed to serialize to YAML: {}", e);
+    let write_err = |e: std::io::Error| miette!("Failed to write YAML: {}", e);
+    let (filtered, all_markdown) = super::json::structured_values(runtime_values);
+
+    if !all_markdown && filtered.len() == 1 {
+        let doc = serde_yaml::to_string(&filtered[0].clone().to_json_value()).map_err(ser_err)?;
+        return out.write_all(doc.as_bytes()).map_err(write_err);
+    }
+    if filtered.is_empty() {
+        return out.write_all(b"[]\n").map_err(write_err);
+    }
+    for value in filtered {
+        let doc = serde_yaml::to_string(&super::json::runtime_value_to_json_value(value)).map_err(ser_err)?;
+        for (i, line) in doc.lines().enumerate() {
+            out.write_all(if i == 0 { b"- " } else { b"  " }).map_err(write_err)?;
+            out.write_all(line.as_bytes()).map_err(write_err)?;
+            out.write_all(b"\n").map_err(write_err)?;
+        }
+    }
+    Ok(())
 }
 
 #[cfg(test)]
@@ -18,6 +42,12 @@ mod tests {
     use super::*;
     use mq_lang::RuntimeValue;
 
+    fn runtime_values_to_yaml(runtime_values: &[mq_lang::RuntimeValue]) -> miette::Result<String> {
+        let mut buf = Vec::new();
+        write_runtime_values_as_yaml(runtime_values, &mut buf)?;
+        String::from_utf8(buf).map_err(|e| miette!("Failed to convert YAML output to UTF-8: {}", e))
+    }
+
     #[test]
     fn test_string_value() {
         let values = vec![RuntimeValue::String("hello".to_string())];
@@ -27,7 +57,7 @@ mod tests {
 
     #[test]
     fn test_dict_value() {
-        let mut map = std::collections::BTreeMap::new();
+        let mut map = mq_lang::Dict::default();
         map.insert(mq_lang::Ident::new("name"), RuntimeValue::String("Alice".to_string()));
         let values = vec![RuntimeValue::Dict(Shared::new(map))];
         let result = runtime_values_to_yaml(&values).unwrap();
@@ -45,6 +75,27 @@ mod tests {
         assert!(result.contains("- b"));
     }
 
+    #[test]
+    fn test_streaming_matches_merged_serialization() {
+        let mut map = mq_lang::Dict::default();
+        map.insert(
+            mq_lang::Ident::new("items"),
+            RuntimeValue::Array(Shared::new(vec![
+                RuntimeValue::String("x".to_string()),
+                RuntimeValue::String("y".to_string()),
+            ])),
+        );
+        let values = vec![
+            RuntimeValue::String("a".to_string()),
+            RuntimeValue::Dict(Shared::new(map)),
+            RuntimeValue::from(42usize),
+        ];
+        let streamed = runtime_values_to_yaml(&values).unwrap();
+        let merged = super::super::json::runtime_values_to_json_value(&values);
+        let whole = serde_yaml::to_string(&merged).unwrap();
+        assert_eq!(streamed, whole);
+    }
+
     #[test]
     fn test_multiple_values_becomes_sequence() {
         let values = vec![
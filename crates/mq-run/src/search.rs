@@ -0,0 +1,285 @@
+//! Ripgrep-style file discovery and pre-filtering for searching directory trees.
+//!
+//! When a positional path is a directory, it is expanded into the Markdown files it
+//! contains using a parallel walker that honours `.gitignore`/`.ignore` files and
+//! skips hidden entries, like ripgrep. For grep output, a cheap byte-level
+//! [`Prefilter`] derived from selector-only queries then skips files whose raw bytes
+//! cannot possibly produce a match (e.g. `.code` against a file with no fences,
+//! tildes, or indentation), so the expensive parse and evaluation only runs on
+//! candidate files.
+
+use miette::miette;
+use std::path::{Path, PathBuf};
+use std::sync::Mutex;
+
+/// File extensions treated as Markdown when expanding directories.
+const MARKDOWN_EXTENSIONS: [&str; 3] = ["md", "markdown", "mdx"];
+
+fn is_markdown_file(path: &Path) -> bool {
+    path.extension()
+        .and_then(|e| e.to_str())
+        .is_some_and(|ext| MARKDOWN_EXTENSIONS.iter().any(|m| ext.eq_ignore_ascii_case(m)))
+}
+
+/// Expands directory arguments into the Markdown files they contain, walking in
+/// parallel and honouring `.gitignore`/`.ignore` files. Plain file arguments are
+/// passed through untouched regardless of extension, and discovered files are
+/// sorted by path so output order stays deterministic across runs.
+pub(crate) fn expand_directories(paths: Vec<PathBuf>) -> miette::Result<Vec<PathBuf>> {
+    let mut expanded = Vec::with_capacity(paths.len());
+    let mut dirs = Vec::new();
+
+    for path in paths {
+        if path.is_dir() {
+            dirs.push(path);
+        } else {
+            expanded.push(path);
+        }
+    }
+
+    if dirs.is_empty() {
+        return Ok(expanded);
+    }
+
+    let mut builder = ignore::WalkBuilder::new(&dirs[0]);
+    for dir in &dirs[1..] {
+        builder.add(dir);
+    }
+
+    let found: Mutex<Vec<PathBuf>> = Mutex::new(Vec::new());
+    let walk_error: Mutex<Option<String>> = Mutex::new(None);
+
+    builder.build_parallel().run(|| {
+        Box::new(|entry| match entry {
+            Ok(entry) => {
+                if entry.file_type().is_some_and(|t| t.is_file()) && is_markdown_file(entry.path()) {
+                    found.lock().unwrap_or_else(|e| e.into_inner()).push(entry.into_path());
+                }
+                ignore::WalkState::Continue
+            }
+            Err(e) => {
+                *walk_error.lock().unwrap_or_else(|e| e.into_inner()) = Some(e.to_string());
+                ignore::WalkState::Quit
+            }
+        })
+    });
+
+    if let Some(e) = walk_error.into_inner().unwrap_or_else(|e| e.into_inner()) {
+        return Err(miette!("Failed to read directory: {}", e));
+    }
+
+    let mut found = found.into_inner().unwrap_or_else(|e| e.into_inner());
+    found.sort_unstable();
+    expanded.extend(found);
+    Ok(expanded)
+}
+
+/// Byte-level pre-filter derived from a selector-only query.
+///
+/// Each entry in `required` is the marker set of one selector stage: at least one
+/// marker of every set must appear in the raw input, otherwise the selector can
+/// never match a node and the file can be skipped without parsing it.
+pub(crate) struct Prefilter {
+    required: Vec<&'static [&'static str]>,
+}
+
+impl Prefilter {
+    /// Builds a pre-filter from `query` when every pipe stage is a bare selector,
+    /// optionally with arguments — e.g. `.code`, `.code("rust") | .text`. Selectors
+    /// map non-matching nodes to `None` and pass `None` through, so a file whose raw
+    /// bytes lack a selector's required syntax marker cannot produce grep output for
+    /// such a query. Anything more complex returns `None` and disables pre-filtering,
+    /// since a later stage could turn `None` back into printable output (e.g.
+    /// `is_none()`).
+    pub(crate) fn from_query(query: &str) -> Option<Self> {
+        let stages = split_stages(query)?;
+        let mut required = Vec::new();
+
+        for stage in stages {
+            let name = parse_selector(stage)?;
+            if let Some(markers) = selector_markers(name) {
+                required.push(markers);
+            }
+        }
+
+        if required.is_empty() {
+            None
+        } else {
+            Some(Self { required })
+        }
+    }
+
+    /// Returns `true` if `content` could produce a match, i.e. every selector
+    /// stage's marker set has at least one marker present in the raw bytes.
+    pub(crate) fn may_match(&self, content: &[u8]) -> bool {
+        self.required
+            .iter()
+            .all(|markers| markers.iter().any(|m| contains_bytes(content, m.as_bytes())))
+    }
+}
+
+/// Raw-byte markers without which a selector can never match. Only selectors whose
+/// CommonMark/GFM syntax requires a distinctive byte are listed; the mapping must be
+/// conservative — a missing marker must prove the selector cannot match.
+fn selector_markers(name: &str) -> Option<&'static [&'static str]> {
+    match name {
+        // fenced (``` or ~~~) or indented (4 spaces / tab) code blocks
+        "code" => Some(&["`", "~", "\t", "    "]),
+        "code_inline" => Some(&["`"]),
+        "h1" => Some(&["#", "="]),
+        "h2" => Some(&["#", "-"]),
+        "h3" | "h4" | "h5" | "h6" => Some(&["#"]),
+        "h" | "heading" => Some(&["#", "=", "-"]),
+        "table" | "table_align" => Some(&["|"]),
+        "image" | "image_ref" => Some(&["!["]),
+        // inline links, autolinks, and GFM autolink literals
+        "link" | "link_ref" => Some(&["[", "<", "http", "www."]),
+        "blockquote" => Some(&[">"]),
+        "html" => Some(&["<"]),
+        "footnote" | "footnote_ref" => Some(&["[^"]),
+        "math" | "math_inline" => Some(&["$"]),
+        "mdx_jsx_flow_element" | "mdx_jsx_text_element" => Some(&["<"]),
+        "mdx_flow_expression" | "mdx_text_expression" => Some(&["{"]),
+        _ => None,
+    }
+}
+
+/// Splits `query` on top-level `|`, outside strings and parentheses. Returns `None`
+/// for queries containing comments, where a plain text scan cannot be trusted.
+fn split_stages(query: &str) -> Option<Vec<&str>> {
+    let mut stages = Vec::new();
+    let mut start = 0;
+    let mut depth = 0usize;
+    let mut in_string = false;
+    let mut escaped = false;
+
+    for (i, c) in query.char_indices() {
+        if in_string {
+            if escaped {
+                escaped = false;
+            } else if c == '\\' {
+                escaped = true;
+            } else if c == '"' {
+                in_string = false;
+            }
+            continue;
+        }
+        match c {
+            '"' => in_string = true,
+            '(' => depth += 1,
+            ')' => depth = depth.checked_sub(1)?,
+            '#' => return None,
+            '|' if depth == 0 => {
+                stages.push(&query[start..i]);
+                start = i + 1;
+            }
+            _ => {}
+        }
+    }
+
+    if in_string || depth != 0 {
+        return None;
+    }
+    stages.push(&query[start..]);
+    Some(stages)
+}
+
+/// Parses a stage of the form `.name` or `.name(...)`, returning the selector name.
+fn parse_selector(stage: &str) -> Option<&str> {
+    let rest = stage.trim().strip_prefix('.')?;
+    let end = rest
+        .find(|c: char| !c.is_ascii_alphanumeric() && c != '_')
+        .unwrap_or(rest.len());
+    let name = &rest[..end];
+    if name.is_empty() {
+        return None;
+    }
+
+    let args = rest[end..].trim();
+    if args.is_empty() || (args.starts_with('(') && args.ends_with(')')) {
+        Some(name)
+    } else {
+        None
+    }
+}
+
+fn contains_bytes(haystack: &[u8], needle: &[u8]) -> bool {
+    match needle.len() {
+        0 => true,
+        1 => haystack.contains(&needle[0]),
+        _ => haystack.windows(needle.len()).any(|w| w == needle),
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+    use rstest::rstest;
+
+    #[rstest]
+    #[case::markdown("a.md", true)]
+    #[case::mdx("a.mdx", true)]
+    #[case::uppercase("A.MD", true)]
+    #[case::long_extension("a.markdown", true)]
+    #[case::text("a.txt", false)]
+    #[case::no_extension("Makefile", false)]
+    fn test_is_markdown_file(#[case] path: &str, #[case] expected: bool) {
+        assert_eq!(is_markdown_file(Path::new(path)), expected);
+    }
+
+    #[rstest]
+    #[case::selector(".code", true)]
+    #[case::selector_with_args(".code(\"rust\")", true)]
+    #[case::selector_pipeline(".code | .text", true)]
+    #[case::unmapped_selector_only(".text", false)]
+    #[case::function_call("select(contains(\"a\"))", false)]
+    #[case::selector_then_function(".code | upcase()", false)]
+    #[case::binding("let x = 1 | x", false)]
+    #[case::comment(".code # comment", false)]
+    fn test_prefilter_from_query(#[case] query: &str, #[case] expected: bool) {
+        assert_eq!(Prefilter::from_query(query).is_some(), expected);
+    }
+
+    #[rstest]
+    #[case::fenced_code(".code", "# Title\n\n```rust\nfn main() {}\n```\n", true)]
+    #[case::indented_code(".code", "# Title\n\n    indented\n", true)]
+    #[case::no_code(".code", "# Title\n\nJust a paragraph.\n", false)]
+    #[case::atx_heading(".h1", "# Title\n", true)]
+    #[case::setext_heading(".h1", "Title\n=====\n", true)]
+    #[case::no_heading(".h3", "plain text\n", false)]
+    #[case::table(".table", "| a | b |\n|---|---|\n", true)]
+    #[case::no_table(".table", "plain text\n", false)]
+    #[case::image(".image", "![alt](img.png)\n", true)]
+    #[case::link_is_not_image(".image", "[text](url)\n", false)]
+    #[case::pipeline_requires_all(".code | .table", "```\nx\n```\n", false)]
+    fn test_prefilter_may_match(#[case] query: &str, #[case] content: &str, #[case] expected: bool) {
+        let prefilter = Prefilter::from_query(query).expect("query should produce a prefilter");
+        assert_eq!(prefilter.may_match(content.as_bytes()), expected);
+    }
+
+    #[test]
+    fn test_expand_directories_respects_gitignore() {
+        let dir = tempfile::tempdir().expect("failed to create temp dir");
+        // `ignore` only applies .gitignore rules inside a repository.
+        std::fs::create_dir(dir.path().join(".git")).unwrap();
+        std::fs::create_dir(dir.path().join("sub")).unwrap();
+        std::fs::write(dir.path().join("a.md"), "# a").unwrap();
+        std::fs::write(dir.path().join("sub/b.mdx"), "# b").unwrap();
+        std::fs::write(dir.path().join("skipped.txt"), "not markdown").unwrap();
+        std::fs::write(dir.path().join("ignored.md"), "# ignored").unwrap();
+        std::fs::write(dir.path().join(".gitignore"), "ignored.md\n").unwrap();
+
+        let result = expand_directories(vec![dir.path().to_path_buf()]).unwrap();
+        assert_eq!(result, vec![dir.path().join("a.md"), dir.path().join("sub/b.mdx")]);
+    }
+
+    #[test]
+    fn test_expand_directories_keeps_plain_files_first() {
+        let dir = tempfile::tempdir().expect("failed to create temp dir");
+        std::fs::write(dir.path().join("explicit.txt"), "text").unwrap();
+        std::fs::write(dir.path().join("a.md"), "# a").unwrap();
+
+        let result = expand_directories(vec![dir.path().join("explicit.txt"), dir.path().to_path_buf()]).unwrap();
+        assert_eq!(result, vec![dir.path().join("explicit.txt"), dir.path().join("a.md")]);
+    }
+}
@@ -259,7 +259,7 @@ In {year}, the snowfall was above average.
 #[case::input_format_xml(
     vec!["--unbuffered", "-I", "xml", "self"],
     "<root>text</root>",
-    Some("{\"text\": \"text\", \"attributes\": {}, \"tag\": \"root\", \"children\": []}\n")
+    Some("{\"tag\": \"root\", \"attributes\": {}, \"children\": [], \"text\": \"text\"}\n")
 )]
 #[case::output_format_yaml(
     vec!["--unbuffered", "-I", "json", "-F", "yaml", "self"],
@@ -1219,6 +1219,31 @@ fn test_eval_all_conflicts_with_update() -> Result<(), Box<dyn std::error::Error
     Ok(())
 }
 
+#[rstest]
+#[case::stream("--stream")]
+#[case::eval_all("--eval-all")]
+#[case::count("--count")]
+fn test_watch_conflicts(#[case] flag: &str) {
+    let mut cmd = cargo::cargo_bin_cmd!("mq");
+    cmd.arg("--watch")
+        .arg(flag)
+        .arg("self")
+        .write_stdin("# title\n")
+        .assert()
+        .failure();
+}
+
+#[test]
+fn test_watch_requires_file_inputs() -> Result<(), Box<dyn std::error::Error>> {
+    let mut cmd = cargo::cargo_bin_cmd!("mq");
+    cmd.arg("--watch")
+        .arg("self")
+        .write_stdin("# title\n")
+        .assert()
+        .failure();
+    Ok(())
+}
+
 #[rstest]
 #[case::bash("bash", "_mq()")]
 #[case::elvish("elvish", "edit:completion:arg-completer[mq]")]
@@ -52,6 +52,26 @@ export function diagnostics(code: string, enableTypeCheck?: boolean): Promise<Re
 export function hover(code: string, line: number, column: number): Promise<HoverResult | null>;
 export function inlayHints(code: string): Promise<ReadonlyArray<InlayHint>>;
 export function run(code: string, content: string, options: Options): Promise<string>;
+/**
+ * Compile-once, evaluate-many session for playground-style callers.
+ *
+ * `run()` re-parses the query and re-parses the document on every call; a
+ * `Session` retains the compiled query and the parsed document in wasm memory,
+ * so re-running after a keystroke only pays for evaluation. Large results can
+ * be read back in chunks via `nextResultChunk` instead of one giant string.
+ */
+export class Session {
+  free(): void;
+  constructor(options: Options);
+  /** Compiles `code` and retains it for subsequent `evaluate()` calls. Preloads any imported modules first. */
+  compile(code: string): Promise<void>;
+  /** Parses `content` using the session's `inputFormat` and retains the result in wasm memory. */
+  loadDocument(content: string): void;
+  /** Evaluates the retained query against the retained document and buffers the rendered output, returning its size in bytes. */
+  evaluate(): number;
+  /** Returns the next chunk of the buffered result (at most `maxBytes` bytes), or `undefined` when the result is exhausted. */
+  nextResultChunk(maxBytes: number): string | undefined;
+}
 /** Clears mutable HTTP module cache (HEAD/branch imports) and their mq.lock entries. Versioned (tagged) cache and lock entries are preserved. */
 export function clearHttpCache(): Promise<void>;
 /** Clears all HTTP module cache including versioned (tagged) imports, and deletes mq.lock. */
@@ -636,15 +656,7 @@ pub async fn run(code: &str, content: &str, options: JsValue) -> Result<String,
         engine.set_timeout(std::time::Duration::from_millis(timeout_ms as u64));
     }
 
-    let input = match options.input_format.as_ref().unwrap_or(&InputFormat::Markdown) {
-        InputFormat::Text => mq_lang::parse_text_input(content),
-        InputFormat::Html => mq_lang::parse_html_input(content),
-        InputFormat::Mdx => mq_lang::parse_mdx_input(content),
-        InputFormat::Markdown => mq_lang::parse_markdown_input(content),
-        InputFormat::Raw => Ok(mq_lang::raw_input(content)),
-        InputFormat::Null => Ok(mq_lang::null_input()),
-    }
-    .map_err(|e| JsValue::from_str(&format!("Failed to parse input content: {}", e)))?;
+    let input = parse_input_content(content, &options)?;
 
     engine
         .eval(code, input.clone().into_iter())
@@ -656,43 +668,200 @@ pub async fn run(code: &str, content: &str, options: JsValue) -> Result<String,
             } else {
                 result_values
             };
+            render_output(values, &options)
+        })
+}
 
-            let mut markdown = mq_markdown::Markdown::new(
-                values
-                    .into_iter()
-                    .map(|runtime_value| match runtime_value {
-                        mq_lang::RuntimeValue::Markdown(node, _) => *node,
-                        _ => runtime_value.to_string().into(),
-                    })
-                    .collect(),
-            );
-            markdown.set_options(mq_markdown::RenderOptions {
-                list_style: options
-                    .list_style
-                    .map(|style| match style {
-                        ListStyle::Dash => mq_markdown::ListStyle::Dash,
-                        ListStyle::Plus => mq_markdown::ListStyle::Plus,
-                        ListStyle::Star => mq_markdown::ListStyle::Star,
-                    })
-                    .unwrap_or_default(),
-                link_title_style: options
-                    .link_title_style
-                    .map(|style| match style {
-                        TitleSurroundStyle::Double => mq_markdown::TitleSurroundStyle::Double,
-                        TitleSurroundStyle::Single => mq_markdown::TitleSurroundStyle::Single,
-                        TitleSurroundStyle::Paren => mq_markdown::TitleSurroundStyle::Paren,
-                    })
-                    .unwrap_or_default(),
-                link_url_style: options
-                    .link_url_style
-                    .map(|style| match style {
-                        UrlSurroundStyle::Angle => mq_markdown::UrlSurroundStyle::Angle,
-                        UrlSurroundStyle::None => mq_markdown::UrlSurroundStyle::None,
-                    })
-                    .unwrap_or_default(),
-            });
-            markdown.to_string()
+/// Parses `content` using the input format from `options` (defaulting to Markdown).
+fn parse_input_content(content: &str, options: &Options) -> Result<Vec<mq_lang::RuntimeValue>, JsValue> {
+    match options.input_format.as_ref().unwrap_or(&InputFormat::Markdown) {
+        InputFormat::Text => mq_lang::parse_text_input(content),
+        InputFormat::Html => mq_lang::parse_html_input(content),
+        InputFormat::Mdx => mq_lang::parse_mdx_input(content),
+        InputFormat::Markdown => mq_lang::parse_markdown_input(content),
+        InputFormat::Raw => Ok(mq_lang::raw_input(content)),
+        InputFormat::Null => Ok(mq_lang::null_input()),
+    }
+    .map_err(|e| JsValue::from_str(&format!("Failed to parse input content: {}", e)))
+}
+
+/// Renders result values to Markdown text using the style settings from `options`.
+fn render_output(values: mq_lang::RuntimeValues, options: &Options) -> String {
+    let mut markdown = mq_markdown::Markdown::new(
+        values
+            .into_iter()
+            .map(|runtime_value| match runtime_value {
+                mq_lang::RuntimeValue::Markdown(node, _) => *node,
+                _ => runtime_value.to_string().into(),
+            })
+            .collect(),
+    );
+    markdown.set_options(mq_markdown::RenderOptions {
+        list_style: options
+            .list_style
+            .as_ref()
+            .map(|style| match style {
+                ListStyle::Dash => mq_markdown::ListStyle::Dash,
+                ListStyle::Plus => mq_markdown::ListStyle::Plus,
+                ListStyle::Star => mq_markdown::ListStyle::Star,
+            })
+            .unwrap_or_default(),
+        link_title_style: options
+            .link_title_style
+            .as_ref()
+            .map(|style| match style {
+                TitleSurroundStyle::Double => mq_markdown::TitleSurroundStyle::Double,
+                TitleSurroundStyle::Single => mq_markdown::TitleSurroundStyle::Single,
+                TitleSurroundStyle::Paren => mq_markdown::TitleSurroundStyle::Paren,
+            })
+            .unwrap_or_default(),
+        link_url_style: options
+            .link_url_style
+            .as_ref()
+            .map(|style| match style {
+                UrlSurroundStyle::Angle => mq_markdown::UrlSurroundStyle::Angle,
+                UrlSurroundStyle::None => mq_markdown::UrlSurroundStyle::None,
+            })
+            .unwrap_or_default(),
+    });
+    markdown.to_string()
+}
+
+/// Compile-once, evaluate-many session for playground-style callers.
+///
+/// [`run`] re-parses the query and copies the whole document across the JS/wasm
+/// boundary on every call. A `Session` compiles the query once into a retained
+/// [`mq_lang::CompiledProgram`], parses the document once into wasm memory, and
+/// re-runs evaluation against the retained parse, so a keystroke in the
+/// playground only pays for evaluation. The rendered result is buffered in wasm
+/// memory and read back in chunks via [`Session::next_result_chunk`], so huge
+/// outputs don't force one giant string allocation.
+#[wasm_bindgen(skip_typescript)]
+pub struct Session {
+    engine: mq_lang::Engine<WasmModuleResolver>,
+    resolver: WasmModuleResolver,
+    options: Options,
+    /// Whether `resolver.initialize()` (OPFS setup) has run for this session.
+    resolver_initialized: bool,
+    program: Option<mq_lang::CompiledProgram>,
+    input: Option<Vec<mq_lang::RuntimeValue>>,
+    /// Rendered output of the last `evaluate()`, drained by `next_result_chunk`.
+    result: String,
+    result_cursor: usize,
+}
+
+#[wasm_bindgen]
+impl Session {
+    #[wasm_bindgen(constructor, skip_typescript)]
+    pub fn new(options: JsValue) -> Result<Session, JsValue> {
+        let options: Options = serde_wasm_bindgen::from_value(options)
+            .map_err(|e| JsValue::from_str(&format!("Failed to parse options: {}", e)))?;
+
+        let resolver = WasmModuleResolver::new();
+        if let Some(ref domains) = options.allowed_domains {
+            resolver.set_allowed_domains(domains.clone());
+        }
+
+        let mut engine = mq_lang::Engine::new(resolver.clone());
+        engine.load_builtin_module();
+        if let Some(timeout_ms) = options.timeout_ms {
+            engine.set_timeout(std::time::Duration::from_millis(timeout_ms as u64));
+        }
+
+        Ok(Session {
+            engine,
+            resolver,
+            options,
+            resolver_initialized: false,
+            program: None,
+            input: None,
+            result: String::new(),
+            result_cursor: 0,
         })
+    }
+
+    /// Compiles `code` and retains the compiled program for subsequent
+    /// [`Session::evaluate`] calls, preloading any modules it imports first.
+    #[wasm_bindgen(skip_typescript)]
+    pub async fn compile(&mut self, code: &str) -> Result<(), JsValue> {
+        if !self.resolver_initialized {
+            self.resolver.initialize().await;
+            self.resolver_initialized = true;
+        }
+        self.resolver.preload_modules(code).await;
+        self.resolver.preload_http_modules(code).await;
+
+        self.program = Some(
+            self.engine
+                .compile(code)
+                .map_err(|e| JsValue::from_str(&format!("{}", &e)))?,
+        );
+        Ok(())
+    }
+
+    /// Parses `content` with the session's input format and retains the parsed
+    /// document in wasm memory, replacing any previously loaded document.
+    #[wasm_bindgen(js_name=loadDocument, skip_typescript)]
+    pub fn load_document(&mut self, content: &str) -> Result<(), JsValue> {
+        self.input = Some(parse_input_content(content, &self.options)?);
+        Ok(())
+    }
+
+    /// Evaluates the retained program against the retained document, buffering
+    /// the rendered output. Returns the buffered size in bytes; read the text
+    /// back with [`Session::next_result_chunk`].
+    #[wasm_bindgen(skip_typescript)]
+    pub fn evaluate(&mut self) -> Result<usize, JsValue> {
+        let program = self
+            .program
+            .as_ref()
+            .ok_or_else(|| JsValue::from_str("No compiled query: call compile() first"))?;
+        let input = self
+            .input
+            .as_ref()
+            .ok_or_else(|| JsValue::from_str("No document loaded: call loadDocument() first"))?;
+
+        let result_values = self
+            .engine
+            .eval_compiled(program, input.clone().into_iter())
+            .map_err(|e| JsValue::from_str(&format!("{}", &e)))?;
+
+        let values = if matches!(self.options.input_format, Some(InputFormat::Markdown)) && self.options.is_update {
+            let values: mq_lang::RuntimeValues = input.clone().into();
+            values.update_with(result_values)
+        } else {
+            result_values
+        };
+
+        self.result = render_output(values, &self.options);
+        self.result_cursor = 0;
+        Ok(self.result.len())
+    }
+
+    /// Returns the next chunk of the buffered result, at most `max_bytes` bytes
+    /// (rounded down to a character boundary), or `None` when exhausted.
+    #[wasm_bindgen(js_name=nextResultChunk, skip_typescript)]
+    pub fn next_result_chunk(&mut self, max_bytes: usize) -> Option<String> {
+        if self.result_cursor >= self.result.len() {
+            return None;
+        }
+
+        let mut end = (self.result_cursor + max_bytes.max(1)).min(self.result.len());
+        while !self.result.is_char_boundary(end) {
+            end -= 1;
+        }
+        // max_bytes smaller than the next character still makes progress.
+        if end <= self.result_cursor {
+            end = self.result_cursor + 1;
+            while end < self.result.len() && !self.result.is_char_boundary(end) {
+                end += 1;
+            }
+        }
+
+        let chunk = self.result[self.result_cursor..end].to_string();
+        self.result_cursor = end;
+        Some(chunk)
+    }
 }
 
 #[wasm_bindgen(js_name=toAst)]
@@ -1343,6 +1512,95 @@ mod tests {
         );
     }
 
+    #[allow(unused)]
+    #[wasm_bindgen_test]
+    async fn test_session_compile_once_evaluate_many() {
+        let mut session = Session::new(
+            serde_wasm_bindgen::to_value(&Options {
+                is_update: false,
+                input_format: None,
+                list_style: None,
+                link_title_style: None,
+                link_url_style: None,
+                allowed_domains: None,
+                timeout_ms: None,
+            })
+            .unwrap(),
+        )
+        .unwrap();
+
+        session.compile(".h1 | upcase()").await.unwrap();
+        session.load_document("# first\n\ntext").unwrap();
+
+        // Re-running against the retained parse must not require reloading.
+        for _ in 0..2 {
+            let len = session.evaluate().unwrap();
+            let mut result = String::new();
+            while let Some(chunk) = session.next_result_chunk(4) {
+                result.push_str(&chunk);
+            }
+            assert_eq!(len, result.len());
+            assert_eq!(result, "# FIRST\n");
+        }
+
+        // Recompiling swaps the query while keeping the loaded document.
+        session.compile(".h1 | downcase()").await.unwrap();
+        session.evaluate().unwrap();
+        assert_eq!(session.next_result_chunk(1024).unwrap(), "# first\n");
+    }
+
+    #[allow(unused)]
+    #[wasm_bindgen_test]
+    async fn test_session_requires_compile_and_document() {
+        let mut session = Session::new(
+            serde_wasm_bindgen::to_value(&Options {
+                is_update: false,
+                input_format: None,
+                list_style: None,
+                link_title_style: None,
+                link_url_style: None,
+                allowed_domains: None,
+                timeout_ms: None,
+            })
+            .unwrap(),
+        )
+        .unwrap();
+
+        assert!(session.evaluate().is_err());
+        session.compile(".h1").await.unwrap();
+        assert!(session.evaluate().is_err());
+        assert!(session.compile("invalid syntax").await.is_err());
+    }
+
+    #[allow(unused)]
+    #[wasm_bindgen_test]
+    async fn test_session_chunked_result_respects_char_boundaries() {
+        let mut session = Session::new(
+            serde_wasm_bindgen::to_value(&Options {
+                is_update: false,
+                input_format: None,
+                list_style: None,
+                link_title_style: None,
+                link_url_style: None,
+                allowed_domains: None,
+                timeout_ms: None,
+            })
+            .unwrap(),
+        )
+        .unwrap();
+
+        session.compile("trim()").await.unwrap();
+        session.load_document("日本語のテキスト").unwrap();
+        session.evaluate().unwrap();
+
+        // A max_bytes that lands mid-codepoint must still yield valid chunks.
+        let mut result = String::new();
+        while let Some(chunk) = session.next_result_chunk(2) {
+            result.push_str(&chunk);
+        }
+        assert_eq!(result, "日本語のテキスト\n");
+    }
+
     #[allow(unused)]
     #[wasm_bindgen_test]
     async fn test_script_format() {
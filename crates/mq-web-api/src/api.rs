@@ -6,6 +6,8 @@ use rayon::prelude::*;
 use serde::{Deserialize, Serialize};
 use utoipa::ToSchema;
 
+use crate::engine_pool::EnginePool;
+
 /// Maximum number of documents allowed in a single `POST /api/v1/batch` request.
 pub const MAX_BATCH_SIZE: usize = 100;
 
@@ -240,13 +242,17 @@ pub struct LintApiResponse {
     pub diagnostics: Vec<LintDiagnostic>,
 }
 
-pub fn query(request: ApiRequest, timeout: std::time::Duration) -> miette::Result<QueryApiResponse> {
-    execute_query(request, timeout)
+pub fn query(request: ApiRequest, timeout: std::time::Duration, pool: &EnginePool) -> miette::Result<QueryApiResponse> {
+    execute_query(request, timeout, pool)
 }
 
 /// Runs `request.query` against every document in `request.inputs` in
-/// parallel, each with its own engine instance.
-pub fn batch_query(request: BatchApiRequest, timeout: std::time::Duration) -> miette::Result<BatchApiResponse> {
+/// parallel, each with its own engine checked out of `pool`.
+pub fn batch_query(
+    request: BatchApiRequest,
+    timeout: std::time::Duration,
+    pool: &EnginePool,
+) -> miette::Result<BatchApiResponse> {
     if request.inputs.len() > MAX_BATCH_SIZE {
         return Err(miette!(
             "Batch request exceeds maximum of {} documents (got {})",
@@ -268,7 +274,7 @@ pub fn batch_query(request: BatchApiRequest, timeout: std::time::Duration) -> mi
                 output_format: request.output_format.clone(),
                 aggregate: request.aggregate,
             };
-            match execute_query(item_request, timeout) {
+            match execute_query(item_request, timeout, pool) {
                 Ok(response) => BatchItemResult {
                     results: response.results,
                     error: None,
@@ -417,14 +423,29 @@ fn type_error_kind(e: &mq_check::TypeError) -> String {
     .to_string()
 }
 
-fn execute_query(request: ApiRequest, timeout: std::time::Duration) -> miette::Result<QueryApiResponse> {
-    let mut engine = mq_lang::DefaultEngine::default();
-    engine.load_builtin_module();
-    engine.set_timeout(timeout);
+fn execute_query(
+    request: ApiRequest,
+    timeout: std::time::Duration,
+    pool: &EnginePool,
+) -> miette::Result<QueryApiResponse> {
+    let input_format = request.input_format.clone().unwrap_or(InputFormat::Markdown);
+
+    // `modules` and `args` bind into the engine's root environment permanently,
+    // and the query prefixes added for `aggregate` and module-backed input
+    // formats contain an `import` that does the same. Such requests get a
+    // one-off engine that is never returned to the pool.
+    let poolable = request.modules.as_ref().is_none_or(|m| m.is_empty())
+        && request.args.as_ref().is_none_or(|a| a.is_empty())
+        && !request.aggregate.unwrap_or(false)
+        && input_format.module_query_prefix().is_none();
+
+    let mut pooled = if poolable { pool.checkout() } else { pool.fresh() };
+    pooled.engine_mut().set_timeout(timeout);
 
     if let Some(modules) = &request.modules {
         for module_name in modules {
-            engine
+            pooled
+                .engine_mut()
                 .load_module(module_name)
                 .map_err(|e| miette!("Failed to load module '{}': {}", module_name, e))?;
         }
@@ -432,12 +453,10 @@ fn execute_query(request: ApiRequest, timeout: std::time::Duration) -> miette::R
 
     if let Some(args) = &request.args {
         for (name, value) in args {
-            engine.define_string_value(name, value);
+            pooled.engine_mut().define_string_value(name, value);
         }
     }
 
-    let input_format = request.input_format.clone().unwrap_or(InputFormat::Markdown);
-
     let query = {
         let base = if request.aggregate.unwrap_or(false) {
             format!(r#"nodes | import "section" | {}"#, request.query)
@@ -468,10 +487,20 @@ fn execute_query(request: ApiRequest, timeout: std::time::Duration) -> miette::R
         | InputFormat::Toon => mq_lang::raw_input(&request.input.unwrap_or_default()),
     };
 
-    let runtime_values = engine
-        .eval(&query, input.into_iter())
+    let compiled = pooled
+        .compile(&query)
         .map_err(|e| miette!("Error executing query: {}", e))?;
 
+    let result = pooled.engine_mut().eval_compiled(&compiled, input.into_iter());
+
+    // An evaluation that defined nothing at the top level leaves the engine
+    // pristine (even when it failed), so it can serve the next request.
+    if poolable && !compiled.mutates_env() {
+        pool.checkin(pooled);
+    }
+
+    let runtime_values = result.map_err(|e| miette!("Error executing query: {}", e))?;
+
     let nodes: Vec<mq_markdown::Node> = runtime_values
         .values()
         .iter()
@@ -510,7 +539,7 @@ fn collect_markdown_nodes(value: &mq_lang::RuntimeValue, nodes: &mut Vec<mq_mark
     }
 }
 
-fn is_typed_dict(map: &std::collections::BTreeMap<mq_lang::Ident, mq_lang::RuntimeValue>) -> bool {
+fn is_typed_dict(map: &mq_lang::Dict) -> bool {
     let type_key = mq_lang::Ident::new("type");
     matches!(
         map.get(&type_key),
@@ -518,9 +547,7 @@ fn is_typed_dict(map: &std::collections::BTreeMap<mq_lang::Ident, mq_lang::Runti
     )
 }
 
-fn expand_typed_dict(
-    map: &std::collections::BTreeMap<mq_lang::Ident, mq_lang::RuntimeValue>,
-) -> Option<Vec<mq_markdown::Node>> {
+fn expand_typed_dict(map: &mq_lang::Dict) -> Option<Vec<mq_markdown::Node>> {
     let type_key = mq_lang::Ident::new("type");
     match map.get(&type_key) {
         Some(mq_lang::RuntimeValue::Symbol(s)) => match s.as_str().as_str() {
@@ -580,8 +607,13 @@ fn runtime_value_to_nodes(runtime_value: &mq_lang::RuntimeValue) -> Vec<mq_markd
 #[cfg(test)]
 mod tests {
     use super::*;
+    use crate::engine_pool::EnginePoolConfig;
     use rstest::rstest;
 
+    fn test_pool() -> EnginePool {
+        EnginePool::new(EnginePoolConfig::default())
+    }
+
     #[rstest]
     #[case(InputFormat::Csv, "name,age\nAlice,30\nBob,25")]
     #[case(InputFormat::Tsv, "name\tage\nAlice\t30")]
@@ -601,7 +633,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok(), "{:?}", result.err());
         assert!(!result.unwrap().results.is_empty());
     }
@@ -631,7 +663,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         assert!(!result.unwrap().results.is_empty());
     }
@@ -647,7 +679,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
     }
 
@@ -662,7 +694,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_err());
     }
 
@@ -678,7 +710,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
     }
 
@@ -694,7 +726,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_err());
     }
 
@@ -712,7 +744,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         let resp = result.unwrap();
         assert!(!resp.results.is_empty());
@@ -729,7 +761,7 @@ mod tests {
             output_format: Some(OutputFormat::Html),
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         let resp = result.unwrap();
         assert!(!resp.results.is_empty());
@@ -747,7 +779,7 @@ mod tests {
             output_format: Some(OutputFormat::None),
             aggregate: None,
         };
-        let result = query(req, std::time::Duration::from_secs(10));
+        let result = query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         assert!(result.unwrap().results.is_empty());
     }
@@ -763,7 +795,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = batch_query(req, std::time::Duration::from_secs(10));
+        let result = batch_query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         let resp = result.unwrap();
         assert_eq!(resp.items.len(), 2);
@@ -783,7 +815,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = batch_query(req, std::time::Duration::from_secs(10));
+        let result = batch_query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         let resp = result.unwrap();
         assert_eq!(resp.items.len(), 1);
@@ -802,7 +834,7 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = batch_query(req, std::time::Duration::from_secs(10));
+        let result = batch_query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_ok());
         assert!(result.unwrap().items.is_empty());
     }
@@ -818,10 +850,54 @@ mod tests {
             output_format: None,
             aggregate: None,
         };
-        let result = batch_query(req, std::time::Duration::from_secs(10));
+        let result = batch_query(req, std::time::Duration::from_secs(10), &test_pool());
         assert!(result.is_err());
     }
 
+    #[test]
+    fn test_pool_does_not_leak_top_level_bindings_between_requests() {
+        let pool = test_pool();
+        let first = ApiRequest {
+            query: r#"let secret = "s3cret" | .h"#.to_string(),
+            input: Some("# Title".to_string()),
+            input_format: Some(InputFormat::Markdown),
+            modules: None,
+            args: None,
+            output_format: None,
+            aggregate: None,
+        };
+        assert!(query(first, std::time::Duration::from_secs(10), &pool).is_ok());
+
+        // `secret` must be undefined again for the next request on the same pool.
+        let second = ApiRequest {
+            query: "secret".to_string(),
+            input: Some("# Title".to_string()),
+            input_format: Some(InputFormat::Markdown),
+            modules: None,
+            args: None,
+            output_format: None,
+            aggregate: None,
+        };
+        assert!(query(second, std::time::Duration::from_secs(10), &pool).is_err());
+    }
+
+    #[test]
+    fn test_pool_repeated_query_returns_same_results() {
+        let pool = test_pool();
+        let req = ApiRequest {
+            query: ".h".to_string(),
+            input: Some("# Title\n\nContent".to_string()),
+            input_format: Some(InputFormat::Markdown),
+            modules: None,
+            args: None,
+            output_format: None,
+            aggregate: None,
+        };
+        let first = query(req.clone(), std::time::Duration::from_secs(10), &pool).unwrap();
+        let second = query(req, std::time::Duration::from_secs(10), &pool).unwrap();
+        assert_eq!(first.results, second.results);
+    }
+
     #[test]
     fn test_check_valid_query() {
         let req = CheckApiRequest {
@@ -1,3 +1,4 @@
+use crate::engine_pool::EnginePoolConfig;
 use crate::query_cache::QueryCacheConfig;
 use crate::rate_limiter::RateLimitConfig;
 use std::{env, time::Duration};
@@ -18,6 +19,8 @@ pub struct Config {
     pub query_timeout: Duration,
     /// Short-lived cache for repeated `{query, input, input_format, args}` combinations.
     pub query_cache: QueryCacheConfig,
+    /// Pool of warm engines and per-engine compiled-query caches.
+    pub engine_pool: EnginePoolConfig,
 }
 
 #[derive(Debug, Clone)]
@@ -39,6 +42,7 @@ impl Default for Config {
             otel_service_name: "mq-web-api".to_string(),
             query_timeout: Duration::from_secs(10),
             query_cache: QueryCacheConfig::default(),
+            engine_pool: EnginePoolConfig::default(),
         }
     }
 }
@@ -177,6 +181,38 @@ impl Config {
             }
         }
 
+        if let Ok(enabled_str) = env::var("ENGINE_POOL_ENABLED") {
+            match enabled_str.parse::<bool>() {
+                Ok(enabled) => config.engine_pool.enabled = enabled,
+                Err(_) => eprintln!(
+                    "Warning: Invalid ENGINE_POOL_ENABLED value '{}', using default {}",
+                    enabled_str, config.engine_pool.enabled
+                ),
+            }
+        }
+
+        if let Ok(max_engines_str) = env::var("ENGINE_POOL_MAX_ENGINES") {
+            if let Ok(max_engines) = max_engines_str.parse::<usize>() {
+                config.engine_pool.max_engines = max_engines;
+            } else {
+                eprintln!(
+                    "Warning: Invalid ENGINE_POOL_MAX_ENGINES value '{}', using default {}",
+                    max_engines_str, config.engine_pool.max_engines
+                );
+            }
+        }
+
+        if let Ok(max_compiled_str) = env::var("ENGINE_POOL_MAX_COMPILED_QUERIES") {
+            if let Ok(max_compiled) = max_compiled_str.parse::<usize>() {
+                config.engine_pool.max_compiled_queries = max_compiled;
+            } else {
+                eprintln!(
+                    "Warning: Invalid ENGINE_POOL_MAX_COMPILED_QUERIES value '{}', using default {}",
+                    max_compiled_str, config.engine_pool.max_compiled_queries
+                );
+            }
+        }
+
         config
     }
 
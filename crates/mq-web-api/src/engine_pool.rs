@@ -0,0 +1,254 @@
+//! Pool of warm `mq_lang` engines with a per-engine compiled-query cache.
+//!
+//! Building an engine for every request re-parses the builtin module each
+//! time, and most production traffic repeats a small set of queries, so the
+//! per-request cost is dominated by initialization and parsing rather than
+//! evaluation. The pool keeps engines that already have builtins loaded and
+//! each engine carries an LRU cache of [`mq_lang::CompiledProgram`]s keyed by
+//! query text, so a repeated query skips straight to evaluation.
+//!
+//! The compiled cache is per engine rather than shared: a compiled program's
+//! node ids index the token arena of the engine that compiled it, so it must
+//! only be evaluated on that engine.
+//!
+//! An engine is only returned to the pool when the request couldn't have left
+//! state behind: no `modules`, no `args`, and a query for which
+//! [`mq_lang::CompiledProgram::mutates_env`] is `false`. Anything else (a
+//! top-level `let`, an `import`, ...) permanently binds into the engine's
+//! root environment, and handing that engine to the next caller would leak
+//! one request's bindings — potentially derived from its input — into
+//! another. Such engines are dropped and replaced lazily.
+
+use std::collections::HashMap;
+use std::sync::Mutex;
+use std::time::Instant;
+
+#[derive(Debug, Clone)]
+pub struct EnginePoolConfig {
+    pub enabled: bool,
+    /// Maximum number of idle engines kept warm.
+    pub max_engines: usize,
+    /// Maximum number of compiled queries cached per engine.
+    pub max_compiled_queries: usize,
+}
+
+impl Default for EnginePoolConfig {
+    fn default() -> Self {
+        Self {
+            enabled: true,
+            max_engines: 8,
+            max_compiled_queries: 256,
+        }
+    }
+}
+
+struct CompiledEntry {
+    program: mq_lang::CompiledProgram,
+    last_used: Instant,
+}
+
+/// A warm engine checked out of an [`EnginePool`], together with the compiled
+/// programs it has produced so far.
+pub struct PooledEngine {
+    engine: mq_lang::DefaultEngine,
+    compiled: HashMap<String, CompiledEntry>,
+    max_compiled_queries: usize,
+    /// Total distinct queries this engine has ever compiled. Each compilation
+    /// appends tokens to the engine's arena, which are never freed, so the
+    /// pool retires engines that have compiled too many distinct queries
+    /// instead of letting their arenas grow without bound.
+    distinct_compiles: usize,
+}
+
+impl PooledEngine {
+    fn warm(max_compiled_queries: usize) -> Self {
+        let mut engine = mq_lang::DefaultEngine::default();
+        engine.load_builtin_module();
+        Self {
+            engine,
+            compiled: HashMap::new(),
+            max_compiled_queries,
+            distinct_compiles: 0,
+        }
+    }
+
+    pub fn engine_mut(&mut self) -> &mut mq_lang::DefaultEngine {
+        &mut self.engine
+    }
+
+    /// Returns the compiled program for `query`, compiling and caching it on
+    /// a miss. Compile errors are not cached.
+    pub fn compile(&mut self, query: &str) -> Result<mq_lang::CompiledProgram, Box<mq_lang::Error>> {
+        if let Some(entry) = self.compiled.get_mut(query) {
+            entry.last_used = Instant::now();
+            return Ok(entry.program.clone());
+        }
+
+        let program = self.engine.compile(query)?;
+
+        if self.max_compiled_queries > 0 {
+            if self.compiled.len() >= self.max_compiled_queries
+                && let Some(oldest) = self
+                    .compiled
+                    .iter()
+                    .min_by_key(|(_, entry)| entry.last_used)
+                    .map(|(key, _)| key.clone())
+            {
+                self.compiled.remove(&oldest);
+            }
+            self.compiled.insert(
+                query.to_string(),
+                CompiledEntry {
+                    program: program.clone(),
+                    last_used: Instant::now(),
+                },
+            );
+        }
+        self.distinct_compiles += 1;
+
+        Ok(program)
+    }
+}
+
+/// A capacity-bounded pool of warm engines. Checkout order is LIFO, so the
+/// most recently used engine (with the hottest compiled cache) is reused
+/// first under low concurrency.
+pub struct EnginePool {
+    idle: Mutex<Vec<PooledEngine>>,
+    config: EnginePoolConfig,
+}
+
+impl EnginePool {
+    pub fn new(config: EnginePoolConfig) -> Self {
+        Self {
+            idle: Mutex::new(Vec::new()),
+            config,
+        }
+    }
+
+    /// Takes a warm engine from the pool, or builds one (with builtins
+    /// loaded) when none is idle. With the pool disabled this always builds
+    /// a fresh engine, matching the previous engine-per-request behavior.
+    pub fn checkout(&self) -> PooledEngine {
+        if self.config.enabled
+            && let Some(engine) = self.idle.lock().expect("engine pool lock poisoned").pop()
+        {
+            return engine;
+        }
+        PooledEngine::warm(self.config.max_compiled_queries)
+    }
+
+    /// Builds a one-off warm engine without touching the idle set. Used for
+    /// requests that are going to taint the engine anyway (`modules`/`args`),
+    /// so they don't drain engines the poolable fast path could reuse.
+    pub fn fresh(&self) -> PooledEngine {
+        PooledEngine::warm(self.config.max_compiled_queries)
+    }
+
+    /// Returns an engine to the pool. The caller must only check in engines
+    /// whose root environment is still pristine (see the module docs);
+    /// engines beyond the pool capacity or past their compile budget are
+    /// dropped instead.
+    pub fn checkin(&self, engine: PooledEngine) {
+        if !self.config.enabled || engine.distinct_compiles > 4 * self.config.max_compiled_queries {
+            return;
+        }
+        let mut idle = self.idle.lock().expect("engine pool lock poisoned");
+        if idle.len() < self.config.max_engines {
+            idle.push(engine);
+        }
+    }
+
+    #[cfg(test)]
+    pub fn idle_count(&self) -> usize {
+        self.idle.lock().expect("engine pool lock poisoned").len()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn checkout_then_checkin_reuses_engine() {
+        let pool = EnginePool::new(EnginePoolConfig::default());
+        let mut engine = pool.checkout();
+        engine.compile(".h1").expect("compile failed");
+        pool.checkin(engine);
+        assert_eq!(pool.idle_count(), 1);
+
+        let reused = pool.checkout();
+        assert_eq!(pool.idle_count(), 0);
+        assert!(reused.compiled.contains_key(".h1"));
+    }
+
+    #[test]
+    fn compile_hit_returns_cached_program() {
+        let pool = EnginePool::new(EnginePoolConfig::default());
+        let mut engine = pool.checkout();
+        let first = engine.compile(".h1").expect("compile failed");
+        let second = engine.compile(".h1").expect("compile failed");
+        assert_eq!(first.source(), second.source());
+        assert_eq!(engine.compiled.len(), 1);
+        assert_eq!(engine.distinct_compiles, 1);
+    }
+
+    #[test]
+    fn compile_cache_evicts_least_recently_used() {
+        let pool = EnginePool::new(EnginePoolConfig {
+            max_compiled_queries: 2,
+            ..EnginePoolConfig::default()
+        });
+        let mut engine = pool.checkout();
+        engine.compile(".h1").expect("compile failed");
+        engine.compile(".h2").expect("compile failed");
+        // Touch `.h1` so `.h2` becomes the eviction candidate.
+        engine.compile(".h1").expect("compile failed");
+        engine.compile(".h3").expect("compile failed");
+
+        assert_eq!(engine.compiled.len(), 2);
+        assert!(engine.compiled.contains_key(".h1"));
+        assert!(!engine.compiled.contains_key(".h2"));
+    }
+
+    #[test]
+    fn compile_error_is_not_cached() {
+        let pool = EnginePool::new(EnginePoolConfig::default());
+        let mut engine = pool.checkout();
+        assert!(engine.compile("def f(: 1;").is_err());
+        assert!(engine.compiled.is_empty());
+    }
+
+    #[test]
+    fn checkin_respects_capacity() {
+        let pool = EnginePool::new(EnginePoolConfig {
+            max_engines: 1,
+            ..EnginePoolConfig::default()
+        });
+        pool.checkin(pool.checkout());
+        pool.checkin(PooledEngine::warm(256));
+        assert_eq!(pool.idle_count(), 1);
+    }
+
+    #[test]
+    fn disabled_pool_never_retains_engines() {
+        let pool = EnginePool::new(EnginePoolConfig {
+            enabled: false,
+            ..EnginePoolConfig::default()
+        });
+        pool.checkin(pool.checkout());
+        assert_eq!(pool.idle_count(), 0);
+    }
+
+    #[test]
+    fn engine_past_compile_budget_is_retired() {
+        let pool = EnginePool::new(EnginePoolConfig {
+            max_compiled_queries: 0,
+            ..EnginePoolConfig::default()
+        });
+        let mut engine = pool.checkout();
+        engine.compile(".h1").expect("compile failed");
+        pool.checkin(engine);
+        assert_eq!(pool.idle_count(), 0);
+    }
+}
@@ -17,6 +17,7 @@ use crate::{
         FormatApiRequest, FormatApiResponse, FunctionDoc, FunctionsApiResponse, InputFormat, LintApiRequest,
         LintApiResponse, LintDiagnostic, OutputFormat, QueryApiResponse, SelectorDoc, SelectorsApiResponse,
     },
+    engine_pool::EnginePool,
     problem::ProblemDetails,
     query_cache::{self, QueryCache},
 };
@@ -27,6 +28,8 @@ pub struct AppState {
     pub query_timeout: Duration,
     /// Short-lived cache of `execute_query` results.
     pub query_cache: Arc<QueryCache>,
+    /// Pool of warm engines with per-engine compiled-query caches.
+    pub engine_pool: Arc<EnginePool>,
 }
 
 /// Returns a cached response for `request` if one is fresh, otherwise runs
@@ -50,7 +53,8 @@ async fn execute_query_with_cache(
     }
 
     let timeout = state.query_timeout;
-    let result = tokio::task::spawn_blocking(move || crate::api::query(request, timeout)).await?;
+    let pool = Arc::clone(&state.engine_pool);
+    let result = tokio::task::spawn_blocking(move || crate::api::query(request, timeout, &pool)).await?;
 
     if let (Ok(response), Some(key)) = (&result, cache_key) {
         state.query_cache.insert(key, response.clone()).await;
@@ -269,7 +273,8 @@ pub async fn post_batch_api(
 
     let query_str = request.query.clone();
     let timeout = state.query_timeout;
-    match tokio::task::spawn_blocking(move || crate::api::batch_query(request, timeout))
+    let pool = Arc::clone(&state.engine_pool);
+    match tokio::task::spawn_blocking(move || crate::api::batch_query(request, timeout, &pool))
         .await
         .map_err(|e| {
             error!("Batch task panicked: {}", e);
@@ -59,6 +59,7 @@ pub mod api;
 pub mod banner;
 pub mod cleanup;
 pub mod config;
+pub mod engine_pool;
 pub mod handlers;
 pub mod middleware;
 pub mod problem;
@@ -70,5 +71,6 @@ pub mod server;
 pub use api::{ApiRequest, InputFormat, query};
 pub use cleanup::CleanupService;
 pub use config::Config;
+pub use engine_pool::{EnginePool, EnginePoolConfig};
 pub use query_cache::{QueryCache, QueryCacheConfig};
 pub use rate_limiter::{RateLimitConfig, RateLimitError, RateLimiter};
@@ -17,6 +17,7 @@ use utoipa_swagger_ui::SwaggerUi;
 
 use crate::{
     config::Config,
+    engine_pool::EnginePool,
     handlers::{
         ApiDoc, AppState, get_functions_api, get_query_api, get_selectors_api, health_check, post_batch_api,
         post_check_api, post_format_api, post_lint_api, post_query_api, post_shorthand_query_api,
@@ -30,6 +31,7 @@ pub fn create_router(config: &Config, rate_limiter: Arc<RateLimiter>) -> Router
     let state = AppState {
         query_timeout: config.query_timeout,
         query_cache: Arc::new(QueryCache::new(config.query_cache.clone())),
+        engine_pool: Arc::new(EnginePool::new(config.engine_pool.clone())),
     };
 
     let cors = if config.cors_origins.contains(&"*".to_string()) {